@@ -58,6 +58,12 @@ uint8_t ba121_basic_init(void)
     DRIVER_BA121_LINK_UART_WRITE(&gs_handle, ba121_interface_uart_write);
     DRIVER_BA121_LINK_DELAY_MS(&gs_handle, ba121_interface_delay_ms);
     DRIVER_BA121_LINK_DEBUG_PRINT(&gs_handle, ba121_interface_debug_print);
+    DRIVER_BA121_LINK_TIMESTAMP_US(&gs_handle, ba121_interface_timestamp_us);
+    DRIVER_BA121_LINK_WAIT_REPLY(&gs_handle, ba121_interface_wait_reply);
+    DRIVER_BA121_LINK_OS_LOCK(&gs_handle, ba121_interface_os_lock);
+    DRIVER_BA121_LINK_OS_UNLOCK(&gs_handle, ba121_interface_os_unlock);
+    DRIVER_BA121_LINK_OS_SEM_WAIT(&gs_handle, ba121_interface_os_sem_wait);
+    DRIVER_BA121_LINK_OS_SEM_GIVE(&gs_handle, ba121_interface_os_sem_give);
     
     /* ba121 init */
     res = ba121_init(&gs_handle);
@@ -68,6 +74,17 @@ uint8_t ba121_basic_init(void)
         return 1;
     }
     
+    /* set default retry */
+    res = ba121_set_retry(&gs_handle, BA121_BASIC_DEFAULT_RETRY_ATTEMPTS, BA121_BASIC_DEFAULT_RETRY_BACKOFF,
+                          BA121_BASIC_DEFAULT_RETRY_MAX_BACKOFF, BA121_BASIC_DEFAULT_RETRY_MASK);
+    if (res != 0)
+    {
+        ba121_interface_debug_print("ba121: set retry failed.\n");
+        (void)ba121_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
 #if (BA121_BASIC_SEND_CONFIG != 0)
     /* set default ntc resistance */
     res = ba121_set_ntc_resistance(&gs_handle, BA121_BASIC_DEFAULT_NTC_RESISTANCE);
@@ -118,6 +135,33 @@ uint8_t ba121_basic_read( uint16_t *conductivity_us_cm, float *temperature_deg)
     return 0;
 }
 
+/**
+ * @brief      basic example read with the raw data and the timestamp
+ * @param[out] *conductivity_raw pointer to a conductivity raw data buffer
+ * @param[out] *conductivity_us_cm pointer to a conductivity uS/cm data buffer
+ * @param[out] *temperature_raw pointer to a temperature raw data buffer
+ * @param[out] *temperature_deg pointer to a converted temperature data buffer
+ * @param[out] *timestamp_us pointer to a reply arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ba121_basic_read_with_timestamp(uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
+                                        uint16_t *temperature_raw, float *temperature_deg, uint64_t *timestamp_us)
+{
+    uint64_t tx_us;
+    
+    /* read */
+    if (ba121_read_with_timestamp(&gs_handle, conductivity_raw, conductivity_us_cm,
+                                  temperature_raw, temperature_deg, &tx_us, timestamp_us) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  basic example deinit
  * @return status code
@@ -62,6 +62,11 @@ extern "C"{
  */
 #define BA121_BASIC_DEFAULT_NTC_RESISTANCE        (10 * 1000)        /**< 10k */
 #define BA121_BASIC_DEFAULT_NTC_B                  3435              /**< 3435 */
+#define BA121_BASIC_DEFAULT_RETRY_ATTEMPTS         3                 /**< 3 attempts */
+#define BA121_BASIC_DEFAULT_RETRY_BACKOFF          20                /**< 20ms */
+#define BA121_BASIC_DEFAULT_RETRY_MAX_BACKOFF      80                /**< 80ms */
+#define BA121_BASIC_DEFAULT_RETRY_MASK             (BA121_RETRY_LINK_ERROR | \
+                                                    BA121_RETRY_FRAME_ERROR)        /**< link and frame errors */
 
 /**
  * @brief  basic example init
@@ -92,6 +97,21 @@ uint8_t ba121_basic_deinit(void);
  */
 uint8_t ba121_basic_read( uint16_t *conductivity_us_cm, float *temperature_deg);
 
+/**
+ * @brief      basic example read with the raw data and the timestamp
+ * @param[out] *conductivity_raw pointer to a conductivity raw data buffer
+ * @param[out] *conductivity_us_cm pointer to a conductivity uS/cm data buffer
+ * @param[out] *temperature_raw pointer to a temperature raw data buffer
+ * @param[out] *temperature_deg pointer to a converted temperature data buffer
+ * @param[out] *timestamp_us pointer to a reply arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ba121_basic_read_with_timestamp(uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
+                                        uint16_t *temperature_raw, float *temperature_deg, uint64_t *timestamp_us);
+
 /**
  * @brief  basic example baseline calibration
  * @return status code
@@ -106,6 +106,53 @@ uint8_t ba121_interface_uart_write(uint8_t *buf, uint16_t len);
  */
 void ba121_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t ba121_interface_timestamp_us(void);
+
+/**
+ * @brief     interface wait reply
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      must block until len bytes are readable or timeout_ms has passed, the driver reads
+ *            right after it returns, so returning early makes the read fail
+ */
+uint8_t ba121_interface_wait_reply(uint16_t len, uint32_t timeout_ms);
+
+/**
+ * @brief interface os lock
+ * @note  blocks until the driver mutex is held
+ */
+void ba121_interface_os_lock(void);
+
+/**
+ * @brief interface os unlock
+ * @note  none
+ */
+void ba121_interface_os_unlock(void);
+
+/**
+ * @brief     interface os semaphore wait
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      takes one count of the driver counting semaphore
+ */
+uint8_t ba121_interface_os_sem_wait(uint32_t timeout_ms);
+
+/**
+ * @brief interface os semaphore give
+ * @note  adds one count to the driver counting semaphore
+ */
+void ba121_interface_os_sem_give(void);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -110,6 +110,73 @@ void ba121_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t ba121_interface_timestamp_us(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface wait reply
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      must block until len bytes are readable or timeout_ms has passed, the driver reads
+ *            right after it returns, the default waits the whole timeout like a plain delay
+ */
+uint8_t ba121_interface_wait_reply(uint16_t len, uint32_t timeout_ms)
+{
+    ba121_interface_delay_ms(timeout_ms);
+    
+    return 0;
+}
+
+/**
+ * @brief interface os lock
+ * @note  blocks until the driver mutex is held
+ */
+void ba121_interface_os_lock(void)
+{
+
+}
+
+/**
+ * @brief interface os unlock
+ * @note  none
+ */
+void ba121_interface_os_unlock(void)
+{
+
+}
+
+/**
+ * @brief     interface os semaphore wait
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      takes one count of the driver counting semaphore
+ */
+uint8_t ba121_interface_os_sem_wait(uint32_t timeout_ms)
+{
+    return 1;
+}
+
+/**
+ * @brief interface os semaphore give
+ * @note  adds one count to the driver counting semaphore
+ */
+void ba121_interface_os_sem_give(void)
+{
+
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
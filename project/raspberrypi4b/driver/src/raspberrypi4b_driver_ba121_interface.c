@@ -35,18 +35,196 @@
  */
 
 #include "driver_ba121_interface.h"
+#include "driver_ba121_frame.h"
 #include "uart.h"
+#include <errno.h>
+#include <pthread.h>
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief uart device name definition
+ * @note  use a /dev/serial/by-id path for usb adapters, so the name survives a reset
  */
-#define UART_DEVICE_NAME "/dev/ttyS0"        /**< uart device name */
+#ifndef UART_DEVICE_NAME
+    #define UART_DEVICE_NAME "/dev/ttyS0"        /**< uart device name */
+#endif
+
+/**
+ * @brief uart baud rate definition
+ */
+#ifndef UART_BAUD_RATE
+    #define UART_BAUD_RATE 9600                  /**< 9600bps */
+#endif
+
+/**
+ * @brief uart reconnect timeout definition
+ */
+#ifndef UART_RECONNECT_TIMEOUT_MS
+    #define UART_RECONNECT_TIMEOUT_MS 1000       /**< 1000ms */
+#endif
 
 /**
  * @brief uart device handle definition
  */
-static int gs_fd;                           /**< uart handle */
+static int gs_fd = -1;                      /**< uart handle */
+
+/**
+ * @brief cached config frame definition
+ */
+static uint8_t gs_ntc_resistance[6];        /**< last ntc resistance frame */
+static uint8_t gs_ntc_b[6];                 /**< last ntc b frame */
+static uint8_t gs_ntc_resistance_valid;     /**< ntc resistance frame valid flag */
+static uint8_t gs_ntc_b_valid;              /**< ntc b frame valid flag */
+static uint8_t gs_ntc_pending[6];           /**< ntc frame waiting for its ack */
+static uint8_t gs_ntc_pending_valid;        /**< pending ntc frame valid flag */
+static uint8_t gs_rx[6];                    /**< last received bytes */
+static uint8_t gs_rx_len;                   /**< last received bytes length */
+
+/**
+ * @brief os mutex and semaphore definition
+ */
+static pthread_mutex_t gs_os_mutex = PTHREAD_MUTEX_INITIALIZER;         /**< driver mutex */
+static pthread_mutex_t gs_sem_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< semaphore mutex */
+static pthread_cond_t gs_sem_cond;                                     /**< semaphore condition */
+static pthread_once_t gs_sem_once = PTHREAD_ONCE_INIT;                 /**< semaphore init flag */
+static uint32_t gs_sem_count;                                          /**< semaphore count */
+
+/**
+ * @brief  open the device
+ * @return status code
+ *         - 0 success
+ *         - 1 open failed
+ * @note   none
+ */
+static uint8_t a_uart_open(void)
+{
+    return uart_init(UART_DEVICE_NAME, &gs_fd, UART_BAUD_RATE, 8, 'N', 1);
+}
+
+/**
+ * @brief     replay one cached config frame
+ * @param[in] *frame pointer to a frame buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 no ack
+ * @note      returns as soon as the ack is buffered, waits at most BA121_ACK_DELAY_MS
+ */
+static uint8_t a_uart_replay(uint8_t frame[6])
+{
+    uint8_t buf[6];
+    uint32_t len = 6;
+    uint32_t data;
+    
+    if (uart_flush(gs_fd) != 0)
+    {
+        return 1;
+    }
+    if (uart_write(gs_fd, frame, 6) != 0)
+    {
+        return 1;
+    }
+    if (uart_wait_data(gs_fd, 6, BA121_ACK_DELAY_MS) != 0)
+    {
+        return 1;
+    }
+    if ((uart_read(gs_fd, buf, &len) != 0) || (len != 6))
+    {
+        return 1;
+    }
+    if (ba121_frame_parse(buf, BA121_FRAME_ACK, &data) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     watch the received bytes for the ack of a pending ntc frame
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @note      the frame is only cached once the device acked it, so a refused config is never replayed
+ */
+static void a_uart_ack(const uint8_t *buf, uint32_t len)
+{
+    uint32_t data;
+    uint32_t i;
+    
+    for (i = 0; (i < len) && (gs_ntc_pending_valid != 0); i++)
+    {
+        if (gs_rx_len == 6)
+        {
+            memmove(gs_rx, gs_rx + 1, 5);
+            gs_rx_len = 5;
+        }
+        gs_rx[gs_rx_len++] = buf[i];
+        if ((gs_rx_len == 6) && (ba121_frame_parse(gs_rx, BA121_FRAME_ACK, &data) == 0))
+        {
+            if (gs_ntc_pending[0] == BA121_COMMAND_NTC_RES)
+            {
+                memcpy(gs_ntc_resistance, gs_ntc_pending, 6);
+                gs_ntc_resistance_valid = 1;
+            }
+            else
+            {
+                memcpy(gs_ntc_b, gs_ntc_pending, 6);
+                gs_ntc_b_valid = 1;
+            }
+            gs_ntc_pending_valid = 0;
+        }
+    }
+}
+
+/**
+ * @brief  reopen the device after a disconnect
+ * @return status code
+ *         - 0 success
+ *         - 1 reconnect failed
+ * @note   waits up to UART_RECONNECT_TIMEOUT_MS for the device node,
+ *         then restores the cached ntc config, each frame takes until its ack, at most BA121_ACK_DELAY_MS
+ */
+static uint8_t a_uart_reconnect(void)
+{
+    ba121_interface_debug_print("ba121: uart lost, reconnecting.\n");
+    if (uart_reopen(UART_DEVICE_NAME, &gs_fd, UART_BAUD_RATE, UART_RECONNECT_TIMEOUT_MS) != 0)
+    {
+        ba121_interface_debug_print("ba121: uart reconnect failed.\n");
+        
+        return 1;
+    }
+    
+    /* restore the config, a refused frame stays cached for the next reconnect */
+    if ((gs_ntc_resistance_valid != 0) && (a_uart_replay(gs_ntc_resistance) != 0))
+    {
+        ba121_interface_debug_print("ba121: ntc resistance replay not acked.\n");
+    }
+    if ((gs_ntc_b_valid != 0) && (a_uart_replay(gs_ntc_b) != 0))
+    {
+        ba121_interface_debug_print("ba121: ntc b replay not acked.\n");
+    }
+    ba121_interface_debug_print("ba121: uart reconnected.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief     check a failed call
+ * @param[in] err errno of the failed call
+ * @return    status code
+ *            - 0 reconnected
+ *            - 1 not a disconnect or reconnect failed
+ * @note      none
+ */
+static uint8_t a_uart_recover(int err)
+{
+    if ((gs_fd >= 0) && (uart_lost(err) == 0) && (uart_check(gs_fd) == 0))
+    {
+        return 1;
+    }
+    
+    return a_uart_reconnect();
+}
 
 /**
  * @brief  interface uart init
@@ -57,7 +235,12 @@ static int gs_fd;                           /**< uart handle */
  */
 uint8_t ba121_interface_uart_init(void)
 {
-    return uart_init(UART_DEVICE_NAME, &gs_fd, 9600, 8, 'N', 1);
+    gs_ntc_resistance_valid = 0;
+    gs_ntc_b_valid = 0;
+    gs_ntc_pending_valid = 0;
+    gs_rx_len = 0;
+    
+    return a_uart_open();
 }
 
 /**
@@ -69,7 +252,16 @@ uint8_t ba121_interface_uart_init(void)
  */
 uint8_t ba121_interface_uart_deinit(void)
 {
-    return uart_deinit(gs_fd);
+    uint8_t res;
+    
+    if (gs_fd < 0)
+    {
+        return 0;
+    }
+    res = uart_deinit(gs_fd);
+    gs_fd = -1;
+    
+    return res;
 }
 
 /**
@@ -85,12 +277,24 @@ uint16_t ba121_interface_uart_read(uint8_t *buf, uint16_t len)
 {
     uint32_t l = len;
 
-    if (uart_read(gs_fd, buf, (uint32_t *)&l))
+    if ((gs_fd < 0) || (uart_read(gs_fd, buf, (uint32_t *)&l) != 0))
     {
+        /* the reply is lost anyway, the driver retry resends the command */
+        (void)a_uart_recover(errno);
+        
+        return 0;
+    }
+    else if ((l == 0) && (len != 0) && (uart_check(gs_fd) != 0))
+    {
+        /* end of file on a hung up device */
+        (void)a_uart_reconnect();
+        
         return 0;
     }
     else
     {
+        a_uart_ack(buf, l);
+        
         return l;
     }
 }
@@ -104,7 +308,17 @@ uint16_t ba121_interface_uart_read(uint8_t *buf, uint16_t len)
  */
 uint8_t ba121_interface_uart_flush(void)
 {
-    return uart_flush(gs_fd);
+    if ((gs_fd < 0) || (uart_flush(gs_fd) != 0))
+    {
+        if (a_uart_recover(errno) != 0)
+        {
+            return 1;
+        }
+        
+        return uart_flush(gs_fd);
+    }
+    
+    return 0;
 }
 
 /**
@@ -118,7 +332,29 @@ uint8_t ba121_interface_uart_flush(void)
  */
 uint8_t ba121_interface_uart_write(uint8_t *buf, uint16_t len)
 {
-    return uart_write(gs_fd, buf, len);
+    /* hold the config until it is acked, so it can be restored after a reconnect */
+    if ((len == 6) && ((buf[0] == BA121_COMMAND_NTC_RES) || (buf[0] == BA121_COMMAND_NTC_B)))
+    {
+        memcpy(gs_ntc_pending, buf, 6);
+        gs_ntc_pending_valid = 1;
+    }
+    else
+    {
+        gs_ntc_pending_valid = 0;
+    }
+    gs_rx_len = 0;
+    
+    if ((gs_fd < 0) || (uart_write(gs_fd, buf, len) != 0))
+    {
+        if (a_uart_recover(errno) != 0)
+        {
+            return 1;
+        }
+        
+        return uart_write(gs_fd, buf, len);
+    }
+    
+    return 0;
 }
 
 /**
@@ -131,6 +367,127 @@ void ba121_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief     interface wait reply
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      a lost device waits the whole timeout, so the reconnect keeps its pace
+ */
+uint8_t ba121_interface_wait_reply(uint16_t len, uint32_t timeout_ms)
+{
+    if ((gs_fd < 0) || (uart_check(gs_fd) != 0))
+    {
+        usleep(1000 * timeout_ms);
+        
+        return 1;
+    }
+    
+    return uart_wait_data(gs_fd, len, timeout_ms);
+}
+
+/**
+ * @brief set up the semaphore condition
+ * @note  the condition waits on the monotonic clock, so a wall clock step does not move the timeout
+ */
+static void a_os_sem_init(void)
+{
+    pthread_condattr_t attr;
+    
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&gs_sem_cond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief interface os lock
+ * @note  blocks until the driver mutex is held
+ */
+void ba121_interface_os_lock(void)
+{
+    (void)pthread_mutex_lock(&gs_os_mutex);
+}
+
+/**
+ * @brief interface os unlock
+ * @note  none
+ */
+void ba121_interface_os_unlock(void)
+{
+    (void)pthread_mutex_unlock(&gs_os_mutex);
+}
+
+/**
+ * @brief     interface os semaphore wait
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      a pthread counting semaphore, a count given at the timeout is still taken
+ */
+uint8_t ba121_interface_os_sem_wait(uint32_t timeout_ms)
+{
+    struct timespec ts;
+    
+    (void)pthread_once(&gs_sem_once, a_os_sem_init);
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += (time_t)(timeout_ms / 1000);
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    (void)pthread_mutex_lock(&gs_sem_mutex);
+    while (gs_sem_count == 0)
+    {
+        if (pthread_cond_timedwait(&gs_sem_cond, &gs_sem_mutex, &ts) == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+    if (gs_sem_count == 0)
+    {
+        (void)pthread_mutex_unlock(&gs_sem_mutex);
+        
+        return 1;
+    }
+    gs_sem_count--;
+    (void)pthread_mutex_unlock(&gs_sem_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief interface os semaphore give
+ * @note  none
+ */
+void ba121_interface_os_sem_give(void)
+{
+    (void)pthread_once(&gs_sem_once, a_os_sem_init);
+    (void)pthread_mutex_lock(&gs_sem_mutex);
+    gs_sem_count++;
+    (void)pthread_cond_signal(&gs_sem_cond);
+    (void)pthread_mutex_unlock(&gs_sem_mutex);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t ba121_interface_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)(ts.tv_nsec / 1000);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      acquire.h
+ * @brief     acquire header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef ACQUIRE_H
+#define ACQUIRE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup acquire acquire function
+ * @brief    acquire function modules
+ * @{
+ */
+
+/**
+ * @brief acquire max ports definition
+ */
+#ifndef ACQUIRE_MAX_PORTS
+    #define ACQUIRE_MAX_PORTS        16        /**< 16 serial ports */
+#endif
+
+/**
+ * @brief acquire sample structure definition
+ */
+typedef struct acquire_sample_s
+{
+    uint64_t timestamp_ns;              /**< sampling instant, CLOCK_MONOTONIC */
+    uint16_t port;                      /**< port index in the name list */
+    uint16_t conductivity_raw;          /**< conductivity raw */
+    uint16_t conductivity_us_cm;        /**< conductivity in uS/cm */
+    uint16_t temperature_raw;           /**< temperature raw */
+    float temperature;                  /**< temperature in C */
+    uint8_t valid;                      /**< 1 if the sensor answered */
+} acquire_sample_t;
+
+/**
+ * @brief acquire ring structure definition
+ * @note  single producer single consumer, head and tail live on their own cache lines
+ */
+typedef struct acquire_ring_s
+{
+    uint32_t head __attribute__((aligned(64)));        /**< next write, owned by the producer */
+    uint32_t tail __attribute__((aligned(64)));        /**< next read, owned by the consumer */
+    uint32_t mask __attribute__((aligned(64)));        /**< size - 1 */
+    acquire_sample_t *buf;                             /**< sample buffer */
+} acquire_ring_t;
+
+/**
+ * @brief     ring init
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] size number of samples, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t acquire_ring_init(acquire_ring_t *ring, uint32_t size);
+
+/**
+ * @brief     ring deinit
+ * @param[in] *ring pointer to a ring structure
+ * @note      none
+ */
+void acquire_ring_deinit(acquire_ring_t *ring);
+
+/**
+ * @brief     ring push
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *sample pointer to a sample
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      producer side only, never blocks
+ */
+uint8_t acquire_ring_push(acquire_ring_t *ring, const acquire_sample_t *sample);
+
+/**
+ * @brief      ring pop
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 ring is empty
+ * @note       consumer side only, never blocks
+ */
+uint8_t acquire_ring_pop(acquire_ring_t *ring, acquire_sample_t *sample);
+
+/**
+ * @brief     acquire init
+ * @param[in] **name pointer to a device name list
+ * @param[in] count number of devices
+ * @param[in] group ports per reader thread
+ * @param[in] period_ms sampling period in ms
+ * @param[in] ring_size samples per reader ring, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      every reader thread sweeps its ports on an absolute period, it writes the read command
+ *            to all ports, waits once and collects the replies, a period shorter than the reply delay overruns
+ */
+uint8_t acquire_init(char **name, uint16_t count, uint16_t group, uint32_t period_ms, uint32_t ring_size);
+
+/**
+ * @brief     acquire deinit
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      stops and joins the reader threads, then closes the ports
+ */
+uint8_t acquire_deinit(void);
+
+/**
+ * @brief      acquire read
+ * @param[out] *sample pointer to a sample buffer
+ * @param[in]  timeout_ms timeout in ms, -1 waits forever
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 timeout
+ * @note       drains the reader rings in turn, call it from one thread only
+ */
+uint8_t acquire_read(acquire_sample_t *sample, int32_t timeout_ms);
+
+/**
+ * @brief      acquire get statistics
+ * @param[out] *drops pointer to a dropped sample counter buffer
+ * @param[out] *overruns pointer to a missed period counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       drops count samples lost to a full ring, overruns count sweeps that missed their slot
+ */
+uint8_t acquire_get_stats(uint32_t *drops, uint32_t *overruns);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
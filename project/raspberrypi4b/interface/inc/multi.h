@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      multi.h
+ * @brief     multi header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef MULTI_H
+#define MULTI_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup multi multi function
+ * @brief    multi function modules
+ * @{
+ */
+
+/**
+ * @brief multi max sensors definition
+ */
+#ifndef MULTI_MAX_SENSORS
+    #define MULTI_MAX_SENSORS        256        /**< 256 sensors */
+#endif
+
+/**
+ * @brief multi max output sinks definition
+ */
+#ifndef MULTI_MAX_SINKS
+    #define MULTI_MAX_SINKS        16        /**< 16 output files */
+#endif
+
+/**
+ * @brief multi string length definition
+ */
+#ifndef MULTI_NAME_LEN
+    #define MULTI_NAME_LEN        32         /**< 32 bytes */
+#endif
+#ifndef MULTI_PATH_LEN
+    #define MULTI_PATH_LEN        128        /**< 128 bytes */
+#endif
+
+/**
+ * @brief multi sensor config structure definition
+ */
+typedef struct multi_config_s
+{
+    char name[MULTI_NAME_LEN];              /**< sensor name, the port by default */
+    char port[MULTI_PATH_LEN];              /**< serial port */
+    char output[MULTI_PATH_LEN];            /**< output sink, "-" is stdout */
+    uint32_t baud_rate;                     /**< baud rate */
+    uint32_t interval_ms;                   /**< sampling interval */
+    uint32_t flush_ms;                      /**< output flush policy, see output_open */
+    uint32_t ntc_resistance;                /**< ntc resistance in ohm, 0 keeps the sensor setting */
+    uint16_t ntc_b;                         /**< ntc b value, 0 keeps the sensor setting */
+    uint8_t attempts;                       /**< driver retry attempts, 0 or 1 disables the retry */
+    uint8_t format;                         /**< output format, see output_format_t */
+} multi_config_t;
+
+/**
+ * @brief multi statistics structure definition
+ */
+typedef struct multi_stats_s
+{
+    uint64_t samples;               /**< good samples */
+    uint64_t errors;                /**< failed reads and slots without a device */
+    uint64_t overruns;              /**< slots skipped because the last read was still running */
+    uint64_t reconnects;            /**< reopened ports */
+} multi_stats_t;
+
+/**
+ * @brief      load a config file
+ * @param[in]  *path pointer to a file path
+ * @param[out] *config pointer to a config list
+ * @param[in]  max max config entries
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       one sensor per line as key=value pairs, '#' starts a comment,
+ *             keys are port, name, baud, interval, ntc_resistance, ntc_b, retry, output, format and flush
+ */
+uint8_t multi_load(const char *path, multi_config_t *config, uint16_t max, uint16_t *count);
+
+/**
+ * @brief     multi init
+ * @param[in] *config pointer to a config list
+ * @param[in] count number of sensors
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      every sensor gets its own driver handle, all of them share one epoll loop,
+ *            a missing device doesn't fail the init and is opened once it appears
+ */
+uint8_t multi_init(const multi_config_t *config, uint16_t count);
+
+/**
+ * @brief  multi deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   cancels the running commands, then closes the ports and the output files
+ */
+uint8_t multi_deinit(void);
+
+/**
+ * @brief     run the event loop once
+ * @param[in] max_wait_ms max blocking time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      starts the due reads, waits for uart data or the next deadline and runs the driver,
+ *            samples are written to the output sinks from inside this function,
+ *            a signal ends the wait early
+ */
+uint8_t multi_poll(uint32_t max_wait_ms);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  index sensor index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ * @note       none
+ */
+uint8_t multi_get_stats(uint16_t index, multi_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      output.h
+ * @brief     output header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup output output function
+ * @brief    output function modules
+ * @{
+ */
+
+/**
+ * @brief output buffer size definition
+ */
+#ifndef OUTPUT_BUFFER_SIZE
+    #define OUTPUT_BUFFER_SIZE        4096        /**< 4096 bytes */
+#endif
+
+/**
+ * @brief output flush policy definition
+ */
+#define OUTPUT_FLUSH_RECORD        0                 /**< flush after every record */
+#define OUTPUT_FLUSH_FULL          0xFFFFFFFFU       /**< flush only when the buffer is full */
+
+/**
+ * @brief output binary record definition
+ * @note  the file starts with the 8 byte header "BA121", version, record size and 0,
+ *        then one little endian record per sample:
+ *        - 0  uint64 timestamp in us
+ *        - 8  uint16 sensor index
+ *        - 10 uint16 conductivity raw
+ *        - 12 uint16 conductivity in uS/cm
+ *        - 14 uint16 temperature raw
+ *        - 16 int16 temperature in 0.01C
+ *        - 18 uint8 status
+ *        - 19 uint8 reserved
+ */
+#define OUTPUT_BINARY_VERSION        1         /**< version 1 */
+#define OUTPUT_BINARY_RECORD_SIZE    20        /**< 20 bytes */
+
+/**
+ * @brief output format enumeration definition
+ */
+typedef enum
+{
+    OUTPUT_FORMAT_TEXT   = 0x00,        /**< one sentence per sample */
+    OUTPUT_FORMAT_JSONL  = 0x01,        /**< one json object per line */
+    OUTPUT_FORMAT_CSV    = 0x02,        /**< csv with a header line */
+    OUTPUT_FORMAT_BINARY = 0x03,        /**< fixed size binary records */
+} output_format_t;
+
+/**
+ * @brief output record structure definition
+ */
+typedef struct output_record_s
+{
+    uint64_t timestamp_us;            /**< reply arrival time in us */
+    const char *name;                 /**< sensor name, can be NULL */
+    uint16_t sensor;                  /**< sensor index */
+    uint16_t conductivity_raw;        /**< raw conductivity */
+    uint16_t conductivity_us_cm;      /**< conductivity in uS/cm */
+    uint16_t temperature_raw;         /**< raw temperature */
+    float temperature;                /**< temperature in C */
+    uint8_t status;                   /**< 0 for a good sample, else the driver error */
+} output_record_t;
+
+/**
+ * @brief output structure definition
+ */
+typedef struct output_s
+{
+    int fd;                                  /**< output file */
+    uint8_t owner;                           /**< close the file on close */
+    uint8_t format;                          /**< output format */
+    uint32_t flush_ms;                       /**< flush policy */
+    uint64_t oldest_us;                      /**< time of the oldest buffered record */
+    uint32_t len;                            /**< buffered bytes */
+    uint64_t records;                        /**< written records */
+    uint64_t errors;                         /**< failed writes */
+    uint8_t buf[OUTPUT_BUFFER_SIZE];         /**< output buffer */
+} output_t;
+
+/**
+ * @brief      parse a format name
+ * @param[in]  *name pointer to a format name
+ * @param[out] *format pointer to a format buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 name is invalid
+ * @note       text, jsonl, csv or binary
+ */
+uint8_t output_parse_format(const char *name, output_format_t *format);
+
+/**
+ * @brief      parse a flush policy
+ * @param[in]  *value pointer to a flush policy
+ * @param[out] *flush_ms pointer to a flush policy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 value is invalid
+ * @note       full or a decimal age in ms, 0 flushes every record
+ */
+uint8_t output_parse_flush(const char *value, uint32_t *flush_ms);
+
+/**
+ * @brief     open an output
+ * @param[in] *out pointer to an output structure
+ * @param[in] *path pointer to a file path, "-" is stdout
+ * @param[in] format output format
+ * @param[in] flush_ms flush policy, OUTPUT_FLUSH_RECORD, OUTPUT_FLUSH_FULL or the max age of a buffered record in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      files are appended, the csv header and the binary header are only written to an empty file
+ */
+uint8_t output_open(output_t *out, const char *path, output_format_t format, uint32_t flush_ms);
+
+/**
+ * @brief     write a record
+ * @param[in] *out pointer to an output structure
+ * @param[in] *record pointer to a record
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the record is formatted into the buffer and written out by the flush policy
+ */
+uint8_t output_write(output_t *out, const output_record_t *record);
+
+/**
+ * @brief     flush the output when the policy says so
+ * @param[in] *out pointer to an output structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      call it from the event loop, so an aged record is written without waiting for the next one
+ */
+uint8_t output_poll(output_t *out);
+
+/**
+ * @brief     flush the output
+ * @param[in] *out pointer to an output structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffer is dropped on a write error
+ */
+uint8_t output_flush(output_t *out);
+
+/**
+ * @brief     close an output
+ * @param[in] *out pointer to an output structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      flushes first, stdout is not closed
+ */
+uint8_t output_close(output_t *out);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      soak.h
+ * @brief     soak header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SOAK_H
+#define SOAK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup soak soak function
+ * @brief    soak function modules
+ * @{
+ */
+
+/**
+ * @brief soak max ports definition
+ */
+#ifndef SOAK_MAX_PORTS
+    #define SOAK_MAX_PORTS        16        /**< 16 serial ports */
+#endif
+
+/**
+ * @brief soak latency histogram definition
+ */
+#ifndef SOAK_HISTOGRAM_SIZE
+    #define SOAK_HISTOGRAM_SIZE        1000        /**< 1000 buckets */
+#endif
+#ifndef SOAK_HISTOGRAM_STEP_MS
+    #define SOAK_HISTOGRAM_STEP_MS     10          /**< 10ms per bucket, the last bucket holds the rest */
+#endif
+
+/**
+ * @brief soak statistics structure definition
+ */
+typedef struct soak_stats_s
+{
+    uint64_t transactions;                             /**< read transactions */
+    uint64_t ok;                                       /**< good samples */
+    uint64_t link_errors;                              /**< uart errors and missing replies */
+    uint64_t frame_errors;                             /**< bad checksum or header */
+    uint64_t other_errors;                             /**< any other driver error */
+    uint64_t retries;                                  /**< extra attempts of the driver retry */
+    uint64_t reconnects;                               /**< reopened ports */
+    uint64_t latency_total_ms;                         /**< latency sum of the good samples */
+    uint32_t latency_max_ms;                           /**< worst latency of the good samples */
+    uint32_t histogram[SOAK_HISTOGRAM_SIZE];           /**< latency histogram of the good samples */
+} soak_stats_t;
+
+/**
+ * @brief     soak init
+ * @param[in] **name pointer to a device name list
+ * @param[in] count number of devices
+ * @param[in] period_ms sampling period of each port in ms
+ * @param[in] attempts driver retry attempts, 0 or 1 disables the retry
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      every port gets its own thread and driver handle and keeps reading through errors,
+ *            a lost device is reopened between two reads
+ */
+uint8_t soak_init(char **name, uint16_t count, uint32_t period_ms, uint8_t attempts);
+
+/**
+ * @brief  soak deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   stops and joins the port threads, then closes the ports
+ */
+uint8_t soak_deinit(void);
+
+/**
+ * @brief      get the statistics
+ * @param[in]  port port index, SOAK_MAX_PORTS sums all ports
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 port is invalid
+ * @note       a consistent snapshot, the threads keep running
+ */
+uint8_t soak_get_stats(uint16_t port, soak_stats_t *stats);
+
+/**
+ * @brief     get a latency percentile
+ * @param[in] *stats pointer to a statistics structure
+ * @param[in] permille percentile in 1/1000, 500 is the median
+ * @return    latency in ms, the upper edge of the histogram bucket capped by the max
+ * @note      0 without samples
+ */
+uint32_t soak_percentile(const soak_stats_t *stats, uint16_t permille);
+
+/**
+ * @brief     write the json report
+ * @param[in] *path pointer to a file path
+ * @param[in] **name pointer to a device name list
+ * @param[in] elapsed_s soak duration in s
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one object per port and the total
+ */
+uint8_t soak_report(const char *path, char **name, double elapsed_s);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
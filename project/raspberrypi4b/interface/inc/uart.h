@@ -111,6 +111,64 @@ uint8_t uart_read(int fd, uint8_t *buf, uint32_t *len);
  */
 uint8_t uart_flush(int fd);
 
+/**
+ * @brief     check whether the device is still connected
+ * @param[in] fd uart handle
+ * @return    status code
+ *            - 0 connected
+ *            - 1 disconnected
+ * @note      a removed device node or a hang up counts as disconnected
+ */
+uint8_t uart_check(int fd);
+
+/**
+ * @brief     check whether an error means the device is gone
+ * @param[in] err errno of the failed call
+ * @return    status code
+ *            - 0 other error
+ *            - 1 device lost
+ * @note      EIO, ENODEV, ENXIO and EBADF
+ */
+uint8_t uart_lost(int err);
+
+/**
+ * @brief     wait for a device node to appear
+ * @param[in] *name pointer to a device name buffer
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      inotify watches the parent directory, e.g. /dev/serial/by-id,
+ *            and falls back to polling while the directory itself is missing
+ */
+uint8_t uart_wait(char *name, uint32_t timeout_ms);
+
+/**
+ * @brief         reopen a lost device
+ * @param[in]     *name pointer to a device name buffer
+ * @param[in,out] *fd pointer to a uart handle, the old handle is closed, -1 on failure
+ * @param[in]     baud_rate baud rate
+ * @param[in]     timeout_ms timeout of each wait for the device node in ms
+ * @return        status code
+ *                - 0 success
+ *                - 1 reopen failed
+ * @note          8N1, the open is tried 3 times because udev may still be fixing the permissions
+ *                after the node appears
+ */
+uint8_t uart_reopen(char *name, int *fd, uint32_t baud_rate, uint32_t timeout_ms);
+
+/**
+ * @brief     wait for received data
+ * @param[in] fd uart handle
+ * @param[in] len data length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout or disconnected
+ * @note      sleeps in poll until the first byte, then one byte time at a time until len bytes are buffered
+ */
+uint8_t uart_wait_data(int fd, uint32_t len, uint32_t timeout_ms);
+
 /**
  * @}
  */
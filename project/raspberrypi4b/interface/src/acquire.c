@@ -0,0 +1,621 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      acquire.c
+ * @brief     acquire source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "acquire.h"
+#include "uart.h"
+#include "driver_ba121_pool.h"
+#include "driver_ba121_interface.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+#include <sys/eventfd.h>
+
+/**
+ * @brief acquire reader structure definition
+ */
+typedef struct acquire_reader_s
+{
+    acquire_ring_t ring;        /**< sample ring */
+    pthread_t thread;           /**< reader thread */
+    uint16_t first;             /**< first port index */
+    uint16_t count;             /**< number of ports */
+    uint8_t started;            /**< thread started flag */
+} acquire_reader_t;
+
+static int gs_fd[ACQUIRE_MAX_PORTS];                                /**< uart handles */
+static acquire_reader_t gs_reader[ACQUIRE_MAX_PORTS];               /**< reader threads */
+static uint16_t gs_port_count = 0;                                  /**< opened ports */
+static uint16_t gs_reader_count = 0;                                /**< reader threads */
+static uint16_t gs_next = 0;                                        /**< next ring to drain */
+static uint32_t gs_period_ms = 1000;                                /**< sampling period */
+static int gs_event_fd = -1;                                        /**< consumer wake up */
+static uint8_t gs_running = 0;                                      /**< running flag */
+static uint8_t gs_inited = 0;                                       /**< inited flag */
+static uint32_t gs_drops = 0;                                       /**< dropped samples */
+static uint32_t gs_overruns = 0;                                    /**< missed periods */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< stop lock */
+static pthread_cond_t gs_cond;                                      /**< stop signal */
+
+/**
+ * @brief     pool uart init
+ * @param[in] port port index
+ * @return    status code
+ *            - 0 success
+ * @note      the ports are opened by acquire_init
+ */
+static uint8_t a_acquire_uart_init(uint16_t port)
+{
+    (void)port;
+    
+    return 0;
+}
+
+/**
+ * @brief     pool uart deinit
+ * @param[in] port port index
+ * @return    status code
+ *            - 0 success
+ * @note      the ports are closed by acquire_deinit
+ */
+static uint8_t a_acquire_uart_deinit(uint16_t port)
+{
+    (void)port;
+    
+    return 0;
+}
+
+/**
+ * @brief      pool uart read
+ * @param[in]  port port index
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       none
+ */
+static uint16_t a_acquire_uart_read(uint16_t port, uint8_t *buf, uint16_t len)
+{
+    uint32_t l = len;
+    
+    if (uart_read(gs_fd[port], buf, &l) != 0)
+    {
+        return 0;
+    }
+    
+    return (uint16_t)l;
+}
+
+/**
+ * @brief     pool uart flush
+ * @param[in] port port index
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush failed
+ * @note      none
+ */
+static uint8_t a_acquire_uart_flush(uint16_t port)
+{
+    return uart_flush(gs_fd[port]);
+}
+
+/**
+ * @brief     pool uart write
+ * @param[in] port port index
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_acquire_uart_write(uint16_t port, uint8_t *buf, uint16_t len)
+{
+    return uart_write(gs_fd[port], buf, len);
+}
+
+/**
+ * @brief     pool wait reply
+ * @param[in] port port index
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      none
+ */
+static uint8_t a_acquire_wait_reply(uint16_t port, uint16_t len, uint32_t timeout_ms)
+{
+    return uart_wait_data(gs_fd[port], len, timeout_ms);
+}
+
+/**
+ * @brief     pool delay
+ * @param[in] ms time in ms
+ * @note      none
+ */
+static void a_acquire_delay_ms(uint32_t ms)
+{
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief pool ops definition
+ */
+static const ba121_pool_ops_t gs_ops =
+{
+    a_acquire_uart_init,
+    a_acquire_uart_deinit,
+    a_acquire_uart_read,
+    a_acquire_uart_flush,
+    a_acquire_uart_write,
+    a_acquire_wait_reply,
+};
+
+/**
+ * @brief     convert a time
+ * @param[in] *t pointer to a time
+ * @return    time in ns
+ * @note      none
+ */
+static uint64_t a_acquire_ns(const struct timespec *t)
+{
+    return (uint64_t)t->tv_sec * 1000000000ULL + (uint64_t)t->tv_nsec;
+}
+
+/**
+ * @brief         add a period to a time
+ * @param[in,out] *t pointer to a time
+ * @param[in]     ms period in ms
+ * @note          none
+ */
+static void a_acquire_add_ms(struct timespec *t, uint32_t ms)
+{
+    t->tv_sec += ms / 1000;
+    t->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (t->tv_nsec >= 1000000000L)
+    {
+        t->tv_sec++;
+        t->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief     reader thread
+ * @param[in] *arg pointer to a reader structure
+ * @return    NULL
+ * @note      the thread only does i/o and pushes samples, so a slow consumer never moves the sampling instant
+ */
+static void *a_acquire_thread(void *arg)
+{
+    acquire_reader_t *reader = (acquire_reader_t *)arg;
+    ba121_pool_t pool;
+    acquire_sample_t sample;
+    struct timespec next;
+    struct timespec now;
+    uint64_t one = 1;
+    uint16_t channel;
+    uint16_t valid;
+    uint8_t ops_index;
+    uint16_t i;
+    
+    /* build the pool of this reader */
+    if ((ba121_pool_init(&pool, a_acquire_delay_ms, ba121_interface_debug_print) != 0) ||
+        (ba121_pool_set_clock(&pool, ba121_interface_timestamp_us) != 0) ||
+        (ba121_pool_register_ops(&pool, &gs_ops, &ops_index) != 0))
+    {
+        return NULL;
+    }
+    for (i = 0; i < reader->count; i++)
+    {
+        (void)ba121_pool_add(&pool, ops_index, (uint16_t)(reader->first + i), &channel);
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (__atomic_load_n(&gs_running, __ATOMIC_ACQUIRE) != 0)
+    {
+        /* sample all ports of the group */
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        sample.timestamp_ns = a_acquire_ns(&now);
+        (void)ba121_pool_sweep(&pool, &valid);
+        
+        /* publish */
+        channel = BA121_POOL_ITERATE_START;
+        while (ba121_pool_next(&pool, BA121_POOL_ITERATE_ACTIVE, &channel) == 0)
+        {
+            sample.port = pool.port[channel];
+            sample.valid = (uint8_t)(ba121_pool_get_sample(&pool, channel,
+                                                           &sample.conductivity_raw,
+                                                           &sample.conductivity_us_cm,
+                                                           &sample.temperature_raw,
+                                                           &sample.temperature) == 0);
+            if (acquire_ring_push(&reader->ring, &sample) != 0)
+            {
+                __atomic_fetch_add(&gs_drops, 1, __ATOMIC_RELAXED);
+            }
+        }
+        (void)!write(gs_event_fd, &one, sizeof(one));
+        
+        /* next slot on the absolute grid, skip the slots already missed */
+        a_acquire_add_ms(&next, gs_period_ms);
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        while (a_acquire_ns(&next) <= a_acquire_ns(&now))
+        {
+            __atomic_fetch_add(&gs_overruns, 1, __ATOMIC_RELAXED);
+            a_acquire_add_ms(&next, gs_period_ms);
+        }
+        
+        /* sleep until the slot or the stop signal */
+        pthread_mutex_lock(&gs_mutex);
+        while (__atomic_load_n(&gs_running, __ATOMIC_ACQUIRE) != 0)
+        {
+            if (pthread_cond_timedwait(&gs_cond, &gs_mutex, &next) == ETIMEDOUT)
+            {
+                break;
+            }
+        }
+        pthread_mutex_unlock(&gs_mutex);
+    }
+    (void)ba121_pool_deinit(&pool);
+    
+    return NULL;
+}
+
+/**
+ * @brief     ring init
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] size number of samples, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t acquire_ring_init(acquire_ring_t *ring, uint32_t size)
+{
+    if ((size == 0) || ((size & (size - 1)) != 0))
+    {
+        return 1;
+    }
+    
+    ring->buf = (acquire_sample_t *)malloc(sizeof(acquire_sample_t) * size);
+    if (ring->buf == NULL)
+    {
+        return 1;
+    }
+    ring->head = 0;
+    ring->tail = 0;
+    ring->mask = size - 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     ring deinit
+ * @param[in] *ring pointer to a ring structure
+ * @note      none
+ */
+void acquire_ring_deinit(acquire_ring_t *ring)
+{
+    free(ring->buf);
+    ring->buf = NULL;
+}
+
+/**
+ * @brief     ring push
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *sample pointer to a sample
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      producer side only, never blocks
+ */
+uint8_t acquire_ring_push(acquire_ring_t *ring, const acquire_sample_t *sample)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    
+    if (head - tail > ring->mask)
+    {
+        return 1;
+    }
+    
+    /* fill the slot, then publish it */
+    ring->buf[head & ring->mask] = *sample;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief      ring pop
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *sample pointer to a sample buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 ring is empty
+ * @note       consumer side only, never blocks
+ */
+uint8_t acquire_ring_pop(acquire_ring_t *ring, acquire_sample_t *sample)
+{
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    
+    if (head == tail)
+    {
+        return 1;
+    }
+    
+    /* copy the slot, then release it */
+    *sample = ring->buf[tail & ring->mask];
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+/**
+ * @brief     acquire init
+ * @param[in] **name pointer to a device name list
+ * @param[in] count number of devices
+ * @param[in] group ports per reader thread
+ * @param[in] period_ms sampling period in ms
+ * @param[in] ring_size samples per reader ring, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      every reader thread sweeps its ports on an absolute period, it writes the read command
+ *            to all ports, waits once and collects the replies, a period shorter than the reply delay overruns
+ */
+uint8_t acquire_init(char **name, uint16_t count, uint16_t group, uint32_t period_ms, uint32_t ring_size)
+{
+    pthread_condattr_t attr;
+    uint16_t i;
+    
+    if ((name == NULL) || (count == 0) || (count > ACQUIRE_MAX_PORTS) ||
+        (group == 0) || (group > BA121_POOL_MAX_CHANNELS) || (period_ms == 0))
+    {
+        ba121_interface_debug_print("acquire: param is invalid.\n");
+        
+        return 1;
+    }
+    if (gs_inited != 0)
+    {
+        ba121_interface_debug_print("acquire: already running.\n");
+        
+        return 1;
+    }
+    
+    /* the stop signal uses the monotonic clock of the sampling grid */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&gs_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    gs_inited = 1;
+    
+    /* open all ports first so a missing device fails early */
+    gs_port_count = 0;
+    gs_reader_count = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (uart_init(name[i], &gs_fd[i], 9600, 8, 'N', 1) != 0)
+        {
+            ba121_interface_debug_print("acquire: open %s failed.\n", name[i]);
+            (void)acquire_deinit();
+            
+            return 1;
+        }
+        gs_port_count++;
+    }
+    gs_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (gs_event_fd < 0)
+    {
+        ba121_interface_debug_print("acquire: eventfd failed.\n");
+        (void)acquire_deinit();
+        
+        return 1;
+    }
+    
+    /* start one reader per group */
+    gs_period_ms = period_ms;
+    gs_next = 0;
+    __atomic_store_n(&gs_drops, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&gs_overruns, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&gs_running, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < count; i = (uint16_t)(i + group))
+    {
+        acquire_reader_t *reader = &gs_reader[gs_reader_count];
+        
+        reader->first = i;
+        reader->count = (uint16_t)((count - i < group) ? (count - i) : group);
+        reader->started = 0;
+        if (acquire_ring_init(&reader->ring, ring_size) != 0)
+        {
+            ba121_interface_debug_print("acquire: ring init failed.\n");
+            (void)acquire_deinit();
+            
+            return 1;
+        }
+        gs_reader_count++;
+        if (pthread_create(&reader->thread, NULL, a_acquire_thread, reader) != 0)
+        {
+            ba121_interface_debug_print("acquire: create thread failed.\n");
+            (void)acquire_deinit();
+            
+            return 1;
+        }
+        reader->started = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     acquire deinit
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      stops and joins the reader threads, then closes the ports
+ */
+uint8_t acquire_deinit(void)
+{
+    uint8_t res = 0;
+    uint16_t i;
+    
+    if (gs_inited == 0)
+    {
+        return 0;
+    }
+    
+    /* stop the readers */
+    pthread_mutex_lock(&gs_mutex);
+    __atomic_store_n(&gs_running, 0, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&gs_cond);
+    pthread_mutex_unlock(&gs_mutex);
+    for (i = 0; i < gs_reader_count; i++)
+    {
+        if (gs_reader[i].started != 0)
+        {
+            pthread_join(gs_reader[i].thread, NULL);
+            gs_reader[i].started = 0;
+        }
+        acquire_ring_deinit(&gs_reader[i].ring);
+    }
+    gs_reader_count = 0;
+    
+    /* close the ports */
+    for (i = 0; i < gs_port_count; i++)
+    {
+        if (uart_deinit(gs_fd[i]) != 0)
+        {
+            res = 1;
+        }
+    }
+    gs_port_count = 0;
+    if (gs_event_fd >= 0)
+    {
+        (void)close(gs_event_fd);
+        gs_event_fd = -1;
+    }
+    pthread_cond_destroy(&gs_cond);
+    gs_inited = 0;
+    
+    return res;
+}
+
+/**
+ * @brief      acquire read
+ * @param[out] *sample pointer to a sample buffer
+ * @param[in]  timeout_ms timeout in ms, -1 waits forever
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 timeout
+ * @note       drains the reader rings in turn, call it from one thread only
+ */
+uint8_t acquire_read(acquire_sample_t *sample, int32_t timeout_ms)
+{
+    struct timespec start;
+    struct timespec now;
+    struct pollfd fds;
+    uint64_t value;
+    int32_t left;
+    uint16_t i;
+    
+    if ((sample == NULL) || (gs_reader_count == 0))
+    {
+        return 1;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (1)
+    {
+        /* take from the rings in turn so one busy group can not starve the others */
+        for (i = 0; i < gs_reader_count; i++)
+        {
+            uint16_t r = (uint16_t)((gs_next + i) % gs_reader_count);
+            
+            if (acquire_ring_pop(&gs_reader[r].ring, sample) == 0)
+            {
+                gs_next = (uint16_t)((r + 1) % gs_reader_count);
+                
+                return 0;
+            }
+        }
+        
+        /* wait for the next publish */
+        left = -1;
+        if (timeout_ms >= 0)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            left = timeout_ms - (int32_t)((a_acquire_ns(&now) - a_acquire_ns(&start)) / 1000000ULL);
+            if (left <= 0)
+            {
+                return 2;
+            }
+        }
+        fds.fd = gs_event_fd;
+        fds.events = POLLIN;
+        fds.revents = 0;
+        if ((poll(&fds, 1, left) < 0) && (errno != EINTR))
+        {
+            perror("acquire: poll failed.\n");
+            
+            return 1;
+        }
+        (void)!read(gs_event_fd, &value, sizeof(value));
+    }
+}
+
+/**
+ * @brief      acquire get statistics
+ * @param[out] *drops pointer to a dropped sample counter buffer
+ * @param[out] *overruns pointer to a missed period counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ * @note       drops count samples lost to a full ring, overruns count sweeps that missed their slot
+ */
+uint8_t acquire_get_stats(uint32_t *drops, uint32_t *overruns)
+{
+    if ((drops == NULL) || (overruns == NULL))
+    {
+        return 1;
+    }
+    
+    *drops = __atomic_load_n(&gs_drops, __ATOMIC_RELAXED);
+    *overruns = __atomic_load_n(&gs_overruns, __ATOMIC_RELAXED);
+    
+    return 0;
+}
@@ -0,0 +1,961 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      multi.c
+ * @brief     multi source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "multi.h"
+#include "output.h"
+#include "uart.h"
+#include "driver_ba121.h"
+#include "driver_ba121_interface.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#if (BA121_QUEUE_ENABLE == 0)
+    #error "multi needs the async api, build it with BA121_QUEUE_ENABLE"
+#endif
+
+/**
+ * @brief multi epoll events definition
+ */
+#ifndef MULTI_MAX_EVENTS
+    #define MULTI_MAX_EVENTS        64        /**< 64 events per wait */
+#endif
+
+/**
+ * @brief multi sink structure definition
+ */
+typedef struct multi_sink_s
+{
+    char path[MULTI_PATH_LEN];        /**< output path */
+    output_t out;                     /**< buffered output */
+} multi_sink_t;
+
+/**
+ * @brief multi sensor structure definition
+ */
+typedef struct multi_sensor_s
+{
+    ba121_handle_t handle;            /**< driver handle */
+    multi_config_t config;            /**< sensor config */
+    multi_sink_t *sink;               /**< output sink */
+    multi_stats_t stats;              /**< statistics */
+    uint32_t next_ms;                 /**< next sampling slot */
+    uint16_t index;                   /**< sensor index */
+    int fd;                           /**< uart handle */
+    uint8_t lost;                     /**< device lost flag */
+    uint8_t busy;                     /**< read in flight flag */
+} multi_sensor_t;
+
+static multi_sensor_t gs_sensor[MULTI_MAX_SENSORS];        /**< sensors */
+static multi_sink_t gs_sink[MULTI_MAX_SINKS];              /**< output sinks */
+static uint16_t gs_sensor_count = 0;                       /**< sensor count */
+static uint16_t gs_sink_count = 0;                         /**< sink count */
+static int gs_epoll = -1;                                  /**< epoll handle */
+static uint8_t gs_inited = 0;                              /**< inited flag */
+static multi_sensor_t *gs_current = NULL;                  /**< sensor of the running driver call */
+
+/**
+ * @brief  get the loop time
+ * @return time in ms
+ * @note   wraps after 49 days, only differences are used
+ */
+static uint32_t a_multi_now_ms(void)
+{
+    struct timespec t;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint32_t)((uint64_t)t.tv_sec * 1000ULL + (uint64_t)(t.tv_nsec / 1000000L));
+}
+
+/**
+ * @brief     open a port
+ * @param[in] *sensor pointer to a sensor structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      a missing device node fails quietly
+ */
+static uint8_t a_multi_open(multi_sensor_t *sensor)
+{
+    struct epoll_event event;
+    
+    if (access(sensor->config.port, F_OK) != 0)
+    {
+        return 1;
+    }
+    if (uart_init(sensor->config.port, &sensor->fd, sensor->config.baud_rate, 8, 'N', 1) != 0)
+    {
+        if (sensor->fd >= 0)
+        {
+            (void)close(sensor->fd);
+        }
+        sensor->fd = -1;
+        
+        return 1;
+    }
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = sensor;
+    if (epoll_ctl(gs_epoll, EPOLL_CTL_ADD, sensor->fd, &event) != 0)
+    {
+        (void)close(sensor->fd);
+        sensor->fd = -1;
+        
+        return 1;
+    }
+    sensor->lost = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     close a port
+ * @param[in] *sensor pointer to a sensor structure
+ * @note      none
+ */
+static void a_multi_close(multi_sensor_t *sensor)
+{
+    if (sensor->fd >= 0)
+    {
+        (void)epoll_ctl(gs_epoll, EPOLL_CTL_DEL, sensor->fd, NULL);
+        (void)close(sensor->fd);
+        sensor->fd = -1;
+    }
+    sensor->lost = 1;
+}
+
+#if (BA121_STATIC_LINK == 0)
+
+/**
+ * @brief  uart init
+ * @return status code
+ *         - 0 success
+ * @note   a missing device is opened later by the loop
+ */
+static uint8_t a_multi_uart_init(void)
+{
+    if (a_multi_open(gs_current) != 0)
+    {
+        printf("multi: %s is not ready, waiting for it.\n", gs_current->config.port);
+        gs_current->lost = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  uart deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_multi_uart_deinit(void)
+{
+    a_multi_close(gs_current);
+    
+    return 0;
+}
+
+/**
+ * @brief     flag a failed uart call
+ * @param[in] err errno of the failed call
+ * @note      the loop closes the port after the driver call returns
+ */
+static void a_multi_uart_fail(int err)
+{
+    if ((uart_lost(err) != 0) || (uart_check(gs_current->fd) != 0))
+    {
+        gs_current->lost = 1;
+    }
+}
+
+/**
+ * @brief      uart read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       the port is non-blocking, an empty port reads 0 bytes
+ */
+static uint16_t a_multi_uart_read(uint8_t *buf, uint16_t len)
+{
+    ssize_t l;
+    
+    if ((gs_current->lost != 0) || (gs_current->fd < 0) || (len == 0))
+    {
+        return 0;
+    }
+    l = read(gs_current->fd, buf, len);
+    if (l < 0)
+    {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            a_multi_uart_fail(errno);
+        }
+        
+        return 0;
+    }
+    
+    return (uint16_t)l;
+}
+
+/**
+ * @brief  uart flush
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   none
+ */
+static uint8_t a_multi_uart_flush(void)
+{
+    if ((gs_current->lost != 0) || (gs_current->fd < 0))
+    {
+        return 1;
+    }
+    if (uart_flush(gs_current->fd) != 0)
+    {
+        a_multi_uart_fail(errno);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     uart write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_multi_uart_write(uint8_t *buf, uint16_t len)
+{
+    if ((gs_current->lost != 0) || (gs_current->fd < 0))
+    {
+        return 1;
+    }
+    if (uart_write(gs_current->fd, buf, len) != 0)
+    {
+        a_multi_uart_fail(errno);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     delay
+ * @param[in] ms time in ms
+ * @note      only the blocking driver api delays, the loop never calls it
+ */
+static void a_multi_delay_ms(uint32_t ms)
+{
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief     debug print
+ * @param[in] fmt format data
+ * @note      the driver messages are dropped, the failed reads are counted instead
+ */
+static void a_multi_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+#endif
+
+/**
+ * @brief     async read callback
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] res read result
+ * @param[in] conductivity_raw raw conductivity
+ * @param[in] conductivity_us_cm converted conductivity
+ * @param[in] temperature_raw raw temperature
+ * @param[in] temperature converted temperature
+ * @param[in] *user pointer to a sensor structure
+ * @note      writes one record to the output sink
+ */
+static void a_multi_read_callback(ba121_handle_t *handle, uint8_t res,
+                                  uint16_t conductivity_raw, uint16_t conductivity_us_cm,
+                                  uint16_t temperature_raw, float temperature, void *user)
+{
+    multi_sensor_t *sensor = (multi_sensor_t *)user;
+    output_record_t record;
+    uint64_t tx_us;
+    
+    sensor->busy = 0;
+    if (gs_inited == 0)
+    {
+        return;
+    }
+    memset(&record, 0, sizeof(record));
+    record.name = sensor->config.name;
+    record.sensor = sensor->index;
+    record.status = res;
+    if (res != 0)
+    {
+        sensor->stats.errors++;
+        record.timestamp_us = ba121_interface_timestamp_us();
+    }
+    else
+    {
+        sensor->stats.samples++;
+        (void)ba121_get_timestamp(handle, &tx_us, &record.timestamp_us);
+        record.conductivity_raw = conductivity_raw;
+        record.conductivity_us_cm = conductivity_us_cm;
+        record.temperature_raw = temperature_raw;
+        record.temperature = temperature;
+    }
+    (void)output_write(&sensor->sink->out, &record);
+}
+
+/**
+ * @brief     async config callback
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] res command result
+ * @param[in] *user pointer to a sensor structure
+ * @note      none
+ */
+static void a_multi_config_callback(ba121_handle_t *handle, uint8_t res, void *user)
+{
+    multi_sensor_t *sensor = (multi_sensor_t *)user;
+    
+    (void)handle;
+    if ((gs_inited != 0) && (res != 0))
+    {
+        printf("multi: %s ntc config failed.\n", sensor->config.name);
+    }
+}
+
+/**
+ * @brief     queue the ntc config of a sensor
+ * @param[in] *sensor pointer to a sensor structure
+ * @note      runs after every open, so a replugged sensor gets its config back
+ */
+static void a_multi_configure(multi_sensor_t *sensor)
+{
+    if (sensor->config.ntc_resistance != 0)
+    {
+        (void)ba121_async_set_ntc_resistance(&sensor->handle, sensor->config.ntc_resistance,
+                                             a_multi_config_callback, sensor);
+    }
+    if (sensor->config.ntc_b != 0)
+    {
+        (void)ba121_async_set_ntc_b(&sensor->handle, sensor->config.ntc_b,
+                                    a_multi_config_callback, sensor);
+    }
+}
+
+/**
+ * @brief     start the due work of a sensor
+ * @param[in] *sensor pointer to a sensor structure
+ * @param[in] now_ms current time in ms
+ * @note      none
+ */
+static void a_multi_schedule(multi_sensor_t *sensor, uint32_t now_ms)
+{
+    if ((int32_t)(now_ms - sensor->next_ms) < 0)
+    {
+        return;
+    }
+    
+    /* next slot on the grid, a late loop moves the grid instead of bursting */
+    sensor->next_ms += sensor->config.interval_ms;
+    if ((int32_t)(now_ms - sensor->next_ms) >= 0)
+    {
+        sensor->next_ms = now_ms + sensor->config.interval_ms;
+    }
+    
+    /* a lost device is retried once per slot */
+    if (sensor->fd < 0)
+    {
+        if (a_multi_open(sensor) != 0)
+        {
+            sensor->stats.errors++;
+            
+            return;
+        }
+        sensor->stats.reconnects++;
+        a_multi_configure(sensor);
+    }
+    if (sensor->busy != 0)
+    {
+        sensor->stats.overruns++;
+        
+        return;
+    }
+    sensor->busy = 1;
+    if (ba121_async_read(&sensor->handle, a_multi_read_callback, sensor) != 0)
+    {
+        sensor->busy = 0;
+        sensor->stats.errors++;
+    }
+}
+
+/**
+ * @brief      parse a number
+ * @param[in]  *s pointer to a string
+ * @param[out] *value pointer to a value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not a number
+ * @note       none
+ */
+static uint8_t a_multi_parse_number(const char *s, uint32_t *value)
+{
+    char *end;
+    unsigned long v;
+    
+    if ((*s < '0') || (*s > '9'))
+    {
+        return 1;
+    }
+    errno = 0;
+    v = strtoul(s, &end, 10);
+    if ((errno != 0) || (*end != '\0') || (v > 0xFFFFFFFFUL))
+    {
+        return 1;
+    }
+    *value = (uint32_t)v;
+    
+    return 0;
+}
+
+/**
+ * @brief         parse one key=value pair
+ * @param[in,out] *config pointer to a config structure
+ * @param[in]     *token pointer to a token
+ * @return        status code
+ *                - 0 success
+ *                - 1 parse failed
+ * @note          none
+ */
+static uint8_t a_multi_parse_pair(multi_config_t *config, char *token)
+{
+    char *value;
+    uint32_t v;
+    
+    value = strchr(token, '=');
+    if ((value == NULL) || (value[1] == '\0'))
+    {
+        return 1;
+    }
+    *value++ = '\0';
+    if (strcmp(token, "port") == 0)
+    {
+        strncpy(config->port, value, MULTI_PATH_LEN - 1);
+        
+        return (uint8_t)(strlen(value) >= MULTI_PATH_LEN);
+    }
+    else if (strcmp(token, "name") == 0)
+    {
+        strncpy(config->name, value, MULTI_NAME_LEN - 1);
+        
+        return (uint8_t)(strlen(value) >= MULTI_NAME_LEN);
+    }
+    else if (strcmp(token, "output") == 0)
+    {
+        strncpy(config->output, value, MULTI_PATH_LEN - 1);
+        
+        return (uint8_t)(strlen(value) >= MULTI_PATH_LEN);
+    }
+    else if (strcmp(token, "format") == 0)
+    {
+        output_format_t format;
+        
+        if (output_parse_format(value, &format) != 0)
+        {
+            return 1;
+        }
+        config->format = (uint8_t)format;
+        
+        return 0;
+    }
+    else if (strcmp(token, "flush") == 0)
+    {
+        return output_parse_flush(value, &config->flush_ms);
+    }
+    if (a_multi_parse_number(value, &v) != 0)
+    {
+        return 1;
+    }
+    if (strcmp(token, "baud") == 0)
+    {
+        config->baud_rate = v;
+        
+        return (uint8_t)((v != 2400) && (v != 4800) && (v != 9600) && (v != 19200) &&
+                         (v != 38400) && (v != 57600) && (v != 115200));
+    }
+    else if (strcmp(token, "interval") == 0)
+    {
+        config->interval_ms = v;
+        
+        return (uint8_t)(v == 0);
+    }
+    else if (strcmp(token, "ntc_resistance") == 0)
+    {
+        config->ntc_resistance = v;
+        
+        return 0;
+    }
+    else if (strcmp(token, "ntc_b") == 0)
+    {
+        config->ntc_b = (uint16_t)v;
+        
+        return (uint8_t)(v > 0xFFFF);
+    }
+    else if (strcmp(token, "retry") == 0)
+    {
+        config->attempts = (uint8_t)v;
+        
+        return (uint8_t)(v > 0xFF);
+    }
+    else
+    {
+        return 1;
+    }
+}
+
+/**
+ * @brief      load a config file
+ * @param[in]  *path pointer to a file path
+ * @param[out] *config pointer to a config list
+ * @param[in]  max max config entries
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       one sensor per line as key=value pairs, '#' starts a comment,
+ *             keys are port, name, baud, interval, ntc_resistance, ntc_b, retry, output, format and flush
+ */
+uint8_t multi_load(const char *path, multi_config_t *config, uint16_t max, uint16_t *count)
+{
+    FILE *fp;
+    char line[512];
+    char *p;
+    char *token;
+    uint32_t number;
+    uint16_t n;
+    
+    if ((path == NULL) || (config == NULL) || (count == NULL))
+    {
+        printf("multi: param is invalid.\n");
+        
+        return 1;
+    }
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        printf("multi: can't open %s.\n", path);
+        
+        return 1;
+    }
+    n = 0;
+    number = 0;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        number++;
+        p = strchr(line, '#');
+        if (p != NULL)
+        {
+            *p = '\0';
+        }
+        token = strtok(line, " \t\r\n");
+        if (token == NULL)
+        {
+            continue;
+        }
+        if (n >= max)
+        {
+            printf("multi: %s:%u too many sensors, the max is %u.\n", path, number, max);
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        
+        /* defaults */
+        memset(&config[n], 0, sizeof(multi_config_t));
+        strcpy(config[n].output, "-");
+        config[n].baud_rate = 9600;
+        config[n].interval_ms = 1000;
+        config[n].attempts = 1;
+        config[n].format = OUTPUT_FORMAT_TEXT;
+        config[n].flush_ms = OUTPUT_FLUSH_RECORD;
+        for (; token != NULL; token = strtok(NULL, " \t\r\n"))
+        {
+            if (a_multi_parse_pair(&config[n], token) != 0)
+            {
+                printf("multi: %s:%u %s is invalid.\n", path, number, token);
+                (void)fclose(fp);
+                
+                return 1;
+            }
+        }
+        if (config[n].port[0] == '\0')
+        {
+            printf("multi: %s:%u port is missing.\n", path, number);
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        if (config[n].name[0] == '\0')
+        {
+            snprintf(config[n].name, MULTI_NAME_LEN, "%.*s", MULTI_NAME_LEN - 1, config[n].port);
+        }
+        n++;
+    }
+    (void)fclose(fp);
+    if (n == 0)
+    {
+        printf("multi: %s has no sensor.\n", path);
+        
+        return 1;
+    }
+    *count = n;
+    
+    return 0;
+}
+
+/**
+ * @brief     find or open an output sink
+ * @param[in] *config pointer to a sensor config
+ * @return    pointer to a sink, NULL on failure
+ * @note      sensors with the same output share one buffered writer,
+ *            the first sensor sets its format and flush policy
+ */
+static multi_sink_t *a_multi_sink(const multi_config_t *config)
+{
+    multi_sink_t *sink;
+    uint16_t i;
+    
+    for (i = 0; i < gs_sink_count; i++)
+    {
+        if (strcmp(gs_sink[i].path, config->output) == 0)
+        {
+            if (gs_sink[i].out.format != config->format)
+            {
+                printf("multi: %s is used with two formats.\n", config->output);
+                
+                return NULL;
+            }
+            
+            return &gs_sink[i];
+        }
+    }
+    if (gs_sink_count >= MULTI_MAX_SINKS)
+    {
+        printf("multi: too many outputs, the max is %d.\n", MULTI_MAX_SINKS);
+        
+        return NULL;
+    }
+    sink = &gs_sink[gs_sink_count];
+    strncpy(sink->path, config->output, MULTI_PATH_LEN - 1);
+    sink->path[MULTI_PATH_LEN - 1] = '\0';
+    if (output_open(&sink->out, config->output, (output_format_t)config->format, config->flush_ms) != 0)
+    {
+        printf("multi: can't open %s.\n", config->output);
+        
+        return NULL;
+    }
+    gs_sink_count++;
+    
+    return sink;
+}
+
+/**
+ * @brief     multi init
+ * @param[in] *config pointer to a config list
+ * @param[in] count number of sensors
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      every sensor gets its own driver handle, all of them share one epoll loop,
+ *            a missing device doesn't fail the init and is opened once it appears
+ */
+uint8_t multi_init(const multi_config_t *config, uint16_t count)
+{
+    multi_sensor_t *sensor;
+    uint32_t now;
+    uint16_t i;
+    
+    if ((config == NULL) || (count == 0) || (count > MULTI_MAX_SENSORS))
+    {
+        printf("multi: param is invalid.\n");
+        
+        return 1;
+    }
+    if (gs_inited != 0)
+    {
+        printf("multi: already running.\n");
+        
+        return 1;
+    }
+#if (BA121_STATIC_LINK != 0)
+    printf("multi: the per sensor handles need the driver without BA121_STATIC_LINK.\n");
+    
+    return 1;
+#endif
+    gs_epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (gs_epoll < 0)
+    {
+        perror("multi: epoll create failed.\n");
+        
+        return 1;
+    }
+    gs_sensor_count = 0;
+    gs_sink_count = 0;
+    gs_inited = 1;
+    now = a_multi_now_ms();
+    for (i = 0; i < count; i++)
+    {
+        sensor = &gs_sensor[i];
+        memset(sensor, 0, sizeof(multi_sensor_t));
+        sensor->config = config[i];
+        sensor->fd = -1;
+        sensor->index = i;
+        sensor->sink = a_multi_sink(&config[i]);
+        if (sensor->sink == NULL)
+        {
+            (void)multi_deinit();
+            
+            return 1;
+        }
+        
+        /* link the sensor callbacks, the driver calls run with gs_current set */
+        gs_current = sensor;
+        DRIVER_BA121_LINK_INIT(&sensor->handle, ba121_handle_t);
+        DRIVER_BA121_LINK_UART_INIT(&sensor->handle, a_multi_uart_init);
+        DRIVER_BA121_LINK_UART_DEINIT(&sensor->handle, a_multi_uart_deinit);
+        DRIVER_BA121_LINK_UART_READ(&sensor->handle, a_multi_uart_read);
+        DRIVER_BA121_LINK_UART_FLUSH(&sensor->handle, a_multi_uart_flush);
+        DRIVER_BA121_LINK_UART_WRITE(&sensor->handle, a_multi_uart_write);
+        DRIVER_BA121_LINK_DELAY_MS(&sensor->handle, a_multi_delay_ms);
+        DRIVER_BA121_LINK_DEBUG_PRINT(&sensor->handle, a_multi_debug_print);
+        DRIVER_BA121_LINK_TIMESTAMP_US(&sensor->handle, ba121_interface_timestamp_us);
+        if (ba121_init(&sensor->handle) != 0)
+        {
+            printf("multi: %s init failed.\n", sensor->config.name);
+            (void)multi_deinit();
+            
+            return 1;
+        }
+        gs_sensor_count++;
+        if ((sensor->config.attempts > 1) &&
+            (ba121_set_retry(&sensor->handle, sensor->config.attempts, 20, 200, BA121_RETRY_ALL) != 0))
+        {
+            printf("multi: %s set retry failed.\n", sensor->config.name);
+            (void)multi_deinit();
+            
+            return 1;
+        }
+        if (sensor->fd >= 0)
+        {
+            a_multi_configure(sensor);
+        }
+        
+        /* the first slot of each sensor is now, a missing device waits one interval */
+        sensor->next_ms = (sensor->fd >= 0) ? now : (now + sensor->config.interval_ms);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  multi deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   cancels the running commands, then closes the ports and the output files
+ */
+uint8_t multi_deinit(void)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    if (gs_inited == 0)
+    {
+        return 1;
+    }
+    
+    /* the cancelled reads complete without output */
+    gs_inited = 0;
+    res = 0;
+    for (i = 0; i < gs_sensor_count; i++)
+    {
+        gs_current = &gs_sensor[i];
+        (void)ba121_queue_cancel(&gs_sensor[i].handle);
+        if (ba121_deinit(&gs_sensor[i].handle) != 0)
+        {
+            res = 1;
+        }
+    }
+    for (i = 0; i < gs_sink_count; i++)
+    {
+        if (output_close(&gs_sink[i].out) != 0)
+        {
+            res = 1;
+        }
+    }
+    (void)close(gs_epoll);
+    gs_epoll = -1;
+    gs_current = NULL;
+    gs_sink_count = 0;
+    
+    return res;
+}
+
+/**
+ * @brief     run the event loop once
+ * @param[in] max_wait_ms max blocking time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      starts the due reads, waits for uart data or the next deadline and runs the driver,
+ *            samples are written to the output sinks from inside this function,
+ *            a signal ends the wait early
+ */
+uint8_t multi_poll(uint32_t max_wait_ms)
+{
+    struct epoll_event events[MULTI_MAX_EVENTS];
+    multi_sensor_t *sensor;
+    uint32_t now;
+    uint32_t wait;
+    uint32_t timeout;
+    uint16_t i;
+    int n;
+    int j;
+    
+    if (gs_inited == 0)
+    {
+        return 1;
+    }
+    
+    /* start the due reads and find the nearest deadline */
+    now = a_multi_now_ms();
+    wait = max_wait_ms;
+    for (i = 0; i < gs_sensor_count; i++)
+    {
+        sensor = &gs_sensor[i];
+        gs_current = sensor;
+        a_multi_schedule(sensor, now);
+        if ((ba121_async_get_timeout(&sensor->handle, now, &timeout) == 0) && (timeout < wait))
+        {
+            wait = timeout;
+        }
+        timeout = (uint32_t)(sensor->next_ms - now);
+        if (((int32_t)timeout >= 0) && (timeout < wait))
+        {
+            wait = timeout;
+        }
+    }
+    
+    /* wait for the ports */
+    n = epoll_wait(gs_epoll, events, MULTI_MAX_EVENTS, (int)wait);
+    if (n < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        perror("multi: epoll wait failed.\n");
+        
+        return 1;
+    }
+    now = a_multi_now_ms();
+    for (j = 0; j < n; j++)
+    {
+        sensor = (multi_sensor_t *)events[j].data.ptr;
+        gs_current = sensor;
+        if ((events[j].events & (EPOLLHUP | EPOLLERR)) != 0)
+        {
+            sensor->lost = 1;
+        }
+        (void)ba121_async_readable(&sensor->handle, now);
+    }
+    
+    /* expired deadlines, then drop the lost ports before they spin the loop */
+    for (i = 0; i < gs_sensor_count; i++)
+    {
+        sensor = &gs_sensor[i];
+        gs_current = sensor;
+        if ((ba121_async_get_timeout(&sensor->handle, now, &timeout) == 0) && (timeout == 0))
+        {
+            (void)ba121_async_timeout(&sensor->handle, now);
+        }
+        if ((sensor->lost != 0) && (sensor->fd >= 0))
+        {
+            printf("multi: %s lost, reconnecting.\n", sensor->config.port);
+            a_multi_close(sensor);
+        }
+    }
+    
+    /* write out the aged records of the sinks with a flush interval */
+    for (i = 0; i < gs_sink_count; i++)
+    {
+        (void)output_poll(&gs_sink[i].out);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  index sensor index
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 index is invalid
+ * @note       none
+ */
+uint8_t multi_get_stats(uint16_t index, multi_stats_t *stats)
+{
+    if ((index >= gs_sensor_count) || (stats == NULL))
+    {
+        return 1;
+    }
+    *stats = gs_sensor[index].stats;
+    
+    return 0;
+}
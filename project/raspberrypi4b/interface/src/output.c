@@ -0,0 +1,633 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      output.c
+ * @brief     output source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "output.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief output record limit definition
+ */
+#define OUTPUT_RECORD_MAX        512        /**< max formatted record */
+#define OUTPUT_NAME_MAX          64         /**< max written name characters */
+
+/**
+ * @brief  get the output time
+ * @return time in us
+ * @note   none
+ */
+static uint64_t a_output_now_us(void)
+{
+    struct timespec t;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint64_t)t.tv_sec * 1000000ULL + (uint64_t)(t.tv_nsec / 1000L);
+}
+
+/**
+ * @brief     write a buffer to the file
+ * @param[in] fd output file
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      retries short writes and signals
+ */
+static uint8_t a_output_write_all(int fd, const uint8_t *buf, uint32_t len)
+{
+    ssize_t l;
+    
+    while (len > 0)
+    {
+        l = write(fd, buf, len);
+        if (l < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        buf += l;
+        len -= (uint32_t)l;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     format an unsigned number
+ * @param[in] *p pointer to a text buffer
+ * @param[in] v number
+ * @return    pointer behind the text
+ * @note      none
+ */
+static char *a_output_u64(char *p, uint64_t v)
+{
+    char tmp[20];
+    uint8_t n;
+    
+    n = 0;
+    do
+    {
+        tmp[n++] = (char)('0' + (v % 10));
+        v /= 10;
+    } while (v != 0);
+    while (n > 0)
+    {
+        *p++ = tmp[--n];
+    }
+    
+    return p;
+}
+
+/**
+ * @brief     format a value with two decimals
+ * @param[in] *p pointer to a text buffer
+ * @param[in] v value in 1/100
+ * @return    pointer behind the text
+ * @note      none
+ */
+static char *a_output_centi(char *p, int32_t v)
+{
+    uint32_t u;
+    
+    if (v < 0)
+    {
+        *p++ = '-';
+        u = (uint32_t)(-(int64_t)v);
+    }
+    else
+    {
+        u = (uint32_t)v;
+    }
+    p = a_output_u64(p, u / 100);
+    *p++ = '.';
+    *p++ = (char)('0' + (u / 10) % 10);
+    *p++ = (char)('0' + u % 10);
+    
+    return p;
+}
+
+/**
+ * @brief     copy a string
+ * @param[in] *p pointer to a text buffer
+ * @param[in] *s pointer to a string
+ * @return    pointer behind the text
+ * @note      none
+ */
+static char *a_output_str(char *p, const char *s)
+{
+    while (*s != '\0')
+    {
+        *p++ = *s++;
+    }
+    
+    return p;
+}
+
+/**
+ * @brief     copy a sensor name
+ * @param[in] *p pointer to a text buffer
+ * @param[in] *s pointer to a name
+ * @param[in] mode 0 writes the name as it is, 1 escapes for json and 2 for csv
+ * @return    pointer behind the text
+ * @note      control characters become '?' and long names are cut
+ */
+static char *a_output_name(char *p, const char *s, uint8_t mode)
+{
+    uint8_t n;
+    
+    for (n = 0; (s[n] != '\0') && (n < OUTPUT_NAME_MAX); n++)
+    {
+        if ((unsigned char)s[n] < 0x20)
+        {
+            *p++ = '?';
+            
+            continue;
+        }
+        if ((mode == 1) && ((s[n] == '"') || (s[n] == '\\')))
+        {
+            *p++ = '\\';
+        }
+        else if ((mode == 2) && (s[n] == '"'))
+        {
+            *p++ = '"';
+        }
+        *p++ = s[n];
+    }
+    
+    return p;
+}
+
+/**
+ * @brief     round a temperature
+ * @param[in] t temperature in C
+ * @return    temperature in 0.01C
+ * @note      none
+ */
+static int32_t a_output_centi_round(float t)
+{
+    return (int32_t)(t * 100.0f + ((t >= 0.0f) ? 0.5f : -0.5f));
+}
+
+/**
+ * @brief     put a little endian number
+ * @param[in] *p pointer to a data buffer
+ * @param[in] v number
+ * @param[in] n number of bytes
+ * @return    pointer behind the data
+ * @note      none
+ */
+static uint8_t *a_output_le(uint8_t *p, uint64_t v, uint8_t n)
+{
+    uint8_t i;
+    
+    for (i = 0; i < n; i++)
+    {
+        *p++ = (uint8_t)(v >> (8 * i));
+    }
+    
+    return p;
+}
+
+/**
+ * @brief     format a text record
+ * @param[in] *p pointer to a text buffer
+ * @param[in] *record pointer to a record
+ * @return    pointer behind the text
+ * @note      the multi mode sentence, the name is left out when a record has none
+ */
+static char *a_output_text(char *p, const output_record_t *record)
+{
+    p = a_output_str(p, "ba121: ");
+    if (record->name != NULL)
+    {
+        p = a_output_name(p, record->name, 0);
+        *p++ = ' ';
+    }
+    if (record->status != 0)
+    {
+        return a_output_str(p, "no reply.\n");
+    }
+    p = a_output_u64(p, record->timestamp_us / 1000);
+    *p++ = '.';
+    *p++ = (char)('0' + (record->timestamp_us / 100) % 10);
+    *p++ = (char)('0' + (record->timestamp_us / 10) % 10);
+    *p++ = (char)('0' + record->timestamp_us % 10);
+    p = a_output_str(p, "ms conductivity is ");
+    p = a_output_u64(p, record->conductivity_us_cm);
+    p = a_output_str(p, " uS/cm, temperature is ");
+    p = a_output_centi(p, a_output_centi_round(record->temperature));
+    
+    return a_output_str(p, "C.\n");
+}
+
+/**
+ * @brief     format a json line
+ * @param[in] *p pointer to a text buffer
+ * @param[in] *record pointer to a record
+ * @return    pointer behind the text
+ * @note      none
+ */
+static char *a_output_jsonl(char *p, const output_record_t *record)
+{
+    p = a_output_str(p, "{\"timestamp_us\":");
+    p = a_output_u64(p, record->timestamp_us);
+    p = a_output_str(p, ",\"sensor\":");
+    p = a_output_u64(p, record->sensor);
+    if (record->name != NULL)
+    {
+        p = a_output_str(p, ",\"name\":\"");
+        p = a_output_name(p, record->name, 1);
+        *p++ = '"';
+    }
+    p = a_output_str(p, ",\"status\":");
+    p = a_output_u64(p, record->status);
+    p = a_output_str(p, ",\"conductivity_raw\":");
+    p = a_output_u64(p, record->conductivity_raw);
+    p = a_output_str(p, ",\"conductivity_us_cm\":");
+    p = a_output_u64(p, record->conductivity_us_cm);
+    p = a_output_str(p, ",\"temperature_raw\":");
+    p = a_output_u64(p, record->temperature_raw);
+    p = a_output_str(p, ",\"temperature\":");
+    p = a_output_centi(p, a_output_centi_round(record->temperature));
+    
+    return a_output_str(p, "}\n");
+}
+
+/**
+ * @brief     format a csv line
+ * @param[in] *p pointer to a text buffer
+ * @param[in] *record pointer to a record
+ * @return    pointer behind the text
+ * @note      the name is always quoted
+ */
+static char *a_output_csv(char *p, const output_record_t *record)
+{
+    p = a_output_u64(p, record->timestamp_us);
+    *p++ = ',';
+    p = a_output_u64(p, record->sensor);
+    *p++ = ',';
+    *p++ = '"';
+    if (record->name != NULL)
+    {
+        p = a_output_name(p, record->name, 2);
+    }
+    *p++ = '"';
+    *p++ = ',';
+    p = a_output_u64(p, record->status);
+    *p++ = ',';
+    p = a_output_u64(p, record->conductivity_raw);
+    *p++ = ',';
+    p = a_output_u64(p, record->conductivity_us_cm);
+    *p++ = ',';
+    p = a_output_u64(p, record->temperature_raw);
+    *p++ = ',';
+    p = a_output_centi(p, a_output_centi_round(record->temperature));
+    *p++ = '\n';
+    
+    return p;
+}
+
+/**
+ * @brief      parse a format name
+ * @param[in]  *name pointer to a format name
+ * @param[out] *format pointer to a format buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 name is invalid
+ * @note       text, jsonl, csv or binary
+ */
+uint8_t output_parse_format(const char *name, output_format_t *format)
+{
+    if ((name == NULL) || (format == NULL))
+    {
+        return 1;
+    }
+    if (strcmp(name, "text") == 0)
+    {
+        *format = OUTPUT_FORMAT_TEXT;
+    }
+    else if (strcmp(name, "jsonl") == 0)
+    {
+        *format = OUTPUT_FORMAT_JSONL;
+    }
+    else if (strcmp(name, "csv") == 0)
+    {
+        *format = OUTPUT_FORMAT_CSV;
+    }
+    else if (strcmp(name, "binary") == 0)
+    {
+        *format = OUTPUT_FORMAT_BINARY;
+    }
+    else
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      parse a flush policy
+ * @param[in]  *value pointer to a flush policy
+ * @param[out] *flush_ms pointer to a flush policy buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 value is invalid
+ * @note       full or a decimal age in ms, 0 flushes every record
+ */
+uint8_t output_parse_flush(const char *value, uint32_t *flush_ms)
+{
+    char *end;
+    unsigned long v;
+    
+    if ((value == NULL) || (flush_ms == NULL))
+    {
+        return 1;
+    }
+    if (strcmp(value, "full") == 0)
+    {
+        *flush_ms = OUTPUT_FLUSH_FULL;
+        
+        return 0;
+    }
+    if ((*value < '0') || (*value > '9'))
+    {
+        return 1;
+    }
+    errno = 0;
+    v = strtoul(value, &end, 10);
+    if ((errno != 0) || (*end != '\0') || (v > 0xFFFFFFFFUL))
+    {
+        return 1;
+    }
+    *flush_ms = (uint32_t)v;
+    
+    return 0;
+}
+
+/**
+ * @brief     open an output
+ * @param[in] *out pointer to an output structure
+ * @param[in] *path pointer to a file path, "-" is stdout
+ * @param[in] format output format
+ * @param[in] flush_ms flush policy, OUTPUT_FLUSH_RECORD, OUTPUT_FLUSH_FULL or the max age of a buffered record in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      files are appended, the csv header and the binary header are only written to an empty file
+ */
+uint8_t output_open(output_t *out, const char *path, output_format_t format, uint32_t flush_ms)
+{
+    const char header[] = "timestamp_us,sensor,name,status,conductivity_raw,conductivity_us_cm,"
+                          "temperature_raw,temperature\n";
+    uint8_t binary[8] = {'B', 'A', '1', '2', '1', OUTPUT_BINARY_VERSION, OUTPUT_BINARY_RECORD_SIZE, 0};
+    uint8_t empty;
+    
+    if ((out == NULL) || (path == NULL) || (format > OUTPUT_FORMAT_BINARY))
+    {
+        printf("output: param is invalid.\n");
+        
+        return 1;
+    }
+    memset(out, 0, sizeof(output_t));
+    out->format = (uint8_t)format;
+    out->flush_ms = flush_ms;
+    if (strcmp(path, "-") == 0)
+    {
+        out->fd = STDOUT_FILENO;
+        out->owner = 0;
+        empty = 1;
+    }
+    else
+    {
+        out->fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (out->fd < 0)
+        {
+            perror("output: open failed.\n");
+            
+            return 1;
+        }
+        out->owner = 1;
+        empty = (uint8_t)(lseek(out->fd, 0, SEEK_END) == 0);
+    }
+    
+    /* the header goes straight into the buffer and leaves with the first flush */
+    if ((empty != 0) && (format == OUTPUT_FORMAT_CSV))
+    {
+        memcpy(out->buf, header, sizeof(header) - 1);
+        out->len = sizeof(header) - 1;
+    }
+    else if ((empty != 0) && (format == OUTPUT_FORMAT_BINARY))
+    {
+        memcpy(out->buf, binary, sizeof(binary));
+        out->len = sizeof(binary);
+    }
+    out->oldest_us = a_output_now_us();
+    
+    return output_flush(out);
+}
+
+/**
+ * @brief     write a record
+ * @param[in] *out pointer to an output structure
+ * @param[in] *record pointer to a record
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the record is formatted into the buffer and written out by the flush policy
+ */
+uint8_t output_write(output_t *out, const output_record_t *record)
+{
+    char *start;
+    char *p;
+    uint8_t *b;
+    
+    if ((out == NULL) || (record == NULL))
+    {
+        return 1;
+    }
+    
+    /* keep room for the longest record, so it is formatted in place */
+    if ((OUTPUT_BUFFER_SIZE - out->len < OUTPUT_RECORD_MAX) && (output_flush(out) != 0))
+    {
+        return 1;
+    }
+    if (out->len == 0)
+    {
+        out->oldest_us = a_output_now_us();
+    }
+    start = (char *)&out->buf[out->len];
+    switch (out->format)
+    {
+        case OUTPUT_FORMAT_JSONL :
+        {
+            p = a_output_jsonl(start, record);
+            
+            break;
+        }
+        
+        case OUTPUT_FORMAT_CSV :
+        {
+            p = a_output_csv(start, record);
+            
+            break;
+        }
+        
+        case OUTPUT_FORMAT_BINARY :
+        {
+            b = (uint8_t *)start;
+            b = a_output_le(b, record->timestamp_us, 8);
+            b = a_output_le(b, record->sensor, 2);
+            b = a_output_le(b, record->conductivity_raw, 2);
+            b = a_output_le(b, record->conductivity_us_cm, 2);
+            b = a_output_le(b, record->temperature_raw, 2);
+            b = a_output_le(b, (uint16_t)(int16_t)a_output_centi_round(record->temperature), 2);
+            b = a_output_le(b, record->status, 1);
+            b = a_output_le(b, 0, 1);
+            p = (char *)b;
+            
+            break;
+        }
+        
+        default :
+        {
+            p = a_output_text(start, record);
+            
+            break;
+        }
+    }
+    out->len += (uint32_t)(p - start);
+    out->records++;
+    
+    return output_poll(out);
+}
+
+/**
+ * @brief     flush the output when the policy says so
+ * @param[in] *out pointer to an output structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      call it from the event loop, so an aged record is written without waiting for the next one
+ */
+uint8_t output_poll(output_t *out)
+{
+    if ((out == NULL) || (out->len == 0) || (out->flush_ms == OUTPUT_FLUSH_FULL))
+    {
+        return 0;
+    }
+    if ((out->flush_ms == OUTPUT_FLUSH_RECORD) ||
+        (a_output_now_us() - out->oldest_us >= (uint64_t)out->flush_ms * 1000ULL))
+    {
+        return output_flush(out);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     flush the output
+ * @param[in] *out pointer to an output structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the buffer is dropped on a write error
+ */
+uint8_t output_flush(output_t *out)
+{
+    uint8_t res;
+    
+    if (out == NULL)
+    {
+        return 1;
+    }
+    if (out->len == 0)
+    {
+        return 0;
+    }
+    
+    /* keep the order with the printf messages */
+    if (out->fd == STDOUT_FILENO)
+    {
+        (void)fflush(stdout);
+    }
+    res = a_output_write_all(out->fd, out->buf, out->len);
+    if (res != 0)
+    {
+        out->errors++;
+    }
+    out->len = 0;
+    
+    return res;
+}
+
+/**
+ * @brief     close an output
+ * @param[in] *out pointer to an output structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      flushes first, stdout is not closed
+ */
+uint8_t output_close(output_t *out)
+{
+    uint8_t res;
+    
+    if (out == NULL)
+    {
+        return 1;
+    }
+    res = output_flush(out);
+    if ((out->owner != 0) && (close(out->fd) != 0))
+    {
+        res = 1;
+    }
+    out->fd = -1;
+    out->owner = 0;
+    
+    return res;
+}
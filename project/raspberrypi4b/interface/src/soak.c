@@ -0,0 +1,678 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      soak.c
+ * @brief     soak source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "soak.h"
+#include "uart.h"
+#include "driver_ba121.h"
+#include "driver_ba121_interface.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief soak port structure definition
+ */
+typedef struct soak_port_s
+{
+    pthread_t thread;          /**< port thread */
+    char *name;                /**< device name */
+    int fd;                    /**< uart handle */
+    uint8_t lost;              /**< device lost flag */
+    uint8_t started;           /**< thread started flag */
+    soak_stats_t stats;        /**< statistics, guarded by gs_mutex */
+} soak_port_t;
+
+static soak_port_t gs_port[SOAK_MAX_PORTS];                         /**< ports */
+static uint16_t gs_port_count = 0;                                  /**< opened ports */
+static uint32_t gs_period_ms = 1000;                                /**< sampling period */
+static uint8_t gs_attempts = 1;                                     /**< driver retry attempts */
+static uint8_t gs_running = 0;                                      /**< running flag */
+static uint8_t gs_inited = 0;                                       /**< inited flag */
+static pthread_mutex_t gs_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< statistics and stop lock */
+static pthread_cond_t gs_cond;                                      /**< stop signal */
+static __thread soak_port_t *gs_current = NULL;                     /**< port of the calling thread */
+
+#if (BA121_STATIC_LINK == 0)
+
+/**
+ * @brief  uart init
+ * @return status code
+ *         - 0 success
+ * @note   the ports are opened by soak_init
+ */
+static uint8_t a_soak_uart_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief  uart deinit
+ * @return status code
+ *         - 0 success
+ * @note   the ports are closed by soak_deinit
+ */
+static uint8_t a_soak_uart_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      uart read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       a hung up device is flagged for the port thread to reopen
+ */
+static uint16_t a_soak_uart_read(uint8_t *buf, uint16_t len)
+{
+    uint32_t l = len;
+    
+    if (gs_current->lost != 0)
+    {
+        return 0;
+    }
+    if (uart_read(gs_current->fd, buf, &l) != 0)
+    {
+        gs_current->lost = (uint8_t)((uart_lost(errno) != 0) || (uart_check(gs_current->fd) != 0));
+        
+        return 0;
+    }
+    if ((l == 0) && (len != 0) && (uart_check(gs_current->fd) != 0))
+    {
+        gs_current->lost = 1;
+    }
+    
+    return (uint16_t)l;
+}
+
+/**
+ * @brief  uart flush
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   none
+ */
+static uint8_t a_soak_uart_flush(void)
+{
+    if (gs_current->lost != 0)
+    {
+        return 1;
+    }
+    if (uart_flush(gs_current->fd) != 0)
+    {
+        gs_current->lost = (uint8_t)((uart_lost(errno) != 0) || (uart_check(gs_current->fd) != 0));
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     uart write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_soak_uart_write(uint8_t *buf, uint16_t len)
+{
+    if (gs_current->lost != 0)
+    {
+        return 1;
+    }
+    if (uart_write(gs_current->fd, buf, len) != 0)
+    {
+        gs_current->lost = (uint8_t)((uart_lost(errno) != 0) || (uart_check(gs_current->fd) != 0));
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     wait reply
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the read returns as soon as the reply is buffered, so the latency is the real reply time,
+ *            a lost device waits the whole timeout
+ */
+static uint8_t a_soak_wait_reply(uint16_t len, uint32_t timeout_ms)
+{
+    if ((gs_current->lost != 0) || (uart_check(gs_current->fd) != 0))
+    {
+        gs_current->lost = 1;
+        usleep(1000 * timeout_ms);
+        
+        return 1;
+    }
+    
+    return uart_wait_data(gs_current->fd, len, timeout_ms);
+}
+
+/**
+ * @brief     delay
+ * @param[in] ms time in ms
+ * @note      none
+ */
+static void a_soak_delay_ms(uint32_t ms)
+{
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief     debug print
+ * @param[in] fmt format data
+ * @note      the driver messages are dropped, every error is counted instead
+ */
+static void a_soak_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+#endif
+
+/**
+ * @brief     convert a time
+ * @param[in] *t pointer to a time
+ * @return    time in ms
+ * @note      none
+ */
+static uint64_t a_soak_ms(const struct timespec *t)
+{
+    return (uint64_t)t->tv_sec * 1000ULL + (uint64_t)(t->tv_nsec / 1000000L);
+}
+
+/**
+ * @brief         add a period to a time
+ * @param[in,out] *t pointer to a time
+ * @param[in]     ms period in ms
+ * @note          none
+ */
+static void a_soak_add_ms(struct timespec *t, uint32_t ms)
+{
+    t->tv_sec += ms / 1000;
+    t->tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (t->tv_nsec >= 1000000000L)
+    {
+        t->tv_sec++;
+        t->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief     reopen a lost device
+ * @param[in] *port pointer to a port structure
+ * @note      the same reopen as the interface hot plug, waits up to one second for the device node
+ */
+static void a_soak_reconnect(soak_port_t *port)
+{
+    if (uart_reopen(port->name, &port->fd, 9600, 1000) != 0)
+    {
+        return;
+    }
+    port->lost = 0;
+    pthread_mutex_lock(&gs_mutex);
+    port->stats.reconnects++;
+    pthread_mutex_unlock(&gs_mutex);
+}
+
+/**
+ * @brief     add one transaction to the statistics
+ * @param[in] *stats pointer to a statistics structure
+ * @param[in] res driver result
+ * @param[in] attempts driver attempts
+ * @param[in] latency_ms transaction latency
+ * @note      call it with gs_mutex held
+ */
+static void a_soak_count(soak_stats_t *stats, uint8_t res, uint8_t attempts, uint32_t latency_ms)
+{
+    uint32_t bucket;
+    
+    stats->transactions++;
+    stats->retries += (attempts > 1) ? (uint64_t)(attempts - 1) : 0;
+    if (res == 0)
+    {
+        bucket = latency_ms / SOAK_HISTOGRAM_STEP_MS;
+        stats->ok++;
+        stats->latency_total_ms += latency_ms;
+        stats->latency_max_ms = (latency_ms > stats->latency_max_ms) ? latency_ms : stats->latency_max_ms;
+        stats->histogram[(bucket < SOAK_HISTOGRAM_SIZE) ? bucket : (SOAK_HISTOGRAM_SIZE - 1)]++;
+    }
+    else if (res == 1)
+    {
+        stats->link_errors++;
+    }
+    else if (res == 4)
+    {
+        stats->frame_errors++;
+    }
+    else
+    {
+        stats->other_errors++;
+    }
+}
+
+/**
+ * @brief     port thread
+ * @param[in] *arg pointer to a port structure
+ * @return    NULL
+ * @note      one driver handle per thread, the uart callbacks find the port through a thread local pointer
+ */
+static void *a_soak_thread(void *arg)
+{
+    soak_port_t *port = (soak_port_t *)arg;
+    ba121_handle_t handle;
+    struct timespec next;
+    struct timespec start;
+    struct timespec stop;
+    uint16_t conductivity_raw;
+    uint16_t conductivity_us_cm;
+    uint16_t temperature_raw;
+    float temperature;
+    uint8_t attempts;
+    uint8_t res;
+    
+    /* link the port callbacks */
+    gs_current = port;
+    DRIVER_BA121_LINK_INIT(&handle, ba121_handle_t);
+    DRIVER_BA121_LINK_UART_INIT(&handle, a_soak_uart_init);
+    DRIVER_BA121_LINK_UART_DEINIT(&handle, a_soak_uart_deinit);
+    DRIVER_BA121_LINK_UART_READ(&handle, a_soak_uart_read);
+    DRIVER_BA121_LINK_UART_FLUSH(&handle, a_soak_uart_flush);
+    DRIVER_BA121_LINK_UART_WRITE(&handle, a_soak_uart_write);
+    DRIVER_BA121_LINK_DELAY_MS(&handle, a_soak_delay_ms);
+    DRIVER_BA121_LINK_DEBUG_PRINT(&handle, a_soak_debug_print);
+#if (BA121_STATIC_LINK == 0)
+    DRIVER_BA121_LINK_WAIT_REPLY(&handle, a_soak_wait_reply);
+    DRIVER_BA121_LINK_TIMESTAMP_US(&handle, ba121_interface_timestamp_us);
+#endif
+    if (ba121_init(&handle) != 0)
+    {
+        return NULL;
+    }
+    if ((gs_attempts > 1) && (ba121_set_retry(&handle, gs_attempts, 20, 200, BA121_RETRY_ALL) != 0))
+    {
+        (void)ba121_deinit(&handle);
+        
+        return NULL;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (__atomic_load_n(&gs_running, __ATOMIC_ACQUIRE) != 0)
+    {
+        if (port->lost != 0)
+        {
+            /* a slot without a device is a lost sample too */
+            a_soak_reconnect(port);
+            if (port->lost != 0)
+            {
+                pthread_mutex_lock(&gs_mutex);
+                a_soak_count(&port->stats, 1, 1, 0);
+                pthread_mutex_unlock(&gs_mutex);
+            }
+        }
+        else
+        {
+            /* one read, errors only count */
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            res = ba121_read(&handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+            clock_gettime(CLOCK_MONOTONIC, &stop);
+            (void)ba121_get_last_attempts(&handle, &attempts);
+            pthread_mutex_lock(&gs_mutex);
+            a_soak_count(&port->stats, res, attempts, (uint32_t)(a_soak_ms(&stop) - a_soak_ms(&start)));
+            pthread_mutex_unlock(&gs_mutex);
+        }
+        
+        /* next slot on the absolute grid, a slow read moves the grid instead of bursting */
+        a_soak_add_ms(&next, gs_period_ms);
+        clock_gettime(CLOCK_MONOTONIC, &stop);
+        if (a_soak_ms(&next) < a_soak_ms(&stop))
+        {
+            next = stop;
+        }
+        
+        /* sleep until the slot or the stop signal */
+        pthread_mutex_lock(&gs_mutex);
+        while (__atomic_load_n(&gs_running, __ATOMIC_ACQUIRE) != 0)
+        {
+            if (pthread_cond_timedwait(&gs_cond, &gs_mutex, &next) == ETIMEDOUT)
+            {
+                break;
+            }
+        }
+        pthread_mutex_unlock(&gs_mutex);
+    }
+    (void)ba121_deinit(&handle);
+    
+    return NULL;
+}
+
+/**
+ * @brief     soak init
+ * @param[in] **name pointer to a device name list
+ * @param[in] count number of devices
+ * @param[in] period_ms sampling period of each port in ms
+ * @param[in] attempts driver retry attempts, 0 or 1 disables the retry
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      every port gets its own thread and driver handle and keeps reading through errors,
+ *            a lost device is reopened between two reads
+ */
+uint8_t soak_init(char **name, uint16_t count, uint32_t period_ms, uint8_t attempts)
+{
+    pthread_condattr_t attr;
+    uint16_t i;
+    
+    if ((name == NULL) || (count == 0) || (count > SOAK_MAX_PORTS) || (period_ms == 0))
+    {
+        printf("soak: param is invalid.\n");
+        
+        return 1;
+    }
+    if (gs_inited != 0)
+    {
+        printf("soak: already running.\n");
+        
+        return 1;
+    }
+#if (BA121_STATIC_LINK != 0)
+    printf("soak: the per port handles need the driver without BA121_STATIC_LINK.\n");
+    
+    return 1;
+#endif
+    
+    /* the stop signal uses the monotonic clock of the sampling grid */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&gs_cond, &attr);
+    pthread_condattr_destroy(&attr);
+    gs_inited = 1;
+    
+    /* open all ports first so a missing device fails early */
+    gs_port_count = 0;
+    for (i = 0; i < count; i++)
+    {
+        memset(&gs_port[i], 0, sizeof(soak_port_t));
+        gs_port[i].name = name[i];
+        gs_port[i].fd = -1;
+        if (uart_init(name[i], &gs_port[i].fd, 9600, 8, 'N', 1) != 0)
+        {
+            printf("soak: open %s failed.\n", name[i]);
+            (void)soak_deinit();
+            
+            return 1;
+        }
+        gs_port_count++;
+    }
+    
+    /* start one thread per port */
+    gs_period_ms = period_ms;
+    gs_attempts = attempts;
+    __atomic_store_n(&gs_running, 1, __ATOMIC_RELEASE);
+    for (i = 0; i < count; i++)
+    {
+        if (pthread_create(&gs_port[i].thread, NULL, a_soak_thread, &gs_port[i]) != 0)
+        {
+            printf("soak: create thread failed.\n");
+            (void)soak_deinit();
+            
+            return 1;
+        }
+        gs_port[i].started = 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  soak deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   stops and joins the port threads, then closes the ports
+ */
+uint8_t soak_deinit(void)
+{
+    uint8_t res = 0;
+    uint16_t i;
+    
+    if (gs_inited == 0)
+    {
+        return 0;
+    }
+    
+    /* stop the threads, a read in progress finishes first */
+    pthread_mutex_lock(&gs_mutex);
+    __atomic_store_n(&gs_running, 0, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&gs_cond);
+    pthread_mutex_unlock(&gs_mutex);
+    for (i = 0; i < gs_port_count; i++)
+    {
+        if (gs_port[i].started != 0)
+        {
+            pthread_join(gs_port[i].thread, NULL);
+            gs_port[i].started = 0;
+        }
+    }
+    
+    /* close the ports */
+    for (i = 0; i < gs_port_count; i++)
+    {
+        if ((gs_port[i].fd >= 0) && (uart_deinit(gs_port[i].fd) != 0))
+        {
+            res = 1;
+        }
+        gs_port[i].fd = -1;
+    }
+    pthread_cond_destroy(&gs_cond);
+    gs_inited = 0;
+    
+    return res;
+}
+
+/**
+ * @brief      get the statistics
+ * @param[in]  port port index, SOAK_MAX_PORTS sums all ports
+ * @param[out] *stats pointer to a statistics buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 port is invalid
+ * @note       a consistent snapshot, the threads keep running
+ */
+uint8_t soak_get_stats(uint16_t port, soak_stats_t *stats)
+{
+    uint16_t i;
+    uint32_t j;
+    
+    if ((port != SOAK_MAX_PORTS) && (port >= gs_port_count))
+    {
+        return 1;
+    }
+    
+    pthread_mutex_lock(&gs_mutex);
+    if (port != SOAK_MAX_PORTS)
+    {
+        *stats = gs_port[port].stats;
+    }
+    else
+    {
+        memset(stats, 0, sizeof(soak_stats_t));
+        for (i = 0; i < gs_port_count; i++)
+        {
+            const soak_stats_t *s = &gs_port[i].stats;
+            
+            stats->transactions += s->transactions;
+            stats->ok += s->ok;
+            stats->link_errors += s->link_errors;
+            stats->frame_errors += s->frame_errors;
+            stats->other_errors += s->other_errors;
+            stats->retries += s->retries;
+            stats->reconnects += s->reconnects;
+            stats->latency_total_ms += s->latency_total_ms;
+            stats->latency_max_ms = (s->latency_max_ms > stats->latency_max_ms) ? s->latency_max_ms : stats->latency_max_ms;
+            for (j = 0; j < SOAK_HISTOGRAM_SIZE; j++)
+            {
+                stats->histogram[j] += s->histogram[j];
+            }
+        }
+    }
+    pthread_mutex_unlock(&gs_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief     get a latency percentile
+ * @param[in] *stats pointer to a statistics structure
+ * @param[in] permille percentile in 1/1000, 500 is the median
+ * @return    latency in ms, the upper edge of the histogram bucket capped by the max
+ * @note      0 without samples
+ */
+uint32_t soak_percentile(const soak_stats_t *stats, uint16_t permille)
+{
+    uint64_t target;
+    uint64_t sum;
+    uint32_t i;
+    
+    if (stats->ok == 0)
+    {
+        return 0;
+    }
+    target = (stats->ok * permille + 999) / 1000;
+    target = (target == 0) ? 1 : target;
+    sum = 0;
+    for (i = 0; i < SOAK_HISTOGRAM_SIZE - 1; i++)
+    {
+        sum += stats->histogram[i];
+        if (sum >= target)
+        {
+            return ((i + 1) * SOAK_HISTOGRAM_STEP_MS < stats->latency_max_ms) ?
+                   (i + 1) * SOAK_HISTOGRAM_STEP_MS : stats->latency_max_ms;
+        }
+    }
+    
+    return stats->latency_max_ms;
+}
+
+/**
+ * @brief     write one statistics object
+ * @param[in] *fp pointer to a file
+ * @param[in] *stats pointer to a statistics structure
+ * @param[in] elapsed_s soak duration in s
+ * @note      none
+ */
+static void a_soak_json_stats(FILE *fp, const soak_stats_t *stats, double elapsed_s)
+{
+    fprintf(fp, "\"transactions\": %llu, \"ok\": %llu, \"samples_per_s\": %.3f, "
+                "\"error_rate\": %.6f, \"errors\": {\"link\": %llu, \"frame\": %llu, \"other\": %llu}, "
+                "\"retries\": %llu, \"reconnects\": %llu, "
+                "\"latency_ms\": {\"mean\": %.1f, \"p50\": %u, \"p90\": %u, \"p99\": %u, \"p999\": %u, \"max\": %u}",
+            (unsigned long long)stats->transactions, (unsigned long long)stats->ok,
+            (elapsed_s > 0.0) ? (double)stats->ok / elapsed_s : 0.0,
+            (stats->transactions != 0) ? (double)(stats->transactions - stats->ok) / (double)stats->transactions : 0.0,
+            (unsigned long long)stats->link_errors, (unsigned long long)stats->frame_errors,
+            (unsigned long long)stats->other_errors, (unsigned long long)stats->retries,
+            (unsigned long long)stats->reconnects,
+            (stats->ok != 0) ? (double)stats->latency_total_ms / (double)stats->ok : 0.0,
+            (unsigned int)soak_percentile(stats, 500), (unsigned int)soak_percentile(stats, 900),
+            (unsigned int)soak_percentile(stats, 990), (unsigned int)soak_percentile(stats, 999),
+            (unsigned int)stats->latency_max_ms);
+}
+
+/**
+ * @brief     write the json report
+ * @param[in] *path pointer to a file path
+ * @param[in] **name pointer to a device name list
+ * @param[in] elapsed_s soak duration in s
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one object per port and the total
+ */
+uint8_t soak_report(const char *path, char **name, double elapsed_s)
+{
+    FILE *fp;
+    const char *p;
+    uint16_t i;
+    static soak_stats_t stats;
+    
+    fp = fopen(path, "w");
+    if (fp == NULL)
+    {
+        printf("soak: open %s failed.\n", path);
+        
+        return 1;
+    }
+    fprintf(fp, "{\n  \"duration_s\": %.3f,\n  \"period_ms\": %u,\n  \"attempts\": %u,\n  \"ports\": [\n",
+            elapsed_s, (unsigned int)gs_period_ms, (unsigned int)((gs_attempts > 1) ? gs_attempts : 1));
+    for (i = 0; i < gs_port_count; i++)
+    {
+        (void)soak_get_stats(i, &stats);
+        fprintf(fp, "    {\"name\": \"");
+        for (p = name[i]; *p != '\0'; p++)
+        {
+            if ((*p == '"') || (*p == '\\'))
+            {
+                fputc('\\', fp);
+            }
+            fputc(*p, fp);
+        }
+        fprintf(fp, "\", ");
+        a_soak_json_stats(fp, &stats, elapsed_s);
+        fprintf(fp, "}%s\n", (i + 1 < gs_port_count) ? "," : "");
+    }
+    (void)soak_get_stats(SOAK_MAX_PORTS, &stats);
+    fprintf(fp, "  ],\n  \"total\": {");
+    a_soak_json_stats(fp, &stats, elapsed_s);
+    fprintf(fp, "}\n}\n");
+    if (fclose(fp) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
@@ -35,9 +35,16 @@
  */
 
 #include "uart.h"
+#include <errno.h>
 #include <fcntl.h>
+#include <libgen.h>
+#include <poll.h>
 #include <string.h>
 #include <termios.h>
+#include <time.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
 
 /**
  * @brief     uart config
@@ -431,3 +438,263 @@ uint8_t uart_flush(int fd)
         return 0;
     }
 }
+
+/**
+ * @brief     check whether the device is still connected
+ * @param[in] fd uart handle
+ * @return    status code
+ *            - 0 connected
+ *            - 1 disconnected
+ * @note      a removed device node or a hang up counts as disconnected
+ */
+uint8_t uart_check(int fd)
+{
+    struct stat st;
+    struct pollfd p;
+    
+    /* the node is unlinked when the adapter is removed */
+    if ((fstat(fd, &st) != 0) || (st.st_nlink == 0))
+    {
+        return 1;
+    }
+    
+    /* check hang up */
+    p.fd = fd;
+    p.events = 0;
+    p.revents = 0;
+    if (poll(&p, 1, 0) < 0)
+    {
+        return 1;
+    }
+    if ((p.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check whether an error means the device is gone
+ * @param[in] err errno of the failed call
+ * @return    status code
+ *            - 0 other error
+ *            - 1 device lost
+ * @note      EIO, ENODEV, ENXIO and EBADF
+ */
+uint8_t uart_lost(int err)
+{
+    if ((err == EIO) || (err == ENODEV) || (err == ENXIO) || (err == EBADF))
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     wait for a device node to appear
+ * @param[in] *name pointer to a device name buffer
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      inotify watches the parent directory, e.g. /dev/serial/by-id,
+ *            and falls back to polling while the directory itself is missing
+ */
+uint8_t uart_wait(char *name, uint32_t timeout_ms)
+{
+    char path[256];
+    struct timespec start;
+    struct timespec now;
+    uint32_t elapsed;
+    int watched;
+    int in;
+    
+    /* create the watch */
+    in = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    watched = -1;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (1)
+    {
+        struct pollfd p;
+        uint32_t wait;
+        char events[512];
+        
+        /* watch the parent directory, it may be missing too, e.g. /dev/serial goes away with the last adapter */
+        if ((in >= 0) && (watched < 0))
+        {
+            strncpy(path, name, sizeof(path) - 1);
+            path[sizeof(path) - 1] = 0;
+            watched = inotify_add_watch(in, dirname(path), IN_CREATE | IN_ATTRIB | IN_MOVED_TO);
+        }
+        
+        /* check the node after adding the watch, so it can't be missed */
+        if (access(name, R_OK | W_OK) == 0)
+        {
+            if (in >= 0)
+            {
+                (void)close(in);
+            }
+            
+            return 0;
+        }
+        
+        /* check timeout */
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (uint32_t)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+        if (elapsed >= timeout_ms)
+        {
+            break;
+        }
+        wait = timeout_ms - elapsed;
+        
+        /* poll while there is no watch */
+        if ((watched < 0) && (wait > 50))
+        {
+            wait = 50;
+        }
+        if (watched >= 0)
+        {
+            p.fd = in;
+            p.events = POLLIN;
+            p.revents = 0;
+            if (poll(&p, 1, (int)wait) > 0)
+            {
+                while (read(in, events, sizeof(events)) > 0)
+                {
+                    /* drain events */
+                }
+                
+                /* re-add, the directory itself may have been removed */
+                watched = -1;
+            }
+        }
+        else
+        {
+            (void)usleep(wait * 1000);
+        }
+    }
+    if (in >= 0)
+    {
+        (void)close(in);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief         reopen a lost device
+ * @param[in]     *name pointer to a device name buffer
+ * @param[in,out] *fd pointer to a uart handle, the old handle is closed, -1 on failure
+ * @param[in]     baud_rate baud rate
+ * @param[in]     timeout_ms timeout of each wait for the device node in ms
+ * @return        status code
+ *                - 0 success
+ *                - 1 reopen failed
+ * @note          8N1, the open is tried 3 times because udev may still be fixing the permissions
+ *                after the node appears
+ */
+uint8_t uart_reopen(char *name, int *fd, uint32_t baud_rate, uint32_t timeout_ms)
+{
+    uint8_t i;
+    
+    /* drop the dead fd */
+    if (*fd >= 0)
+    {
+        (void)close(*fd);
+        *fd = -1;
+    }
+    
+    /* udev may still be fixing the permissions after the node appears */
+    for (i = 0; i < 3; i++)
+    {
+        if (uart_wait(name, timeout_ms) != 0)
+        {
+            break;
+        }
+        if (uart_init(name, fd, baud_rate, 8, 'N', 1) == 0)
+        {
+            return 0;
+        }
+        if (*fd >= 0)
+        {
+            (void)close(*fd);
+            *fd = -1;
+        }
+        (void)usleep(50 * 1000);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     wait for received data
+ * @param[in] fd uart handle
+ * @param[in] len data length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout or disconnected
+ * @note      sleeps in poll until the first byte, then one byte time at a time until len bytes are buffered
+ */
+uint8_t uart_wait_data(int fd, uint32_t len, uint32_t timeout_ms)
+{
+    struct timespec start;
+    struct timespec now;
+    uint32_t elapsed;
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    while (1)
+    {
+        struct pollfd p;
+        uint32_t wait;
+        int count;
+        
+        /* check the buffered length */
+        if (ioctl(fd, FIONREAD, &count) != 0)
+        {
+            return 1;
+        }
+        if ((uint32_t)count >= len)
+        {
+            return 0;
+        }
+        
+        /* check timeout */
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (uint32_t)((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000);
+        if (elapsed >= timeout_ms)
+        {
+            return 1;
+        }
+        wait = timeout_ms - elapsed;
+        
+        /* poll stays readable once a byte is buffered, so sleep for the rest of the reply instead */
+        if (count > 0)
+        {
+            (void)usleep(1000);
+            
+            continue;
+        }
+        p.fd = fd;
+        p.events = POLLIN;
+        p.revents = 0;
+        if (poll(&p, 1, (int)wait) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        if ((p.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0)
+        {
+            return 1;
+        }
+    }
+}
@@ -37,10 +37,51 @@
 #include "driver_ba121_basic.h"
 #include "driver_ba121_register_test.h"
 #include "driver_ba121_read_test.h"
+#include "acquire.h"
+#include "soak.h"
+#include "multi.h"
+#include "output.h"
 #include <getopt.h>
 #include <ctype.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t gs_stop = 0;        /**< stop request */
+
+/**
+ * @brief     stop signal handler
+ * @param[in] signum signal number
+ * @note      none
+ */
+static void a_stop_handler(int signum)
+{
+    (void)signum;
+    gs_stop = 1;
+}
+
+/**
+ * @brief     print one soak summary line
+ * @param[in] *label pointer to a line label
+ * @param[in] *stats pointer to a statistics structure
+ * @param[in] *last pointer to the statistics of the previous summary
+ * @param[in] interval_s seconds since the previous summary
+ * @note      the rate covers the last interval, the percentiles and errors the whole run
+ */
+static void a_soak_print(const char *label, const soak_stats_t *stats, const soak_stats_t *last, double interval_s)
+{
+    ba121_interface_debug_print("ba121: %s %.2f samples/s, ok %llu/%llu, p50 %ums p90 %ums p99 %ums max %ums, "
+                                "link %llu frame %llu other %llu, retries %llu, reconnects %llu.\n", label,
+                                (interval_s > 0.0) ? (double)(stats->ok - last->ok) / interval_s : 0.0,
+                                (unsigned long long)stats->ok, (unsigned long long)stats->transactions,
+                                soak_percentile(stats, 500), soak_percentile(stats, 900),
+                                soak_percentile(stats, 990), stats->latency_max_ms,
+                                (unsigned long long)stats->link_errors, (unsigned long long)stats->frame_errors,
+                                (unsigned long long)stats->other_errors, (unsigned long long)stats->retries,
+                                (unsigned long long)stats->reconnects);
+}
 
 /**
  * @brief     ba121 full function
@@ -65,10 +106,32 @@ uint8_t ba121(uint8_t argc, char **argv)
         {"example", required_argument, NULL, 'e'},
         {"test", required_argument, NULL, 't'},
         {"times", required_argument, NULL, 1},
+        {"ports", required_argument, NULL, 2},
+        {"group", required_argument, NULL, 3},
+        {"period", required_argument, NULL, 4},
+        {"duration", required_argument, NULL, 5},
+        {"interval", required_argument, NULL, 6},
+        {"report", required_argument, NULL, 7},
+        {"retry", required_argument, NULL, 8},
+        {"config", required_argument, NULL, 9},
+        {"format", required_argument, NULL, 10},
+        {"output", required_argument, NULL, 11},
+        {"flush", required_argument, NULL, 12},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint32_t times = 3;
+    char ports[256] = "/dev/ttyS0";
+    uint16_t group = 1;
+    uint32_t period = 1000;
+    uint32_t duration = 0;
+    uint32_t interval = 10;
+    char report[256] = "ba121_soak.json";
+    uint8_t retry = 3;
+    char config[256] = "ba121.conf";
+    output_format_t format = OUTPUT_FORMAT_TEXT;
+    char output[256] = "-";
+    uint32_t flush = OUTPUT_FLUSH_RECORD;
     
     /* if no params */
     if (argc == 1)
@@ -148,6 +211,115 @@ uint8_t ba121(uint8_t argc, char **argv)
                 break;
             }
             
+            /* ports */
+            case 2 :
+            {
+                /* set ports */
+                memset(ports, 0, sizeof(char) * 256);
+                strncpy(ports, optarg, 255);
+                
+                break;
+            }
+            
+            /* group */
+            case 3 :
+            {
+                /* set group */
+                group = atoi(optarg);
+                
+                break;
+            }
+            
+            /* period */
+            case 4 :
+            {
+                /* set period */
+                period = atoi(optarg);
+                
+                break;
+            }
+            
+            /* duration */
+            case 5 :
+            {
+                /* set duration */
+                duration = atoi(optarg);
+                
+                break;
+            }
+            
+            /* interval */
+            case 6 :
+            {
+                /* set interval */
+                interval = atoi(optarg);
+                
+                break;
+            }
+            
+            /* report */
+            case 7 :
+            {
+                /* set report */
+                memset(report, 0, sizeof(char) * 256);
+                strncpy(report, optarg, 255);
+                
+                break;
+            }
+            
+            /* retry */
+            case 8 :
+            {
+                /* set retry */
+                retry = atoi(optarg);
+                
+                break;
+            }
+            
+            /* config */
+            case 9 :
+            {
+                /* set config */
+                memset(config, 0, sizeof(char) * 256);
+                strncpy(config, optarg, 255);
+                
+                break;
+            }
+            
+            /* format */
+            case 10 :
+            {
+                /* set format */
+                if (output_parse_format(optarg, &format) != 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* output */
+            case 11 :
+            {
+                /* set output */
+                memset(output, 0, sizeof(char) * 256);
+                strncpy(output, optarg, 255);
+                
+                break;
+            }
+            
+            /* flush */
+            case 12 :
+            {
+                /* set flush */
+                if (output_parse_flush(optarg, &flush) != 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -189,6 +361,8 @@ uint8_t ba121(uint8_t argc, char **argv)
         uint16_t conductivity_us_cm;
         float temperature;
         uint32_t i;
+        static output_t out;
+        output_record_t record;
         
         /* init */
         res = ba121_basic_init();
@@ -197,6 +371,47 @@ uint8_t ba121(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* the sentences stay on stdout, any other output goes through the output layer */
+        if ((format != OUTPUT_FORMAT_TEXT) || (strcmp(output, "-") != 0))
+        {
+            if (output_open(&out, output, format, flush) != 0)
+            {
+                (void)ba121_basic_deinit();
+                
+                return 1;
+            }
+            memset(&record, 0, sizeof(record));
+            for (i = 0; i < times; i++)
+            {
+                /* delay 1000ms */
+                ba121_interface_delay_ms(1000);
+                
+                /* read, a failed read is a record too */
+                record.status = ba121_basic_read_with_timestamp(&record.conductivity_raw, &record.conductivity_us_cm,
+                                                                &record.temperature_raw, &record.temperature,
+                                                                &record.timestamp_us);
+                if (record.status != 0)
+                {
+                    memset(&record, 0, sizeof(record));
+                    record.status = 1;
+                    record.timestamp_us = ba121_interface_timestamp_us();
+                }
+                if (output_write(&out, &record) != 0)
+                {
+                    (void)output_close(&out);
+                    (void)ba121_basic_deinit();
+                    
+                    return 1;
+                }
+            }
+            
+            /* deinit */
+            res = output_close(&out);
+            (void)ba121_basic_deinit();
+            
+            return res;
+        }
+        
         for (i = 0; i < times; i++)
         {
             /* delay 1000ms */
@@ -280,6 +495,208 @@ uint8_t ba121(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("e_acquire", type) == 0)
+    {
+        char *name[ACQUIRE_MAX_PORTS];
+        char *p;
+        uint16_t count;
+        uint32_t drops;
+        uint32_t overruns;
+        uint32_t i;
+        acquire_sample_t sample;
+        
+        /* split the port list */
+        count = 0;
+        for (p = strtok(ports, ","); (p != NULL) && (count < ACQUIRE_MAX_PORTS); p = strtok(NULL, ","))
+        {
+            name[count++] = p;
+        }
+        
+        /* start the reader threads */
+        if (acquire_init(name, count, group, period, 256) != 0)
+        {
+            return 1;
+        }
+        
+        for (i = 0; i < times; i++)
+        {
+            /* wait for the next sample */
+            if (acquire_read(&sample, (int32_t)(period * 2 + 1000)) != 0)
+            {
+                ba121_interface_debug_print("ba121: acquire read timeout.\n");
+                (void)acquire_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            if (sample.valid != 0)
+            {
+                ba121_interface_debug_print("ba121: %d/%d %s %llu.%03llums conductivity is %d uS/cm, temperature is %0.2fC.\n",
+                                            i + 1, times, name[sample.port],
+                                            (unsigned long long)(sample.timestamp_ns / 1000000ULL),
+                                            (unsigned long long)(sample.timestamp_ns / 1000ULL % 1000ULL),
+                                            sample.conductivity_us_cm, sample.temperature);
+            }
+            else
+            {
+                ba121_interface_debug_print("ba121: %d/%d %s no reply.\n", i + 1, times, name[sample.port]);
+            }
+        }
+        
+        /* output the statistics */
+        (void)acquire_get_stats(&drops, &overruns);
+        ba121_interface_debug_print("ba121: %d dropped samples, %d missed periods.\n", drops, overruns);
+        
+        /* deinit */
+        (void)acquire_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_soak", type) == 0)
+    {
+        char *name[SOAK_MAX_PORTS];
+        char label[32];
+        char *p;
+        uint16_t count;
+        uint16_t i;
+        struct sigaction action;
+        struct timespec start;
+        struct timespec now;
+        double elapsed;
+        double last_print;
+        static soak_stats_t stats;
+        static soak_stats_t last[SOAK_MAX_PORTS + 1];
+        
+        /* split the port list */
+        count = 0;
+        for (p = strtok(ports, ","); (p != NULL) && (count < SOAK_MAX_PORTS); p = strtok(NULL, ","))
+        {
+            name[count++] = p;
+        }
+        
+        /* ctrl-c ends the soak and still writes the report */
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = a_stop_handler;
+        sigemptyset(&action.sa_mask);
+        (void)sigaction(SIGINT, &action, NULL);
+        (void)sigaction(SIGTERM, &action, NULL);
+        gs_stop = 0;
+        
+        /* start the port threads */
+        if (soak_init(name, count, period, retry) != 0)
+        {
+            return 1;
+        }
+        memset(last, 0, sizeof(last));
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        last_print = 0.0;
+        elapsed = 0.0;
+        while (gs_stop == 0)
+        {
+            /* poll the clock, the threads do the work */
+            usleep(100 * 1000);
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            elapsed = (double)(now.tv_sec - start.tv_sec) + (double)(now.tv_nsec - start.tv_nsec) / 1e9;
+            if ((duration != 0) && (elapsed >= (double)duration))
+            {
+                break;
+            }
+            if ((interval == 0) || (elapsed - last_print < (double)interval))
+            {
+                continue;
+            }
+            
+            /* periodic summary */
+            if (count > 1)
+            {
+                for (i = 0; i < count; i++)
+                {
+                    (void)soak_get_stats(i, &stats);
+                    a_soak_print(name[i], &stats, &last[i], elapsed - last_print);
+                    last[i] = stats;
+                }
+            }
+            (void)soak_get_stats(SOAK_MAX_PORTS, &stats);
+            snprintf(label, sizeof(label), "%.0fs total", elapsed);
+            a_soak_print(label, &stats, &last[SOAK_MAX_PORTS], elapsed - last_print);
+            last[SOAK_MAX_PORTS] = stats;
+            last_print = elapsed;
+        }
+        
+        /* stop, then report the whole run */
+        (void)soak_deinit();
+        memset(&last[SOAK_MAX_PORTS], 0, sizeof(soak_stats_t));
+        (void)soak_get_stats(SOAK_MAX_PORTS, &stats);
+        snprintf(label, sizeof(label), "%.0fs final", elapsed);
+        a_soak_print(label, &stats, &last[SOAK_MAX_PORTS], elapsed);
+        if (soak_report(report, name, elapsed) != 0)
+        {
+            return 1;
+        }
+        ba121_interface_debug_print("ba121: report written to %s.\n", report);
+        
+        return 0;
+    }
+    else if (strcmp("e_multi", type) == 0)
+    {
+        static multi_config_t list[MULTI_MAX_SENSORS];
+        uint16_t count;
+        uint16_t i;
+        struct sigaction action;
+        struct timespec start;
+        struct timespec now;
+        multi_stats_t stats;
+        
+        /* load the sensor list */
+        if (multi_load(config, list, MULTI_MAX_SENSORS, &count) != 0)
+        {
+            return 1;
+        }
+        
+        /* ctrl-c ends the run */
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = a_stop_handler;
+        sigemptyset(&action.sa_mask);
+        (void)sigaction(SIGINT, &action, NULL);
+        (void)sigaction(SIGTERM, &action, NULL);
+        gs_stop = 0;
+        
+        /* one loop drives all sensors */
+        if (multi_init(list, count) != 0)
+        {
+            return 1;
+        }
+        ba121_interface_debug_print("ba121: %d sensors from %s.\n", count, config);
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        while (gs_stop == 0)
+        {
+            if (multi_poll(500) != 0)
+            {
+                (void)multi_deinit();
+                
+                return 1;
+            }
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            if ((duration != 0) && (now.tv_sec - start.tv_sec >= (time_t)duration))
+            {
+                break;
+            }
+        }
+        (void)multi_deinit();
+        
+        /* output the statistics */
+        for (i = 0; i < count; i++)
+        {
+            (void)multi_get_stats(i, &stats);
+            ba121_interface_debug_print("ba121: %s %llu samples, %llu errors, %llu overruns, %llu reconnects.\n",
+                                        list[i].name, (unsigned long long)stats.samples,
+                                        (unsigned long long)stats.errors, (unsigned long long)stats.overruns,
+                                        (unsigned long long)stats.reconnects);
+        }
+        
+        return 0;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -289,16 +706,35 @@ uint8_t ba121(uint8_t argc, char **argv)
         ba121_interface_debug_print("  ba121 (-p | --port)\n");
         ba121_interface_debug_print("  ba121 (-t reg | --test=reg)\n");
         ba121_interface_debug_print("  ba121 (-t read | --test=read) [--times=<num>]\n");
-        ba121_interface_debug_print("  ba121 (-e read | --example=read) [--times=<num>]\n");
+        ba121_interface_debug_print("  ba121 (-e read | --example=read) [--times=<num>] [--format=<text | jsonl | csv | binary>]\n");
+        ba121_interface_debug_print("        [--output=<path>] [--flush=<ms | full>]\n");
         ba121_interface_debug_print("  ba121 (-e status | --example=status)\n");
         ba121_interface_debug_print("  ba121 (-e baseline | --example=baseline)\n");
+        ba121_interface_debug_print("  ba121 (-e acquire | --example=acquire) [--ports=<dev[,dev...]>] [--group=<num>]\n");
+        ba121_interface_debug_print("        [--period=<ms>] [--times=<num>]\n");
+        ba121_interface_debug_print("  ba121 (-e soak | --example=soak) [--ports=<dev[,dev...]>] [--period=<ms>] [--retry=<num>]\n");
+        ba121_interface_debug_print("        [--duration=<s>] [--interval=<s>] [--report=<path>]\n");
+        ba121_interface_debug_print("  ba121 (-e multi | --example=multi) [--config=<path>] [--duration=<s>]\n");
         ba121_interface_debug_print("\n");
         ba121_interface_debug_print("Options:\n");
-        ba121_interface_debug_print("  -e <read | status | baseline>, --example=<read | status | baseline>\n");
+        ba121_interface_debug_print("      --config=<path>             Set the multi sensor config file.([default: ba121.conf])\n");
+        ba121_interface_debug_print("      --duration=<s>              Set the soak or multi duration in s, 0 runs until ctrl-c.([default: 0])\n");
+        ba121_interface_debug_print("  -e <read | status | baseline | acquire | soak | multi>, --example=<read | status | baseline | acquire | soak | multi>\n");
         ba121_interface_debug_print("                                  Run the driver example.\n");
+        ba121_interface_debug_print("      --flush=<ms | full>         Set the output flush policy, 0 flushes every record, full only a full buffer.([default: 0])\n");
+        ba121_interface_debug_print("      --format=<text | jsonl | csv | binary>\n");
+        ba121_interface_debug_print("                                  Set the read output format, text to stdout keeps the three line output,\n");
+        ba121_interface_debug_print("                                  text to a file writes one timestamped sentence per sample.([default: text])\n");
+        ba121_interface_debug_print("      --group=<num>               Set the ports per reader thread.([default: 1])\n");
         ba121_interface_debug_print("  -h, --help                      Show the help.\n");
         ba121_interface_debug_print("  -i, --information               Show the chip information.\n");
+        ba121_interface_debug_print("      --interval=<s>              Set the soak summary interval in s.([default: 10])\n");
+        ba121_interface_debug_print("      --period=<ms>               Set the sampling period in ms.([default: 1000])\n");
+        ba121_interface_debug_print("      --output=<path>             Set the read output file, - is stdout.([default: -])\n");
         ba121_interface_debug_print("  -p, --port                      Display the pins used by this device to connect the chip.\n");
+        ba121_interface_debug_print("      --ports=<dev[,dev...]>      Set the serial ports.([default: /dev/ttyS0])\n");
+        ba121_interface_debug_print("      --report=<path>             Set the soak json report path.([default: ba121_soak.json])\n");
+        ba121_interface_debug_print("      --retry=<num>               Set the soak read attempts.([default: 3])\n");
         ba121_interface_debug_print("  -t <reg | read>, --test=<reg | read>\n");
         ba121_interface_debug_print("                                  Run the driver test.\n");
         ba121_interface_debug_print("      --times=<num>               Set the running times.([default: 3])\n");
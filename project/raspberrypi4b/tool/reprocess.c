@@ -0,0 +1,1148 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      reprocess.c
+ * @brief     reprocess source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_filter.h"
+#include <getopt.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief reprocess default definition
+ */
+#define REPROCESS_DEFAULT_CHUNK_SIZE        (4 * 1024 * 1024)        /**< 4 MiB per chunk */
+#define REPROCESS_MAX_THREADS               256                      /**< max worker threads */
+#define REPROCESS_MAX_LINE                  128                      /**< max formatted line */
+
+/**
+ * @brief reprocess config structure definition
+ */
+typedef struct reprocess_config_s
+{
+    uint8_t window;             /**< median window, 0 disables the filter */
+    float sigma;                /**< hampel threshold */
+    float coefficient;          /**< compensation coefficient */
+    float reference;            /**< compensation reference temperature */
+    uint32_t rollup_ms;         /**< rollup period, 0 writes every sample */
+} reprocess_config_t;
+
+/**
+ * @brief reprocess record structure definition
+ */
+typedef struct reprocess_record_s
+{
+    int64_t key;                /**< timestamp or rollup bucket */
+    uint64_t seq;               /**< input order */
+    uint32_t count;             /**< sample count */
+    uint32_t outlier;           /**< outlier count */
+    uint16_t cond_min;          /**< min conductivity */
+    uint16_t cond_max;          /**< max conductivity */
+    double cond_sum;            /**< conductivity sum */
+    double temp_sum;            /**< temperature sum */
+    double comp_sum;            /**< compensated conductivity sum */
+} reprocess_record_t;
+
+/**
+ * @brief reprocess chunk structure definition
+ */
+typedef struct reprocess_chunk_s
+{
+    size_t begin;                      /**< first byte */
+    size_t end;                        /**< one past the last byte */
+    reprocess_record_t *record;        /**< output records */
+    size_t record_count;               /**< output record count */
+    char *text;                        /**< formatted records */
+    size_t text_length;                /**< formatted length */
+    uint64_t lines;                    /**< parsed lines */
+    uint64_t invalid;                  /**< rejected lines */
+    uint8_t failed;                    /**< out of memory flag */
+} reprocess_chunk_t;
+
+/**
+ * @brief reprocess deque structure definition
+ */
+typedef struct reprocess_deque_s
+{
+    pthread_mutex_t mutex;        /**< deque lock */
+    size_t head;                  /**< owner end */
+    size_t tail;                  /**< thief end */
+} reprocess_deque_t;
+
+/**
+ * @brief reprocess pool structure definition
+ */
+typedef struct reprocess_pool_s
+{
+    const char *data;                         /**< mapped log */
+    size_t size;                              /**< log size */
+    const reprocess_config_t *config;         /**< pipeline config */
+    reprocess_chunk_t *chunk;                 /**< chunks */
+    reprocess_deque_t *deque;                 /**< one deque per worker */
+    uint32_t threads;                         /**< worker count */
+    uint64_t *seq_base;                       /**< first line number of each chunk */
+} reprocess_pool_t;
+
+/**
+ * @brief reprocess worker structure definition
+ */
+typedef struct reprocess_worker_s
+{
+    reprocess_pool_t *pool;        /**< shared pool */
+    uint32_t id;                   /**< worker id */
+    uint64_t stolen;               /**< stolen chunk count */
+} reprocess_worker_t;
+
+/**
+ * @brief      parse one log line
+ * @param[in]  *p pointer to the line start
+ * @param[in]  *end pointer to the line end
+ * @param[out] *ts pointer to a timestamp buffer
+ * @param[out] *cond pointer to a conductivity raw buffer
+ * @param[out] *temp pointer to a temperature raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 invalid line
+ *             - 2 blank or comment line
+ * @note       the line format is "timestamp_ms,conductivity_raw,temperature_raw"
+ */
+static uint8_t a_reprocess_parse(const char *p, const char *end, int64_t *ts, uint16_t *cond, uint16_t *temp)
+{
+    uint64_t v[3];
+    uint8_t i;
+    uint8_t neg;
+
+    while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\r')))
+    {
+        p++;
+    }
+    if ((p == end) || (*p == '#'))
+    {
+        return 2;
+    }
+    neg = 0;
+    if (*p == '-')
+    {
+        neg = 1;
+        p++;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        const char *start = p;
+
+        v[i] = 0;
+        while ((p < end) && (*p >= '0') && (*p <= '9'))
+        {
+            v[i] = v[i] * 10 + (uint64_t)(*p - '0');
+            p++;
+        }
+        if ((p == start) || ((i > 0) && (v[i] > 0xFFFF)))
+        {
+            return 1;
+        }
+        while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\r')))
+        {
+            p++;
+        }
+        if (i < 2)
+        {
+            if ((p == end) || (*p != ','))
+            {
+                return 1;
+            }
+            p++;
+            while ((p < end) && ((*p == ' ') || (*p == '\t')))
+            {
+                p++;
+            }
+        }
+    }
+    if (p != end)
+    {
+        return 1;
+    }
+    *ts = (neg != 0) ? -(int64_t)v[0] : (int64_t)v[0];
+    *cond = (uint16_t)v[1];
+    *temp = (uint16_t)v[2];
+
+    return 0;
+}
+
+/**
+ * @brief     floor division
+ * @param[in] a dividend
+ * @param[in] b divisor
+ * @return    floor(a / b)
+ * @note      none
+ */
+static int64_t a_reprocess_floor_div(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+
+    if (((a % b) != 0) && ((a < 0) != (b < 0)))
+    {
+        q--;
+    }
+
+    return q;
+}
+
+/**
+ * @brief     record order
+ * @param[in] *a pointer to a record
+ * @param[in] *b pointer to a record
+ * @return    compare result
+ * @note      none
+ */
+static int a_reprocess_compare(const void *a, const void *b)
+{
+    const reprocess_record_t *x = (const reprocess_record_t *)a;
+    const reprocess_record_t *y = (const reprocess_record_t *)b;
+
+    if (x->key != y->key)
+    {
+        return (x->key < y->key) ? -1 : 1;
+    }
+    if (x->seq != y->seq)
+    {
+        return (x->seq < y->seq) ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief         append a record
+ * @param[in,out] *chunk pointer to a chunk
+ * @param[in]     *r pointer to a record
+ * @param[in,out] *cap pointer to the record capacity
+ * @return        status code
+ *                - 0 success
+ *                - 1 out of memory
+ * @note          none
+ */
+static uint8_t a_reprocess_append(reprocess_chunk_t *chunk, const reprocess_record_t *r, size_t *cap)
+{
+    if (chunk->record_count == *cap)
+    {
+        size_t n = (*cap == 0) ? 4096 : (*cap * 2);
+        reprocess_record_t *p = (reprocess_record_t *)realloc(chunk->record, n * sizeof(reprocess_record_t));
+
+        if (p == NULL)
+        {
+            return 1;
+        }
+        chunk->record = p;
+        *cap = n;
+    }
+    chunk->record[chunk->record_count++] = *r;
+
+    return 0;
+}
+
+/**
+ * @brief         merge a record into a rollup bucket
+ * @param[in,out] *dst pointer to a bucket
+ * @param[in]     *src pointer to a record
+ * @note          none
+ */
+static void a_reprocess_fold(reprocess_record_t *dst, const reprocess_record_t *src)
+{
+    dst->count += src->count;
+    dst->outlier += src->outlier;
+    dst->cond_min = (src->cond_min < dst->cond_min) ? src->cond_min : dst->cond_min;
+    dst->cond_max = (src->cond_max > dst->cond_max) ? src->cond_max : dst->cond_max;
+    dst->cond_sum += src->cond_sum;
+    dst->temp_sum += src->temp_sum;
+    dst->comp_sum += src->comp_sum;
+}
+
+/**
+ * @brief      format one record
+ * @param[out] *buf pointer to a line buffer with REPROCESS_MAX_LINE bytes
+ * @param[in]  *r pointer to a record
+ * @param[in]  rollup_ms rollup period
+ * @return     line length
+ * @note       none
+ */
+static size_t a_reprocess_format(char *buf, const reprocess_record_t *r, uint32_t rollup_ms)
+{
+    int len;
+
+    if (rollup_ms != 0)
+    {
+        len = snprintf(buf, REPROCESS_MAX_LINE, "%lld,%u,%u,%u,%.2f,%u,%.2f,%.2f\n",
+                       (long long)(r->key * (int64_t)rollup_ms), r->count, r->outlier,
+                       r->cond_min, r->cond_sum / r->count, r->cond_max,
+                       r->temp_sum / r->count, r->comp_sum / r->count);
+    }
+    else
+    {
+        len = snprintf(buf, REPROCESS_MAX_LINE, "%lld,%u,%.2f,%.2f,%u\n",
+                       (long long)r->key, (uint32_t)r->cond_sum, r->temp_sum, r->comp_sum, r->outlier);
+    }
+    if ((len < 0) || (len >= REPROCESS_MAX_LINE))
+    {
+        len = snprintf(buf, REPROCESS_MAX_LINE, "%lld,overflow\n", (long long)r->key);
+    }
+
+    return (size_t)len;
+}
+
+/**
+ * @brief     write one record
+ * @param[in] *f pointer to an output file
+ * @param[in] *r pointer to a record
+ * @param[in] rollup_ms rollup period
+ * @note      none
+ */
+static void a_reprocess_write(FILE *f, const reprocess_record_t *r, uint32_t rollup_ms)
+{
+    char buf[REPROCESS_MAX_LINE];
+
+    (void)fwrite(buf, 1, a_reprocess_format(buf, r, rollup_ms), f);
+}
+
+/**
+ * @brief     check whether the chunk outputs are already in time order
+ * @param[in] *pool pointer to a pool
+ * @param[in] chunk_count chunk count
+ * @return    1 if the formatted chunks can be concatenated, otherwise 0
+ * @note      usual for logs written by one logger, equal timestamps keep the input order
+ */
+static uint8_t a_reprocess_in_order(reprocess_pool_t *pool, size_t chunk_count)
+{
+    const reprocess_record_t *last = NULL;
+    size_t i;
+
+    for (i = 0; i < chunk_count; i++)
+    {
+        reprocess_chunk_t *chunk = &pool->chunk[i];
+
+        if (chunk->record_count == 0)
+        {
+            continue;
+        }
+        if (chunk->text == NULL)
+        {
+            return 0;
+        }
+        if ((last != NULL) && (last->key > chunk->record[0].key))
+        {
+            return 0;
+        }
+        last = &chunk->record[chunk->record_count - 1];
+    }
+
+    return 1;
+}
+
+/**
+ * @brief     run the pipeline on one chunk
+ * @param[in] *pool pointer to a pool
+ * @param[in] index chunk index
+ * @note      the median filter is warmed up with the samples preceding the chunk,
+ *            so the output does not depend on the chunk layout
+ */
+static void a_reprocess_chunk(reprocess_pool_t *pool, size_t index)
+{
+    const reprocess_config_t *config = pool->config;
+    reprocess_chunk_t *chunk = &pool->chunk[index];
+    ba121_filter_handle_t filter;
+    const char *p;
+    const char *end;
+    size_t cap;
+    uint64_t seq;
+    uint32_t warm;
+    int64_t ts;
+    uint16_t cond;
+    uint16_t temp;
+
+    cap = 0;
+    seq = pool->seq_base[index];
+    if (config->window != 0)
+    {
+        (void)ba121_filter_init(&filter, config->window, config->sigma);
+    }
+
+    /* walk back over the samples the filter needs to see first */
+    p = pool->data + chunk->begin;
+    warm = 0;
+    if (config->window != 0)
+    {
+        const char *line_end = p;
+
+        while ((warm + 1 < config->window) && (line_end > pool->data))
+        {
+            const char *line = line_end - 1;
+
+            while ((line > pool->data) && (*(line - 1) != '\n'))
+            {
+                line--;
+            }
+            if (a_reprocess_parse(line, line_end - 1, &ts, &cond, &temp) == 0)
+            {
+                warm++;
+            }
+            line_end = line;
+        }
+        p = line_end;
+    }
+
+    end = pool->data + chunk->end;
+    while (p < end)
+    {
+        const char *nl = (const char *)memchr(p, '\n', (size_t)(pool->data + pool->size - p));
+        const char *line_end = (nl != NULL) ? nl : (pool->data + pool->size);
+        uint8_t in_chunk = (uint8_t)(p >= pool->data + chunk->begin);
+        uint8_t res;
+
+        res = a_reprocess_parse(p, line_end, &ts, &cond, &temp);
+        p = (nl != NULL) ? (nl + 1) : line_end;
+        if (res == 2)
+        {
+            continue;
+        }
+        if (res != 0)
+        {
+            if (in_chunk != 0)
+            {
+                chunk->invalid++;
+            }
+            continue;
+        }
+
+        {
+            reprocess_record_t r;
+            uint16_t median;
+            uint16_t output;
+            uint8_t outlier;
+            float temperature;
+            float factor;
+
+            /* conversion and filter */
+            output = cond;
+            outlier = 0;
+            if (config->window != 0)
+            {
+                (void)ba121_filter_update(&filter, cond, &median, &output, &outlier);
+            }
+            if (in_chunk == 0)
+            {
+                continue;
+            }
+            chunk->lines++;
+
+            /* compensation */
+            temperature = (float)temp / 100.0f;
+            factor = 1.0f + config->coefficient * (temperature - config->reference);
+            r.key = (config->rollup_ms != 0) ? a_reprocess_floor_div(ts, config->rollup_ms) : ts;
+            r.seq = seq++;
+            r.count = 1;
+            r.outlier = outlier;
+            r.cond_min = output;
+            r.cond_max = output;
+            r.cond_sum = output;
+            r.temp_sum = temperature;
+            r.comp_sum = (factor > 0.0f) ? ((float)output / factor) : (float)output;
+
+            /* rollup consecutive samples of the same bucket in place */
+            if ((config->rollup_ms != 0) && (chunk->record_count != 0) &&
+                (chunk->record[chunk->record_count - 1].key == r.key))
+            {
+                a_reprocess_fold(&chunk->record[chunk->record_count - 1], &r);
+            }
+            else if (a_reprocess_append(chunk, &r, &cap) != 0)
+            {
+                chunk->failed = 1;
+
+                return;
+            }
+        }
+    }
+
+    /* sort the chunk so the merge can stream it */
+    qsort(chunk->record, chunk->record_count, sizeof(reprocess_record_t), a_reprocess_compare);
+
+    /* format per sample output here, so it scales with the workers */
+    if ((config->rollup_ms == 0) && (chunk->record_count != 0))
+    {
+        size_t i;
+
+        cap = chunk->record_count * 40;
+        chunk->text = (char *)malloc(cap);
+        for (i = 0; (chunk->text != NULL) && (i < chunk->record_count); i++)
+        {
+            if (cap - chunk->text_length < REPROCESS_MAX_LINE)
+            {
+                char *t = (char *)realloc(chunk->text, cap * 2);
+
+                if (t == NULL)
+                {
+                    free(chunk->text);
+                    chunk->text = NULL;
+                    chunk->text_length = 0;
+
+                    break;
+                }
+                chunk->text = t;
+                cap *= 2;
+            }
+            chunk->text_length += a_reprocess_format(chunk->text + chunk->text_length, &chunk->record[i], 0);
+        }
+    }
+}
+
+/**
+ * @brief         take a chunk from the own deque
+ * @param[in,out] *deque pointer to a deque
+ * @param[out]    *index pointer to a chunk index buffer
+ * @return        1 if a chunk was taken, otherwise 0
+ * @note          none
+ */
+static uint8_t a_reprocess_pop(reprocess_deque_t *deque, size_t *index)
+{
+    uint8_t res = 0;
+
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->head < deque->tail)
+    {
+        *index = deque->head++;
+        res = 1;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+
+    return res;
+}
+
+/**
+ * @brief         steal a chunk from the far end of another deque
+ * @param[in,out] *deque pointer to a deque
+ * @param[out]    *index pointer to a chunk index buffer
+ * @return        1 if a chunk was stolen, otherwise 0
+ * @note          none
+ */
+static uint8_t a_reprocess_steal(reprocess_deque_t *deque, size_t *index)
+{
+    uint8_t res = 0;
+
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->head < deque->tail)
+    {
+        *index = --deque->tail;
+        res = 1;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+
+    return res;
+}
+
+/**
+ * @brief     worker thread
+ * @param[in] *arg pointer to a worker
+ * @return    NULL
+ * @note      no task creates new tasks, so a worker exits once every deque is empty
+ */
+static void *a_reprocess_worker(void *arg)
+{
+    reprocess_worker_t *worker = (reprocess_worker_t *)arg;
+    reprocess_pool_t *pool = worker->pool;
+    size_t index;
+
+    while (1)
+    {
+        uint32_t i;
+        uint8_t found;
+
+        if (a_reprocess_pop(&pool->deque[worker->id], &index) != 0)
+        {
+            a_reprocess_chunk(pool, index);
+            continue;
+        }
+        found = 0;
+        for (i = 1; i < pool->threads; i++)
+        {
+            if (a_reprocess_steal(&pool->deque[(worker->id + i) % pool->threads], &index) != 0)
+            {
+                worker->stolen++;
+                a_reprocess_chunk(pool, index);
+                found = 1;
+                break;
+            }
+        }
+        if (found == 0)
+        {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief     merge all chunk outputs in time order
+ * @param[in] *pool pointer to a pool
+ * @param[in] chunk_count chunk count
+ * @param[in] *f pointer to an output file
+ * @return    written record count
+ * @note      a binary heap over the chunk heads, rollup buckets split across chunks are folded
+ */
+static uint64_t a_reprocess_merge(reprocess_pool_t *pool, size_t chunk_count, FILE *f)
+{
+    size_t *heap;
+    size_t *pos;
+    size_t n;
+    size_t i;
+    uint64_t written;
+    uint8_t has_pending;
+    reprocess_record_t pending;
+
+    heap = (size_t *)malloc(sizeof(size_t) * (chunk_count + 1));
+    pos = (size_t *)calloc(chunk_count + 1, sizeof(size_t));
+    if ((heap == NULL) || (pos == NULL))
+    {
+        free(heap);
+        free(pos);
+
+        return 0;
+    }
+    n = 0;
+    for (i = 0; i < chunk_count; i++)
+    {
+        size_t c;
+
+        if (pool->chunk[i].record_count == 0)
+        {
+            continue;
+        }
+        c = n++;
+        heap[c] = i;
+        while (c > 0)
+        {
+            size_t parent = (c - 1) / 2;
+            size_t t;
+
+            if (a_reprocess_compare(&pool->chunk[heap[c]].record[0], &pool->chunk[heap[parent]].record[0]) >= 0)
+            {
+                break;
+            }
+            t = heap[c];
+            heap[c] = heap[parent];
+            heap[parent] = t;
+            c = parent;
+        }
+    }
+    written = 0;
+    has_pending = 0;
+    while (n != 0)
+    {
+        size_t top = heap[0];
+        const reprocess_record_t *r = &pool->chunk[top].record[pos[top]];
+        size_t c;
+
+        if ((pool->config->rollup_ms != 0) && (has_pending != 0) && (pending.key == r->key))
+        {
+            a_reprocess_fold(&pending, r);
+        }
+        else
+        {
+            if (has_pending != 0)
+            {
+                a_reprocess_write(f, &pending, pool->config->rollup_ms);
+                written++;
+            }
+            pending = *r;
+            has_pending = 1;
+        }
+
+        /* advance the top chunk and sift down */
+        pos[top]++;
+        if (pos[top] == pool->chunk[top].record_count)
+        {
+            heap[0] = heap[--n];
+        }
+        c = 0;
+        while (1)
+        {
+            size_t l = 2 * c + 1;
+            size_t m = c;
+            size_t t;
+
+            if ((l < n) && (a_reprocess_compare(&pool->chunk[heap[l]].record[pos[heap[l]]],
+                                                &pool->chunk[heap[m]].record[pos[heap[m]]]) < 0))
+            {
+                m = l;
+            }
+            if ((l + 1 < n) && (a_reprocess_compare(&pool->chunk[heap[l + 1]].record[pos[heap[l + 1]]],
+                                                    &pool->chunk[heap[m]].record[pos[heap[m]]]) < 0))
+            {
+                m = l + 1;
+            }
+            if (m == c)
+            {
+                break;
+            }
+            t = heap[c];
+            heap[c] = heap[m];
+            heap[m] = t;
+            c = m;
+        }
+    }
+    if (has_pending != 0)
+    {
+        a_reprocess_write(f, &pending, pool->config->rollup_ms);
+        written++;
+    }
+    free(heap);
+    free(pos);
+
+    return written;
+}
+
+/**
+ * @brief  get the monotonic time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_reprocess_now(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief     reprocess full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+static uint8_t reprocess(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "hi:o:j:";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"input", required_argument, NULL, 'i'},
+        {"output", required_argument, NULL, 'o'},
+        {"threads", required_argument, NULL, 'j'},
+        {"chunk", required_argument, NULL, 1},
+        {"median", required_argument, NULL, 2},
+        {"sigma", required_argument, NULL, 3},
+        {"coefficient", required_argument, NULL, 4},
+        {"reference", required_argument, NULL, 5},
+        {"rollup", required_argument, NULL, 6},
+        {NULL, 0, NULL, 0},
+    };
+    reprocess_config_t config;
+    reprocess_pool_t pool;
+    reprocess_worker_t *worker;
+    pthread_t *tid;
+    const char *input = NULL;
+    const char *output = NULL;
+    long threads;
+    size_t chunk_size = REPROCESS_DEFAULT_CHUNK_SIZE;
+    size_t chunk_count;
+    size_t i;
+    size_t started;
+    struct stat st;
+    uint64_t lines;
+    uint64_t invalid;
+    uint64_t stolen;
+    uint64_t written;
+    double start;
+    uint8_t res;
+    FILE *f;
+    int fd;
+
+    /* default pipeline */
+    config.window = 0;
+    config.sigma = BA121_FILTER_DEFAULT_SIGMA;
+    config.coefficient = 0.02f;
+    config.reference = 25.0f;
+    config.rollup_ms = 0;
+    threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    /* parse */
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                goto help;
+            }
+            case 'i' :
+            {
+                input = optarg;
+
+                break;
+            }
+            case 'o' :
+            {
+                output = optarg;
+
+                break;
+            }
+            case 'j' :
+            {
+                threads = atol(optarg);
+
+                break;
+            }
+            case 1 :
+            {
+                chunk_size = (size_t)strtoull(optarg, NULL, 0);
+
+                break;
+            }
+            case 2 :
+            {
+                long w = atol(optarg);
+
+                if ((w < 0) || (w > BA121_FILTER_MAX_WINDOW))
+                {
+                    return 5;
+                }
+                config.window = (uint8_t)w;
+
+                break;
+            }
+            case 3 :
+            {
+                config.sigma = (float)atof(optarg);
+
+                break;
+            }
+            case 4 :
+            {
+                config.coefficient = (float)atof(optarg);
+
+                break;
+            }
+            case 5 :
+            {
+                config.reference = (float)atof(optarg);
+
+                break;
+            }
+            case 6 :
+            {
+                config.rollup_ms = (uint32_t)strtoul(optarg, NULL, 0);
+
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    if ((input == NULL) || (threads < 1) || (threads > REPROCESS_MAX_THREADS) || (chunk_size < 4096))
+    {
+        return 5;
+    }
+
+    /* map the log */
+    fd = open(input, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("reprocess: open failed");
+
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || (st.st_size == 0))
+    {
+        fprintf(stderr, "reprocess: input is empty.\n");
+        close(fd);
+
+        return 1;
+    }
+    memset(&pool, 0, sizeof(pool));
+    pool.size = (size_t)st.st_size;
+    pool.data = (const char *)mmap(NULL, pool.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pool.data == MAP_FAILED)
+    {
+        perror("reprocess: mmap failed");
+
+        return 1;
+    }
+    (void)madvise((void *)pool.data, pool.size, MADV_SEQUENTIAL);
+    start = a_reprocess_now();
+
+    /* split at line boundaries */
+    chunk_count = (pool.size + chunk_size - 1) / chunk_size;
+    pool.chunk = (reprocess_chunk_t *)calloc(chunk_count, sizeof(reprocess_chunk_t));
+    pool.seq_base = (uint64_t *)calloc(chunk_count, sizeof(uint64_t));
+    pool.deque = (reprocess_deque_t *)calloc((size_t)threads, sizeof(reprocess_deque_t));
+    worker = (reprocess_worker_t *)calloc((size_t)threads, sizeof(reprocess_worker_t));
+    tid = (pthread_t *)calloc((size_t)threads, sizeof(pthread_t));
+    if ((pool.chunk == NULL) || (pool.seq_base == NULL) || (pool.deque == NULL) || (worker == NULL) || (tid == NULL))
+    {
+        fprintf(stderr, "reprocess: out of memory.\n");
+        res = 1;
+
+        goto exit;
+    }
+    {
+        size_t begin = 0;
+        size_t n = 0;
+
+        while (begin < pool.size)
+        {
+            size_t end = begin + chunk_size;
+
+            if (end >= pool.size)
+            {
+                end = pool.size;
+            }
+            else
+            {
+                const char *nl = (const char *)memchr(pool.data + end, '\n', pool.size - end);
+
+                end = (nl != NULL) ? (size_t)(nl - pool.data) + 1 : pool.size;
+            }
+            pool.chunk[n].begin = begin;
+            pool.chunk[n].end = end;
+            pool.seq_base[n] = (uint64_t)begin;                /* a line takes at least one byte, so this keeps the order */
+            n++;
+            begin = end;
+        }
+        chunk_count = n;
+    }
+
+    /* fix the worker count before the ranges are dealt, no more workers than chunks */
+    if ((size_t)threads > chunk_count)
+    {
+        threads = (long)chunk_count;
+    }
+
+    /* deal contiguous ranges to the workers, idle workers steal from the far end */
+    pool.config = &config;
+    pool.threads = (uint32_t)threads;
+    for (i = 0; i < (size_t)threads; i++)
+    {
+        pthread_mutex_init(&pool.deque[i].mutex, NULL);
+        pool.deque[i].head = chunk_count * i / (size_t)threads;
+        pool.deque[i].tail = chunk_count * (i + 1) / (size_t)threads;
+        worker[i].pool = &pool;
+        worker[i].id = (uint32_t)i;
+    }
+    started = 0;
+    for (i = 0; i < (size_t)threads; i++)
+    {
+        if (pthread_create(&tid[i], NULL, a_reprocess_worker, &worker[i]) != 0)
+        {
+            fprintf(stderr, "reprocess: create thread failed, the main thread runs the rest.\n");
+            break;
+        }
+        started++;
+    }
+
+    /* the main thread drains the deques of the workers that did not start */
+    for (i = started; i < (size_t)threads; i++)
+    {
+        (void)a_reprocess_worker(&worker[i]);
+    }
+    lines = 0;
+    invalid = 0;
+    stolen = 0;
+    res = 0;
+    for (i = 0; i < started; i++)
+    {
+        pthread_join(tid[i], NULL);
+    }
+    for (i = 0; i < (size_t)threads; i++)
+    {
+        stolen += worker[i].stolen;
+    }
+    for (i = 0; i < chunk_count; i++)
+    {
+        lines += pool.chunk[i].lines;
+        invalid += pool.chunk[i].invalid;
+        res |= pool.chunk[i].failed;
+    }
+    if (res != 0)
+    {
+        fprintf(stderr, "reprocess: out of memory.\n");
+
+        goto exit;
+    }
+
+    /* merge in time order */
+    f = (output != NULL) ? fopen(output, "w") : stdout;
+    if (f == NULL)
+    {
+        perror("reprocess: open output failed");
+        res = 1;
+
+        goto exit;
+    }
+    (void)setvbuf(f, NULL, _IOFBF, 1 << 20);
+    if (config.rollup_ms != 0)
+    {
+        fprintf(f, "# bucket_ms,count,outliers,conductivity_min,conductivity_mean,conductivity_max,temperature_mean,compensated_mean\n");
+    }
+    else
+    {
+        fprintf(f, "# timestamp_ms,conductivity_us_cm,temperature_c,compensated_us_cm,outlier\n");
+    }
+    if ((config.rollup_ms == 0) && (a_reprocess_in_order(&pool, chunk_count) != 0))
+    {
+        written = 0;
+        for (i = 0; i < chunk_count; i++)
+        {
+            (void)fwrite(pool.chunk[i].text, 1, pool.chunk[i].text_length, f);
+            written += pool.chunk[i].record_count;
+        }
+    }
+    else
+    {
+        written = a_reprocess_merge(&pool, chunk_count, f);
+    }
+    if (f != stdout)
+    {
+        fclose(f);
+    }
+    else
+    {
+        fflush(f);
+    }
+    fprintf(stderr, "reprocess: %llu samples, %llu invalid lines, %llu records, %zu chunks, %u threads, %llu steals, %.3fs.\n",
+            (unsigned long long)lines, (unsigned long long)invalid, (unsigned long long)written,
+            chunk_count, pool.threads, (unsigned long long)stolen, a_reprocess_now() - start);
+
+    exit:
+    if (pool.chunk != NULL)
+    {
+        for (i = 0; i < chunk_count; i++)
+        {
+            free(pool.chunk[i].record);
+            free(pool.chunk[i].text);
+        }
+    }
+    if (pool.deque != NULL)
+    {
+        for (i = 0; i < (size_t)threads; i++)
+        {
+            pthread_mutex_destroy(&pool.deque[i].mutex);
+        }
+    }
+    free(pool.chunk);
+    free(pool.seq_base);
+    free(pool.deque);
+    free(worker);
+    free(tid);
+    (void)munmap((void *)pool.data, pool.size);
+
+    return res;
+
+    help:
+    printf("Usage:\n");
+    printf("  ba121_reprocess (-h | --help)\n");
+    printf("  ba121_reprocess (-i <path> | --input=<path>) [-o <path> | --output=<path>] [-j <num> | --threads=<num>]\n");
+    printf("                  [--chunk=<bytes>] [--median=<window>] [--sigma=<k>] [--coefficient=<a>]\n");
+    printf("                  [--reference=<deg>] [--rollup=<ms>]\n");
+    printf("\n");
+    printf("Input lines are \"timestamp_ms,conductivity_raw,temperature_raw\", '#' starts a comment.\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("      --chunk=<bytes>             Set the chunk size.([default: 4194304])\n");
+    printf("      --coefficient=<a>           Set the compensation coefficient per degree.([default: 0.02])\n");
+    printf("  -h, --help                      Show the help.\n");
+    printf("  -i <path>, --input=<path>       Set the input log.\n");
+    printf("      --median=<window>           Set the median/hampel window, 0 disables it.([default: 0])\n");
+    printf("  -o <path>, --output=<path>      Set the output csv.([default: stdout])\n");
+    printf("      --reference=<deg>           Set the compensation reference temperature.([default: 25])\n");
+    printf("      --rollup=<ms>               Set the rollup period, 0 writes every sample.([default: 0])\n");
+    printf("      --sigma=<k>                 Set the hampel threshold, 0 passes every sample through.([default: 3])\n");
+    printf("  -j <num>, --threads=<num>       Set the worker threads.([default: online cpus])\n");
+
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    uint8_t res;
+
+    res = reprocess(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        fprintf(stderr, "reprocess: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        fprintf(stderr, "reprocess: param is invalid.\n");
+    }
+    else
+    {
+        fprintf(stderr, "reprocess: unknown status code.\n");
+    }
+
+    return (res == 0) ? 0 : 1;
+}
@@ -37,6 +37,8 @@
 #include "driver_ba121_interface.h"
 #include "delay.h"
 #include "uart.h"
+#include "frame.h"
+#include "wait.h"
 #include <stdarg.h>
 
 /**
@@ -70,11 +72,16 @@ uint8_t ba121_interface_uart_deinit(void)
  * @return     status code
  *             - 0 success
  *             - 1 read failed
- * @note       none
+ * @note       with the dma reception only whole frames are returned, a burst lands in the ring at the idle
+ *             event so there is no need to wait for a quiet line
  */
 uint16_t ba121_interface_uart_read(uint8_t *buf, uint16_t len)
 {
+#if (UART2_RX_DMA != 0)
+    return frame_read(uart2_get_ring(), buf, len, NULL);
+#else
     return uart2_read(buf, len);
+#endif
 }
 
 /**
@@ -113,6 +120,148 @@ void ba121_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief     check the reply length
+ * @param[in] need reply length
+ * @return    1 if the reply is in the rx ring
+ * @note      none
+ */
+static uint8_t a_ba121_reply_ready(uint32_t need)
+{
+    return (uint8_t)(ring_count(uart2_get_ring()) >= need);
+}
+
+/**
+ * @brief sleep until the next interrupt
+ * @note  the uart idle or byte interrupt ends it early, the systick at the latest
+ */
+static void a_ba121_sleep(void)
+{
+    __WFI();
+}
+
+/**
+ * @brief wait hooks definition
+ */
+static const wait_t gs_wait =
+{
+    HAL_GetTick,
+    a_ba121_reply_ready,
+    a_ba121_sleep,
+};
+
+/**
+ * @brief     interface wait reply
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the core sleeps with wfi between the interrupts instead of spinning in the delay,
+ *            an rtos port can take a semaphore given by the uart2 rx event instead
+ */
+uint8_t ba121_interface_wait_reply(uint16_t len, uint32_t timeout_ms)
+{
+    return wait_until(&gs_wait, len, timeout_ms);
+}
+
+/**
+ * @brief os lock and semaphore definition
+ */
+static uint32_t gs_os_primask;                  /**< saved primask */
+static volatile uint32_t gs_sem_count;          /**< semaphore count */
+
+/**
+ * @brief interface os lock
+ * @note  bare metal masks the interrupts for the few lines the driver holds it,
+ *        a freertos port takes a mutex with portMAX_DELAY instead
+ */
+void ba121_interface_os_lock(void)
+{
+    uint32_t primask;
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    gs_os_primask = primask;
+}
+
+/**
+ * @brief interface os unlock
+ * @note  none
+ */
+void ba121_interface_os_unlock(void)
+{
+    __set_PRIMASK(gs_os_primask);
+}
+
+/**
+ * @brief     interface os semaphore wait
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      bare metal has one caller so the bus is never taken when it waits,
+ *            a freertos port maps it to xSemaphoreTake on a counting semaphore,
+ *            the primask of the caller is restored, if it masked the interrupts the tick stops
+ *            so only the current count is checked
+ */
+uint8_t ba121_interface_os_sem_wait(uint32_t timeout_ms)
+{
+    uint32_t start;
+    uint32_t primask;
+    
+    start = HAL_GetTick();
+    while (1)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        if (gs_sem_count != 0)
+        {
+            gs_sem_count--;
+            __set_PRIMASK(primask);
+            
+            return 0;
+        }
+        __set_PRIMASK(primask);
+        if ((primask != 0) || ((HAL_GetTick() - start) >= timeout_ms))
+        {
+            return 1;
+        }
+        __WFI();
+    }
+}
+
+/**
+ * @brief interface os semaphore give
+ * @note  called with the os lock held
+ */
+void ba121_interface_os_sem_give(void)
+{
+    gs_sem_count++;
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   the systick counts down from LOAD once per HAL tick,
+ *         the tick is read again if it moved while sampling the counter
+ */
+uint64_t ba121_interface_timestamp_us(void)
+{
+    uint32_t tick;
+    uint32_t val;
+    uint32_t load;
+    
+    load = SysTick->LOAD + 1;
+    do
+    {
+        tick = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (tick != HAL_GetTick());
+    
+    return (uint64_t)tick * 1000ULL + (uint64_t)(load - val) * 1000ULL / load;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
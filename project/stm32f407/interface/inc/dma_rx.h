@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      dma_rx.h
+ * @brief     dma rx header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DMA_RX_H
+#define DMA_RX_H
+
+#include "ring.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup dma_rx dma rx function
+ * @brief    circular dma rx function modules
+ * @{
+ */
+
+/**
+ * @brief dma rx structure definition
+ * @note  follows the write position of a circular dma buffer and moves the new bytes into a ring,
+ *        it has no hal dependency so the host test can drive it
+ */
+typedef struct dma_rx_s
+{
+    const uint8_t *buf;             /**< circular dma buffer */
+    uint32_t size;                  /**< dma buffer size */
+    uint32_t pos;                   /**< first byte not moved yet */
+    ring_t *ring;                   /**< destination ring */
+    volatile uint32_t events;       /**< update calls that moved bytes */
+} dma_rx_t;
+
+/**
+ * @brief     dma rx init
+ * @param[in] *rx pointer to a dma rx structure
+ * @param[in] *buf pointer to the circular dma buffer
+ * @param[in] size dma buffer size
+ * @param[in] *ring pointer to an initialized ring
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      call it before the dma starts, the dma must start at the beginning of the buffer
+ */
+uint8_t dma_rx_init(dma_rx_t *rx, const uint8_t *buf, uint32_t size, ring_t *ring);
+
+/**
+ * @brief     move the bytes written by the dma
+ * @param[in] *rx pointer to a dma rx structure
+ * @param[in] pos dma write position, size - NDTR, from the half, full or idle event
+ * @return    moved length
+ * @note      ring producer side, call it from the dma and idle interrupts only,
+ *            the events must come at least twice per buffer lap or bytes are lost unseen
+ */
+uint32_t dma_rx_update(dma_rx_t *rx, uint32_t pos);
+
+/**
+ * @brief     restart from the beginning of the buffer
+ * @param[in] *rx pointer to a dma rx structure
+ * @note      call it before the dma is restarted after an error
+ */
+void dma_rx_reset(dma_rx_t *rx);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
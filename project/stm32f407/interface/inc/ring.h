@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ring.h
+ * @brief     ring header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ring ring function
+ * @brief    ring function modules
+ * @{
+ */
+
+/**
+ * @brief ring memory barrier definition
+ * @note  orders the data access before the index update, a compiler barrier is enough on one core
+ *        but the host test runs the producer and the consumer on two cores
+ */
+#ifndef RING_BARRIER
+    #if defined(__GNUC__)
+        #define RING_BARRIER()    __atomic_thread_fence(__ATOMIC_SEQ_CST)        /**< gcc and armclang */
+    #elif defined(__ICCARM__)
+        #include <intrinsics.h>
+        #define RING_BARRIER()    __DMB()                                        /**< iar */
+    #elif defined(__CC_ARM)
+        #define RING_BARRIER()    __dmb(0xF)                                     /**< armcc */
+    #else
+        #error "ring: define RING_BARRIER for this compiler"
+    #endif
+#endif
+
+/**
+ * @brief ring structure definition
+ * @note  one producer, usually an interrupt, and one consumer, the indices run freely and wrap at 2^32
+ */
+typedef struct ring_s
+{
+    uint8_t *buf;                     /**< storage */
+    uint32_t mask;                    /**< size - 1 */
+    volatile uint32_t head;           /**< write index, only the producer changes it */
+    volatile uint32_t tail;           /**< read index, only the consumer changes it */
+    volatile uint32_t overflow;       /**< dropped bytes, only the producer changes it */
+} ring_t;
+
+/**
+ * @brief     ring init
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a storage buffer
+ * @param[in] size storage size, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      call it before the producer starts
+ */
+uint8_t ring_init(ring_t *ring, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief     put one byte
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] data one byte
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      producer side, a full ring drops the new byte and counts it
+ */
+uint8_t ring_put(ring_t *ring, uint8_t data);
+
+/**
+ * @brief     write bytes
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    written length
+ * @note      producer side, the bytes that don't fit are dropped and counted
+ */
+uint32_t ring_write(ring_t *ring, const uint8_t *buf, uint32_t len);
+
+/**
+ * @brief      read bytes
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     read length
+ * @note       consumer side, the bytes that don't fit stay in the ring
+ */
+uint32_t ring_read(ring_t *ring, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief      copy bytes without consuming them
+ * @param[in]  *ring pointer to a ring structure
+ * @param[in]  offset offset from the oldest byte
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     copied length
+ * @note       consumer side, lets a frame parser look for a header and a checksum before it consumes
+ */
+uint32_t ring_peek(ring_t *ring, uint32_t offset, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief     consume bytes
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] len length to consume
+ * @return    consumed length
+ * @note      consumer side
+ */
+uint32_t ring_skip(ring_t *ring, uint32_t len);
+
+/**
+ * @brief     get the stored length
+ * @param[in] *ring pointer to a ring structure
+ * @return    stored length
+ * @note      either side, the producer may add bytes right after the call
+ */
+uint32_t ring_count(ring_t *ring);
+
+/**
+ * @brief     drop all stored bytes
+ * @param[in] *ring pointer to a ring structure
+ * @note      consumer side, a byte arriving during the call is either dropped or kept whole
+ */
+void ring_flush(ring_t *ring);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -38,6 +38,8 @@
 #define UART_H
 
 #include "stm32f4xx_hal.h"
+#include "ring.h"
+#include "dma_rx.h"
 
 #ifdef __cplusplus
 extern "C"{
@@ -51,10 +53,25 @@ extern "C"{
 
 /**
  * @brief uart max rx buffer length definition
+ * @note  the rx rings need a power of 2
  */
 #define UART_MAX_LEN        256        /**< uart max len */
 #define UART2_MAX_LEN       512        /**< uart2 max len */
 
+/**
+ * @brief uart2 rx mode definition
+ * @note  1 receives with a circular dma and the idle line interrupt, 0 takes one interrupt per byte
+ */
+#ifndef UART2_RX_DMA
+    #define UART2_RX_DMA        1
+#endif
+
+/**
+ * @brief uart2 dma buffer length definition
+ * @note  the half and full events fire every 32 bytes, well above one ba121 frame
+ */
+#define UART2_DMA_LEN       64        /**< uart2 dma len */
+
 /**
  * @brief     uart init with 8 data bits, 1 stop bit and no parity
  * @param[in] baud baud rate
@@ -90,7 +107,7 @@ uint8_t uart_write(uint8_t *buf, uint16_t len);
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data length
  * @return     length of the read data
- * @note       this function will clear all received buffer even read length is less than received length
+ * @note       bytes beyond len stay in the rx ring for the next read
  */
 uint16_t uart_read(uint8_t *buf, uint16_t len);
 
@@ -117,6 +134,13 @@ uint16_t uart_print(const char *const fmt, ...);
  */
 UART_HandleTypeDef* uart_get_handle(void);
 
+/**
+ * @brief  uart get the rx ring
+ * @return pointer to a ring structure
+ * @note   the interrupt is the producer, the caller becomes the only consumer
+ */
+ring_t* uart_get_ring(void);
+
 /**
  * @brief uart set tx done
  * @note  none
@@ -164,7 +188,7 @@ uint8_t uart2_write(uint8_t *buf, uint16_t len);
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data length
  * @return     length of the read data
- * @note       this function will clear all received buffer even read length is less than received length
+ * @note       bytes beyond len stay in the rx ring for the next read
  */
 uint16_t uart2_read(uint8_t *buf, uint16_t len);
 
@@ -183,6 +207,20 @@ uint16_t uart2_flush(void);
  */
 UART_HandleTypeDef* uart2_get_handle(void);
 
+/**
+ * @brief  uart2 get the rx ring
+ * @return pointer to a ring structure
+ * @note   the interrupt is the producer, the caller becomes the only consumer
+ */
+ring_t* uart2_get_ring(void);
+
+/**
+ * @brief  uart2 get the rx dma handle
+ * @return pointer to a dma handle
+ * @note   the msp links it to the uart2 handle
+ */
+DMA_HandleTypeDef* uart2_get_dma_handle(void);
+
 /**
  * @brief uart2 set tx done
  * @note  none
@@ -195,6 +233,19 @@ void uart2_set_tx_done(void);
  */
 void uart2_irq_handler(void);
 
+/**
+ * @brief     uart2 rx event handler
+ * @param[in] pos dma write position
+ * @note      called from the half, full and idle events of the dma reception
+ */
+void uart2_event_handler(uint16_t pos);
+
+/**
+ * @brief uart2 error handler
+ * @note  restarts the reception an overrun stopped
+ */
+void uart2_error_handler(void);
+
 /**
  * @}
  */
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      frame.c
+ * @brief     frame source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "frame.h"
+#include <stddef.h>
+
+/**
+ * @brief      read whole frames from a ring
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @param[out] *dropped pointer to a dropped length buffer, may be NULL
+ * @return     read length, a multiple of FRAME_LEN
+ * @note       ring consumer side, ba121_frame_sync of the driver checks the next FRAME_LEN bytes,
+ *             bytes that can't start a frame are dropped and a frame still on the wire stays in the ring
+ */
+uint16_t frame_read(ring_t *ring, uint8_t *buf, uint16_t len, uint32_t *dropped)
+{
+    uint16_t n;
+    uint16_t got;
+    uint16_t left;
+    uint32_t skip;
+    
+    n = 0;
+    skip = 0;
+    while ((uint16_t)(len - n) >= FRAME_LEN)
+    {
+        got = (uint16_t)ring_peek(ring, 0, &buf[n], FRAME_LEN);
+        left = got;
+        if (ba121_frame_sync(&buf[n], &left) == 0)
+        {
+            (void)ring_skip(ring, FRAME_LEN);
+            n += FRAME_LEN;
+            
+            continue;
+        }
+        
+        /* less than one frame is buffered, wait for the rest */
+        if (left == got)
+        {
+            break;
+        }
+        skip += ring_skip(ring, got - left);
+    }
+    if (dropped != NULL)
+    {
+        *dropped = skip;
+    }
+    
+    return n;
+}
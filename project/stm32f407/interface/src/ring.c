@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ring.c
+ * @brief     ring source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ring.h"
+#include <stddef.h>
+
+/**
+ * @brief     ring init
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a storage buffer
+ * @param[in] size storage size, a power of 2
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      call it before the producer starts
+ */
+uint8_t ring_init(ring_t *ring, uint8_t *buf, uint32_t size)
+{
+    if ((ring == NULL) || (buf == NULL) || (size < 2) || ((size & (size - 1)) != 0))
+    {
+        return 1;
+    }
+    ring->buf = buf;
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->overflow = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     put one byte
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] data one byte
+ * @return    status code
+ *            - 0 success
+ *            - 1 ring is full
+ * @note      producer side, a full ring drops the new byte and counts it
+ */
+uint8_t ring_put(ring_t *ring, uint8_t data)
+{
+    uint32_t head = ring->head;
+    
+    /* the consumer frees space, so an old tail only underestimates it */
+    if (head - ring->tail > ring->mask)
+    {
+        ring->overflow++;
+        
+        return 1;
+    }
+    ring->buf[head & ring->mask] = data;
+    
+    /* publish the byte after it is stored */
+    RING_BARRIER();
+    ring->head = head + 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     write bytes
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    written length
+ * @note      producer side, the bytes that don't fit are dropped and counted
+ */
+uint32_t ring_write(ring_t *ring, const uint8_t *buf, uint32_t len)
+{
+    uint32_t head = ring->head;
+    uint32_t space;
+    uint32_t i;
+    
+    space = (ring->mask + 1) - (head - ring->tail);
+    if (len > space)
+    {
+        ring->overflow += len - space;
+        len = space;
+    }
+    for (i = 0; i < len; i++)
+    {
+        ring->buf[(head + i) & ring->mask] = buf[i];
+    }
+    RING_BARRIER();
+    ring->head = head + len;
+    
+    return len;
+}
+
+/**
+ * @brief      copy bytes without consuming them
+ * @param[in]  *ring pointer to a ring structure
+ * @param[in]  offset offset from the oldest byte
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     copied length
+ * @note       consumer side, lets a frame parser look for a header and a checksum before it consumes
+ */
+uint32_t ring_peek(ring_t *ring, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    uint32_t tail = ring->tail;
+    uint32_t count;
+    uint32_t i;
+    
+    /* the head is read before the data it covers */
+    count = ring->head - tail;
+    RING_BARRIER();
+    if (offset >= count)
+    {
+        return 0;
+    }
+    count -= offset;
+    len = (len < count) ? len : count;
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = ring->buf[(tail + offset + i) & ring->mask];
+    }
+    
+    return len;
+}
+
+/**
+ * @brief     consume bytes
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] len length to consume
+ * @return    consumed length
+ * @note      consumer side
+ */
+uint32_t ring_skip(ring_t *ring, uint32_t len)
+{
+    uint32_t tail = ring->tail;
+    uint32_t count;
+    
+    count = ring->head - tail;
+    len = (len < count) ? len : count;
+    
+    /* the copies are done before the space is handed back */
+    RING_BARRIER();
+    ring->tail = tail + len;
+    
+    return len;
+}
+
+/**
+ * @brief      read bytes
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len buffer length
+ * @return     read length
+ * @note       consumer side, the bytes that don't fit stay in the ring
+ */
+uint32_t ring_read(ring_t *ring, uint8_t *buf, uint32_t len)
+{
+    len = ring_peek(ring, 0, buf, len);
+    
+    return ring_skip(ring, len);
+}
+
+/**
+ * @brief     get the stored length
+ * @param[in] *ring pointer to a ring structure
+ * @return    stored length
+ * @note      either side, the producer may add bytes right after the call
+ */
+uint32_t ring_count(ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+/**
+ * @brief     drop all stored bytes
+ * @param[in] *ring pointer to a ring structure
+ * @note      consumer side, a byte arriving during the call is either dropped or kept whole
+ */
+void ring_flush(ring_t *ring)
+{
+    ring->tail = ring->head;
+}
@@ -35,6 +35,8 @@
  */
 
 #include "uart.h"
+#include "ring.h"
+#include "dma_rx.h"
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
@@ -45,7 +47,7 @@
 UART_HandleTypeDef g_uart_handle;              /**< uart handle */
 uint8_t g_uart_rx_buffer[UART_MAX_LEN];        /**< uart rx buffer */
 uint8_t g_uart_buffer;                         /**< uart one buffer */
-volatile uint16_t g_uart_point;                /**< uart rx point */
+ring_t g_uart_ring;                            /**< uart rx ring */
 volatile uint8_t g_uart_tx_done;               /**< uart tx done flag */
 
 /**
@@ -54,7 +56,10 @@ volatile uint8_t g_uart_tx_done;               /**< uart tx done flag */
 UART_HandleTypeDef g_uart2_handle;               /**< uart2 handle */
 uint8_t g_uart2_rx_buffer[UART2_MAX_LEN];        /**< uart2 rx buffer */
 uint8_t g_uart2_buffer;                          /**< uart2 one buffer */
-volatile uint16_t g_uart2_point;                 /**< uart2 rx point */
+ring_t g_uart2_ring;                             /**< uart2 rx ring */
+DMA_HandleTypeDef g_uart2_dma_handle;            /**< uart2 rx dma handle */
+uint8_t g_uart2_dma_buffer[UART2_DMA_LEN];       /**< uart2 circular dma buffer */
+dma_rx_t g_uart2_dma_rx;                         /**< uart2 dma position */
 volatile uint8_t g_uart2_tx_done;                /**< uart2 tx done flag */
 
 /**
@@ -76,6 +81,12 @@ uint8_t uart_init(uint32_t baud)
     g_uart_handle.Init.HwFlowCtl = UART_HWCONTROL_NONE;
     g_uart_handle.Init.OverSampling = UART_OVERSAMPLING_16;
     
+    /* the ring is empty before the first interrupt */
+    if (ring_init(&g_uart_ring, g_uart_rx_buffer, UART_MAX_LEN) != 0)
+    {
+        return 1;
+    }
+    
     /* uart init */
     if (HAL_UART_Init(&g_uart_handle) != HAL_OK)
     {
@@ -154,30 +165,21 @@ uint8_t uart_write(uint8_t *buf, uint16_t len)
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data length
  * @return     length of the read data
- * @note       this function will clear all received buffer even read length is less than received length
+ * @note       bytes beyond len stay in the rx ring for the next read
  */
 uint16_t uart_read(uint8_t *buf, uint16_t len)
 {
-    uint16_t read_len;
-    uint16_t g_uart_point_old;
+    uint32_t count;
     
-    /* check receiving */
-    start:
-    g_uart_point_old = g_uart_point;
-    HAL_Delay(1);
-    if (g_uart_point > g_uart_point_old)
+    /* wait until the line is quiet for 1ms */
+    do
     {
-        goto start;
-    }
-    
-    /* copy the data */
-    read_len = (len < g_uart_point) ? len : g_uart_point;
-    memcpy(buf, g_uart_rx_buffer, read_len);
-    
-    /* clear the buffer */
-    g_uart_point = 0;
+        count = ring_count(&g_uart_ring);
+        HAL_Delay(1);
+    } while (ring_count(&g_uart_ring) != count);
     
-    return read_len;
+    /* take the oldest bytes, the rest stays for the next read */
+    return (uint16_t)ring_read(&g_uart_ring, buf, len);
 }
 
 /**
@@ -189,7 +191,7 @@ uint16_t uart_read(uint8_t *buf, uint16_t len)
 uint16_t uart_flush(void)
 {
     /* clear the buffer */
-    g_uart_point = 0;
+    ring_flush(&g_uart_ring);
     
     return 0;
 }
@@ -243,17 +245,35 @@ uint8_t uart2_init(uint32_t baud)
     g_uart2_handle.Init.HwFlowCtl = UART_HWCONTROL_NONE;
     g_uart2_handle.Init.OverSampling = UART_OVERSAMPLING_16;
     
+    /* the ring is empty before the first interrupt */
+    if (ring_init(&g_uart2_ring, g_uart2_rx_buffer, UART2_MAX_LEN) != 0)
+    {
+        return 1;
+    }
+    if (dma_rx_init(&g_uart2_dma_rx, g_uart2_dma_buffer, UART2_DMA_LEN, &g_uart2_ring) != 0)
+    {
+        return 1;
+    }
+    
     /* uart init */
     if (HAL_UART_Init(&g_uart2_handle) != HAL_OK)
     {
         return 1;
     }
     
+#if (UART2_RX_DMA != 0)
+    /* receive into the circular dma, the half, full and idle events move the bytes */
+    if (HAL_UARTEx_ReceiveToIdle_DMA(&g_uart2_handle, g_uart2_dma_buffer, UART2_DMA_LEN) != HAL_OK)
+    {
+        return 1;
+    }
+#else
     /* receive one byte */
     if (HAL_UART_Receive_IT(&g_uart2_handle, (uint8_t *)&g_uart2_buffer, 1) != HAL_OK)
     {
         return 1;
     }
+#endif
     
     return 0;
 }
@@ -321,30 +341,21 @@ uint8_t uart2_write(uint8_t *buf, uint16_t len)
  * @param[out] *buf pointer to a data buffer
  * @param[in]  len data length
  * @return     length of the read data
- * @note       this function will clear all received buffer even read length is less than received length
+ * @note       bytes beyond len stay in the rx ring for the next read
  */
 uint16_t uart2_read(uint8_t *buf, uint16_t len)
 {
-    uint16_t read_len;
-    uint16_t g_uart_point_old;
+    uint32_t count;
     
-    /* check receiving */
-    start:
-    g_uart_point_old = g_uart2_point;
-    HAL_Delay(1);
-    if (g_uart2_point > g_uart_point_old)
+    /* wait until the line is quiet for 1ms */
+    do
     {
-        goto start;
-    }
-    
-    /* copy the data */
-    read_len = (len < g_uart2_point) ? len : g_uart2_point;
-    memcpy(buf, g_uart2_rx_buffer, read_len);
-    
-    /* clear the buffer */
-    g_uart2_point = 0;
+        count = ring_count(&g_uart2_ring);
+        HAL_Delay(1);
+    } while (ring_count(&g_uart2_ring) != count);
     
-    return read_len;
+    /* take the oldest bytes, the rest stays for the next read */
+    return (uint16_t)ring_read(&g_uart2_ring, buf, len);
 }
 
 /**
@@ -355,8 +366,18 @@ uint16_t uart2_read(uint8_t *buf, uint16_t len)
  */
 uint16_t uart2_flush(void)
 {
+#if (UART2_RX_DMA != 0)
+    uint32_t primask;
+    
+    /* move the bytes of an unfinished burst as well, with the events masked */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    (void)dma_rx_update(&g_uart2_dma_rx, UART2_DMA_LEN - __HAL_DMA_GET_COUNTER(&g_uart2_dma_handle));
+    __set_PRIMASK(primask);
+#endif
+    
     /* clear the buffer */
-    g_uart2_point = 0;
+    ring_flush(&g_uart2_ring);
     
     return 0;
 }
@@ -381,6 +402,36 @@ UART_HandleTypeDef* uart2_get_handle(void)
     return &g_uart2_handle;
 }
 
+/**
+ * @brief  uart2 get the rx dma handle
+ * @return pointer to a dma handle
+ * @note   the msp links it to the uart2 handle
+ */
+DMA_HandleTypeDef* uart2_get_dma_handle(void)
+{
+    return &g_uart2_dma_handle;
+}
+
+/**
+ * @brief  uart get the rx ring
+ * @return pointer to a ring structure
+ * @note   the interrupt is the producer, the caller becomes the only consumer
+ */
+ring_t* uart_get_ring(void)
+{
+    return &g_uart_ring;
+}
+
+/**
+ * @brief  uart2 get the rx ring
+ * @return pointer to a ring structure
+ * @note   the interrupt is the producer, the caller becomes the only consumer
+ */
+ring_t* uart2_get_ring(void)
+{
+    return &g_uart2_ring;
+}
+
 /**
  * @brief uart set tx done
  * @note  none
@@ -405,13 +456,8 @@ void uart2_set_tx_done(void)
  */
 void uart_irq_handler(void)
 {
-    /* save one byte */
-    g_uart_rx_buffer[g_uart_point] = g_uart_buffer;
-    g_uart_point++;
-    if (g_uart_point > (UART_MAX_LEN - 1))
-    {
-        g_uart_point = 0;
-    }
+    /* save one byte, a full ring drops it */
+    (void)ring_put(&g_uart_ring, g_uart_buffer);
     
     /* receive one byte */
     (void)HAL_UART_Receive_IT(&g_uart_handle, (uint8_t *)&g_uart_buffer, 1);
@@ -423,14 +469,43 @@ void uart_irq_handler(void)
  */
 void uart2_irq_handler(void)
 {
-    /* save one byte */
-    g_uart2_rx_buffer[g_uart2_point] = g_uart2_buffer;
-    g_uart2_point++;
-    if (g_uart2_point > (UART2_MAX_LEN - 1))
+    /* save one byte, a full ring drops it */
+    (void)ring_put(&g_uart2_ring, g_uart2_buffer);
+    
+    /* receive one byte */
+    (void)HAL_UART_Receive_IT(&g_uart2_handle, (uint8_t *)&g_uart2_buffer, 1);
+}
+
+/**
+ * @brief     uart2 rx event handler
+ * @param[in] pos dma write position
+ * @note      called from the half, full and idle events of the dma reception
+ */
+void uart2_event_handler(uint16_t pos)
+{
+    /* move the new bytes, a full ring drops them */
+    (void)dma_rx_update(&g_uart2_dma_rx, pos);
+}
+
+/**
+ * @brief uart2 error handler
+ * @note  restarts the reception an overrun stopped
+ */
+void uart2_error_handler(void)
+{
+    /* a noise or framing error keeps the reception running */
+    if (g_uart2_handle.RxState != HAL_UART_STATE_READY)
     {
-        g_uart2_point = 0;
+        return;
     }
     
+#if (UART2_RX_DMA != 0)
+    /* keep the bytes before the error, then start over at the beginning of the buffer */
+    (void)dma_rx_update(&g_uart2_dma_rx, UART2_DMA_LEN - __HAL_DMA_GET_COUNTER(&g_uart2_dma_handle));
+    dma_rx_reset(&g_uart2_dma_rx);
+    (void)HAL_UARTEx_ReceiveToIdle_DMA(&g_uart2_handle, g_uart2_dma_buffer, UART2_DMA_LEN);
+#else
     /* receive one byte */
     (void)HAL_UART_Receive_IT(&g_uart2_handle, (uint8_t *)&g_uart2_buffer, 1);
+#endif
 }
@@ -114,6 +114,12 @@ void USART1_IRQHandler(void);
  */
 void USART2_IRQHandler(void);
 
+/**
+ * @brief dma1 stream5 irq handler
+ * @note  usart2 rx
+ */
+void DMA1_Stream5_IRQHandler(void);
+
 /**
  * @}
  */
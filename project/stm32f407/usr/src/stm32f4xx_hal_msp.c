@@ -35,6 +35,7 @@
  */
 
 #include "stm32f4xx_hal.h"
+#include "uart.h"
 
 /** 
  * @defgroup msp HAL_MSP_Private_Functions
@@ -67,6 +68,9 @@ void HAL_MspDeInit(void)
 void HAL_UART_MspInit(UART_HandleTypeDef *huart)
 {
     GPIO_InitTypeDef GPIO_InitStruct;
+#if (UART2_RX_DMA != 0)
+    DMA_HandleTypeDef *hdma;
+#endif
     
     if (huart->Instance == USART1)
     {
@@ -110,6 +114,32 @@ void HAL_UART_MspInit(UART_HandleTypeDef *huart)
         GPIO_InitStruct.Alternate = GPIO_AF7_USART2;
         HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
         
+#if (UART2_RX_DMA != 0)
+        /* enable dma1 clock */
+        __HAL_RCC_DMA1_CLK_ENABLE();
+        
+        /**
+         * DMA1 Stream5 Channel4 ------> USART2_RX
+         */
+        hdma = uart2_get_dma_handle();
+        hdma->Instance = DMA1_Stream5;
+        hdma->Init.Channel = DMA_CHANNEL_4;
+        hdma->Init.Direction = DMA_PERIPH_TO_MEMORY;
+        hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+        hdma->Init.MemInc = DMA_MINC_ENABLE;
+        hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+        hdma->Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+        hdma->Init.Mode = DMA_CIRCULAR;
+        hdma->Init.Priority = DMA_PRIORITY_MEDIUM;
+        hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+        (void)HAL_DMA_Init(hdma);
+        __HAL_LINKDMA(huart, hdmarx, *hdma);
+        
+        /* enable dma nvic */
+        HAL_NVIC_SetPriority(DMA1_Stream5_IRQn, 2, 0);
+        HAL_NVIC_EnableIRQ(DMA1_Stream5_IRQn);
+#endif
+        
         /* enable nvic */
         HAL_NVIC_SetPriority(USART2_IRQn, 2, 0);
         HAL_NVIC_EnableIRQ(USART2_IRQn);
@@ -142,6 +172,12 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* huart)
         /* uart gpio deinit */
         HAL_GPIO_DeInit(GPIOA, GPIO_PIN_2 | GPIO_PIN_3);
         
+#if (UART2_RX_DMA != 0)
+        /* dma deinit */
+        (void)HAL_DMA_DeInit(huart->hdmarx);
+        HAL_NVIC_DisableIRQ(DMA1_Stream5_IRQn);
+#endif
+        
         /* disable nvic */
         HAL_NVIC_DisableIRQ(USART2_IRQn);
     }
@@ -164,6 +164,15 @@ void USART2_IRQHandler(void)
     HAL_UART_IRQHandler(uart2_get_handle());
 }
 
+/**
+ * @brief dma1 stream5 irq handler
+ * @note  usart2 rx
+ */
+void DMA1_Stream5_IRQHandler(void)
+{
+    HAL_DMA_IRQHandler(uart2_get_dma_handle());
+}
+
 /**
  * @brief     uart error callback
  * @param[in] *huart pointer to a uart handle
@@ -172,6 +181,11 @@ void USART2_IRQHandler(void)
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
     __HAL_UART_CLEAR_FEFLAG(huart);
+    if (huart->Instance == USART2)
+    {
+        /* restart a stopped reception */
+        uart2_error_handler();
+    }
 }
 
 /**
@@ -193,6 +207,21 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
     }
 }
 
+/**
+ * @brief     uart rx event callback
+ * @param[in] *huart pointer to a uart handle
+ * @param[in] size dma write position
+ * @note      the half, full and idle events of a dma reception
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size)
+{
+    if (huart->Instance == USART2)
+    {
+        /* run the uart2 event handler */
+        uart2_event_handler(size);
+    }
+}
+
 /**
  * @brief     uart tx finished callback
  * @param[in] *huart pointer to a uart handle
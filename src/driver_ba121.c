@@ -35,6 +35,10 @@
  */
 
 #include "driver_ba121.h"
+#include "driver_ba121_frame.h"
+#if (BA121_STATIC_LINK == 1)
+#include "driver_ba121_interface.h"
+#endif
 
 /**
  * @brief chip information definition
@@ -49,24 +53,98 @@
 #define DRIVER_VERSION            1000                   /**< driver version */
 
 /**
- * @brief chip command definition
+ * @brief bus wait margin definition
  */
-#define BA121_COMMAND_READ        0xA0        /**< read command */
-#define BA121_COMMAND_BASELINE    0xA6        /**< baseline command */
-#define BA121_COMMAND_NTC_RES     0xA3        /**< ntc resistance command */
-#define BA121_COMMAND_NTC_B       0xA5        /**< ntc b command */
+#define BA121_BUS_MARGIN_MS       1000        /**< added to the longest owner time */
+
+#if (BA121_QUEUE_ENABLE == 1)
+
+/**
+ * @brief queue entry state definition
+ */
+#define BA121_QUEUE_FREE          0           /**< free */
+#define BA121_QUEUE_QUEUED        1           /**< waiting to be sent */
+#define BA121_QUEUE_IN_FLIGHT     2           /**< waiting for the reply */
+
+/**
+ * @brief queue entry kind definition
+ */
+#define BA121_QUEUE_KIND_QUEUE    0           /**< queue callback */
+#define BA121_QUEUE_KIND_READ     1           /**< async read callback */
+#define BA121_QUEUE_KIND_DONE     2           /**< async command callback */
+
+#endif
+
+/**
+ * @brief link function call definition
+ */
+#if (BA121_STATIC_LINK == 1)
+    #define BA121_UART_INIT(HANDLE)               ((void)(HANDLE), ba121_interface_uart_init())                 /**< uart init */
+    #define BA121_UART_DEINIT(HANDLE)             ((void)(HANDLE), ba121_interface_uart_deinit())               /**< uart deinit */
+    #define BA121_UART_READ(HANDLE, BUF, LEN)     ((void)(HANDLE), ba121_interface_uart_read(BUF, LEN))         /**< uart read */
+    #define BA121_UART_FLUSH(HANDLE)              ((void)(HANDLE), ba121_interface_uart_flush())                /**< uart flush */
+    #define BA121_UART_WRITE(HANDLE, BUF, LEN)    ((void)(HANDLE), ba121_interface_uart_write(BUF, LEN))        /**< uart write */
+    #define BA121_DELAY_MS(HANDLE, MS)            ((void)(HANDLE), ba121_interface_delay_ms(MS))                /**< delay ms */
+    #define BA121_DEBUG_PRINT(HANDLE, ...)        ((void)(HANDLE), ba121_interface_debug_print(__VA_ARGS__))    /**< debug print */
+#if (BA121_STATIC_TIMESTAMP == 1)
+    #define BA121_TIMESTAMP_US(HANDLE)            ((void)(HANDLE), ba121_interface_timestamp_us())              /**< timestamp us */
+#else
+    #define BA121_TIMESTAMP_US(HANDLE)            ((void)(HANDLE), (uint64_t)0)                                 /**< no time */
+#endif
+#if (BA121_STATIC_WAIT_REPLY == 1)
+    #define BA121_WAIT_LINKED(HANDLE)             ((void)(HANDLE), 1)                                           /**< wait linked */
+    #define BA121_WAIT_REPLY(HANDLE, LEN, MS)     ((void)(HANDLE), ba121_interface_wait_reply(LEN, MS))         /**< wait reply */
+#else
+    #define BA121_WAIT_LINKED(HANDLE)             ((void)(HANDLE), 0)                                           /**< no wait */
+    #define BA121_WAIT_REPLY(HANDLE, LEN, MS)     ((void)(HANDLE), (uint8_t)1)                                  /**< no wait */
+#endif
+#if (BA121_STATIC_OS == 1)
+    #define BA121_OS_LINKED(HANDLE)               ((void)(HANDLE), 1)                                           /**< os linked */
+    #define BA121_OS_LOCK(HANDLE)                 ((void)(HANDLE), ba121_interface_os_lock())                   /**< os lock */
+    #define BA121_OS_UNLOCK(HANDLE)               ((void)(HANDLE), ba121_interface_os_unlock())                 /**< os unlock */
+    #define BA121_OS_SEM_WAIT(HANDLE, MS)         ((void)(HANDLE), ba121_interface_os_sem_wait(MS))             /**< os sem wait */
+    #define BA121_OS_SEM_GIVE(HANDLE)             ((void)(HANDLE), ba121_interface_os_sem_give())               /**< os sem give */
+#endif
+#else
+    #define BA121_UART_INIT(HANDLE)               ((HANDLE)->uart_init())                                       /**< uart init */
+    #define BA121_UART_DEINIT(HANDLE)             ((HANDLE)->uart_deinit())                                     /**< uart deinit */
+    #define BA121_UART_READ(HANDLE, BUF, LEN)     ((HANDLE)->uart_read(BUF, LEN))                               /**< uart read */
+    #define BA121_UART_FLUSH(HANDLE)              ((HANDLE)->uart_flush())                                      /**< uart flush */
+    #define BA121_UART_WRITE(HANDLE, BUF, LEN)    ((HANDLE)->uart_write(BUF, LEN))                              /**< uart write */
+    #define BA121_DELAY_MS(HANDLE, MS)            ((HANDLE)->delay_ms(MS))                                      /**< delay ms */
+    #define BA121_DEBUG_PRINT(HANDLE, ...)        ((HANDLE)->debug_print(__VA_ARGS__))                          /**< debug print */
+    #define BA121_TIMESTAMP_US(HANDLE)            (((HANDLE)->timestamp_us != NULL) ? \
+                                                   (HANDLE)->timestamp_us() : 0)                                /**< timestamp us */
+    #define BA121_WAIT_LINKED(HANDLE)             ((HANDLE)->wait_reply != NULL)                                /**< wait linked */
+    #define BA121_WAIT_REPLY(HANDLE, LEN, MS)     ((HANDLE)->wait_reply(LEN, MS))                               /**< wait reply */
+    #define BA121_OS_LINKED(HANDLE)               (((HANDLE)->os_lock != NULL) && ((HANDLE)->os_unlock != NULL) && \
+                                                   ((HANDLE)->os_sem_wait != NULL) && \
+                                                   ((HANDLE)->os_sem_give != NULL))                             /**< os linked */
+    #define BA121_OS_LOCK(HANDLE)                 ((HANDLE)->os_lock())                                         /**< os lock */
+    #define BA121_OS_UNLOCK(HANDLE)               ((HANDLE)->os_unlock())                                       /**< os unlock */
+    #define BA121_OS_SEM_WAIT(HANDLE, MS)         ((HANDLE)->os_sem_wait(MS))                                   /**< os sem wait */
+    #define BA121_OS_SEM_GIVE(HANDLE)             ((HANDLE)->os_sem_give())                                     /**< os sem give */
+#endif
+
+/**
+ * @brief     get the current time
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    time in us, 0 without a timestamp function
+ * @note      none
+ */
+static uint64_t a_ba121_now_us(ba121_handle_t *handle)
+{
+    return BA121_TIMESTAMP_US(handle);      /* get time */
+}
 
 /**
  * @brief      make frame
  * @param[in]  command input command
  * @param[in]  data input data
  * @param[out] *output pointer to an output buffer
- * @return     status code
- *             - 0 success
- *             - 1 make frame failed
  * @note       none
  */
-static uint8_t a_ba121_make_frame(uint8_t command, uint32_t data, uint8_t output[6])
+void ba121_frame_make(uint8_t command, uint32_t data, uint8_t output[6])
 {
     uint8_t i;
     uint16_t sum;
@@ -83,8 +161,75 @@ static uint8_t a_ba121_make_frame(uint8_t command, uint32_t data, uint8_t output
         sum += output[i];                   /* sum */
     }
     output[5] = sum & 0xFF;                 /* set sum */
+}
+
+/**
+ * @brief      parse frame
+ * @param[in]  *input pointer to an input buffer
+ * @param[in]  header expected frame header
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 checksum error
+ *             - 2 frame header invalid
+ * @note       none
+ */
+uint8_t ba121_frame_parse(const uint8_t input[6], uint8_t header, uint32_t *data)
+{
+    uint8_t i;
+    uint16_t sum;
+    
+    sum = 0;                                                              /* init 0 */
+    for (i = 0; i < 5; i++)                                               /* add all */
+    {
+        sum += input[i];                                                  /* sum */
+    }
+    if ((sum & 0xFF) != input[5])                                         /* check sum */
+    {
+        return 1;                                                         /* return error */
+    }
+    if (input[0] != header)                                               /* check frame header */
+    {
+        return 2;                                                         /* return error */
+    }
+    *data = ((uint32_t)input[1] << 24) | ((uint32_t)input[2] << 16) | 
+            ((uint32_t)input[3] << 8) | ((uint32_t)input[4] << 0);        /* get data */
+    
+    return 0;                                                             /* success return 0 */
+}
+
+/**
+ * @brief         find the first reply frame in a byte stream
+ * @param[in,out] *buf pointer to a stream buffer
+ * @param[in,out] *len pointer to a stream length buffer
+ * @return        status code
+ *                - 0 a frame starts at buf[0]
+ *                - 1 less than one frame left
+ * @note          bytes that don't start a data or ack frame with a good checksum are dropped one by one,
+ *                the frame itself stays in the buffer
+ */
+uint8_t ba121_frame_sync(uint8_t *buf, uint16_t *len)
+{
+    uint8_t i;
+    uint16_t sum;
     
-    return 0;                               /* success return 0 */
+    while (*len >= BA121_FRAME_LEN)                                       /* one frame at least */
+    {
+        sum = 0;                                                          /* init 0 */
+        for (i = 0; i < 5; i++)                                           /* add all */
+        {
+            sum += buf[i];                                                /* sum */
+        }
+        if (((buf[0] == BA121_FRAME_DATA) || (buf[0] == BA121_FRAME_ACK)) &&
+            ((sum & 0xFF) == buf[5]))                                     /* check frame */
+        {
+            return 0;                                                     /* found */
+        }
+        (*len)--;                                                         /* drop one byte */
+        memmove(buf, &buf[1], *len);                                      /* resync */
+    }
+    
+    return 1;                                                             /* need more bytes */
 }
 
 /**
@@ -99,171 +244,1289 @@ static uint8_t a_ba121_make_frame(uint8_t command, uint32_t data, uint8_t output
  * @note       none
  */
 static uint8_t a_ba121_parse_frame(ba121_handle_t *handle, uint8_t is_data, uint8_t input[6], uint32_t *data)
+{
+    uint8_t res;
+    
+    res = ba121_frame_parse(input, (is_data != 0) ? BA121_FRAME_DATA : BA121_FRAME_ACK, data);        /* parse */
+    if (res == 1)                                                                                     /* check sum */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: checksum error.\n");                                        /* checksum error */
+        
+        return 1;                                                                                     /* return error */
+    }
+    if (res != 0)                                                                                     /* check frame header */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: frame header invalid.\n");                                  /* frame header invalid */
+        
+        return 1;                                                                                     /* return error */
+    }
+    
+    return 0;                                                                                         /* success return 0 */
+}
+
+#if (BA121_QUEUE_ENABLE == 1)
+
+/**
+ * @brief     check whether the queue has commands
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    1 if busy, otherwise 0
+ * @note      none
+ */
+static uint8_t a_ba121_queue_busy(ba121_handle_t *handle)
 {
     uint8_t i;
-    uint16_t sum;
     
-    sum = 0;                                                                   /* init 0 */
-    for (i = 0; i < 5; i++)                                                    /* add all */
+    for (i = 0; i < BA121_QUEUE_DEPTH; i++)                                      /* all entries */
     {
-        sum += input[i];                                                       /* sum */
+        if (handle->queue[i].state != BA121_QUEUE_FREE)                          /* check state */
+        {
+            return 1;                                                            /* busy */
+        }
     }
-    if ((sum & 0xFF) != input[5])                                              /* check sum */
+    
+    return 0;                                                                    /* idle */
+}
+
+/**
+ * @brief     find the oldest entry
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] is_data bool value, data reply or ack reply
+ * @param[in] state entry state
+ * @return    entry index, BA121_QUEUE_DEPTH if none
+ * @note      none
+ */
+static uint8_t a_ba121_queue_find(ba121_handle_t *handle, uint8_t is_data, uint8_t state)
+{
+    uint8_t i;
+    uint8_t index;
+    
+    index = BA121_QUEUE_DEPTH;                                                   /* none */
+    for (i = 0; i < BA121_QUEUE_DEPTH; i++)                                      /* all entries */
     {
-        handle->debug_print("ba121: checksum error.\n");                       /* checksum error */
+        ba121_queue_entry_t *entry = &handle->queue[i];
         
-        return 1;                                                              /* return error */
+        if ((entry->state != state) ||
+            ((uint8_t)(entry->command == BA121_COMMAND_READ) != is_data))        /* check state and reply type */
+        {
+            continue;                                                            /* next */
+        }
+        if ((index == BA121_QUEUE_DEPTH) ||
+            ((int32_t)(entry->seq - handle->queue[index].seq) < 0))              /* older */
+        {
+            index = i;                                                           /* save index */
+        }
+    }
+    
+    return index;                                                                /* return index */
+}
+
+/**
+ * @brief     run the completion callback of an entry
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] *entry pointer to a copy of the finished entry
+ * @param[in] res status code
+ * @param[in] data reply data
+ * @note      none
+ */
+static void a_ba121_queue_dispatch(ba121_handle_t *handle, const ba121_queue_entry_t *entry, uint8_t res, uint32_t data)
+{
+    uint16_t conductivity_raw;
+    uint16_t temperature_raw;
+    
+    if (entry->kind == BA121_QUEUE_KIND_READ)                                    /* async read */
+    {
+        conductivity_raw = (res == 0) ? (uint16_t)((data >> 16) & 0xFFFFU) : 0;  /* set conductivity raw */
+        temperature_raw = (res == 0) ? (uint16_t)((data >> 0) & 0xFFFFU) : 0;    /* set temperature raw */
+        entry->async.read(handle, res, conductivity_raw, conductivity_raw, temperature_raw,
+                          (float)temperature_raw / 100.0f, entry->user);         /* run callback */
     }
-    if (is_data != 0)                                                          /* is data */
+    else if (entry->kind == BA121_QUEUE_KIND_DONE)                               /* async command */
     {
-        if (input[0] != 0xAA)                                                  /* check frame header */
+        if (entry->async.done != NULL)                                           /* check callback */
         {
-            handle->debug_print("ba121: frame header invalid.\n");             /* frame header invalid */
-            
-            return 1;                                                          /* return error */
+            entry->async.done(handle, res, entry->user);                         /* run callback */
         }
-        *data = ((uint32_t)input[1] << 24) | ((uint32_t)input[2] << 16) | 
-                ((uint32_t)input[3] << 8) | ((uint32_t)input[4] << 0);         /* get data */
     }
-    else
+    else                                                                         /* queue */
+    {
+        if (entry->callback != NULL)                                             /* check callback */
+        {
+            entry->callback(handle, entry->command, res, data, entry->user);     /* run callback */
+        }
+    }
+}
+
+/**
+ * @brief     add an entry to the queue
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] command queued command
+ * @param[in] param command data
+ * @param[in] kind callback kind
+ * @return    entry pointer, NULL if the queue is full
+ * @note      none
+ */
+static ba121_queue_entry_t *a_ba121_queue_push(ba121_handle_t *handle, uint8_t command, uint32_t param, uint8_t kind)
+{
+    uint8_t i;
+    
+    for (i = 0; i < BA121_QUEUE_DEPTH; i++)                                      /* find a free entry */
     {
-        if (input[0] != 0xAC)                                                  /* check frame header */
+        ba121_queue_entry_t *entry = &handle->queue[i];
+        
+        if (entry->state == BA121_QUEUE_FREE)                                    /* free */
         {
-            handle->debug_print("ba121: frame header invalid.\n");             /* frame header invalid */
+            memset(entry, 0, sizeof(ba121_queue_entry_t));                       /* clear entry */
+            entry->param = param;                                                /* set param */
+            entry->seq = handle->queue_seq++;                                    /* set order */
+            entry->command = command;                                            /* set command */
+            entry->kind = kind;                                                  /* set kind */
+            entry->state = BA121_QUEUE_QUEUED;                                   /* queued, send at once */
             
-            return 1;                                                          /* return error */
+            return entry;                                                        /* return entry */
         }
-        *data = ((uint32_t)input[1] << 24) | ((uint32_t)input[2] << 26) | 
-                ((uint32_t)input[3] << 8) | ((uint32_t)input[4] << 0);         /* get data */
     }
+    BA121_DEBUG_PRINT(handle, "ba121: queue is full.\n");                        /* queue is full */
     
-    return 0;                                                                  /* success return 0 */
+    return NULL;                                                                 /* return error */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     finish a queued command
  * @param[in] *handle pointer to a ba121 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 uart initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
+ * @param[in] index entry index
+ * @param[in] res status code
+ * @param[in] data reply data
+ * @param[in] now_ms current time in ms
+ * @note      a failed command goes back to the queue while the retry policy allows it
+ */
+static void a_ba121_queue_complete(ba121_handle_t *handle, uint8_t index, uint8_t res, uint32_t data, uint32_t now_ms)
+{
+    ba121_queue_entry_t *entry;
+    ba121_queue_entry_t done;
+    uint8_t attempts;
+    uint8_t mask;
+    uint32_t backoff;
+    uint8_t i;
+    
+    entry = &handle->queue[index];                                               /* get entry */
+    attempts = (handle->retry_attempts != 0) ? handle->retry_attempts : 1;       /* at least one attempt */
+    mask = (res == 1) ? BA121_RETRY_LINK_ERROR : BA121_RETRY_RESPONSE_ERROR;     /* error class */
+    if ((res != 0) && (entry->attempts < attempts) &&
+        ((handle->retry_mask & mask) != 0))                                      /* check policy */
+    {
+        backoff = handle->retry_backoff_ms;                                      /* initial backoff */
+        for (i = 1; (i < entry->attempts) && (backoff < handle->retry_max_backoff_ms); i++)
+        {
+            backoff *= 2;                                                        /* double */
+        }
+        if (backoff > handle->retry_max_backoff_ms)                              /* check max */
+        {
+            backoff = handle->retry_max_backoff_ms;                              /* clamp */
+        }
+        BA121_DEBUG_PRINT(handle, "ba121: retry after %dms.\n", (int)backoff);   /* retry */
+        entry->state = BA121_QUEUE_QUEUED;                                       /* queue again */
+        entry->time_ms = now_ms + backoff;                                       /* earliest send time */
+        
+        return;                                                                  /* return */
+    }
+    
+    done = *entry;                                                               /* save entry */
+    handle->last_attempts = entry->attempts;                                     /* save attempts */
+    entry->state = BA121_QUEUE_FREE;                                             /* free entry before the callback */
+    a_ba121_queue_dispatch(handle, &done, res, data);                            /* run callback */
+}
+
+/**
+ * @brief     drain the reply stream
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
+ * @note      bytes that don't start a valid frame are dropped one by one to resynchronise
+ */
+static void a_ba121_queue_receive(ba121_handle_t *handle, uint32_t now_ms)
+{
+    uint8_t n;
+    uint16_t len;
+    uint16_t rx_len;
+    uint32_t data;
+    
+    for (n = 0; n < 8; n++)                                                      /* bounded drain */
+    {
+        len = BA121_UART_READ(handle, &handle->rx_buf[handle->rx_len],
+                                (uint16_t)(sizeof(handle->rx_buf) - handle->rx_len));
+        rx_len = (uint16_t)(handle->rx_len + len);                               /* append */
+        while (ba121_frame_sync(handle->rx_buf, &rx_len) == 0)                   /* resync to a frame */
+        {
+            uint8_t *frame = handle->rx_buf;
+            uint8_t is_data;
+            uint8_t index;
+            
+            is_data = (uint8_t)(frame[0] == BA121_FRAME_DATA);                   /* reply type */
+            data = ((uint32_t)frame[1] << 24) | ((uint32_t)frame[2] << 16) |
+                   ((uint32_t)frame[3] << 8) | ((uint32_t)frame[4] << 0);        /* get data */
+            rx_len -= BA121_FRAME_LEN;                                           /* consume frame */
+            memmove(handle->rx_buf, &handle->rx_buf[BA121_FRAME_LEN], rx_len);   /* move */
+            handle->rx_len = (uint8_t)rx_len;                                    /* save before the callback */
+            index = a_ba121_queue_find(handle, is_data, BA121_QUEUE_IN_FLIGHT);  /* find the command */
+            if (index == BA121_QUEUE_DEPTH)                                      /* check index */
+            {
+                BA121_DEBUG_PRINT(handle, "ba121: unexpected frame.\n");         /* unexpected frame */
+                
+                continue;                                                        /* next */
+            }
+            handle->last_tx_us = handle->queue[index].tx_us;                     /* transmit time */
+            handle->last_rx_us = a_ba121_now_us(handle);                         /* stamp arrival */
+            if (is_data != 0)                                                    /* data reply */
+            {
+                a_ba121_queue_complete(handle, index, 0, data, now_ms);          /* complete */
+            }
+            else                                                                 /* ack reply */
+            {
+                handle->last_status = (data >> 24) & 0xFF;                       /* save last status */
+                a_ba121_queue_complete(handle, index, (handle->last_status != 0) ? 5 : 0,
+                                       data, now_ms);                            /* complete */
+            }
+        }
+        handle->rx_len = (uint8_t)rx_len;                                        /* save the partial frame */
+        if (len == 0)                                                            /* nothing more */
+        {
+            break;                                                               /* break */
+        }
+    }
+}
+
+/**
+ * @brief     send the next command of each reply type
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
  * @note      none
  */
-uint8_t ba121_init(ba121_handle_t *handle)
+static void a_ba121_queue_send(ba121_handle_t *handle, uint32_t now_ms)
 {
-    if (handle == NULL)                                             /* check handle */
+    uint8_t is_data;
+    uint8_t index;
+    uint8_t output[6];
+    uint32_t param;
+    ba121_queue_entry_t *entry;
+    
+    for (is_data = 0; is_data < 2; is_data++)                                    /* ack and data replies */
     {
-        return 2;                                                   /* return error */
+        if (a_ba121_queue_find(handle, is_data, BA121_QUEUE_IN_FLIGHT) != BA121_QUEUE_DEPTH)
+        {
+            continue;                                                            /* one in flight per reply type */
+        }
+        index = a_ba121_queue_find(handle, is_data, BA121_QUEUE_QUEUED);         /* oldest queued */
+        if (index == BA121_QUEUE_DEPTH)                                          /* check index */
+        {
+            continue;                                                            /* next */
+        }
+        entry = &handle->queue[index];                                           /* get entry */
+        if ((entry->attempts != 0) && ((int32_t)(now_ms - entry->time_ms) < 0))  /* check backoff */
+        {
+            continue;                                                            /* wait */
+        }
+        entry->attempts++;                                                       /* count attempt */
+        if ((a_ba121_queue_find(handle, !is_data, BA121_QUEUE_IN_FLIGHT) == BA121_QUEUE_DEPTH))
+        {
+            handle->rx_len = 0;                                                  /* nothing expected */
+            if (BA121_UART_FLUSH(handle) != 0)                                   /* uart flush */
+            {
+                BA121_DEBUG_PRINT(handle, "ba121: uart flush failed.\n");        /* uart flush failed */
+                a_ba121_queue_complete(handle, index, 1, 0, now_ms);             /* complete */
+                
+                continue;                                                        /* next */
+            }
+        }
+        param = (entry->command == BA121_COMMAND_NTC_B) ? (entry->param << 16) : entry->param;
+        ba121_frame_make(entry->command, param, output);                         /* make frame */
+        if (BA121_UART_WRITE(handle, output, 6) != 0)                            /* uart write */
+        {
+            BA121_DEBUG_PRINT(handle, "ba121: uart write failed.\n");            /* uart write failed */
+            a_ba121_queue_complete(handle, index, 1, 0, now_ms);                 /* complete */
+            
+            continue;                                                            /* next */
+        }
+        entry->tx_us = a_ba121_now_us(handle);                                   /* stamp transmit */
+        entry->state = BA121_QUEUE_IN_FLIGHT;                                    /* in flight */
+        entry->time_ms = now_ms + BA121_QUEUE_TIMEOUT_MARGIN_MS +
+                         ((is_data != 0) ? BA121_READ_DELAY_MS : BA121_ACK_DELAY_MS);
     }
-    if (handle->debug_print == NULL)                                /* check debug_print */
+}
+
+/**
+ * @brief     cancel all queued commands
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @note      none
+ */
+static void a_ba121_queue_cancel(ba121_handle_t *handle)
+{
+    uint8_t i;
+    
+    for (i = 0; i < BA121_QUEUE_DEPTH; i++)                                      /* all entries */
     {
-        return 3;                                                   /* return error */
+        ba121_queue_entry_t *entry = &handle->queue[i];
+        
+        if (entry->state != BA121_QUEUE_FREE)                                    /* check state */
+        {
+            ba121_queue_entry_t done = *entry;                                   /* save entry */
+            
+            entry->state = BA121_QUEUE_FREE;                                     /* free */
+            a_ba121_queue_dispatch(handle, &done, 1, 0);                         /* run callback */
+        }
     }
-    if (handle->uart_init == NULL)                                  /* check uart_init */
+    handle->rx_len = 0;                                                          /* clear stream */
+}
+
+#endif
+
+/**
+ * @brief      run one command
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[in]  command input command
+ * @param[in]  param input data
+ * @param[in]  wait_ms reply delay in ms
+ * @param[in]  is_data bool value
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart flush, write or read failed
+ *             - 4 frame error
+ *             - 5 response error
+ * @note       none
+ */
+static uint8_t a_ba121_command(ba121_handle_t *handle, uint8_t command, uint32_t param,
+                               uint32_t wait_ms, uint8_t is_data, uint32_t *data)
+{
+    uint8_t res;
+    uint8_t output[6];
+    uint8_t input[6];
+    uint16_t len;
+    
+    ba121_frame_make(command, param, output);                           /* make frame */
+    res = BA121_UART_FLUSH(handle);                                     /* uart flush */
+    if (res != 0)                                                       /* check result */
     {
-        handle->debug_print("ba121: uart_init is null.\n");         /* uart_init is null */
+        BA121_DEBUG_PRINT(handle, "ba121: uart flush failed.\n");       /* uart flush failed */
         
-        return 3;                                                   /* return error */
+        return 1;                                                       /* return error */
     }
-    if (handle->uart_deinit == NULL)                                /* check uart_deinit */
+    res = BA121_UART_WRITE(handle, output, 6);                          /* uart write */
+    if (res != 0)                                                       /* check result */
     {
-        handle->debug_print("ba121: uart_deinit is null.\n");       /* uart_deinit is null */
+        BA121_DEBUG_PRINT(handle, "ba121: uart write failed.\n");       /* uart write failed */
         
-        return 3;                                                   /* return error */
+        return 1;                                                       /* return error */
     }
-    if (handle->uart_read == NULL)                                  /* check uart_read */
+    handle->last_tx_us = a_ba121_now_us(handle);                        /* stamp transmit */
+    if (BA121_WAIT_LINKED(handle))                                      /* check wait_reply */
     {
-        handle->debug_print("ba121: uart_read is null.\n");         /* uart_read is null */
+        (void)BA121_WAIT_REPLY(handle, 6, wait_ms);                     /* wait for the reply, a timeout reads short */
+    }
+    else
+    {
+        BA121_DELAY_MS(handle, wait_ms);                                /* delay */
+    }
+    len = BA121_UART_READ(handle, input, 6);                            /* uart read */
+    if (len != 6)                                                       /* check length */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: uart read failed.\n");        /* uart read failed */
         
-        return 3;                                                   /* return error */
+        return 1;                                                       /* return error */
     }
-    if (handle->uart_flush == NULL)                                 /* check uart_flush */
+    handle->last_rx_us = BA121_WAIT_LINKED(handle) ?
+                         a_ba121_now_us(handle) : 0;                    /* stamp arrival, unknown after a fixed delay */
+    res = a_ba121_parse_frame(handle, is_data, input, data);            /* parse data */
+    if (res != 0)                                                       /* check result */
     {
-        handle->debug_print("ba121: uart_flush is null.\n");        /* uart_flush is null */
+        BA121_DEBUG_PRINT(handle, "ba121: frame error.\n");             /* frame error */
         
-        return 3;                                                   /* return error */
+        return 4;                                                       /* return error */
     }
-    if (handle->uart_write == NULL)                                 /* check uart_write */
+    if (is_data == 0)                                                   /* response frame */
     {
-        handle->debug_print("ba121: uart_write is null.\n");        /* uart_write is null */
+        handle->last_status = (*data >> 24) & 0xFF;                     /* save last status */
+        if (handle->last_status != 0)                                   /* check last status */
+        {
+            BA121_DEBUG_PRINT(handle, "ba121: response error.\n");      /* response error */
+            
+            return 5;                                                   /* return error */
+        }
+    }
+    
+    return 0;                                                           /* success return 0 */
+}
+
+/**
+ * @brief      run one command with the retry policy
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[in]  command input command
+ * @param[in]  param input data
+ * @param[in]  wait_ms reply delay in ms
+ * @param[in]  is_data bool value
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart flush, write or read failed
+ *             - 4 frame error
+ *             - 5 response error
+ * @note       the backoff lets a late or partial reply finish, the flush of the next attempt drops it
+ */
+static uint8_t a_ba121_transfer(ba121_handle_t *handle, uint8_t command, uint32_t param,
+                                uint32_t wait_ms, uint8_t is_data, uint32_t *data)
+{
+    uint8_t res;
+    uint8_t attempts;
+    uint8_t mask;
+    uint32_t backoff;
+    
+#if (BA121_QUEUE_ENABLE == 1)
+    if (a_ba121_queue_busy(handle) != 0)                                                 /* check queue */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: queue is busy.\n");                            /* queue is busy */
         
-        return 3;                                                   /* return error */
+        return 1;                                                                        /* return error */
+    }
+#endif
+    attempts = (handle->retry_attempts != 0) ? handle->retry_attempts : 1;               /* at least one attempt */
+    backoff = handle->retry_backoff_ms;                                                  /* initial backoff */
+    handle->last_attempts = 0;                                                           /* init 0 */
+    while (1)                                                                            /* loop */
+    {
+        res = a_ba121_command(handle, command, param, wait_ms, is_data, data);           /* run command */
+        handle->last_attempts++;                                                         /* count attempt */
+        if (res == 0)                                                                    /* check result */
+        {
+            return 0;                                                                    /* success return 0 */
+        }
+        mask = (res == 1) ? BA121_RETRY_LINK_ERROR :
+               ((res == 4) ? BA121_RETRY_FRAME_ERROR : BA121_RETRY_RESPONSE_ERROR);      /* error class */
+        if ((handle->last_attempts >= attempts) || ((handle->retry_mask & mask) == 0))   /* check policy */
+        {
+            return res;                                                                  /* return error */
+        }
+        BA121_DEBUG_PRINT(handle, "ba121: retry after %dms.\n", (int)backoff);           /* retry */
+        BA121_DELAY_MS(handle, backoff);                                                 /* back off */
+        backoff *= 2;                                                                    /* double */
+        if (backoff > handle->retry_max_backoff_ms)                                      /* check max */
+        {
+            backoff = handle->retry_max_backoff_ms;                                      /* clamp */
+        }
+    }
+}
+
+#if (BA121_STATIC_LINK == 0) || (BA121_STATIC_OS == 1)
+
+/**
+ * @brief     check the os functions
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    1 if all os functions are linked, else 0
+ * @note      none
+ */
+static uint8_t a_ba121_os_linked(ba121_handle_t *handle)
+{
+    return (uint8_t)(BA121_OS_LINKED(handle));                                               /* check all */
+}
+
+/**
+ * @brief      acquire the bus for a blocking command
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[in]  read bool value, the command is a read
+ * @param[out] *res pointer to a shared read result buffer
+ * @param[out] *data pointer to a shared read data buffer
+ * @param[out] *tx_us pointer to a shared read transmit time buffer
+ * @param[out] *rx_us pointer to a shared read arrival time buffer
+ * @return     status code
+ *             - 0 the caller owns the bus
+ *             - 1 bus wait timeout
+ *             - 2 an in-flight read finished, the outputs hold its result
+ * @note       without the os functions the caller always owns the bus,
+ *             the wait is bounded by the longest time an owner can hold the bus with the retry policy,
+ *             a timed out waiter may leave one give behind which only wakes a later waiter early
+ */
+static uint8_t a_ba121_bus_acquire(ba121_handle_t *handle, uint8_t read, uint8_t *res,
+                                   uint32_t *data, uint64_t *tx_us, uint64_t *rx_us)
+{
+    uint8_t shared;
+    uint32_t target;
+    uint32_t release;
+    uint32_t timeout;
+    
+    if (a_ba121_os_linked(handle) == 0)                                                       /* check os functions */
+    {
+        return 0;                                                                             /* single task */
+    }
+    shared = 0;                                                                               /* init 0 */
+    target = 0;                                                                               /* init 0 */
+    timeout = (uint32_t)((handle->retry_attempts != 0) ? handle->retry_attempts : 1) *
+              (BA121_READ_DELAY_MS + handle->retry_max_backoff_ms) + BA121_BUS_MARGIN_MS;     /* longest owner time */
+    BA121_OS_LOCK(handle);                                                                        /* lock */
+    while (1)                                                                                 /* loop */
+    {
+        if ((shared != 0) && ((int32_t)(handle->bus_read_done - target) >= 0))                /* shared read finished */
+        {
+            *res = handle->bus_read_res;                                                      /* copy result */
+            *data = handle->bus_read_data;                                                    /* copy data */
+            *tx_us = handle->bus_read_tx_us;                                                  /* copy transmit time */
+            *rx_us = handle->bus_read_rx_us;                                                  /* copy arrival time */
+            BA121_OS_UNLOCK(handle);                                                              /* unlock */
+            
+            return 2;                                                                         /* return shared */
+        }
+        if (handle->bus_busy == 0)                                                            /* check bus */
+        {
+            handle->bus_busy = 1;                                                             /* own the bus */
+            handle->bus_read = read;                                                          /* set kind */
+            if (read != 0)                                                                    /* check read */
+            {
+                handle->bus_read_started++;                                                   /* one more read */
+            }
+            BA121_OS_UNLOCK(handle);                                                              /* unlock */
+            
+            return 0;                                                                         /* return owner */
+        }
+        if ((read != 0) && (handle->bus_read != 0) && (shared == 0))                          /* read in flight */
+        {
+            target = handle->bus_read_started;                                                /* share it */
+            shared = 1;                                                                       /* set shared */
+        }
+        handle->bus_waiters++;                                                                /* one more waiter */
+        release = handle->bus_release;                                                        /* save release */
+        BA121_OS_UNLOCK(handle);                                                                  /* unlock */
+        if (BA121_OS_SEM_WAIT(handle, timeout) != 0)                                                /* wait for a release */
+        {
+            BA121_OS_LOCK(handle);                                                                /* lock */
+            if (handle->bus_release == release)                                               /* no give for us */
+            {
+                handle->bus_waiters--;                                                        /* one less waiter */
+            }
+            BA121_OS_UNLOCK(handle);                                                              /* unlock */
+            BA121_DEBUG_PRINT(handle, "ba121: bus wait timeout.\n");                          /* bus wait timeout */
+            
+            return 1;                                                                         /* return error */
+        }
+        BA121_OS_LOCK(handle);                                                                    /* lock */
+    }
+}
+
+/**
+ * @brief     release the bus after a blocking command
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] read bool value, the command is a read
+ * @param[in] res read result
+ * @param[in] data read data
+ * @note      a read publishes its result to the tasks that share it, every waiter gets one give
+ */
+static void a_ba121_bus_release(ba121_handle_t *handle, uint8_t read, uint8_t res, uint32_t data)
+{
+    if (a_ba121_os_linked(handle) == 0)                              /* check os functions */
+    {
+        return;                                                      /* single task */
+    }
+    BA121_OS_LOCK(handle);                                               /* lock */
+    if (read != 0)                                                   /* check read */
+    {
+        handle->bus_read_res = res;                                  /* set result */
+        handle->bus_read_data = data;                                /* set data */
+        handle->bus_read_tx_us = handle->last_tx_us;                 /* set transmit time */
+        handle->bus_read_rx_us = handle->last_rx_us;                 /* set arrival time */
+        handle->bus_read_done = handle->bus_read_started;            /* read finished */
+    }
+    handle->bus_busy = 0;                                            /* free the bus */
+    handle->bus_read = 0;                                            /* clear kind */
+    handle->bus_release++;                                           /* one more release */
+    while (handle->bus_waiters != 0)                                 /* all waiters */
+    {
+        BA121_OS_SEM_GIVE(handle);                                       /* wake one */
+        handle->bus_waiters--;                                       /* one less */
+    }
+    BA121_OS_UNLOCK(handle);                                             /* unlock */
+}
+
+#else
+
+/**
+ * @brief      acquire the bus for a blocking command
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[in]  read bool value, the command is a read
+ * @param[out] *res pointer to a shared read result buffer
+ * @param[out] *data pointer to a shared read data buffer
+ * @param[out] *tx_us pointer to a shared read transmit time buffer
+ * @param[out] *rx_us pointer to a shared read arrival time buffer
+ * @return     status code
+ *             - 0 the caller owns the bus
+ * @note       without BA121_STATIC_OS the caller always owns the bus
+ */
+static uint8_t a_ba121_bus_acquire(ba121_handle_t *handle, uint8_t read, uint8_t *res,
+                                   uint32_t *data, uint64_t *tx_us, uint64_t *rx_us)
+{
+    (void)handle;                                                    /* not used */
+    (void)read;                                                      /* not used */
+    (void)res;                                                       /* not used */
+    (void)data;                                                      /* not used */
+    (void)tx_us;                                                     /* not used */
+    (void)rx_us;                                                     /* not used */
+    
+    return 0;                                                        /* single task */
+}
+
+/**
+ * @brief     release the bus after a blocking command
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] read bool value, the command is a read
+ * @param[in] res read result
+ * @param[in] data read data
+ * @note      without BA121_STATIC_OS there is nothing to release
+ */
+static void a_ba121_bus_release(ba121_handle_t *handle, uint8_t read, uint8_t res, uint32_t data)
+{
+    (void)handle;                                                    /* not used */
+    (void)read;                                                      /* not used */
+    (void)res;                                                       /* not used */
+    (void)data;                                                      /* not used */
+}
+
+#endif
+
+/**
+ * @brief      run a read on the shared bus
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *data pointer to a data buffer
+ * @param[out] *tx_us pointer to a command transmit time buffer
+ * @param[out] *rx_us pointer to a reply arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or bus wait timeout
+ *             - 4 frame error
+ * @note       none
+ */
+static uint8_t a_ba121_bus_read(ba121_handle_t *handle, uint32_t *data, uint64_t *tx_us, uint64_t *rx_us)
+{
+    uint8_t res;
+    uint8_t shared_res;
+    
+    res = a_ba121_bus_acquire(handle, 1, &shared_res, data, tx_us, rx_us);                 /* acquire */
+    if (res == 1)                                                                          /* check timeout */
+    {
+        return 1;                                                                          /* return error */
+    }
+    if (res == 2)                                                                          /* check shared */
+    {
+        return shared_res;                                                                 /* return shared result */
+    }
+    *data = 0;                                                                             /* init 0 */
+    res = a_ba121_transfer(handle, BA121_COMMAND_READ,
+                           0x00000000, BA121_READ_DELAY_MS, 1, data);                      /* read */
+    *tx_us = handle->last_tx_us;                                                           /* set transmit time */
+    *rx_us = handle->last_rx_us;                                                           /* set arrival time */
+    a_ba121_bus_release(handle, 1, res, *data);                                            /* release */
+    
+    return res;                                                                            /* return result */
+}
+
+/**
+ * @brief     run an ack command on the shared bus
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] command input command
+ * @param[in] param input data
+ * @return    status code
+ *            - 0 success
+ *            - 1 command failed or bus wait timeout
+ *            - 4 frame error
+ *            - 5 response error
+ * @note      none
+ */
+static uint8_t a_ba121_bus_command(ba121_handle_t *handle, uint8_t command, uint32_t param)
+{
+    uint8_t res;
+    uint8_t shared_res;
+    uint32_t data;
+    uint64_t tx_us;
+    uint64_t rx_us;
+    
+    res = a_ba121_bus_acquire(handle, 0, &shared_res, &data, &tx_us, &rx_us);        /* acquire */
+    if (res != 0)                                                                    /* check result */
+    {
+        return 1;                                                                    /* return error */
+    }
+    res = a_ba121_transfer(handle, command, param, BA121_ACK_DELAY_MS, 0, &data);    /* send */
+    a_ba121_bus_release(handle, 0, res, 0);                                          /* release */
+    
+    return res;                                                                      /* return result */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ * @note      with BA121_STATIC_LINK the linked functions are not checked
+ */
+uint8_t ba121_init(ba121_handle_t *handle)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+#if (BA121_STATIC_LINK == 0)
+    if (handle->debug_print == NULL)                                /* check debug_print */
+    {
+        return 3;                                                   /* return error */
+    }
+    if (handle->uart_init == NULL)                                  /* check uart_init */
+    {
+        handle->debug_print("ba121: uart_init is null.\n");         /* uart_init is null */
+        
+        return 3;                                                   /* return error */
+    }
+    if (handle->uart_deinit == NULL)                                /* check uart_deinit */
+    {
+        handle->debug_print("ba121: uart_deinit is null.\n");       /* uart_deinit is null */
+        
+        return 3;                                                   /* return error */
+    }
+    if (handle->uart_read == NULL)                                  /* check uart_read */
+    {
+        handle->debug_print("ba121: uart_read is null.\n");         /* uart_read is null */
+        
+        return 3;                                                   /* return error */
+    }
+    if (handle->uart_flush == NULL)                                 /* check uart_flush */
+    {
+        handle->debug_print("ba121: uart_flush is null.\n");        /* uart_flush is null */
+        
+        return 3;                                                   /* return error */
+    }
+    if (handle->uart_write == NULL)                                 /* check uart_write */
+    {
+        handle->debug_print("ba121: uart_write is null.\n");        /* uart_write is null */
+        
+        return 3;                                                   /* return error */
+    }
+    if (handle->delay_ms == NULL)                                   /* check delay_ms */
+    {
+        handle->debug_print("ba121: delay_ms is null.\n");          /* delay_ms is null */
+        
+        return 3;                                                   /* return error */
+    }
+#endif
+    
+    if (BA121_UART_INIT(handle) != 0)                               /* uart init */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: uart init failed.\n");    /* uart init failed */
+        
+        return 1;                                                   /* return error */
+    }
+    
+#if (BA121_QUEUE_ENABLE == 1)
+    memset(handle->queue, 0, sizeof(handle->queue));                /* clear queue */
+    handle->queue_seq = 0;                                          /* init 0 */
+    handle->rx_len = 0;                                             /* init 0 */
+#endif
+    handle->last_tx_us = 0;                                         /* init 0 */
+    handle->last_rx_us = 0;                                         /* init 0 */
+    handle->inited = 1;                                             /* flag finish initialization */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ba121_deinit(ba121_handle_t *handle)
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (handle->inited != 1)                                        /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+     
+#if (BA121_QUEUE_ENABLE == 1)
+    a_ba121_queue_cancel(handle);                                   /* cancel queued commands */
+#endif
+    if (BA121_UART_DEINIT(handle) != 0)                             /* uart deinit */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: uart deinit failed.\n");  /* uart deinit failed */
+        
+        return 1;                                                   /* return error */
+    }         
+    handle->inited = 0;                                             /* flag close */
+    
+    return 0;                                                       /* success return 0 */ 
+}
+
+/**
+ * @brief      read the data
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *conductivity_raw pointer to a conductivity raw data buffer
+ * @param[out] *conductivity_us_cm pointer to a conductivity uS/cm data buffer
+ * @param[out] *temperature_raw pointer to a temperature raw data buffer
+ * @param[out] *temperature pointer to a converted temperature data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 frame error
+ * @note       with the os functions linked the calls of several tasks are serialised,
+ *             a read that arrives during an in-flight read returns the result of that read
+ */
+uint8_t ba121_read(ba121_handle_t *handle, uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
+                   uint16_t *temperature_raw, float *temperature)
+{
+    uint64_t tx_us;
+    uint64_t rx_us;
+    
+    return ba121_read_with_timestamp(handle, conductivity_raw, conductivity_us_cm,
+                                     temperature_raw, temperature, &tx_us, &rx_us);        /* read */
+}
+
+/**
+ * @brief      read the data with its timestamps
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *conductivity_raw pointer to a conductivity raw data buffer
+ * @param[out] *conductivity_us_cm pointer to a conductivity uS/cm data buffer
+ * @param[out] *temperature_raw pointer to a temperature raw data buffer
+ * @param[out] *temperature pointer to a converted temperature data buffer
+ * @param[out] *tx_us pointer to a command transmit time buffer
+ * @param[out] *rx_us pointer to a reply arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 frame error
+ * @note       the times come from the linked timestamp_us function and are 0 without it,
+ *             rx_us is the reply arrival only with the wait_reply function linked and 0 without it,
+ *             because the fixed delay hides when the frame arrived,
+ *             a shared read returns the times of the in-flight read
+ */
+uint8_t ba121_read_with_timestamp(ba121_handle_t *handle, uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
+                                  uint16_t *temperature_raw, float *temperature, uint64_t *tx_us, uint64_t *rx_us)
+{
+    uint8_t res;
+    uint32_t data;
+    
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    res = a_ba121_bus_read(handle, &data, tx_us, rx_us);                     /* read */
+    if (res != 0)                                                            /* check result */
+    {
+        return res;                                                          /* return error */
+    }
+    *conductivity_raw = (data >> 16) & 0xFFFFU;                              /* set conductivity raw */
+    *conductivity_us_cm = *conductivity_raw;                                 /* set conductivity us cm */
+    *temperature_raw = (data >> 0) & 0xFFFFU;                                /* set temperature raw */
+    *temperature = (float)(*temperature_raw) / 100.0f;                       /* set temperature */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the timestamps of the last transaction
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *tx_us pointer to a command transmit time buffer
+ * @param[out] *rx_us pointer to a reply arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       call it from an async or queue callback to get the times of the finished command,
+ *             the queue path stamps rx_us when the frame is assembled,
+ *             the blocking path sets rx_us only with the wait_reply function linked
+ */
+uint8_t ba121_get_timestamp(ba121_handle_t *handle, uint64_t *tx_us, uint64_t *rx_us)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    
+    *tx_us = handle->last_tx_us;                                             /* set transmit time */
+    *rx_us = handle->last_rx_us;                                             /* set arrival time */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     baseline calibration
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 baseline calibration failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 frame error
+ *            - 5 response error
+ * @note      none
+ */
+uint8_t ba121_baseline_calibration(ba121_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                          /* check handle */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    
+    res = a_ba121_bus_command(handle, BA121_COMMAND_BASELINE, 0x00000000);       /* send */
+    if (res != 0)                                                                /* check result */
+    {
+        return res;                                                              /* return error */
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     set ntc resistance
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] ohm resistance ohm
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ntc resistance failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 frame error
+ *            - 5 response error
+ * @note      none
+ */
+uint8_t ba121_set_ntc_resistance(ba121_handle_t *handle, uint32_t ohm)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    
+    res = a_ba121_bus_command(handle, BA121_COMMAND_NTC_RES, ohm);       /* send */
+    if (res != 0)                                                        /* check result */
+    {
+        return res;                                                      /* return error */
+    }
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set ntc b
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] value ntc value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set ntc b failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 frame error
+ *            - 5 response error
+ * @note      none
+ */
+uint8_t ba121_set_ntc_b(ba121_handle_t *handle, uint16_t value)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    res = a_ba121_bus_command(handle, BA121_COMMAND_NTC_B, (uint32_t)value << 16);     /* send */
+    if (res != 0)                                                              /* check result */
+    {
+        return res;                                                            /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get last status
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ba121_get_last_status(ba121_handle_t *handle, ba121_status_t *status)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->inited != 1)                                /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    *status = (ba121_status_t)(handle->last_status);        /* set status */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the retry policy
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] attempts max attempts including the first one
+ * @param[in] backoff_ms backoff before the first retry
+ * @param[in] max_backoff_ms max backoff, the backoff doubles after every retry
+ * @param[in] mask retried errors, a combination of ba121_retry_t
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 attempts is invalid
+ *            - 5 backoff is invalid
+ *            - 6 mask is invalid
+ * @note      the line is resynchronised between attempts,
+ *            the backoff should cover one frame time (7ms at 9600 baud)
+ */
+uint8_t ba121_set_retry(ba121_handle_t *handle, uint8_t attempts, uint16_t backoff_ms,
+                        uint16_t max_backoff_ms, uint8_t mask)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    if (attempts == 0)                                                     /* check attempts */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: attempts can't be 0.\n");        /* attempts can't be 0 */
+        
+        return 4;                                                          /* return error */
+    }
+    if (backoff_ms > max_backoff_ms)                                       /* check backoff */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: backoff > max backoff.\n");      /* backoff > max backoff */
+        
+        return 5;                                                          /* return error */
+    }
+    if ((mask & (~BA121_RETRY_ALL)) != 0)                                  /* check mask */
+    {
+        BA121_DEBUG_PRINT(handle, "ba121: mask is invalid.\n");            /* mask is invalid */
+        
+        return 6;                                                          /* return error */
+    }
+    
+    handle->retry_attempts = attempts;                                     /* set attempts */
+    handle->retry_backoff_ms = backoff_ms;                                 /* set backoff */
+    handle->retry_max_backoff_ms = max_backoff_ms;                         /* set max backoff */
+    handle->retry_mask = mask;                                             /* set mask */
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the retry policy
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *attempts pointer to a max attempts buffer
+ * @param[out] *backoff_ms pointer to an initial backoff buffer
+ * @param[out] *max_backoff_ms pointer to a max backoff buffer
+ * @param[out] *mask pointer to a retried errors buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ba121_get_retry(ba121_handle_t *handle, uint8_t *attempts, uint16_t *backoff_ms,
+                        uint16_t *max_backoff_ms, uint8_t *mask)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    *attempts = (handle->retry_attempts != 0) ? handle->retry_attempts : 1;             /* get attempts */
+    *backoff_ms = handle->retry_backoff_ms;                                             /* get backoff */
+    *max_backoff_ms = handle->retry_max_backoff_ms;                                     /* get max backoff */
+    *mask = handle->retry_mask;                                                         /* get mask */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the attempts of the last command
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *attempts pointer to an attempts buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       1 means the command passed or failed without a retry
+ */
+uint8_t ba121_get_last_attempts(ba121_handle_t *handle, uint8_t *attempts)
+{
+    if (handle == NULL)                                     /* check handle */
+    {
+        return 2;                                           /* return error */
+    }
+    if (handle->inited != 1)                                /* check handle initialization */
+    {
+        return 3;                                           /* return error */
+    }
+    
+    *attempts = handle->last_attempts;                      /* get attempts */
+    
+    return 0;                                               /* success return 0 */
+}
+
+#if (BA121_QUEUE_ENABLE == 1)
+
+/**
+ * @brief     submit a command to the queue
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] command queued command
+ * @param[in] param command data, ohm for the ntc resistance and the value for the ntc b
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 command is invalid
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error,
+ *            data holds the raw reply, conductivity << 16 | temperature for a read and status << 24 for an ack,
+ *            the queue and async functions are not guarded by the os functions, call them from one task
+ */
+uint8_t ba121_queue_submit(ba121_handle_t *handle, ba121_queue_command_t command, uint32_t param,
+                           void (*callback)(ba121_handle_t *handle, uint8_t command, uint8_t res, uint32_t data, void *user),
+                           void *user)
+{
+    ba121_queue_entry_t *entry;
+    
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
     }
-    if (handle->delay_ms == NULL)                                   /* check delay_ms */
+    if ((command != BA121_QUEUE_COMMAND_READ) &&
+        (command != BA121_QUEUE_COMMAND_NTC_RESISTANCE) &&
+        (command != BA121_QUEUE_COMMAND_NTC_B) &&
+        (command != BA121_QUEUE_COMMAND_BASELINE))                           /* check command */
     {
-        handle->debug_print("ba121: delay_ms is null.\n");          /* delay_ms is null */
+        BA121_DEBUG_PRINT(handle, "ba121: command is invalid.\n");           /* command is invalid */
         
-        return 3;                                                   /* return error */
+        return 4;                                                            /* return error */
     }
     
-    if (handle->uart_init() != 0)                                   /* uart init */
+    entry = a_ba121_queue_push(handle, (uint8_t)command, param,
+                               BA121_QUEUE_KIND_QUEUE);                      /* add entry */
+    if (entry == NULL)                                                       /* check entry */
     {
-        handle->debug_print("ba121: uart init failed.\n");          /* uart init failed */
-        
-        return 1;                                                   /* return error */
+        return 1;                                                            /* return error */
     }
+    entry->callback = callback;                                              /* set callback */
+    entry->user = user;                                                      /* set user */
     
-    handle->inited = 1;                                             /* flag finish initialization */
-    
-    return 0;                                                       /* success return 0 */
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     run the queue
  * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
  * @return    status code
  *            - 0 success
- *            - 1 uart deinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      one read and one ack command can be in flight at the same time, replies are matched by frame type,
+ *            commands of the same reply type keep their submit order, call it whenever the uart has data
+ *            or a deadline expires, completions run inside this function
  */
-uint8_t ba121_deinit(ba121_handle_t *handle)
+uint8_t ba121_queue_process(ba121_handle_t *handle, uint32_t now_ms)
 {
-    if (handle == NULL)                                             /* check handle */
+    uint8_t i;
+    
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                                   /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                        /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                                   /* return error */
+        return 3;                                                            /* return error */
     }
-     
-    if (handle->uart_deinit() != 0)                                 /* uart deinit */
+    
+    if (a_ba121_queue_busy(handle) == 0)                                     /* check queue */
+    {
+        return 0;                                                            /* success return 0 */
+    }
+    a_ba121_queue_receive(handle, now_ms);                                   /* match replies */
+    for (i = 0; i < BA121_QUEUE_DEPTH; i++)                                  /* check deadlines */
     {
-        handle->debug_print("ba121: uart deinit failed.\n");        /* uart deinit failed */
+        ba121_queue_entry_t *entry = &handle->queue[i];
         
-        return 1;                                                   /* return error */
-    }         
-    handle->inited = 0;                                             /* flag close */
+        if ((entry->state == BA121_QUEUE_IN_FLIGHT) &&
+            ((int32_t)(now_ms - entry->time_ms) >= 0))                       /* expired */
+        {
+            BA121_DEBUG_PRINT(handle, "ba121: reply timeout.\n");            /* reply timeout */
+            a_ba121_queue_complete(handle, i, 1, 0, now_ms);                 /* complete */
+        }
+    }
+    a_ba121_queue_send(handle, now_ms);                                      /* send next commands */
     
-    return 0;                                                       /* success return 0 */ 
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief      read the data
+ * @brief      get the queued command count
  * @param[in]  *handle pointer to a ba121 handle structure
- * @param[out] *conductivity_raw pointer to a conductivity raw data buffer
- * @param[out] *conductivity_us_cm pointer to a conductivity uS/cm data buffer
- * @param[out] *temperature_raw pointer to a temperature raw data buffer
- * @param[out] *temperature pointer to a converted temperature data buffer
+ * @param[out] *count pointer to a count buffer
  * @return     status code
  *             - 0 success
- *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 frame error
- * @note       none
+ * @note       queued and in flight commands are counted
  */
-uint8_t ba121_read(ba121_handle_t *handle, uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
-                   uint16_t *temperature_raw, float *temperature)
+uint8_t ba121_queue_get_count(ba121_handle_t *handle, uint8_t *count)
 {
-    uint8_t res;
-    uint8_t output[6];
-    uint8_t input[6];
-    uint16_t len;
-    uint32_t data;
+    uint8_t i;
     
     if (handle == NULL)                                                      /* check handle */
     {
@@ -274,281 +1537,305 @@ uint8_t ba121_read(ba121_handle_t *handle, uint16_t *conductivity_raw, uint16_t
         return 3;                                                            /* return error */
     }
     
-    (void)a_ba121_make_frame(BA121_COMMAND_READ, 0x00000000, output);        /* make frame */
-    res = handle->uart_flush();                                              /* uart flush */
-    if (res != 0)                                                            /* check result */
-    {
-        handle->debug_print("ba121: uart flush failed.\n");                  /* uart flush failed */
-        
-        return 1;                                                            /* return error */
-    }
-    res = handle->uart_write(output, 6);                                     /* uart write */
-    if (res != 0)                                                            /* check result */
+    *count = 0;                                                              /* init 0 */
+    for (i = 0; i < BA121_QUEUE_DEPTH; i++)                                  /* all entries */
     {
-        handle->debug_print("ba121: uart write failed.\n");                  /* uart write failed */
-        
-        return 1;                                                            /* return error */
+        if (handle->queue[i].state != BA121_QUEUE_FREE)                      /* check state */
+        {
+            (*count)++;                                                      /* count */
+        }
     }
-    handle->delay_ms(800);                                                   /* delay 800ms */
-    len = handle->uart_read(input, 6);                                       /* uart read */
-    if (len != 6)                                                            /* check length */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     cancel all queued commands
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      every cancelled command completes with res 1
+ */
+uint8_t ba121_queue_cancel(ba121_handle_t *handle)
+{
+    if (handle == NULL)                                                      /* check handle */
     {
-        handle->debug_print("ba121: uart read failed.\n");                   /* uart read failed */
-        
-        return 1;                                                            /* return error */
+        return 2;                                                            /* return error */
     }
-    res = a_ba121_parse_frame(handle, 1, input, &data);                      /* parse data */
-    if (res != 0)                                                            /* check result */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        handle->debug_print("ba121: frame error.\n");                        /* frame error */
-        
-        return 4;                                                            /* return error */
+        return 3;                                                            /* return error */
     }
-    *conductivity_raw = (data >> 16) & 0xFFFFU;                              /* set conductivity raw */
-    *conductivity_us_cm = *conductivity_raw;                                 /* set conductivity us cm */
-    *temperature_raw = (data >> 0) & 0xFFFFU;                                /* set temperature raw */
-    *temperature = (float)(*temperature_raw) / 100.0f;                       /* set temperature */
     
-    return 0;                                                                /* success return 0 */ 
+    a_ba121_queue_cancel(handle);                                            /* cancel */
+    
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief     baseline calibration
+ * @brief     start an async read
  * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *user user pointer passed to the callback
  * @return    status code
  *            - 0 success
- *            - 1 baseline calibration failed
+ *            - 1 queue is full
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 frame error
- *            - 5 response error
- * @note      none
+ *            - 4 callback is NULL
+ * @note      the callback gets res 0 on success and 1 on a link error or timeout,
+ *            the data are only valid with res 0
  */
-uint8_t ba121_baseline_calibration(ba121_handle_t *handle)
+uint8_t ba121_async_read(ba121_handle_t *handle,
+                         void (*callback)(ba121_handle_t *handle, uint8_t res,
+                                          uint16_t conductivity_raw, uint16_t conductivity_us_cm,
+                                          uint16_t temperature_raw, float temperature, void *user),
+                         void *user)
 {
-    uint8_t res;
-    uint8_t output[6];
-    uint8_t input[6];
-    uint16_t len;
-    uint32_t data;
+    ba121_queue_entry_t *entry;
     
-    if (handle == NULL)                                                          /* check handle */
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                                                /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                                                /* return error */
+        return 3;                                                            /* return error */
     }
-    
-    (void)a_ba121_make_frame(BA121_COMMAND_BASELINE, 0x00000000, output);        /* make frame */
-    res = handle->uart_flush();                                                  /* uart flush */
-    if (res != 0)                                                                /* check result */
+    if (callback == NULL)                                                    /* check callback */
     {
-        handle->debug_print("ba121: uart flush failed.\n");                      /* uart flush failed */
+        BA121_DEBUG_PRINT(handle, "ba121: callback is null.\n");             /* callback is null */
         
-        return 1;                                                                /* return error */
+        return 4;                                                            /* return error */
     }
-    res = handle->uart_write(output, 6);                                         /* uart write */
-    if (res != 0)                                                                /* check result */
+    
+    entry = a_ba121_queue_push(handle, BA121_COMMAND_READ, 0x00000000,
+                               BA121_QUEUE_KIND_READ);                       /* add entry */
+    if (entry == NULL)                                                       /* check entry */
     {
-        handle->debug_print("ba121: uart write failed.\n");                      /* uart write failed */
-        
-        return 1;                                                                /* return error */
+        return 1;                                                            /* return error */
     }
-    handle->delay_ms(500);                                                       /* delay 500ms */
-    len = handle->uart_read(input, 6);                                           /* uart read */
-    if (len != 6)                                                                /* check length */
+    entry->async.read = callback;                                            /* set callback */
+    entry->user = user;                                                      /* set user */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     start an async baseline calibration
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error
+ */
+uint8_t ba121_async_baseline_calibration(ba121_handle_t *handle,
+                                         void (*callback)(ba121_handle_t *handle, uint8_t res, void *user),
+                                         void *user)
+{
+    ba121_queue_entry_t *entry;
+    
+    if (handle == NULL)                                                      /* check handle */
     {
-        handle->debug_print("ba121: uart read failed.\n");                       /* uart read failed */
-        
-        return 1;                                                                /* return error */
+        return 2;                                                            /* return error */
     }
-    res = a_ba121_parse_frame(handle, 0, input, &data);                          /* parse data */
-    if (res != 0)                                                                /* check result */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        handle->debug_print("ba121: frame error.\n");                            /* frame error */
-        
-        return 4;                                                                /* return error */
+        return 3;                                                            /* return error */
     }
-    handle->last_status = (data >> 24) & 0xFF;                                   /* save last status */
-    if (handle->last_status != 0)                                                /* check last status */
+    
+    entry = a_ba121_queue_push(handle, BA121_COMMAND_BASELINE, 0x00000000,
+                               BA121_QUEUE_KIND_DONE);                       /* add entry */
+    if (entry == NULL)                                                       /* check entry */
     {
-        handle->debug_print("ba121: response error.\n");                         /* response error */
-        
-        return 5;                                                                /* return error */
+        return 1;                                                            /* return error */
     }
+    entry->async.done = callback;                                            /* set callback */
+    entry->user = user;                                                      /* set user */
     
-    return 0;                                                                    /* success return 0 */ 
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief     set ntc resistance
+ * @brief     start an async ntc resistance setting
  * @param[in] *handle pointer to a ba121 handle structure
  * @param[in] ohm resistance ohm
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
  * @return    status code
  *            - 0 success
- *            - 1 set ntc resistance failed
+ *            - 1 queue is full
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 frame error
- *            - 5 response error
- * @note      none
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error
  */
-uint8_t ba121_set_ntc_resistance(ba121_handle_t *handle, uint32_t ohm)
+uint8_t ba121_async_set_ntc_resistance(ba121_handle_t *handle, uint32_t ohm,
+                                       void (*callback)(ba121_handle_t *handle, uint8_t res, void *user),
+                                       void *user)
 {
-    uint8_t res;
-    uint8_t output[6];
-    uint8_t input[6];
-    uint16_t len;
-    uint32_t data;
+    ba121_queue_entry_t *entry;
     
-    if (handle == NULL)                                                  /* check handle */
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                                        /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                             /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                                        /* return error */
+        return 3;                                                            /* return error */
     }
     
-    (void)a_ba121_make_frame(BA121_COMMAND_NTC_RES, ohm, output);        /* make frame */
-    res = handle->uart_flush();                                          /* uart flush */
-    if (res != 0)                                                        /* check result */
-    {
-        handle->debug_print("ba121: uart flush failed.\n");              /* uart flush failed */
-        
-        return 1;                                                        /* return error */
-    }
-    res = handle->uart_write(output, 6);                                 /* uart write */
-    if (res != 0)                                                        /* check result */
-    {
-        handle->debug_print("ba121: uart write failed.\n");              /* uart write failed */
-        
-        return 1;                                                        /* return error */
-    }
-    handle->delay_ms(500);                                               /* delay 500ms */
-    len = handle->uart_read(input, 6);                                   /* uart read */
-    if (len != 6)                                                        /* check length */
-    {
-        handle->debug_print("ba121: uart read failed.\n");               /* uart read failed */
-        
-        return 1;                                                        /* return error */
-    }
-    res = a_ba121_parse_frame(handle, 0, input, &data);                  /* parse data */
-    if (res != 0)                                                        /* check result */
-    {
-        handle->debug_print("ba121: frame error.\n");                    /* frame error */
-        
-        return 4;                                                        /* return error */
-    }
-    handle->last_status = (data >> 24) & 0xFF;                           /* save last status */
-    if (handle->last_status != 0)                                        /* check last status */
+    entry = a_ba121_queue_push(handle, BA121_COMMAND_NTC_RES, ohm,
+                               BA121_QUEUE_KIND_DONE);                       /* add entry */
+    if (entry == NULL)                                                       /* check entry */
     {
-        handle->debug_print("ba121: response error.\n");                 /* response error */
-        
-        return 5;                                                        /* return error */
+        return 1;                                                            /* return error */
     }
+    entry->async.done = callback;                                            /* set callback */
+    entry->user = user;                                                      /* set user */
     
-    return 0;                                                            /* success return 0 */ 
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief     set ntc b
+ * @brief     start an async ntc b setting
  * @param[in] *handle pointer to a ba121 handle structure
  * @param[in] value ntc value
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
  * @return    status code
  *            - 0 success
- *            - 1 set ntc b failed
+ *            - 1 queue is full
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 frame error
- *            - 5 response error
- * @note      none
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error
  */
-uint8_t ba121_set_ntc_b(ba121_handle_t *handle, uint16_t value)
+uint8_t ba121_async_set_ntc_b(ba121_handle_t *handle, uint16_t value,
+                              void (*callback)(ba121_handle_t *handle, uint8_t res, void *user),
+                              void *user)
 {
-    uint8_t res;
-    uint8_t output[6];
-    uint8_t input[6];
-    uint16_t len;
-    uint32_t data;
+    ba121_queue_entry_t *entry;
     
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                            /* return error */
     }
     
-    (void)a_ba121_make_frame(BA121_COMMAND_NTC_B, value << 16, output);        /* make frame */
-    res = handle->uart_flush();                                                /* uart flush */
-    if (res != 0)                                                              /* check result */
-    {
-        handle->debug_print("ba121: uart flush failed.\n");                    /* uart flush failed */
-        
-        return 1;                                                              /* return error */
-    }
-    res = handle->uart_write(output, 6);                                       /* uart write */
-    if (res != 0)                                                              /* check result */
-    {
-        handle->debug_print("ba121: uart write failed.\n");                    /* uart write failed */
-        
-        return 1;                                                              /* return error */
-    }
-    handle->delay_ms(500);                                                     /* delay 500ms */
-    len = handle->uart_read(input, 6);                                         /* uart read */
-    if (len != 6)                                                              /* check length */
-    {
-        handle->debug_print("ba121: uart read failed.\n");                     /* uart read failed */
-        
-        return 1;                                                              /* return error */
-    }
-    res = a_ba121_parse_frame(handle, 0, input, &data);                        /* parse data */
-    if (res != 0)                                                              /* check result */
-    {
-        handle->debug_print("ba121: frame error.\n");                          /* frame error */
-        
-        return 4;                                                              /* return error */
-    }
-    handle->last_status = (data >> 24) & 0xFF;                                 /* save last status */
-    if (handle->last_status != 0)                                              /* check last status */
+    entry = a_ba121_queue_push(handle, BA121_COMMAND_NTC_B, value,
+                               BA121_QUEUE_KIND_DONE);                       /* add entry */
+    if (entry == NULL)                                                       /* check entry */
     {
-        handle->debug_print("ba121: response error.\n");                       /* response error */
-        
-        return 5;                                                              /* return error */
+        return 1;                                                            /* return error */
     }
+    entry->async.done = callback;                                            /* set callback */
+    entry->user = user;                                                      /* set user */
     
-    return 0;                                                                  /* success return 0 */ 
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief      get last status
+ * @brief      get the time until the driver needs to run again
  * @param[in]  *handle pointer to a ba121 handle structure
- * @param[out] *status pointer to a status buffer
+ * @param[in]  now_ms current time in ms
+ * @param[out] *timeout_ms pointer to a timeout buffer, 0xFFFFFFFF when idle
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       use it as the epoll_wait, uv_timer or queue receive timeout,
+ *             then call ba121_async_timeout when it expires
  */
-uint8_t ba121_get_last_status(ba121_handle_t *handle, ba121_status_t *status)
+uint8_t ba121_async_get_timeout(ba121_handle_t *handle, uint32_t now_ms, uint32_t *timeout_ms)
 {
-    if (handle == NULL)                                     /* check handle */
+    uint8_t i;
+    uint8_t is_data;
+    int32_t left;
+    
+    if (handle == NULL)                                                      /* check handle */
     {
-        return 2;                                           /* return error */
+        return 2;                                                            /* return error */
     }
-    if (handle->inited != 1)                                /* check handle initialization */
+    if (handle->inited != 1)                                                 /* check handle initialization */
     {
-        return 3;                                           /* return error */
+        return 3;                                                            /* return error */
     }
-    *status = (ba121_status_t)(handle->last_status);        /* set status */
     
-    return 0;                                               /* success return 0 */
+    *timeout_ms = 0xFFFFFFFFU;                                               /* idle */
+    for (i = 0; i < BA121_QUEUE_DEPTH; i++)                                  /* all entries */
+    {
+        ba121_queue_entry_t *entry = &handle->queue[i];
+        
+        if (entry->state == BA121_QUEUE_FREE)                                /* skip free entry */
+        {
+            continue;                                                        /* next */
+        }
+        if ((entry->state == BA121_QUEUE_QUEUED) && (entry->attempts == 0))  /* new command */
+        {
+            is_data = (uint8_t)(entry->command == BA121_COMMAND_READ);       /* reply type */
+            if (a_ba121_queue_find(handle, is_data, BA121_QUEUE_IN_FLIGHT) ==
+                BA121_QUEUE_DEPTH)                                           /* its reply type is free */
+            {
+                *timeout_ms = 0;                                             /* run now */
+            }
+            
+            continue;                                                        /* sent after the one in flight */
+        }
+        left = (int32_t)(entry->time_ms - now_ms);                           /* deadline or backoff */
+        if (left < 0)                                                        /* expired */
+        {
+            left = 0;                                                        /* run now */
+        }
+        if ((uint32_t)left < *timeout_ms)                                    /* earlier */
+        {
+            *timeout_ms = (uint32_t)left;                                    /* save timeout */
+        }
+    }
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     signal that the uart has data
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it from the event loop when the uart fd is readable or the rx interrupt posted an event,
+ *            completion callbacks run inside this function and may start new operations
+ */
+uint8_t ba121_async_readable(ba121_handle_t *handle, uint32_t now_ms)
+{
+    return ba121_queue_process(handle, now_ms);                              /* run the queue */
+}
+
+/**
+ * @brief     signal that the driver timeout expired
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      completion callbacks run inside this function and may start new operations
+ */
+uint8_t ba121_async_timeout(ba121_handle_t *handle, uint32_t now_ms)
+{
+    return ba121_queue_process(handle, now_ms);                              /* run the queue */
 }
 
+#endif
+
 /**
  * @brief     set buffer
  * @param[in] *handle pointer to a ba121 handle structure
@@ -574,17 +1861,17 @@ uint8_t ba121_set_buffer(ba121_handle_t *handle, uint8_t *buf, uint16_t len)
         return 3;                                                  /* return error */
     }
     
-    res = handle->uart_flush();                                    /* uart flush */
+    res = BA121_UART_FLUSH(handle);                                /* uart flush */
     if (res != 0)                                                  /* check result */
     {
-        handle->debug_print("ba121: uart flush failed.\n");        /* uart flush failed */
+        BA121_DEBUG_PRINT(handle, "ba121: uart flush failed.\n");  /* uart flush failed */
         
         return 1;                                                  /* return error */
     }
-    res = handle->uart_write(buf, len);                            /* uart write */
+    res = BA121_UART_WRITE(handle, buf, len);                      /* uart write */
     if (res != 0)                                                  /* check result */
     {
-        handle->debug_print("ba121: uart write failed.\n");        /* uart write failed */
+        BA121_DEBUG_PRINT(handle, "ba121: uart write failed.\n");  /* uart write failed */
         
         return 1;                                                  /* return error */
     }
@@ -617,10 +1904,10 @@ uint8_t ba121_get_buffer(ba121_handle_t *handle, uint8_t *buf, uint16_t len)
         return 3;                                                 /* return error */
     }
     
-    l = handle->uart_read((uint8_t *)buf, len);                   /* uart read */
+    l = BA121_UART_READ(handle, (uint8_t *)buf, len);             /* uart read */
     if (l != len)                                                 /* check result */
     {
-        handle->debug_print("ba121: uart read failed.\n");        /* uart read failed */
+        BA121_DEBUG_PRINT(handle, "ba121: uart read failed.\n");  /* uart read failed */
        
         return 1;                                                 /* return error */
     }
@@ -56,6 +56,52 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief ba121 static link definition
+ * @note  1 calls the ba121_interface_* functions directly and drops the function pointers from the handle,
+ *        build with lto to let the compiler inline them
+ */
+#ifndef BA121_STATIC_LINK
+    #define BA121_STATIC_LINK                0          /**< link through the handle */
+#endif
+
+/**
+ * @brief ba121 static hook definition
+ * @note  with BA121_STATIC_LINK the optional hooks are chosen at build time and their pointers leave the handle,
+ *        1 calls the ba121_interface_* function directly, 0 builds the driver as if the hook were NULL
+ */
+#ifndef BA121_STATIC_TIMESTAMP
+    #define BA121_STATIC_TIMESTAMP           0          /**< no timestamp_us */
+#endif
+#ifndef BA121_STATIC_WAIT_REPLY
+    #define BA121_STATIC_WAIT_REPLY          0          /**< no wait_reply */
+#endif
+#ifndef BA121_STATIC_OS
+    #define BA121_STATIC_OS                  0          /**< no os functions */
+#endif
+
+/**
+ * @brief ba121 queue enable definition
+ * @note  0 drops the command queue and the async api, the handle then only holds the blocking path
+ */
+#ifndef BA121_QUEUE_ENABLE
+    #define BA121_QUEUE_ENABLE               1          /**< build the queue */
+#endif
+
+/**
+ * @brief ba121 queue depth definition
+ */
+#ifndef BA121_QUEUE_DEPTH
+    #define BA121_QUEUE_DEPTH                4          /**< 4 commands */
+#endif
+
+/**
+ * @brief ba121 queue timeout margin definition
+ */
+#ifndef BA121_QUEUE_TIMEOUT_MARGIN_MS
+    #define BA121_QUEUE_TIMEOUT_MARGIN_MS    200        /**< 200ms after the command delay */
+#endif
+
 /**
  * @brief ba121 status enumeration definition
  */
@@ -68,11 +114,71 @@ typedef enum
     BA121_STATUS_TEMPERATURE_OUT_OF_RANGE = 0x04,        /**< temperature out of range */
 } ba121_status_t;
 
+/**
+ * @brief ba121 retry enumeration definition
+ */
+typedef enum
+{
+    BA121_RETRY_NONE           = 0x00,        /**< never retry */
+    BA121_RETRY_LINK_ERROR     = 0x01,        /**< flush, write or short read error */
+    BA121_RETRY_FRAME_ERROR    = 0x02,        /**< checksum or frame header error */
+    BA121_RETRY_RESPONSE_ERROR = 0x04,        /**< non-zero response status */
+    BA121_RETRY_ALL            = 0x07,        /**< all errors */
+} ba121_retry_t;
+
+#if (BA121_QUEUE_ENABLE == 1)
+
+/**
+ * @brief ba121 queue command enumeration definition
+ */
+typedef enum
+{
+    BA121_QUEUE_COMMAND_READ           = 0xA0,        /**< read, data reply */
+    BA121_QUEUE_COMMAND_NTC_RESISTANCE = 0xA3,        /**< set ntc resistance, ack reply */
+    BA121_QUEUE_COMMAND_NTC_B          = 0xA5,        /**< set ntc b, ack reply */
+    BA121_QUEUE_COMMAND_BASELINE       = 0xA6,        /**< baseline calibration, ack reply */
+} ba121_queue_command_t;
+
+/**
+ * @brief ba121 handle structure declaration
+ */
+struct ba121_handle_s;
+
+/**
+ * @brief ba121 queue entry structure definition
+ */
+typedef struct ba121_queue_entry_s
+{
+    void (*callback)(struct ba121_handle_s *handle, uint8_t command,
+                     uint8_t res, uint32_t data, void *user);       /**< point to a completion callback */
+    union
+    {
+        void (*read)(struct ba121_handle_s *handle, uint8_t res,
+                     uint16_t conductivity_raw, uint16_t conductivity_us_cm,
+                     uint16_t temperature_raw, float temperature,
+                     void *user);                                   /**< point to an async read callback */
+        void (*done)(struct ba121_handle_s *handle, uint8_t res,
+                     void *user);                                   /**< point to an async command callback */
+    } async;                                                        /**< async callback */
+    void *user;                                                     /**< user pointer */
+    uint32_t param;                                                 /**< command data */
+    uint32_t seq;                                                   /**< submit order */
+    uint64_t tx_us;                                                 /**< transmit time */
+    uint32_t time_ms;                                               /**< earliest send time or reply deadline */
+    uint8_t command;                                                /**< command */
+    uint8_t state;                                                  /**< free, queued or in flight */
+    uint8_t attempts;                                               /**< sent attempts */
+    uint8_t kind;                                                   /**< queue, async read or async command */
+} ba121_queue_entry_t;
+
+#endif
+
 /**
  * @brief ba121 handle structure definition
  */
 typedef struct ba121_handle_s
 {
+#if (BA121_STATIC_LINK == 0)
     uint8_t (*uart_init)(void);                               /**< point to an uart_init function address */
     uint8_t (*uart_deinit)(void);                             /**< point to an uart_deinit function address */
     uint16_t (*uart_read)(uint8_t *buf, uint16_t len);        /**< point to an uart_read function address */
@@ -80,8 +186,40 @@ typedef struct ba121_handle_s
     uint8_t (*uart_write)(uint8_t *buf, uint16_t len);        /**< point to an uart_write function address */
     void (*delay_ms)(uint32_t ms);                            /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);          /**< point to a debug_print function address */
+    uint64_t (*timestamp_us)(void);                           /**< point to a timestamp_us function address, can be NULL */
+    uint8_t (*wait_reply)(uint16_t len, uint32_t timeout_ms); /**< point to a wait_reply function address, can be NULL */
+    void (*os_lock)(void);                                    /**< point to an os_lock function address, can be NULL */
+    void (*os_unlock)(void);                                  /**< point to an os_unlock function address, can be NULL */
+    uint8_t (*os_sem_wait)(uint32_t timeout_ms);              /**< point to an os_sem_wait function address, can be NULL */
+    void (*os_sem_give)(void);                                /**< point to an os_sem_give function address, can be NULL */
+#endif
+    uint64_t last_tx_us;                                      /**< transmit time of the last command */
+    uint64_t last_rx_us;                                      /**< arrival time of the last reply, 0 after a fixed delay */
     uint8_t inited;                                           /**< inited flag */
     uint8_t last_status;                                      /**< last status */
+    uint8_t retry_attempts;                                   /**< max attempts */
+    uint8_t retry_mask;                                       /**< retried errors */
+    uint16_t retry_backoff_ms;                                /**< initial backoff */
+    uint16_t retry_max_backoff_ms;                            /**< max backoff */
+    uint8_t last_attempts;                                    /**< attempts of the last command */
+#if (BA121_QUEUE_ENABLE == 1)
+    ba121_queue_entry_t queue[BA121_QUEUE_DEPTH];             /**< command queue */
+    uint32_t queue_seq;                                       /**< queue submit counter */
+    uint8_t rx_buf[12];                                       /**< reply stream buffer */
+    uint8_t rx_len;                                           /**< reply stream length */
+#endif
+#if (BA121_STATIC_LINK == 0) || (BA121_STATIC_OS == 1)
+    uint8_t bus_busy;                                         /**< a blocking command owns the uart */
+    uint8_t bus_read;                                         /**< the owner is a read */
+    uint8_t bus_waiters;                                      /**< tasks waiting for the bus */
+    uint8_t bus_read_res;                                     /**< result of the last shared read */
+    uint32_t bus_release;                                     /**< bus release counter */
+    uint32_t bus_read_started;                                /**< started read counter */
+    uint32_t bus_read_done;                                   /**< finished read counter */
+    uint32_t bus_read_data;                                   /**< data of the last shared read */
+    uint64_t bus_read_tx_us;                                  /**< transmit time of the last shared read */
+    uint64_t bus_read_rx_us;                                  /**< arrival time of the last shared read */
+#endif
 } ba121_handle_t;
 
 /**
@@ -119,6 +257,8 @@ typedef struct ba121_info_s
  */
 #define DRIVER_BA121_LINK_INIT(HANDLE, STRUCTURE)            memset(HANDLE, 0, sizeof(STRUCTURE))
 
+#if (BA121_STATIC_LINK == 0)
+
 /**
  * @brief     link uart_init function
  * @param[in] HANDLE pointer to a ba121 handle structure
@@ -175,6 +315,171 @@ typedef struct ba121_info_s
  */
 #define DRIVER_BA121_LINK_DEBUG_PRINT(HANDLE, FUC)          (HANDLE)->debug_print = FUC
 
+#else
+
+/**
+ * @brief     link uart_init function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an uart_init function address
+ * @note      the ba121_interface_* function is called directly
+ */
+#define DRIVER_BA121_LINK_UART_INIT(HANDLE, FUC)            (void)(HANDLE)
+
+/**
+ * @brief     link uart_deinit function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an uart_deinit function address
+ * @note      the ba121_interface_* function is called directly
+ */
+#define DRIVER_BA121_LINK_UART_DEINIT(HANDLE, FUC)          (void)(HANDLE)
+
+/**
+ * @brief     link uart_read function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an uart_read function address
+ * @note      the ba121_interface_* function is called directly
+ */
+#define DRIVER_BA121_LINK_UART_READ(HANDLE, FUC)            (void)(HANDLE)
+
+/**
+ * @brief     link uart_write function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an uart_write function address
+ * @note      the ba121_interface_* function is called directly
+ */
+#define DRIVER_BA121_LINK_UART_WRITE(HANDLE, FUC)           (void)(HANDLE)
+
+/**
+ * @brief     link uart_flush function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an uart_flush function address
+ * @note      the ba121_interface_* function is called directly
+ */
+#define DRIVER_BA121_LINK_UART_FLUSH(HANDLE, FUC)           (void)(HANDLE)
+
+/**
+ * @brief     link delay_ms function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to a delay_ms function address
+ * @note      the ba121_interface_* function is called directly
+ */
+#define DRIVER_BA121_LINK_DELAY_MS(HANDLE, FUC)             (void)(HANDLE)
+
+/**
+ * @brief     link debug_print function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to a debug_print function address
+ * @note      the ba121_interface_* function is called directly
+ */
+#define DRIVER_BA121_LINK_DEBUG_PRINT(HANDLE, FUC)          (void)(HANDLE)
+
+#endif
+
+#if (BA121_STATIC_LINK == 0)
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      optional, the function returns a monotonic time in us
+ */
+#define DRIVER_BA121_LINK_TIMESTAMP_US(HANDLE, FUC)         (HANDLE)->timestamp_us = FUC
+
+/**
+ * @brief     link wait_reply function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to a wait_reply function address
+ * @note      optional, the function returns 0 once len bytes are readable and 1 at the timeout,
+ *            it may sleep meanwhile, without it the driver delays the whole reply time
+ */
+#define DRIVER_BA121_LINK_WAIT_REPLY(HANDLE, FUC)           (HANDLE)->wait_reply = FUC
+
+/**
+ * @brief     link os_lock function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_lock function address
+ * @note      optional, link all four os functions to share the handle between tasks,
+ *            the function blocks until the mutex is held
+ */
+#define DRIVER_BA121_LINK_OS_LOCK(HANDLE, FUC)              (HANDLE)->os_lock = FUC
+
+/**
+ * @brief     link os_unlock function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_unlock function address
+ * @note      optional
+ */
+#define DRIVER_BA121_LINK_OS_UNLOCK(HANDLE, FUC)            (HANDLE)->os_unlock = FUC
+
+/**
+ * @brief     link os_sem_wait function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_sem_wait function address
+ * @note      optional, the function takes the counting semaphore and returns 0,
+ *            or returns 1 at the timeout
+ */
+#define DRIVER_BA121_LINK_OS_SEM_WAIT(HANDLE, FUC)          (HANDLE)->os_sem_wait = FUC
+
+/**
+ * @brief     link os_sem_give function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_sem_give function address
+ * @note      optional, the semaphore count must hold one give per waiting task
+ */
+#define DRIVER_BA121_LINK_OS_SEM_GIVE(HANDLE, FUC)          (HANDLE)->os_sem_give = FUC
+
+#else
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      BA121_STATIC_TIMESTAMP selects the ba121_interface_* function
+ */
+#define DRIVER_BA121_LINK_TIMESTAMP_US(HANDLE, FUC)         (void)(HANDLE)
+
+/**
+ * @brief     link wait_reply function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to a wait_reply function address
+ * @note      BA121_STATIC_WAIT_REPLY selects the ba121_interface_* function
+ */
+#define DRIVER_BA121_LINK_WAIT_REPLY(HANDLE, FUC)           (void)(HANDLE)
+
+/**
+ * @brief     link os_lock function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_lock function address
+ * @note      BA121_STATIC_OS selects the ba121_interface_* function
+ */
+#define DRIVER_BA121_LINK_OS_LOCK(HANDLE, FUC)              (void)(HANDLE)
+
+/**
+ * @brief     link os_unlock function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_unlock function address
+ * @note      BA121_STATIC_OS selects the ba121_interface_* function
+ */
+#define DRIVER_BA121_LINK_OS_UNLOCK(HANDLE, FUC)            (void)(HANDLE)
+
+/**
+ * @brief     link os_sem_wait function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_sem_wait function address
+ * @note      BA121_STATIC_OS selects the ba121_interface_* function
+ */
+#define DRIVER_BA121_LINK_OS_SEM_WAIT(HANDLE, FUC)          (void)(HANDLE)
+
+/**
+ * @brief     link os_sem_give function
+ * @param[in] HANDLE pointer to a ba121 handle structure
+ * @param[in] FUC pointer to an os_sem_give function address
+ * @note      BA121_STATIC_OS selects the ba121_interface_* function
+ */
+#define DRIVER_BA121_LINK_OS_SEM_GIVE(HANDLE, FUC)          (void)(HANDLE)
+
+#endif
+
 /**
  * @}
  */
@@ -233,11 +538,50 @@ uint8_t ba121_deinit(ba121_handle_t *handle);
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 frame error
- * @note       none
+ * @note       with the os functions linked the calls of several tasks are serialised,
+ *             a read that arrives during an in-flight read returns the result of that read
  */
 uint8_t ba121_read(ba121_handle_t *handle, uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
                    uint16_t *temperature_raw, float *temperature);
 
+/**
+ * @brief      read the data with its timestamps
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *conductivity_raw pointer to a conductivity raw data buffer
+ * @param[out] *conductivity_us_cm pointer to a conductivity uS/cm data buffer
+ * @param[out] *temperature_raw pointer to a temperature raw data buffer
+ * @param[out] *temperature pointer to a converted temperature data buffer
+ * @param[out] *tx_us pointer to a command transmit time buffer
+ * @param[out] *rx_us pointer to a reply arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 frame error
+ * @note       the times come from the linked timestamp_us function and are 0 without it,
+ *             rx_us is the reply arrival only with the wait_reply function linked and 0 without it,
+ *             because the fixed delay hides when the frame arrived,
+ *             a shared read returns the times of the in-flight read
+ */
+uint8_t ba121_read_with_timestamp(ba121_handle_t *handle, uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
+                                  uint16_t *temperature_raw, float *temperature, uint64_t *tx_us, uint64_t *rx_us);
+
+/**
+ * @brief      get the timestamps of the last transaction
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *tx_us pointer to a command transmit time buffer
+ * @param[out] *rx_us pointer to a reply arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       call it from an async or queue callback to get the times of the finished command,
+ *             the queue path stamps rx_us when the frame is assembled,
+ *             the blocking path sets rx_us only with the wait_reply function linked
+ */
+uint8_t ba121_get_timestamp(ba121_handle_t *handle, uint64_t *tx_us, uint64_t *rx_us);
+
 /**
  * @brief     baseline calibration
  * @param[in] *handle pointer to a ba121 handle structure
@@ -294,10 +638,251 @@ uint8_t ba121_set_ntc_b(ba121_handle_t *handle, uint16_t value);
  */
 uint8_t ba121_get_last_status(ba121_handle_t *handle, ba121_status_t *status);
 
+/**
+ * @brief     set the retry policy
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] attempts max attempts including the first one
+ * @param[in] backoff_ms backoff before the first retry
+ * @param[in] max_backoff_ms max backoff, the backoff doubles after every retry
+ * @param[in] mask retried errors, a combination of ba121_retry_t
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 attempts is invalid
+ *            - 5 backoff is invalid
+ *            - 6 mask is invalid
+ * @note      the line is resynchronised between attempts,
+ *            the backoff should cover one frame time (7ms at 9600 baud)
+ */
+uint8_t ba121_set_retry(ba121_handle_t *handle, uint8_t attempts, uint16_t backoff_ms,
+                        uint16_t max_backoff_ms, uint8_t mask);
+
+/**
+ * @brief      get the retry policy
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *attempts pointer to a max attempts buffer
+ * @param[out] *backoff_ms pointer to an initial backoff buffer
+ * @param[out] *max_backoff_ms pointer to a max backoff buffer
+ * @param[out] *mask pointer to a retried errors buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ba121_get_retry(ba121_handle_t *handle, uint8_t *attempts, uint16_t *backoff_ms,
+                        uint16_t *max_backoff_ms, uint8_t *mask);
+
+/**
+ * @brief      get the attempts of the last command
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *attempts pointer to an attempts buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       1 means the command passed or failed without a retry
+ */
+uint8_t ba121_get_last_attempts(ba121_handle_t *handle, uint8_t *attempts);
+
 /**
  * @}
  */
 
+#if (BA121_QUEUE_ENABLE == 1)
+
+/**
+ * @defgroup ba121_queue_driver ba121 queue driver function
+ * @brief    ba121 queue driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief     submit a command to the queue
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] command queued command
+ * @param[in] param command data, ohm for the ntc resistance and the value for the ntc b
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 command is invalid
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error,
+ *            data holds the raw reply, conductivity << 16 | temperature for a read and status << 24 for an ack,
+ *            the queue and async functions are not guarded by the os functions, call them from one task
+ */
+uint8_t ba121_queue_submit(ba121_handle_t *handle, ba121_queue_command_t command, uint32_t param,
+                           void (*callback)(ba121_handle_t *handle, uint8_t command, uint8_t res, uint32_t data, void *user),
+                           void *user);
+
+/**
+ * @brief     run the queue
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      one read and one ack command can be in flight at the same time, replies are matched by frame type,
+ *            commands of the same reply type keep their submit order, call it whenever the uart has data
+ *            or a deadline expires, completions run inside this function
+ */
+uint8_t ba121_queue_process(ba121_handle_t *handle, uint32_t now_ms);
+
+/**
+ * @brief      get the queued command count
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[out] *count pointer to a count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       queued and in flight commands are counted
+ */
+uint8_t ba121_queue_get_count(ba121_handle_t *handle, uint8_t *count);
+
+/**
+ * @brief     cancel all queued commands
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      every cancelled command completes with res 1
+ */
+uint8_t ba121_queue_cancel(ba121_handle_t *handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ba121_async_driver ba121 async driver function
+ * @brief    ba121 async driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief     start an async read
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] *callback pointer to a completion callback
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 callback is NULL
+ * @note      the callback gets res 0 on success and 1 on a link error or timeout,
+ *            the data are only valid with res 0
+ */
+uint8_t ba121_async_read(ba121_handle_t *handle,
+                         void (*callback)(ba121_handle_t *handle, uint8_t res,
+                                          uint16_t conductivity_raw, uint16_t conductivity_us_cm,
+                                          uint16_t temperature_raw, float temperature, void *user),
+                         void *user);
+
+/**
+ * @brief     start an async baseline calibration
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error
+ */
+uint8_t ba121_async_baseline_calibration(ba121_handle_t *handle,
+                                         void (*callback)(ba121_handle_t *handle, uint8_t res, void *user),
+                                         void *user);
+
+/**
+ * @brief     start an async ntc resistance setting
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] ohm resistance ohm
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error
+ */
+uint8_t ba121_async_set_ntc_resistance(ba121_handle_t *handle, uint32_t ohm,
+                                       void (*callback)(ba121_handle_t *handle, uint8_t res, void *user),
+                                       void *user);
+
+/**
+ * @brief     start an async ntc b setting
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] value ntc value
+ * @param[in] *callback pointer to a completion callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 1 queue is full
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback gets res 0 on success, 1 on a link error or timeout and 5 on a response error
+ */
+uint8_t ba121_async_set_ntc_b(ba121_handle_t *handle, uint16_t value,
+                              void (*callback)(ba121_handle_t *handle, uint8_t res, void *user),
+                              void *user);
+
+/**
+ * @brief      get the time until the driver needs to run again
+ * @param[in]  *handle pointer to a ba121 handle structure
+ * @param[in]  now_ms current time in ms
+ * @param[out] *timeout_ms pointer to a timeout buffer, 0xFFFFFFFF when idle
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       use it as the epoll_wait, uv_timer or queue receive timeout,
+ *             then call ba121_async_timeout when it expires
+ */
+uint8_t ba121_async_get_timeout(ba121_handle_t *handle, uint32_t now_ms, uint32_t *timeout_ms);
+
+/**
+ * @brief     signal that the uart has data
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      call it from the event loop when the uart fd is readable or the rx interrupt posted an event,
+ *            completion callbacks run inside this function and may start new operations
+ */
+uint8_t ba121_async_readable(ba121_handle_t *handle, uint32_t now_ms);
+
+/**
+ * @brief     signal that the driver timeout expired
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] now_ms current time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      completion callbacks run inside this function and may start new operations
+ */
+uint8_t ba121_async_timeout(ba121_handle_t *handle, uint32_t now_ms);
+
+/**
+ * @}
+ */
+
+#endif
+
 /**
  * @defgroup ba121_extern_driver ba121 extern driver function
  * @brief    ba121 extern driver modules
@@ -0,0 +1,486 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121.hpp
+ * @brief     driver ba121 c++ header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_HPP
+#define DRIVER_BA121_HPP
+
+#if !defined(__cplusplus) || (__cplusplus < 201703L)
+    #error "driver_ba121.hpp needs c++17"
+#endif
+
+#include "driver_ba121.h"
+#include "driver_ba121_frame.h"
+#include "driver_ba121_interface.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * @defgroup ba121_cpp_driver ba121 c++ driver function
+ * @brief    ba121 c++ driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+namespace ba121
+{
+
+/**
+ * @brief ba121 error enumeration definition
+ * @note  the values match the c driver status codes
+ */
+enum class errc : uint8_t
+{
+    link       = 1,        /**< uart flush, write or read failed, or timeout */
+    handle     = 2,        /**< handle is NULL */
+    not_inited = 3,        /**< handle is not initialized */
+    frame      = 4,        /**< frame error */
+    response   = 5,        /**< response error */
+};
+
+/**
+ * @brief ba121 result class definition
+ * @note  holds a value or an errc, no exceptions and no allocation
+ */
+template <typename T>
+class result
+{
+    public:
+        constexpr result(const T &value) noexcept : m_value(value), m_error(0)
+        {
+        }
+        constexpr result(errc error) noexcept : m_value{}, m_error(static_cast<uint8_t>(error))
+        {
+        }
+        
+        constexpr bool has_value() const noexcept
+        {
+            return m_error == 0;
+        }
+        constexpr explicit operator bool() const noexcept
+        {
+            return m_error == 0;
+        }
+        constexpr const T &value() const noexcept
+        {
+            return m_value;
+        }
+        constexpr const T &operator*() const noexcept
+        {
+            return m_value;
+        }
+        constexpr const T *operator->() const noexcept
+        {
+            return &m_value;
+        }
+        constexpr T value_or(const T &other) const noexcept
+        {
+            return (m_error == 0) ? m_value : other;
+        }
+        constexpr errc error() const noexcept
+        {
+            return static_cast<errc>(m_error);
+        }
+        
+        /**
+         * @brief  get the c driver status code
+         * @return status code, 0 on success
+         */
+        constexpr uint8_t code() const noexcept
+        {
+            return m_error;
+        }
+        
+    private:
+        T m_value;              /**< value */
+        uint8_t m_error;        /**< 0 or errc */
+};
+
+template <>
+class result<void>
+{
+    public:
+        constexpr result() noexcept : m_error(0)
+        {
+        }
+        constexpr result(errc error) noexcept : m_error(static_cast<uint8_t>(error))
+        {
+        }
+        
+        constexpr bool has_value() const noexcept
+        {
+            return m_error == 0;
+        }
+        constexpr explicit operator bool() const noexcept
+        {
+            return m_error == 0;
+        }
+        constexpr errc error() const noexcept
+        {
+            return static_cast<errc>(m_error);
+        }
+        constexpr uint8_t code() const noexcept
+        {
+            return m_error;
+        }
+        
+        /**
+         * @brief     convert a c driver status code
+         * @param[in] res status code
+         * @return    result
+         */
+        static constexpr result from_code(uint8_t res) noexcept
+        {
+            return (res == 0) ? result() : result(static_cast<errc>(res));
+        }
+        
+    private:
+        uint8_t m_error;        /**< 0 or errc */
+};
+
+/**
+ * @brief ba121 sample structure definition
+ */
+struct sample
+{
+    uint16_t conductivity_raw;          /**< conductivity raw */
+    uint16_t conductivity_us_cm;        /**< conductivity in uS/cm */
+    uint16_t temperature_raw;           /**< temperature raw */
+    float temperature;                  /**< temperature in C */
+};
+
+/**
+ * @brief ba121 frame namespace definition
+ * @note  compile time copies of the command frames for code outside the driver, e.g. a bus logger or
+ *        a table in flash, the handle classes send the frames of the c driver, the constants come from
+ *        driver_ba121_frame.h and the c++ test checks every frame against ba121_frame_make
+ */
+namespace frame
+{
+
+/**
+ * @brief ba121 frame type definition
+ */
+using type = std::array<uint8_t, BA121_FRAME_LEN>;
+
+inline constexpr uint8_t command_read           = BA121_COMMAND_READ;         /**< read command */
+inline constexpr uint8_t command_ntc_resistance = BA121_COMMAND_NTC_RES;      /**< ntc resistance command */
+inline constexpr uint8_t command_ntc_b          = BA121_COMMAND_NTC_B;        /**< ntc b command */
+inline constexpr uint8_t command_baseline       = BA121_COMMAND_BASELINE;     /**< baseline command */
+inline constexpr uint8_t header_data            = BA121_FRAME_DATA;           /**< data reply header */
+inline constexpr uint8_t header_ack             = BA121_FRAME_ACK;            /**< ack reply header */
+
+/**
+ * @brief     get the checksum of a frame
+ * @param[in] *buf pointer to a 6 bytes frame
+ * @return    checksum of bytes 0 - 4
+ */
+constexpr uint8_t checksum(const uint8_t *buf) noexcept
+{
+    return static_cast<uint8_t>(buf[0] + buf[1] + buf[2] + buf[3] + buf[4]);
+}
+
+/**
+ * @brief     make a command frame
+ * @param[in] command input command
+ * @param[in] data input data
+ * @return    frame
+ * @note      same layout as the c driver, usable in constant expressions
+ */
+constexpr type make(uint8_t command, uint32_t data) noexcept
+{
+    type f{command,
+           static_cast<uint8_t>(data >> 24), static_cast<uint8_t>(data >> 16),
+           static_cast<uint8_t>(data >> 8), static_cast<uint8_t>(data >> 0),
+           0};
+    
+    f[5] = checksum(f.data());
+    
+    return f;
+}
+
+inline constexpr type read     = make(command_read, 0);            /**< read frame */
+inline constexpr type baseline = make(command_baseline, 0);        /**< baseline frame */
+
+/**
+ * @brief ba121 ntc resistance frame definition
+ */
+template <uint32_t Ohm>
+inline constexpr type ntc_resistance = make(command_ntc_resistance, Ohm);
+
+/**
+ * @brief ba121 ntc b frame definition
+ */
+template <uint16_t Value>
+inline constexpr type ntc_b = make(command_ntc_b, static_cast<uint32_t>(Value) << 16);
+
+static_assert((read[0] == 0xA0) && (read[5] == 0xA0), "read frame");
+static_assert((baseline[0] == 0xA6) && (baseline[5] == 0xA6), "baseline frame");
+static_assert(ntc_b<3950>[5] == static_cast<uint8_t>(0xA5 + 0x0F + 0x6E), "ntc b frame");
+
+/**
+ * @brief      parse a reply frame
+ * @param[in]  *buf pointer to a 6 bytes frame
+ * @param[in]  header expected header
+ * @return     raw data or errc::frame
+ */
+constexpr result<uint32_t> parse(const uint8_t *buf, uint8_t header) noexcept
+{
+    if ((checksum(buf) != buf[5]) || (buf[0] != header))
+    {
+        return errc::frame;
+    }
+    
+    return (static_cast<uint32_t>(buf[1]) << 24) | (static_cast<uint32_t>(buf[2]) << 16) |
+           (static_cast<uint32_t>(buf[3]) << 8) | (static_cast<uint32_t>(buf[4]) << 0);
+}
+
+} /* namespace frame */
+
+/**
+ * @brief ba121 c handle class definition
+ * @note  runs ba121_init in the constructor and ba121_deinit in the destructor,
+ *        every call goes through the c driver, so the retry policy, the reply wait and the time stamps apply
+ */
+class handle
+{
+    public:
+        /**
+         * @brief     initialize the chip
+         * @param[in] &links ba121 handle structure with the DRIVER_BA121_LINK_* functions set
+         */
+        explicit handle(const ba121_handle_t &links) noexcept : m_handle(links)
+        {
+            m_handle.inited = 0;
+            m_status = ba121_init(&m_handle);
+        }
+        handle(const handle &) = delete;
+        handle &operator=(const handle &) = delete;
+        ~handle()
+        {
+            if (m_status == 0)
+            {
+                (void)ba121_deinit(&m_handle);
+            }
+        }
+        
+        /**
+         * @brief  get the init result
+         * @return result
+         */
+        result<void> status() const noexcept
+        {
+            return result<void>::from_code(m_status);
+        }
+        
+        /**
+         * @brief  get the c handle
+         * @return pointer to the ba121 handle structure
+         */
+        ba121_handle_t *native() noexcept
+        {
+            return &m_handle;
+        }
+        
+        /**
+         * @brief  read data
+         * @return sample or error
+         */
+        result<sample> read() noexcept
+        {
+            sample s{};
+            uint8_t res;
+            
+            res = ba121_read(&m_handle, &s.conductivity_raw, &s.conductivity_us_cm, &s.temperature_raw, &s.temperature);
+            if (res != 0)
+            {
+                return static_cast<errc>(res);
+            }
+            
+            return s;
+        }
+        
+        /**
+         * @brief  run the baseline calibration
+         * @return result
+         */
+        result<void> calibrate_baseline() noexcept
+        {
+            return result<void>::from_code(ba121_baseline_calibration(&m_handle));
+        }
+        
+        /**
+         * @brief     set the ntc resistance
+         * @param[in] ohm resistance ohm
+         * @return    result
+         */
+        result<void> set_ntc_resistance(uint32_t ohm) noexcept
+        {
+            return result<void>::from_code(ba121_set_ntc_resistance(&m_handle, ohm));
+        }
+        
+        /**
+         * @brief     set the ntc b
+         * @param[in] value ntc value
+         * @return    result
+         */
+        result<void> set_ntc_b(uint16_t value) noexcept
+        {
+            return result<void>::from_code(ba121_set_ntc_b(&m_handle, value));
+        }
+        
+    private:
+        ba121_handle_t m_handle;        /**< c handle */
+        uint8_t m_status;               /**< init status code */
+};
+
+/**
+ * @brief ba121 static transport class definition
+ * @note  binds the ba121_interface_* style functions at compile time, e.g.
+ *        ba121::static_transport<ba121_interface_uart_init, ba121_interface_uart_deinit,
+ *        ba121_interface_uart_read, ba121_interface_uart_flush,
+ *        ba121_interface_uart_write, ba121_interface_delay_ms,
+ *        ba121_interface_debug_print, ba121_interface_wait_reply, ba121_interface_timestamp_us>,
+ *        the wait_reply and timestamp_us functions may be nullptr
+ */
+template <uint8_t (*Init)(void), uint8_t (*Deinit)(void),
+          uint16_t (*Read)(uint8_t *, uint16_t), uint8_t (*Flush)(void),
+          uint8_t (*Write)(uint8_t *, uint16_t), void (*Delay)(uint32_t),
+          void (*Print)(const char *const, ...),
+          uint8_t (*WaitReply)(uint16_t, uint32_t) = nullptr,
+          uint64_t (*Timestamp)(void) = nullptr>
+struct static_transport
+{
+    static constexpr uint8_t (*uart_init)(void) = Init;                           /**< uart init */
+    static constexpr uint8_t (*uart_deinit)(void) = Deinit;                       /**< uart deinit */
+    static constexpr uint16_t (*uart_read)(uint8_t *, uint16_t) = Read;           /**< uart read */
+    static constexpr uint8_t (*uart_flush)(void) = Flush;                         /**< uart flush */
+    static constexpr uint8_t (*uart_write)(uint8_t *, uint16_t) = Write;          /**< uart write */
+    static constexpr void (*delay_ms)(uint32_t) = Delay;                          /**< delay ms */
+    static constexpr void (*debug_print)(const char *const, ...) = Print;         /**< debug print */
+    static constexpr uint8_t (*wait_reply)(uint16_t, uint32_t) = WaitReply;       /**< wait reply */
+    static constexpr uint64_t (*timestamp_us)(void) = Timestamp;                  /**< timestamp us */
+};
+
+/**
+ * @brief ba121 interface transport definition
+ * @note  the ba121_interface_* functions, wait_reply and timestamp_us follow BA121_STATIC_WAIT_REPLY and
+ *        BA121_STATIC_TIMESTAMP when BA121_STATIC_LINK is 1, so the driver and the transport agree
+ */
+using interface_transport = static_transport<ba121_interface_uart_init, ba121_interface_uart_deinit,
+                                             ba121_interface_uart_read, ba121_interface_uart_flush,
+                                             ba121_interface_uart_write, ba121_interface_delay_ms,
+                                             ba121_interface_debug_print,
+#if (BA121_STATIC_LINK == 1) && (BA121_STATIC_WAIT_REPLY == 0)
+                                             nullptr,
+#else
+                                             ba121_interface_wait_reply,
+#endif
+#if (BA121_STATIC_LINK == 1) && (BA121_STATIC_TIMESTAMP == 0)
+                                             nullptr
+#else
+                                             ba121_interface_timestamp_us
+#endif
+                                             >;
+
+/**
+ * @brief ba121 device class definition
+ * @note  a handle whose link functions come from Transport, which provides static uart_init, uart_deinit,
+ *        uart_read, uart_flush, uart_write, delay_ms, debug_print, wait_reply and timestamp_us members
+ *        with the c link signatures, e.g. a static_transport, the protocol, the retry policy and the
+ *        time stamps are the ones of the c driver,
+ *        with BA121_STATIC_LINK 0 the members are copied into the handle and called through its pointers,
+ *        with BA121_STATIC_LINK 1 the driver calls the ba121_interface_* functions directly, so they resolve
+ *        at compile time and Transport must be interface_transport, any other binding fails to compile
+ */
+template <typename Transport = interface_transport>
+class device : public handle
+{
+#if (BA121_STATIC_LINK == 1)
+    static_assert((Transport::uart_init == interface_transport::uart_init) &&
+                  (Transport::uart_deinit == interface_transport::uart_deinit) &&
+                  (Transport::uart_read == interface_transport::uart_read) &&
+                  (Transport::uart_flush == interface_transport::uart_flush) &&
+                  (Transport::uart_write == interface_transport::uart_write) &&
+                  (Transport::delay_ms == interface_transport::delay_ms) &&
+                  (Transport::debug_print == interface_transport::debug_print),
+                  "BA121_STATIC_LINK calls the ba121_interface_* uart, delay and print functions, "
+                  "Transport can't bind others");
+    static_assert(Transport::wait_reply == interface_transport::wait_reply,
+                  "BA121_STATIC_WAIT_REPLY selects wait_reply, Transport can't bind another one");
+    static_assert(Transport::timestamp_us == interface_transport::timestamp_us,
+                  "BA121_STATIC_TIMESTAMP selects timestamp_us, Transport can't bind another one");
+#endif
+    
+    public:
+        /**
+         * @brief initialize the chip
+         */
+        device() noexcept : handle(links())
+        {
+        }
+        
+    private:
+        /**
+         * @brief  link the transport functions
+         * @return ba121 handle structure
+         * @note   the link macros are empty with BA121_STATIC_LINK 1
+         */
+        static ba121_handle_t links() noexcept
+        {
+            ba121_handle_t h;
+            
+            DRIVER_BA121_LINK_INIT(&h, ba121_handle_t);
+            DRIVER_BA121_LINK_UART_INIT(&h, Transport::uart_init);
+            DRIVER_BA121_LINK_UART_DEINIT(&h, Transport::uart_deinit);
+            DRIVER_BA121_LINK_UART_READ(&h, Transport::uart_read);
+            DRIVER_BA121_LINK_UART_FLUSH(&h, Transport::uart_flush);
+            DRIVER_BA121_LINK_UART_WRITE(&h, Transport::uart_write);
+            DRIVER_BA121_LINK_DELAY_MS(&h, Transport::delay_ms);
+            DRIVER_BA121_LINK_DEBUG_PRINT(&h, Transport::debug_print);
+            DRIVER_BA121_LINK_WAIT_REPLY(&h, Transport::wait_reply);
+            DRIVER_BA121_LINK_TIMESTAMP_US(&h, Transport::timestamp_us);
+            
+            return h;
+        }
+};
+
+} /* namespace ba121 */
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,338 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_alarm.c
+ * @brief     driver ba121 alarm source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_alarm.h"
+
+/**
+ * @brief     run one rule state machine
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] index rule index
+ * @param[in] value evaluated value
+ * @param[in] timestamp_ms sample time in ms
+ * @note      none
+ */
+static void a_ba121_alarm_step(ba121_alarm_handle_t *handle, uint8_t index, float value, uint32_t timestamp_ms)
+{
+    ba121_alarm_rule_t *rule;
+    uint8_t below;
+    uint8_t hit;
+
+    rule = &handle->rule[index];                                                        /* get rule */
+    below = (uint8_t)((rule->condition == BA121_ALARM_CONDITION_BELOW) ||
+                      (rule->condition == BA121_ALARM_CONDITION_RATE_BELOW));           /* direction */
+    if (handle->state[index] == BA121_ALARM_STATE_CLEAR)                                /* waiting to raise */
+    {
+        hit = (below != 0) ? (uint8_t)(value < rule->threshold) :
+                             (uint8_t)(value > rule->threshold);                        /* raise condition */
+    }
+    else                                                                                /* waiting to clear */
+    {
+        hit = (below != 0) ? (uint8_t)(value > rule->threshold + rule->hysteresis) :
+                             (uint8_t)(value < rule->threshold - rule->hysteresis);     /* clear condition */
+    }
+    if (hit == 0)                                                                       /* condition broken */
+    {
+        handle->pending[index] = 0;                                                     /* restart hold time */
+
+        return;                                                                         /* return */
+    }
+    if (handle->pending[index] == 0)                                                    /* first hit */
+    {
+        handle->pending[index] = 1;                                                     /* start hold time */
+        handle->since_ms[index] = timestamp_ms;                                         /* save start */
+    }
+    if ((uint32_t)(timestamp_ms - handle->since_ms[index]) >= rule->hold_ms)            /* held long enough */
+    {
+        handle->pending[index] = 0;                                                     /* clear pending */
+        handle->state[index] = (handle->state[index] == BA121_ALARM_STATE_CLEAR) ?
+                               BA121_ALARM_STATE_ACTIVE : BA121_ALARM_STATE_CLEAR;      /* toggle state */
+        if (handle->receive_callback != NULL)                                           /* check callback */
+        {
+            handle->receive_callback(handle, index, (ba121_alarm_state_t)handle->state[index],
+                                     value, handle->user);                              /* run callback */
+        }
+    }
+}
+
+/**
+ * @brief     initialize the alarm engine
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] *callback pointer to a transition callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      compensation starts with the default coefficient and reference
+ */
+uint8_t ba121_alarm_init(ba121_alarm_handle_t *handle,
+                         void (*callback)(ba121_alarm_handle_t *handle, uint8_t index,
+                                          ba121_alarm_state_t state, float value, void *user),
+                         void *user)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+
+    memset(handle, 0, sizeof(ba121_alarm_handle_t));                                    /* clear handle */
+    handle->coefficient = BA121_ALARM_DEFAULT_COEFFICIENT;                              /* set default coefficient */
+    handle->reference = BA121_ALARM_DEFAULT_REFERENCE;                                  /* set default reference */
+    handle->receive_callback = callback;                                                /* set callback */
+    handle->user = user;                                                                /* set user pointer */
+    handle->inited = 1;                                                                 /* flag finish initialization */
+
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the temperature compensation
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] coefficient compensation coefficient per degree
+ * @param[in] reference reference temperature in C
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      compensated = conductivity / (1 + coefficient * (temperature - reference))
+ */
+uint8_t ba121_alarm_set_compensation(ba121_alarm_handle_t *handle, float coefficient, float reference)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+
+    handle->coefficient = coefficient;                                                  /* set coefficient */
+    handle->reference = reference;                                                      /* set reference */
+
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      add a rule
+ * @param[in]  *handle pointer to a ba121 alarm handle structure
+ * @param[in]  *rule pointer to a ba121 alarm rule structure
+ * @param[out] *index pointer to a rule index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no free rule
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 rule is invalid
+ * @note       a new rule starts clear
+ */
+uint8_t ba121_alarm_add_rule(ba121_alarm_handle_t *handle, const ba121_alarm_rule_t *rule, uint8_t *index)
+{
+    uint8_t i;
+
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if ((rule == NULL) || (rule->source > BA121_ALARM_SOURCE_TEMPERATURE) ||
+        (rule->condition > BA121_ALARM_CONDITION_RATE_BELOW) ||
+        (rule->hysteresis < 0.0f))                                                      /* check rule */
+    {
+        return 4;                                                                       /* return error */
+    }
+
+    for (i = 0; i < BA121_ALARM_MAX_RULES; i++)                                         /* find a free rule */
+    {
+        if (handle->used[i] == 0)                                                       /* free */
+        {
+            handle->rule[i] = *rule;                                                    /* copy rule */
+            handle->state[i] = BA121_ALARM_STATE_CLEAR;                                 /* start clear */
+            handle->pending[i] = 0;                                                     /* nothing pending */
+            handle->used[i] = 1;                                                        /* flag used */
+            *index = i;                                                                 /* set index */
+
+            return 0;                                                                   /* success return 0 */
+        }
+    }
+
+    return 1;                                                                           /* return error */
+}
+
+/**
+ * @brief     remove a rule
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] index rule index
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 index is invalid
+ * @note      none
+ */
+uint8_t ba121_alarm_remove_rule(ba121_alarm_handle_t *handle, uint8_t index)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if ((index >= BA121_ALARM_MAX_RULES) || (handle->used[index] == 0))                 /* check index */
+    {
+        return 4;                                                                       /* return error */
+    }
+
+    handle->used[index] = 0;                                                            /* flag free */
+
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     evaluate all rules on one sample
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] conductivity_us_cm conductivity in uS/cm
+ * @param[in] temperature temperature in C
+ * @param[in] timestamp_ms sample time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback runs inline for every state transition
+ */
+uint8_t ba121_alarm_process(ba121_alarm_handle_t *handle, uint16_t conductivity_us_cm,
+                            float temperature, uint32_t timestamp_ms)
+{
+    uint8_t i;
+    uint8_t has_rate;
+    uint32_t dt_ms;
+    float factor;
+    float value[3];
+    float rate[3];
+
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+
+    factor = 1.0f + handle->coefficient * (temperature - handle->reference);            /* compensation factor */
+    value[BA121_ALARM_SOURCE_CONDUCTIVITY] = (float)conductivity_us_cm;                 /* conductivity */
+    value[BA121_ALARM_SOURCE_COMPENSATED_CONDUCTIVITY] = (factor > 0.0f) ?
+                                                         (float)conductivity_us_cm / factor :
+                                                         (float)conductivity_us_cm;     /* compensated conductivity */
+    value[BA121_ALARM_SOURCE_TEMPERATURE] = temperature;                                /* temperature */
+    dt_ms = (uint32_t)(timestamp_ms - handle->last_ms);                                 /* time step */
+    has_rate = (uint8_t)((handle->has_last != 0) && (dt_ms != 0));                      /* rate available */
+    for (i = 0; i < 3; i++)                                                             /* all sources */
+    {
+        rate[i] = (has_rate != 0) ? (value[i] - handle->last[i]) * 1000.0f / (float)dt_ms : 0.0f;
+    }
+
+    for (i = 0; i < BA121_ALARM_MAX_RULES; i++)                                         /* all rules */
+    {
+        ba121_alarm_condition_t condition;
+
+        if (handle->used[i] == 0)                                                       /* skip free rule */
+        {
+            continue;                                                                   /* next */
+        }
+        condition = handle->rule[i].condition;                                          /* get condition */
+        if ((condition == BA121_ALARM_CONDITION_RATE_ABOVE) ||
+            (condition == BA121_ALARM_CONDITION_RATE_BELOW))                            /* rate rule */
+        {
+            if (has_rate != 0)                                                          /* need two samples */
+            {
+                a_ba121_alarm_step(handle, i, rate[handle->rule[i].source], timestamp_ms);
+            }
+        }
+        else                                                                            /* level rule */
+        {
+            a_ba121_alarm_step(handle, i, value[handle->rule[i].source], timestamp_ms);
+        }
+    }
+
+    if ((handle->has_last == 0) || (dt_ms != 0))                                        /* keep the last sample */
+    {
+        for (i = 0; i < 3; i++)                                                         /* all sources */
+        {
+            handle->last[i] = value[i];                                                 /* save value */
+        }
+        handle->last_ms = timestamp_ms;                                                 /* save time */
+        handle->has_last = 1;                                                           /* flag valid */
+    }
+
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      get a rule state
+ * @param[in]  *handle pointer to a ba121 alarm handle structure
+ * @param[in]  index rule index
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 index is invalid
+ * @note       none
+ */
+uint8_t ba121_alarm_get_state(ba121_alarm_handle_t *handle, uint8_t index, ba121_alarm_state_t *state)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if ((index >= BA121_ALARM_MAX_RULES) || (handle->used[index] == 0))                 /* check index */
+    {
+        return 4;                                                                       /* return error */
+    }
+
+    *state = (ba121_alarm_state_t)handle->state[index];                                 /* set state */
+
+    return 0;                                                                           /* success return 0 */
+}
@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_alarm.h
+ * @brief     driver ba121 alarm header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_ALARM_H
+#define DRIVER_BA121_ALARM_H
+
+#include "driver_ba121.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_alarm_driver ba121 alarm driver function
+ * @brief    ba121 alarm driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief ba121 alarm max rules definition
+ */
+#ifndef BA121_ALARM_MAX_RULES
+    #define BA121_ALARM_MAX_RULES        8        /**< 8 rules */
+#endif
+
+/**
+ * @brief ba121 alarm default compensation definition
+ */
+#define BA121_ALARM_DEFAULT_COEFFICIENT        0.02f        /**< 2% per degree */
+#define BA121_ALARM_DEFAULT_REFERENCE          25.0f        /**< 25C */
+
+/**
+ * @brief ba121 alarm source enumeration definition
+ */
+typedef enum
+{
+    BA121_ALARM_SOURCE_CONDUCTIVITY             = 0x00,        /**< conductivity in uS/cm */
+    BA121_ALARM_SOURCE_COMPENSATED_CONDUCTIVITY = 0x01,        /**< compensated conductivity in uS/cm */
+    BA121_ALARM_SOURCE_TEMPERATURE              = 0x02,        /**< temperature in C */
+} ba121_alarm_source_t;
+
+/**
+ * @brief ba121 alarm condition enumeration definition
+ */
+typedef enum
+{
+    BA121_ALARM_CONDITION_ABOVE      = 0x00,        /**< value above threshold */
+    BA121_ALARM_CONDITION_BELOW      = 0x01,        /**< value below threshold */
+    BA121_ALARM_CONDITION_RATE_ABOVE = 0x02,        /**< rate of change per second above threshold */
+    BA121_ALARM_CONDITION_RATE_BELOW = 0x03,        /**< rate of change per second below threshold */
+} ba121_alarm_condition_t;
+
+/**
+ * @brief ba121 alarm state enumeration definition
+ */
+typedef enum
+{
+    BA121_ALARM_STATE_CLEAR  = 0x00,        /**< clear */
+    BA121_ALARM_STATE_ACTIVE = 0x01,        /**< active */
+} ba121_alarm_state_t;
+
+/**
+ * @brief ba121 alarm rule structure definition
+ */
+typedef struct ba121_alarm_rule_s
+{
+    ba121_alarm_source_t source;              /**< rule source */
+    ba121_alarm_condition_t condition;        /**< rule condition */
+    float threshold;                          /**< raise threshold */
+    float hysteresis;                         /**< distance from the threshold before clearing */
+    uint32_t hold_ms;                         /**< time a condition must hold before a transition */
+} ba121_alarm_rule_t;
+
+/**
+ * @brief ba121 alarm handle structure definition
+ */
+typedef struct ba121_alarm_handle_s
+{
+    ba121_alarm_rule_t rule[BA121_ALARM_MAX_RULES];                                /**< rules */
+    uint32_t since_ms[BA121_ALARM_MAX_RULES];                                      /**< pending transition start */
+    uint8_t used[BA121_ALARM_MAX_RULES];                                           /**< rule used flag */
+    uint8_t state[BA121_ALARM_MAX_RULES];                                          /**< rule state */
+    uint8_t pending[BA121_ALARM_MAX_RULES];                                        /**< pending transition flag */
+    float last[3];                                                                 /**< last source values */
+    uint32_t last_ms;                                                              /**< last sample time */
+    uint8_t has_last;                                                              /**< last sample valid flag */
+    float coefficient;                                                             /**< compensation coefficient */
+    float reference;                                                               /**< compensation reference temperature */
+    void (*receive_callback)(struct ba121_alarm_handle_s *handle, uint8_t index,
+                             ba121_alarm_state_t state, float value, void *user);  /**< point to a receive_callback function address */
+    void *user;                                                                    /**< user pointer */
+    uint8_t inited;                                                                /**< inited flag */
+} ba121_alarm_handle_t;
+
+/**
+ * @brief     initialize the alarm engine
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] *callback pointer to a transition callback, can be NULL
+ * @param[in] *user user pointer passed to the callback
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      compensation starts with the default coefficient and reference
+ */
+uint8_t ba121_alarm_init(ba121_alarm_handle_t *handle,
+                         void (*callback)(ba121_alarm_handle_t *handle, uint8_t index,
+                                          ba121_alarm_state_t state, float value, void *user),
+                         void *user);
+
+/**
+ * @brief     set the temperature compensation
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] coefficient compensation coefficient per degree
+ * @param[in] reference reference temperature in C
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      compensated = conductivity / (1 + coefficient * (temperature - reference))
+ */
+uint8_t ba121_alarm_set_compensation(ba121_alarm_handle_t *handle, float coefficient, float reference);
+
+/**
+ * @brief      add a rule
+ * @param[in]  *handle pointer to a ba121 alarm handle structure
+ * @param[in]  *rule pointer to a ba121 alarm rule structure
+ * @param[out] *index pointer to a rule index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no free rule
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 rule is invalid
+ * @note       a new rule starts clear
+ */
+uint8_t ba121_alarm_add_rule(ba121_alarm_handle_t *handle, const ba121_alarm_rule_t *rule, uint8_t *index);
+
+/**
+ * @brief     remove a rule
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] index rule index
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 index is invalid
+ * @note      none
+ */
+uint8_t ba121_alarm_remove_rule(ba121_alarm_handle_t *handle, uint8_t index);
+
+/**
+ * @brief     evaluate all rules on one sample
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] conductivity_us_cm conductivity in uS/cm
+ * @param[in] temperature temperature in C
+ * @param[in] timestamp_ms sample time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the callback runs inline for every state transition
+ */
+uint8_t ba121_alarm_process(ba121_alarm_handle_t *handle, uint16_t conductivity_us_cm,
+                            float temperature, uint32_t timestamp_ms);
+
+/**
+ * @brief      get a rule state
+ * @param[in]  *handle pointer to a ba121 alarm handle structure
+ * @param[in]  index rule index
+ * @param[out] *state pointer to a state buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 index is invalid
+ * @note       none
+ */
+uint8_t ba121_alarm_get_state(ba121_alarm_handle_t *handle, uint8_t index, ba121_alarm_state_t *state);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,783 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_coroutine.hpp
+ * @brief     driver ba121 coroutine header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_COROUTINE_HPP
+#define DRIVER_BA121_COROUTINE_HPP
+
+#if !defined(__cplusplus) || (__cplusplus < 202002L)
+    #error "driver_ba121_coroutine.hpp needs c++20"
+#endif
+
+#include "driver_ba121.h"
+
+#if (BA121_QUEUE_ENABLE == 0)
+    #error "driver_ba121_coroutine.hpp needs the async api, build it with BA121_QUEUE_ENABLE"
+#endif
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <ctime>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+/**
+ * @defgroup ba121_coroutine_driver ba121 coroutine driver function
+ * @brief    ba121 coroutine driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+namespace ba121
+{
+
+/**
+ * @brief ba121 read result structure definition
+ */
+struct read_result
+{
+    uint8_t res;                        /**< status code, 0 success, 1 link error or timeout, other submit error */
+    uint16_t conductivity_raw;          /**< conductivity raw */
+    uint16_t conductivity_us_cm;        /**< conductivity in uS/cm */
+    uint16_t temperature_raw;           /**< temperature raw */
+    float temperature;                  /**< temperature in C */
+};
+
+/**
+ * @brief ba121 coroutine task class definition
+ * @note  lazily started, co_await a task to run it as a child, or pass it to executor::spawn
+ */
+template <typename T = void>
+class task;
+
+/**
+ * @brief ba121 task promise base class definition
+ */
+class promise_base
+{
+    public:
+        /**
+         * @brief  start lazily
+         * @return suspend always
+         */
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+        
+        /**
+         * @brief ba121 final awaiter structure definition
+         */
+        struct final_awaiter
+        {
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+            template <typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+            {
+                promise_base &p = h.promise();
+                
+                if (p.m_live != nullptr)
+                {
+                    /* a spawned task owns its frame, hand its exception to the executor first */
+                    if (p.m_exception && !*p.m_error)
+                    {
+                        *p.m_error = p.m_exception;
+                    }
+                    (*p.m_live)--;
+                    h.destroy();
+                    
+                    return std::noop_coroutine();
+                }
+                
+                return p.m_continuation ? p.m_continuation : std::noop_coroutine();
+            }
+            void await_resume() noexcept
+            {
+            }
+        };
+        
+        /**
+         * @brief  resume the awaiting coroutine when the task finishes
+         * @return final awaiter
+         */
+        final_awaiter final_suspend() noexcept
+        {
+            return {};
+        }
+        
+        /**
+         * @brief keep the exception for the awaiting coroutine
+         */
+        void unhandled_exception() noexcept
+        {
+            m_exception = std::current_exception();
+        }
+        
+        std::coroutine_handle<> m_continuation;        /**< awaiting coroutine */
+        std::exception_ptr m_exception;                /**< pending exception */
+        size_t *m_live = nullptr;                      /**< executor task counter of a spawned task */
+        std::exception_ptr *m_error = nullptr;         /**< executor exception slot of a spawned task */
+};
+
+template <typename T>
+class task
+{
+    public:
+        /**
+         * @brief ba121 task promise class definition
+         */
+        struct promise_type : promise_base
+        {
+            task get_return_object() noexcept
+            {
+                return task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            void return_value(T value)
+            {
+                m_value = std::move(value);
+            }
+            T m_value{};        /**< result */
+        };
+        
+        task(task &&other) noexcept : m_handle(std::exchange(other.m_handle, {}))
+        {
+        }
+        task(const task &) = delete;
+        task &operator=(const task &) = delete;
+        ~task()
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+        }
+        
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+        {
+            m_handle.promise().m_continuation = continuation;
+            
+            return m_handle;
+        }
+        T await_resume()
+        {
+            if (m_handle.promise().m_exception)
+            {
+                std::rethrow_exception(m_handle.promise().m_exception);
+            }
+            
+            return std::move(m_handle.promise().m_value);
+        }
+        
+        /**
+         * @brief  release the frame to a detached owner
+         * @return coroutine handle
+         */
+        std::coroutine_handle<promise_type> release() noexcept
+        {
+            return std::exchange(m_handle, {});
+        }
+        
+    private:
+        explicit task(std::coroutine_handle<promise_type> h) noexcept : m_handle(h)
+        {
+        }
+        
+        std::coroutine_handle<promise_type> m_handle;        /**< coroutine frame */
+};
+
+template <>
+class task<void>
+{
+    public:
+        /**
+         * @brief ba121 task promise class definition
+         */
+        struct promise_type : promise_base
+        {
+            task get_return_object() noexcept
+            {
+                return task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            void return_void() noexcept
+            {
+            }
+        };
+        
+        task(task &&other) noexcept : m_handle(std::exchange(other.m_handle, {}))
+        {
+        }
+        task(const task &) = delete;
+        task &operator=(const task &) = delete;
+        ~task()
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+        }
+        
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+        {
+            m_handle.promise().m_continuation = continuation;
+            
+            return m_handle;
+        }
+        void await_resume()
+        {
+            if (m_handle.promise().m_exception)
+            {
+                std::rethrow_exception(m_handle.promise().m_exception);
+            }
+        }
+        
+        /**
+         * @brief  release the frame to a detached owner
+         * @return coroutine handle
+         */
+        std::coroutine_handle<promise_type> release() noexcept
+        {
+            return std::exchange(m_handle, {});
+        }
+        
+    private:
+        explicit task(std::coroutine_handle<promise_type> h) noexcept : m_handle(h)
+        {
+        }
+        
+        std::coroutine_handle<promise_type> m_handle;        /**< coroutine frame */
+};
+
+/**
+ * @brief ba121 epoll executor class definition
+ * @note  single threaded, sensors are driven by fd readiness and the driver deadlines,
+ *        only sensors with commands in flight are scanned for deadlines, the scan is linear
+ *        in the busy sensors and every sensor holds its own uart fd, so the sensor count is
+ *        bounded by the open file limit and the bus, not by the coroutine frames
+ */
+class executor
+{
+    public:
+        /**
+         * @brief create the epoll instance
+         */
+        executor() : m_epfd(epoll_create1(EPOLL_CLOEXEC))
+        {
+        }
+        executor(const executor &) = delete;
+        executor &operator=(const executor &) = delete;
+        ~executor()
+        {
+            if (m_epfd >= 0)
+            {
+                (void)close(m_epfd);
+            }
+        }
+        
+        /**
+         * @brief  check the epoll instance
+         * @return true if usable
+         */
+        bool valid() const noexcept
+        {
+            return m_epfd >= 0;
+        }
+        
+        /**
+         * @brief  get the monotonic time
+         * @return time in ms
+         */
+        static uint32_t now_ms() noexcept
+        {
+            struct timespec t;
+            
+            clock_gettime(CLOCK_MONOTONIC, &t);
+            
+            return (uint32_t)((uint64_t)t.tv_sec * 1000U + (uint64_t)t.tv_nsec / 1000000U);
+        }
+        
+        /**
+         * @brief     watch a sensor
+         * @param[in] *handle pointer to an initialized ba121 handle structure
+         * @param[in] fd uart fd of the sensor, -1 to rely on the deadlines only
+         * @return    true on success
+         */
+        bool attach(ba121_handle_t *handle, int fd)
+        {
+            if (fd >= 0)
+            {
+                struct epoll_event ev{};
+                
+                ev.events = EPOLLIN;
+                ev.data.ptr = handle;
+                if (epoll_ctl(m_epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+                {
+                    return false;
+                }
+            }
+            
+            return true;
+        }
+        
+        /**
+         * @brief     stop watching a sensor
+         * @param[in] *handle pointer to a ba121 handle structure
+         * @param[in] fd uart fd of the sensor
+         * @note      cancel the handle queue first
+         */
+        void detach(ba121_handle_t *handle, int fd)
+        {
+            if (fd >= 0)
+            {
+                (void)epoll_ctl(m_epfd, EPOLL_CTL_DEL, fd, nullptr);
+            }
+            m_active.erase(std::remove(m_active.begin(), m_active.end(), handle), m_active.end());
+        }
+        
+        /**
+         * @brief     mark a sensor as busy
+         * @param[in] *handle pointer to a ba121 handle structure
+         */
+        void arm(ba121_handle_t *handle)
+        {
+            if (std::find(m_active.begin(), m_active.end(), handle) == m_active.end())
+            {
+                m_active.push_back(handle);
+            }
+        }
+        
+        /**
+         * @brief     resume a coroutine from the loop
+         * @param[in] h coroutine handle
+         */
+        void post(std::coroutine_handle<> h)
+        {
+            m_ready.push_back(h);
+        }
+        
+        /**
+         * @brief     start a detached task
+         * @param[in] t task to run
+         * @note      the executor runs until every spawned task has finished
+         */
+        void spawn(task<void> t)
+        {
+            auto h = t.release();
+            
+            m_live++;
+            h.promise().m_live = &m_live;
+            h.promise().m_error = &m_error;
+            post(h);
+        }
+        
+        /**
+         * @brief     suspend the calling coroutine
+         * @param[in] ms time in ms
+         * @return    awaiter
+         */
+        auto sleep_for(uint32_t ms)
+        {
+            struct sleep_awaiter
+            {
+                executor &ex;
+                uint32_t ms;
+                
+                bool await_ready() const noexcept
+                {
+                    return ms == 0;
+                }
+                void await_suspend(std::coroutine_handle<> h)
+                {
+                    ex.m_timers.push_back({now_ms() + ms, h});
+                    std::push_heap(ex.m_timers.begin(), ex.m_timers.end(), timer_later);
+                }
+                void await_resume() noexcept
+                {
+                }
+            };
+            
+            return sleep_awaiter{*this, ms};
+        }
+        
+        /**
+         * @brief  run until every spawned task has finished
+         * @return status code
+         *         - 0 success
+         *         - 1 epoll failed
+         * @note   the first exception that escapes a spawned task is rethrown here, the other tasks
+         *         stay suspended and a later run call continues them
+         */
+        uint8_t run()
+        {
+            struct epoll_event events[64];
+            
+            while (true)
+            {
+                uint32_t now;
+                uint32_t timeout;
+                int n;
+                
+                /* resume ready coroutines, they may post more */
+                while (!m_ready.empty())
+                {
+                    std::vector<std::coroutine_handle<>> ready;
+                    
+                    ready.swap(m_ready);
+                    for (auto h : ready)
+                    {
+                        h.resume();
+                    }
+                }
+                if (m_error)
+                {
+                    std::rethrow_exception(std::exchange(m_error, nullptr));
+                }
+                if ((m_live == 0) && m_timers.empty())
+                {
+                    return 0;
+                }
+                
+                /* sleep until the first driver deadline, timer or readable fd */
+                now = now_ms();
+                timeout = next_timeout(now);
+                n = epoll_wait(m_epfd, events, 64, (timeout == 0xFFFFFFFFU) ? -1 : (int)timeout);
+                if ((n < 0) && (errno != EINTR))
+                {
+                    return 1;
+                }
+                now = now_ms();
+                for (int i = 0; i < n; i++)
+                {
+                    (void)ba121_async_readable((ba121_handle_t *)events[i].data.ptr, now);
+                }
+                
+                /* expire the driver deadlines */
+                for (size_t i = 0; i < m_active.size(); )
+                {
+                    ba121_handle_t *handle = m_active[i];
+                    uint32_t left;
+                    
+                    if ((ba121_async_get_timeout(handle, now, &left) == 0) && (left == 0))
+                    {
+                        (void)ba121_async_timeout(handle, now);
+                        (void)ba121_async_get_timeout(handle, now, &left);
+                    }
+                    if (left == 0xFFFFFFFFU)
+                    {
+                        m_active[i] = m_active.back();
+                        m_active.pop_back();
+                    }
+                    else
+                    {
+                        i++;
+                    }
+                }
+                
+                /* expire the timers */
+                while (!m_timers.empty() && ((int32_t)(m_timers.front().deadline - now) <= 0))
+                {
+                    std::pop_heap(m_timers.begin(), m_timers.end(), timer_later);
+                    post(m_timers.back().h);
+                    m_timers.pop_back();
+                }
+            }
+        }
+        
+    private:
+        /**
+         * @brief ba121 timer structure definition
+         */
+        struct timer
+        {
+            uint32_t deadline;                 /**< wake up time */
+            std::coroutine_handle<> h;         /**< sleeping coroutine */
+        };
+        
+        /**
+         * @brief     timer heap order
+         * @param[in] a timer
+         * @param[in] b timer
+         * @return    true if a expires later than b
+         */
+        static bool timer_later(const timer &a, const timer &b) noexcept
+        {
+            return (int32_t)(a.deadline - b.deadline) > 0;
+        }
+        
+        /**
+         * @brief     get the next loop timeout
+         * @param[in] now current time in ms
+         * @return    timeout in ms, 0xFFFFFFFF if none
+         */
+        uint32_t next_timeout(uint32_t now)
+        {
+            uint32_t timeout = 0xFFFFFFFFU;
+            
+            if (!m_ready.empty())
+            {
+                return 0;
+            }
+            for (ba121_handle_t *handle : m_active)
+            {
+                uint32_t left;
+                
+                if ((ba121_async_get_timeout(handle, now, &left) == 0) && (left < timeout))
+                {
+                    timeout = left;
+                }
+            }
+            if (!m_timers.empty())
+            {
+                int32_t left = (int32_t)(m_timers.front().deadline - now);
+                
+                timeout = std::min(timeout, (left <= 0) ? 0U : (uint32_t)left);
+            }
+            
+            return timeout;
+        }
+        
+        int m_epfd;                                          /**< epoll fd */
+        size_t m_live = 0;                                   /**< running spawned tasks */
+        std::exception_ptr m_error;                          /**< exception of a spawned task */
+        std::vector<ba121_handle_t *> m_active;              /**< sensors with commands in flight */
+        std::vector<std::coroutine_handle<>> m_ready;        /**< coroutines to resume */
+        std::vector<timer> m_timers;                         /**< timer heap */
+};
+
+/**
+ * @brief ba121 coroutine sensor class definition
+ * @note  the awaitables keep their state in the awaiting coroutine frame,
+ *        one sensor runs one transaction at a time and up to BA121_QUEUE_DEPTH are queued
+ */
+class sensor
+{
+    public:
+        /**
+         * @brief     bind a sensor to an executor
+         * @param[in] &ex executor
+         * @param[in] *handle pointer to an initialized ba121 handle structure
+         * @param[in] fd uart fd of the sensor, -1 to rely on the deadlines only
+         */
+        sensor(executor &ex, ba121_handle_t *handle, int fd) : m_ex(ex), m_handle(handle), m_fd(fd)
+        {
+            m_attached = m_ex.attach(m_handle, m_fd);
+        }
+        sensor(const sensor &) = delete;
+        sensor &operator=(const sensor &) = delete;
+        ~sensor()
+        {
+            if (m_attached)
+            {
+                m_ex.detach(m_handle, m_fd);
+            }
+        }
+        
+        /**
+         * @brief  check the epoll registration
+         * @return true if attached
+         */
+        bool valid() const noexcept
+        {
+            return m_attached;
+        }
+        
+        /**
+         * @brief  get the driver handle
+         * @return pointer to the ba121 handle structure
+         */
+        ba121_handle_t *handle() const noexcept
+        {
+            return m_handle;
+        }
+        
+        /**
+         * @brief  read data
+         * @return awaiter resuming with a read_result
+         */
+        auto read()
+        {
+            struct read_awaiter
+            {
+                executor &ex;
+                ba121_handle_t *handle;
+                read_result r{};
+                std::coroutine_handle<> h{};
+                
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+                bool await_suspend(std::coroutine_handle<> c)
+                {
+                    h = c;
+                    r.res = ba121_async_read(handle, &complete, this);
+                    if (r.res != 0)
+                    {
+                        return false;
+                    }
+                    ex.arm(handle);
+                    
+                    return true;
+                }
+                read_result await_resume() const noexcept
+                {
+                    return r;
+                }
+                static void complete(ba121_handle_t *, uint8_t res,
+                                     uint16_t conductivity_raw, uint16_t conductivity_us_cm,
+                                     uint16_t temperature_raw, float temperature, void *user)
+                {
+                    read_awaiter *self = static_cast<read_awaiter *>(user);
+                    
+                    self->r = {res, conductivity_raw, conductivity_us_cm, temperature_raw, temperature};
+                    self->ex.post(self->h);
+                }
+            };
+            
+            return read_awaiter{m_ex, m_handle, {}, {}};
+        }
+        
+        /**
+         * @brief  run the baseline calibration
+         * @return awaiter resuming with the status code
+         */
+        auto calibrate_baseline()
+        {
+            return command_awaiter{m_ex, m_handle, BA121_QUEUE_COMMAND_BASELINE, 0, 0, {}};
+        }
+        
+        /**
+         * @brief     set the ntc resistance
+         * @param[in] ohm resistance ohm
+         * @return    awaiter resuming with the status code
+         */
+        auto set_ntc_resistance(uint32_t ohm)
+        {
+            return command_awaiter{m_ex, m_handle, BA121_QUEUE_COMMAND_NTC_RESISTANCE, ohm, 0, {}};
+        }
+        
+        /**
+         * @brief     set the ntc b
+         * @param[in] value ntc value
+         * @return    awaiter resuming with the status code
+         */
+        auto set_ntc_b(uint16_t value)
+        {
+            return command_awaiter{m_ex, m_handle, BA121_QUEUE_COMMAND_NTC_B, value, 0, {}};
+        }
+        
+    private:
+        /**
+         * @brief ba121 command awaiter structure definition
+         * @note  resumes with 0 on success, 1 on a link error or timeout, 5 on a response error
+         *        or the submit status code
+         */
+        struct command_awaiter
+        {
+            executor &ex;
+            ba121_handle_t *handle;
+            ba121_queue_command_t command;
+            uint32_t param;
+            uint8_t res = 0;
+            std::coroutine_handle<> h{};
+            
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+            bool await_suspend(std::coroutine_handle<> c)
+            {
+                h = c;
+                if (command == BA121_QUEUE_COMMAND_NTC_RESISTANCE)
+                {
+                    res = ba121_async_set_ntc_resistance(handle, param, &complete, this);
+                }
+                else if (command == BA121_QUEUE_COMMAND_NTC_B)
+                {
+                    res = ba121_async_set_ntc_b(handle, (uint16_t)param, &complete, this);
+                }
+                else
+                {
+                    res = ba121_async_baseline_calibration(handle, &complete, this);
+                }
+                if (res != 0)
+                {
+                    return false;
+                }
+                ex.arm(handle);
+                
+                return true;
+            }
+            uint8_t await_resume() const noexcept
+            {
+                return res;
+            }
+            static void complete(ba121_handle_t *, uint8_t res, void *user)
+            {
+                command_awaiter *self = static_cast<command_awaiter *>(user);
+                
+                self->res = res;
+                self->ex.post(self->h);
+            }
+        };
+        
+        executor &m_ex;                 /**< executor */
+        ba121_handle_t *m_handle;       /**< driver handle */
+        int m_fd;                       /**< uart fd */
+        bool m_attached;                /**< epoll registration */
+};
+
+} /* namespace ba121 */
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,596 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_decode.c
+ * @brief     driver ba121 decode source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_decode.h"
+
+/**
+ * @brief simd select definition, gcc and clang on x86 build every path and pick one at run time
+ */
+#if !defined(BA121_DECODE_DISABLE_SIMD)
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        #include <immintrin.h>
+        #define BA121_DECODE_USE_DISPATCH
+        #define BA121_DECODE_USE_AVX2
+        #define BA121_DECODE_USE_SSSE3
+        #define BA121_DECODE_USE_SSE2
+    #elif defined(__AVX2__)
+        #include <immintrin.h>
+        #define BA121_DECODE_USE_AVX2
+        #define BA121_DECODE_USE_SSSE3
+        #define BA121_DECODE_USE_SSE2
+    #elif defined(__SSSE3__)
+        #include <tmmintrin.h>
+        #define BA121_DECODE_USE_SSSE3
+        #define BA121_DECODE_USE_SSE2
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #include <emmintrin.h>
+        #define BA121_DECODE_USE_SSE2
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>
+        #define BA121_DECODE_USE_NEON
+    #endif
+#endif
+
+/**
+ * @brief simd target definition
+ */
+#if defined(BA121_DECODE_USE_DISPATCH)
+    #define BA121_DECODE_TARGET(isa)        __attribute__((target(isa)))        /**< build one function for isa */
+    #define BA121_DECODE_CPU(isa)           __builtin_cpu_supports(isa)         /**< run time cpu check */
+#else
+    #define BA121_DECODE_TARGET(isa)                                            /**< whole file built for isa */
+    #define BA121_DECODE_CPU(isa)           1                                   /**< checked at compile time */
+#endif
+
+static ba121_decode_path_t gs_path;        /**< active path */
+static uint8_t gs_path_inited;             /**< active path valid flag */
+
+#if defined(BA121_DECODE_USE_SSSE3)
+/**
+ * @brief byte gather masks, row r moves chunk (r % 3) into vector b01, b23 or b45 (r / 3),
+ *        lanes 0 - 7 hold the even byte and lanes 8 - 15 the odd byte of 8 frames
+ */
+static const uint8_t gs_gather[9][16] =
+{
+    {0x00, 0x06, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x07, 0x0D, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x02, 0x08, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x09, 0x0F, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x04, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x05, 0x0B},
+    {0x02, 0x08, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x09, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x04, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x05, 0x0B, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x06, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x07, 0x0D},
+    {0x04, 0x0A, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x05, 0x0B, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x00, 0x06, 0x0C, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x07, 0x0D, 0x80, 0x80, 0x80},
+    {0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x08, 0x0E, 0x80, 0x80, 0x80, 0x80, 0x80, 0x03, 0x09, 0x0F},
+};
+#endif
+
+#if defined(BA121_DECODE_USE_SSE2)
+/**
+ * @brief      count set bits
+ * @param[in]  v input value
+ * @return     set bit count
+ * @note       none
+ */
+static uint32_t a_ba121_decode_popcount(uint32_t v)
+{
+    v = v - ((v >> 1) & 0x55555555U);                                              /* 2 bits */
+    v = (v & 0x33333333U) + ((v >> 2) & 0x33333333U);                              /* 4 bits */
+    v = (v + (v >> 4)) & 0x0F0F0F0FU;                                              /* 8 bits */
+
+    return (v * 0x01010101U) >> 24;                                                /* sum */
+}
+#endif
+
+/**
+ * @brief      decode frames one by one
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  frame_count number of frames
+ * @param[out] *conductivity_raw pointer to a conductivity raw array
+ * @param[out] *temperature_raw pointer to a temperature raw array
+ * @param[out] *valid pointer to a valid flag array
+ * @return     valid frame count
+ * @note       none
+ */
+static uint32_t a_ba121_decode_scalar(const uint8_t *buf, uint32_t frame_count,
+                                      uint16_t *conductivity_raw, uint16_t *temperature_raw,
+                                      uint8_t *valid)
+{
+    uint32_t i;
+    uint32_t count;
+
+    count = 0;                                                                     /* init 0 */
+    for (i = 0; i < frame_count; i++)                                              /* all frames */
+    {
+        const uint8_t *p = buf + i * BA121_DECODE_FRAME_LENGTH;                    /* frame */
+        uint8_t sum;
+        uint8_t ok;
+
+        sum = (uint8_t)(p[0] + p[1] + p[2] + p[3] + p[4]);                         /* checksum */
+        ok = (uint8_t)((p[0] == 0xAA) && (sum == p[5]));                           /* check frame */
+        conductivity_raw[i] = (uint16_t)(((uint16_t)p[1] << 8) | p[2]);            /* set conductivity raw */
+        temperature_raw[i] = (uint16_t)(((uint16_t)p[3] << 8) | p[4]);             /* set temperature raw */
+        valid[i] = ok;                                                             /* set valid */
+        count += ok;                                                               /* count */
+    }
+
+    return count;                                                                  /* return count */
+}
+
+#if defined(BA121_DECODE_USE_AVX2)
+/**
+ * @brief      decode 16 frames per step with avx2
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  steps number of 16 frames steps
+ * @param[out] *conductivity_raw pointer to a conductivity raw array
+ * @param[out] *temperature_raw pointer to a temperature raw array
+ * @param[out] *valid pointer to a valid flag array
+ * @return     valid frame count
+ * @note       each 128 bits lane decodes 8 frames
+ */
+BA121_DECODE_TARGET("avx2")
+static uint32_t a_ba121_decode_avx2(const uint8_t *buf, uint32_t steps,
+                                    uint16_t *conductivity_raw, uint16_t *temperature_raw,
+                                    uint8_t *valid)
+{
+    __m256i m[9];
+    __m256i header;
+    __m256i one;
+    uint32_t i;
+    uint32_t count;
+
+    for (i = 0; i < 9; i++)                                                        /* broadcast masks */
+    {
+        m[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)gs_gather[i]));
+    }
+    header = _mm256_set1_epi8((char)0xAA);                                         /* frame header */
+    one = _mm256_set1_epi8(1);                                                     /* valid flag */
+    count = 0;                                                                     /* init 0 */
+    for (i = 0; i < steps; i++)                                                    /* all steps */
+    {
+        const uint8_t *p = buf + i * 16 * BA121_DECODE_FRAME_LENGTH;               /* 96 bytes */
+        __m256i c0, c1, c2;
+        __m256i b01, b23, b45;
+        __m256i sum, ok;
+        uint32_t mask;
+
+        c0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(p + 0))),
+                                     _mm_loadu_si128((const __m128i *)(p + 48)), 1);
+        c1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(p + 16))),
+                                     _mm_loadu_si128((const __m128i *)(p + 64)), 1);
+        c2 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(p + 32))),
+                                     _mm_loadu_si128((const __m128i *)(p + 80)), 1);
+        b01 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(c0, m[0]), _mm256_shuffle_epi8(c1, m[1])),
+                              _mm256_shuffle_epi8(c2, m[2]));                      /* bytes 0 and 1 */
+        b23 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(c0, m[3]), _mm256_shuffle_epi8(c1, m[4])),
+                              _mm256_shuffle_epi8(c2, m[5]));                      /* bytes 2 and 3 */
+        b45 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(c0, m[6]), _mm256_shuffle_epi8(c1, m[7])),
+                              _mm256_shuffle_epi8(c2, m[8]));                      /* bytes 4 and 5 */
+        sum = _mm256_add_epi8(_mm256_add_epi8(b01, _mm256_srli_si256(b01, 8)),
+                              _mm256_add_epi8(b23, _mm256_srli_si256(b23, 8)));    /* bytes 0 - 3 */
+        sum = _mm256_add_epi8(sum, b45);                                           /* byte 4 */
+        ok = _mm256_and_si256(_mm256_cmpeq_epi8(sum, _mm256_srli_si256(b45, 8)),
+                              _mm256_cmpeq_epi8(b01, header));                     /* checksum and header */
+        mask = (uint32_t)_mm256_movemask_epi8(ok) & 0x00FF00FFU;                   /* 8 frames per lane */
+        count += a_ba121_decode_popcount(mask);                                    /* count */
+        _mm256_storeu_si256((__m256i *)(conductivity_raw + i * 16),
+                            _mm256_unpacklo_epi8(b23, _mm256_srli_si256(b01, 8))); /* (b1 << 8) | b2 */
+        _mm256_storeu_si256((__m256i *)(temperature_raw + i * 16),
+                            _mm256_unpacklo_epi8(b45, _mm256_srli_si256(b23, 8))); /* (b3 << 8) | b4 */
+        ok = _mm256_and_si256(ok, one);                                            /* 0 or 1 */
+        _mm_storel_epi64((__m128i *)(valid + i * 16), _mm256_castsi256_si128(ok)); /* frames 0 - 7 */
+        _mm_storel_epi64((__m128i *)(valid + i * 16 + 8), _mm256_extracti128_si256(ok, 1));
+    }
+
+    return count;                                                                  /* return count */
+}
+#endif
+
+#if defined(BA121_DECODE_USE_SSSE3)
+/**
+ * @brief      decode 8 frames per step with ssse3
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  steps number of 8 frames steps
+ * @param[out] *conductivity_raw pointer to a conductivity raw array
+ * @param[out] *temperature_raw pointer to a temperature raw array
+ * @param[out] *valid pointer to a valid flag array
+ * @return     valid frame count
+ * @note       none
+ */
+BA121_DECODE_TARGET("ssse3")
+static uint32_t a_ba121_decode_ssse3(const uint8_t *buf, uint32_t steps,
+                                     uint16_t *conductivity_raw, uint16_t *temperature_raw,
+                                     uint8_t *valid)
+{
+    __m128i m[9];
+    __m128i header;
+    __m128i one;
+    uint32_t i;
+    uint32_t count;
+
+    for (i = 0; i < 9; i++)                                                        /* load masks */
+    {
+        m[i] = _mm_loadu_si128((const __m128i *)gs_gather[i]);
+    }
+    header = _mm_set1_epi8((char)0xAA);                                            /* frame header */
+    one = _mm_set1_epi8(1);                                                        /* valid flag */
+    count = 0;                                                                     /* init 0 */
+    for (i = 0; i < steps; i++)                                                    /* all steps */
+    {
+        const uint8_t *p = buf + i * 8 * BA121_DECODE_FRAME_LENGTH;                /* 48 bytes */
+        __m128i c0, c1, c2;
+        __m128i b01, b23, b45;
+        __m128i sum, ok;
+
+        c0 = _mm_loadu_si128((const __m128i *)(p + 0));                            /* bytes 0 - 15 */
+        c1 = _mm_loadu_si128((const __m128i *)(p + 16));                           /* bytes 16 - 31 */
+        c2 = _mm_loadu_si128((const __m128i *)(p + 32));                           /* bytes 32 - 47 */
+        b01 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, m[0]), _mm_shuffle_epi8(c1, m[1])),
+                           _mm_shuffle_epi8(c2, m[2]));                            /* bytes 0 and 1 */
+        b23 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, m[3]), _mm_shuffle_epi8(c1, m[4])),
+                           _mm_shuffle_epi8(c2, m[5]));                            /* bytes 2 and 3 */
+        b45 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(c0, m[6]), _mm_shuffle_epi8(c1, m[7])),
+                           _mm_shuffle_epi8(c2, m[8]));                            /* bytes 4 and 5 */
+        sum = _mm_add_epi8(_mm_add_epi8(b01, _mm_srli_si128(b01, 8)),
+                           _mm_add_epi8(b23, _mm_srli_si128(b23, 8)));             /* bytes 0 - 3 */
+        sum = _mm_add_epi8(sum, b45);                                              /* byte 4 */
+        ok = _mm_and_si128(_mm_cmpeq_epi8(sum, _mm_srli_si128(b45, 8)),
+                           _mm_cmpeq_epi8(b01, header));                           /* checksum and header */
+        count += a_ba121_decode_popcount((uint32_t)_mm_movemask_epi8(ok) & 0xFFU); /* count */
+        _mm_storeu_si128((__m128i *)(conductivity_raw + i * 8),
+                         _mm_unpacklo_epi8(b23, _mm_srli_si128(b01, 8)));          /* (b1 << 8) | b2 */
+        _mm_storeu_si128((__m128i *)(temperature_raw + i * 8),
+                         _mm_unpacklo_epi8(b45, _mm_srli_si128(b23, 8)));          /* (b3 << 8) | b4 */
+        _mm_storel_epi64((__m128i *)(valid + i * 8), _mm_and_si128(ok, one));     /* 0 or 1 */
+    }
+
+    return count;                                                                  /* return count */
+}
+#endif
+
+#if defined(BA121_DECODE_USE_SSE2)
+/**
+ * @brief      decode 8 frames per step with sse2
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  steps number of 8 frames steps
+ * @param[out] *conductivity_raw pointer to a conductivity raw array
+ * @param[out] *temperature_raw pointer to a temperature raw array
+ * @param[out] *valid pointer to a valid flag array
+ * @return     valid frame count
+ * @note       without pshufb the frames are loaded 8 bytes at a time and transposed by unpacks,
+ *             the last frame is loaded 2 bytes early so no step reads past its 48 bytes
+ */
+BA121_DECODE_TARGET("sse2")
+static uint32_t a_ba121_decode_sse2(const uint8_t *buf, uint32_t steps,
+                                    uint16_t *conductivity_raw, uint16_t *temperature_raw,
+                                    uint8_t *valid)
+{
+    __m128i header;
+    __m128i one;
+    uint32_t i;
+    uint32_t count;
+
+    header = _mm_set1_epi8((char)0xAA);                                            /* frame header */
+    one = _mm_set1_epi8(1);                                                        /* valid flag */
+    count = 0;                                                                     /* init 0 */
+    for (i = 0; i < steps; i++)                                                    /* all steps */
+    {
+        const uint8_t *p = buf + i * 8 * BA121_DECODE_FRAME_LENGTH;                /* 48 bytes */
+        __m128i f01, f23, f45, f67;
+        __m128i lo, hi, lo4, hi4;
+        __m128i b01, b23, b45;
+        __m128i sum, ok;
+
+        f01 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p + 0)),
+                                _mm_loadl_epi64((const __m128i *)(p + 6)));        /* frames 0 and 1 */
+        f23 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p + 12)),
+                                _mm_loadl_epi64((const __m128i *)(p + 18)));       /* frames 2 and 3 */
+        f45 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p + 24)),
+                                _mm_loadl_epi64((const __m128i *)(p + 30)));       /* frames 4 and 5 */
+        f67 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p + 36)),
+                                _mm_srli_epi64(_mm_loadl_epi64((const __m128i *)(p + 40)), 16));
+        lo = _mm_unpacklo_epi16(f01, f23);                                         /* bytes 0 - 3 of frames 0 - 3 */
+        hi = _mm_unpackhi_epi16(f01, f23);                                         /* bytes 4 - 7 of frames 0 - 3 */
+        lo4 = _mm_unpacklo_epi16(f45, f67);                                        /* bytes 0 - 3 of frames 4 - 7 */
+        hi4 = _mm_unpackhi_epi16(f45, f67);                                        /* bytes 4 - 7 of frames 4 - 7 */
+        b01 = _mm_unpacklo_epi32(lo, lo4);                                         /* bytes 0 and 1 */
+        b23 = _mm_unpackhi_epi32(lo, lo4);                                         /* bytes 2 and 3 */
+        b45 = _mm_unpacklo_epi32(hi, hi4);                                         /* bytes 4 and 5 */
+        sum = _mm_add_epi8(_mm_add_epi8(b01, _mm_srli_si128(b01, 8)),
+                           _mm_add_epi8(b23, _mm_srli_si128(b23, 8)));             /* bytes 0 - 3 */
+        sum = _mm_add_epi8(sum, b45);                                              /* byte 4 */
+        ok = _mm_and_si128(_mm_cmpeq_epi8(sum, _mm_srli_si128(b45, 8)),
+                           _mm_cmpeq_epi8(b01, header));                           /* checksum and header */
+        count += a_ba121_decode_popcount((uint32_t)_mm_movemask_epi8(ok) & 0xFFU); /* count */
+        _mm_storeu_si128((__m128i *)(conductivity_raw + i * 8),
+                         _mm_unpacklo_epi8(b23, _mm_srli_si128(b01, 8)));          /* (b1 << 8) | b2 */
+        _mm_storeu_si128((__m128i *)(temperature_raw + i * 8),
+                         _mm_unpacklo_epi8(b45, _mm_srli_si128(b23, 8)));          /* (b3 << 8) | b4 */
+        _mm_storel_epi64((__m128i *)(valid + i * 8), _mm_and_si128(ok, one));     /* 0 or 1 */
+    }
+
+    return count;                                                                  /* return count */
+}
+#endif
+
+#if defined(BA121_DECODE_USE_NEON)
+/**
+ * @brief      decode 8 frames per step with neon
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  steps number of 8 frames steps
+ * @param[out] *conductivity_raw pointer to a conductivity raw array
+ * @param[out] *temperature_raw pointer to a temperature raw array
+ * @param[out] *valid pointer to a valid flag array
+ * @return     valid frame count
+ * @note       a 3 way de-interleave puts bytes 0 - 2 of each frame in the even lanes
+ *             and bytes 3 - 5 in the odd lanes
+ */
+static uint32_t a_ba121_decode_neon(const uint8_t *buf, uint32_t steps,
+                                    uint16_t *conductivity_raw, uint16_t *temperature_raw,
+                                    uint8_t *valid)
+{
+    uint32_t i;
+    uint32_t count;
+
+    count = 0;                                                                     /* init 0 */
+    for (i = 0; i < steps; i++)                                                    /* all steps */
+    {
+        uint8x16x3_t v;
+        uint8x16x2_t u0, u1, u2;
+        uint8x8_t b0, b1, b2, b3, b4, b5;
+        uint8x8_t sum, ok;
+
+        v = vld3q_u8(buf + i * 8 * BA121_DECODE_FRAME_LENGTH);                     /* 48 bytes */
+        u0 = vuzpq_u8(v.val[0], v.val[0]);                                         /* bytes 0 and 3 */
+        u1 = vuzpq_u8(v.val[1], v.val[1]);                                         /* bytes 1 and 4 */
+        u2 = vuzpq_u8(v.val[2], v.val[2]);                                         /* bytes 2 and 5 */
+        b0 = vget_low_u8(u0.val[0]);                                               /* byte 0 */
+        b3 = vget_low_u8(u0.val[1]);                                               /* byte 3 */
+        b1 = vget_low_u8(u1.val[0]);                                               /* byte 1 */
+        b4 = vget_low_u8(u1.val[1]);                                               /* byte 4 */
+        b2 = vget_low_u8(u2.val[0]);                                               /* byte 2 */
+        b5 = vget_low_u8(u2.val[1]);                                               /* byte 5 */
+        sum = vadd_u8(vadd_u8(vadd_u8(b0, b1), vadd_u8(b2, b3)), b4);              /* checksum */
+        ok = vand_u8(vceq_u8(sum, b5), vceq_u8(b0, vdup_n_u8(0xAA)));              /* checksum and header */
+        ok = vand_u8(ok, vdup_n_u8(1));                                            /* 0 or 1 */
+        vst1q_u16(conductivity_raw + i * 8, vorrq_u16(vshll_n_u8(b1, 8), vmovl_u8(b2)));
+        vst1q_u16(temperature_raw + i * 8, vorrq_u16(vshll_n_u8(b3, 8), vmovl_u8(b4)));
+        vst1_u8(valid + i * 8, ok);                                                /* set valid */
+        count += (uint32_t)vget_lane_u64(vpaddl_u32(vpaddl_u16(vpaddl_u8(ok))), 0);/* count */
+    }
+
+    return count;                                                                  /* return count */
+}
+#endif
+
+/**
+ * @brief     check a decode path
+ * @param[in] path decode path
+ * @return    1 if the path is built and the cpu runs it, else 0
+ * @note      none
+ */
+static uint8_t a_ba121_decode_supported(ba121_decode_path_t path)
+{
+#if defined(BA121_DECODE_USE_DISPATCH)
+    __builtin_cpu_init();                                                          /* read cpuid */
+#endif
+    switch (path)                                                                  /* check path */
+    {
+        case BA121_DECODE_PATH_SCALAR :
+        {
+            return 1;                                                              /* always built */
+        }
+#if defined(BA121_DECODE_USE_SSE2)
+        case BA121_DECODE_PATH_SSE2 :
+        {
+            return (uint8_t)(BA121_DECODE_CPU("sse2") != 0);                       /* sse2 */
+        }
+#endif
+#if defined(BA121_DECODE_USE_SSSE3)
+        case BA121_DECODE_PATH_SSSE3 :
+        {
+            return (uint8_t)(BA121_DECODE_CPU("ssse3") != 0);                      /* ssse3 */
+        }
+#endif
+#if defined(BA121_DECODE_USE_AVX2)
+        case BA121_DECODE_PATH_AVX2 :
+        {
+            return (uint8_t)(BA121_DECODE_CPU("avx2") != 0);                       /* avx2 */
+        }
+#endif
+#if defined(BA121_DECODE_USE_NEON)
+        case BA121_DECODE_PATH_NEON :
+        {
+            return 1;                                                              /* neon */
+        }
+#endif
+        default :
+        {
+            return 0;                                                              /* not built */
+        }
+    }
+}
+
+/**
+ * @brief  get the active decode path
+ * @return decode path
+ * @note   the fastest supported path is picked on the first call
+ */
+static ba121_decode_path_t a_ba121_decode_path(void)
+{
+    if (gs_path_inited == 0)                                                       /* first call */
+    {
+        if (a_ba121_decode_supported(BA121_DECODE_PATH_AVX2) != 0)                 /* avx2 */
+        {
+            gs_path = BA121_DECODE_PATH_AVX2;                                      /* set avx2 */
+        }
+        else if (a_ba121_decode_supported(BA121_DECODE_PATH_SSSE3) != 0)           /* ssse3 */
+        {
+            gs_path = BA121_DECODE_PATH_SSSE3;                                     /* set ssse3 */
+        }
+        else if (a_ba121_decode_supported(BA121_DECODE_PATH_SSE2) != 0)            /* sse2 */
+        {
+            gs_path = BA121_DECODE_PATH_SSE2;                                      /* set sse2 */
+        }
+        else if (a_ba121_decode_supported(BA121_DECODE_PATH_NEON) != 0)            /* neon */
+        {
+            gs_path = BA121_DECODE_PATH_NEON;                                      /* set neon */
+        }
+        else
+        {
+            gs_path = BA121_DECODE_PATH_SCALAR;                                    /* set scalar */
+        }
+        gs_path_inited = 1;                                                        /* flag picked */
+    }
+
+    return gs_path;                                                                /* return path */
+}
+
+/**
+ * @brief      decode a buffer of data frames
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  frame_count number of 6 bytes frames in the buffer
+ * @param[out] *conductivity_raw pointer to a conductivity raw array with frame_count entries
+ * @param[out] *temperature_raw pointer to a temperature raw array with frame_count entries
+ * @param[out] *valid pointer to a valid flag array with frame_count entries
+ * @param[out] *valid_count pointer to a valid frame count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       a frame is valid when its header is 0xAA and its checksum matches,
+ *             the fields of invalid frames are split out as well
+ */
+uint8_t ba121_decode_frames(const uint8_t *buf, uint32_t frame_count,
+                            uint16_t *conductivity_raw, uint16_t *temperature_raw,
+                            uint8_t *valid, uint32_t *valid_count)
+{
+    ba121_decode_path_t path;
+    uint32_t done;
+    uint32_t count;
+
+    if ((buf == NULL) || (conductivity_raw == NULL) ||
+        (temperature_raw == NULL) || (valid == NULL) || (valid_count == NULL))     /* check buffer */
+    {
+        return 2;                                                                  /* return error */
+    }
+
+    done = 0;                                                                      /* init 0 */
+    count = 0;                                                                     /* init 0 */
+    path = a_ba121_decode_path();                                                  /* get path */
+#if !defined(BA121_DECODE_USE_SSE2) && !defined(BA121_DECODE_USE_NEON)
+    (void)path;                                                                    /* scalar only */
+#endif
+#if defined(BA121_DECODE_USE_AVX2)
+    if (path == BA121_DECODE_PATH_AVX2)                                            /* avx2 */
+    {
+        count += a_ba121_decode_avx2(buf, frame_count / 16, conductivity_raw,
+                                     temperature_raw, valid);                      /* 16 frames steps */
+        done = frame_count - frame_count % 16;                                     /* decoded frames */
+    }
+#endif
+#if defined(BA121_DECODE_USE_SSSE3)
+    if ((path == BA121_DECODE_PATH_AVX2) || (path == BA121_DECODE_PATH_SSSE3))     /* ssse3 and the avx2 tail */
+    {
+        count += a_ba121_decode_ssse3(buf + done * BA121_DECODE_FRAME_LENGTH, (frame_count - done) / 8,
+                                      conductivity_raw + done, temperature_raw + done,
+                                      valid + done);                               /* 8 frames steps */
+        done = frame_count - frame_count % 8;                                      /* decoded frames */
+    }
+#endif
+#if defined(BA121_DECODE_USE_SSE2)
+    if (path == BA121_DECODE_PATH_SSE2)                                            /* sse2 */
+    {
+        count += a_ba121_decode_sse2(buf, frame_count / 8, conductivity_raw,
+                                     temperature_raw, valid);                      /* 8 frames steps */
+        done = frame_count - frame_count % 8;                                      /* decoded frames */
+    }
+#endif
+#if defined(BA121_DECODE_USE_NEON)
+    if (path == BA121_DECODE_PATH_NEON)                                            /* neon */
+    {
+        count += a_ba121_decode_neon(buf, frame_count / 8, conductivity_raw,
+                                     temperature_raw, valid);                      /* 8 frames steps */
+        done = frame_count - frame_count % 8;                                      /* decoded frames */
+    }
+#endif
+    count += a_ba121_decode_scalar(buf + done * BA121_DECODE_FRAME_LENGTH, frame_count - done,
+                                   conductivity_raw + done, temperature_raw + done,
+                                   valid + done);                                  /* tail */
+    *valid_count = count;                                                          /* set valid count */
+
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the decode path
+ * @param[in] path decode path
+ * @return    status code
+ *            - 0 success
+ *            - 4 path is not built or not supported by the cpu
+ * @note      the fastest supported path is used until this is called,
+ *            forcing a slower path is meant for tests and benchmarks
+ */
+uint8_t ba121_decode_set_path(ba121_decode_path_t path)
+{
+    if (a_ba121_decode_supported(path) == 0)                                       /* check path */
+    {
+        return 4;                                                                  /* return error */
+    }
+
+    gs_path = path;                                                                /* set path */
+    gs_path_inited = 1;                                                            /* flag picked */
+
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the active decode path
+ * @param[out] *path pointer to a decode path buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 path is NULL
+ * @note       none
+ */
+uint8_t ba121_decode_get_path(ba121_decode_path_t *path)
+{
+    if (path == NULL)                                                              /* check path */
+    {
+        return 2;                                                                  /* return error */
+    }
+
+    *path = a_ba121_decode_path();                                                 /* get path */
+
+    return 0;                                                                      /* success return 0 */
+}
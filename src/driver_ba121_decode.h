@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_decode.h
+ * @brief     driver ba121 decode header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_DECODE_H
+#define DRIVER_BA121_DECODE_H
+
+#include "driver_ba121.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_decode_driver ba121 decode driver function
+ * @brief    ba121 decode driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief ba121 decode frame length definition
+ */
+#define BA121_DECODE_FRAME_LENGTH        6        /**< 6 bytes */
+
+/**
+ * @brief ba121 decode path enumeration definition
+ */
+typedef enum
+{
+    BA121_DECODE_PATH_SCALAR = 0x00,        /**< portable c */
+    BA121_DECODE_PATH_SSSE3  = 0x01,        /**< x86 ssse3, 8 frames per step */
+    BA121_DECODE_PATH_AVX2   = 0x02,        /**< x86 avx2, 16 frames per step */
+    BA121_DECODE_PATH_NEON   = 0x03,        /**< arm neon, 8 frames per step */
+    BA121_DECODE_PATH_SSE2   = 0x04,        /**< x86 sse2, 8 frames per step */
+} ba121_decode_path_t;
+
+/**
+ * @brief      decode a buffer of data frames
+ * @param[in]  *buf pointer to a frame buffer
+ * @param[in]  frame_count number of 6 bytes frames in the buffer
+ * @param[out] *conductivity_raw pointer to a conductivity raw array with frame_count entries
+ * @param[out] *temperature_raw pointer to a temperature raw array with frame_count entries
+ * @param[out] *valid pointer to a valid flag array with frame_count entries
+ * @param[out] *valid_count pointer to a valid frame count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 buffer is NULL
+ * @note       a frame is valid when its header is 0xAA and its checksum matches,
+ *             the fields of invalid frames are split out as well
+ */
+uint8_t ba121_decode_frames(const uint8_t *buf, uint32_t frame_count,
+                            uint16_t *conductivity_raw, uint16_t *temperature_raw,
+                            uint8_t *valid, uint32_t *valid_count);
+
+/**
+ * @brief     set the decode path
+ * @param[in] path decode path
+ * @return    status code
+ *            - 0 success
+ *            - 4 path is not built or not supported by the cpu
+ * @note      the fastest supported path is used until this is called,
+ *            forcing a slower path is meant for tests and benchmarks
+ */
+uint8_t ba121_decode_set_path(ba121_decode_path_t path);
+
+/**
+ * @brief      get the active decode path
+ * @param[out] *path pointer to a decode path buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 path is NULL
+ * @note       gcc and clang on x86 build all x86 paths and pick the fastest one the cpu runs,
+ *             other compilers use the instruction sets enabled at compile time
+ */
+uint8_t ba121_decode_get_path(ba121_decode_path_t *path);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,468 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_filter.c
+ * @brief     driver ba121 filter source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_filter.h"
+
+#if (BA121_FILTER_MAX_WINDOW > 127)
+    #error "BA121_FILTER_MAX_WINDOW must not exceed 127"
+#endif
+
+/**
+ * @brief ba121 filter heap flag definition
+ */
+#define BA121_FILTER_HIGH_FLAG        0x80        /**< slot lives in the upper heap */
+
+/**
+ * @brief      check the heap order
+ * @param[in]  *handle pointer to a ba121 filter handle structure
+ * @param[in]  is_high upper heap flag
+ * @param[in]  a first slot
+ * @param[in]  b second slot
+ * @return     1 if slot a must be above slot b, otherwise 0
+ * @note       none
+ */
+static uint8_t a_ba121_filter_above(ba121_filter_handle_t *handle, uint8_t is_high, uint8_t a, uint8_t b)
+{
+    if (is_high != 0)                                                        /* min heap */
+    {
+        return (uint8_t)(handle->sample[a] < handle->sample[b]);            /* smaller on top */
+    }
+    else                                                                     /* max heap */
+    {
+        return (uint8_t)(handle->sample[a] > handle->sample[b]);            /* bigger on top */
+    }
+}
+
+/**
+ * @brief     place a slot at a heap position
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] is_high upper heap flag
+ * @param[in] i heap position
+ * @param[in] slot sample slot
+ * @note      none
+ */
+static void a_ba121_filter_place(ba121_filter_handle_t *handle, uint8_t is_high, uint8_t i, uint8_t slot)
+{
+    if (is_high != 0)                                                        /* upper heap */
+    {
+        handle->high[i] = slot;                                              /* set slot */
+        handle->pos[slot] = i | BA121_FILTER_HIGH_FLAG;                      /* set position */
+    }
+    else                                                                     /* lower heap */
+    {
+        handle->low[i] = slot;                                               /* set slot */
+        handle->pos[slot] = i;                                               /* set position */
+    }
+}
+
+/**
+ * @brief     restore the heap order around a position
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] is_high upper heap flag
+ * @param[in] i heap position
+ * @note      none
+ */
+static void a_ba121_filter_sift(ba121_filter_handle_t *handle, uint8_t is_high, uint8_t i)
+{
+    uint8_t *heap;
+    uint8_t count;
+    uint8_t slot;
+
+    heap = (is_high != 0) ? handle->high : handle->low;                      /* select heap */
+    count = (is_high != 0) ? handle->high_count : handle->low_count;         /* select count */
+    slot = heap[i];                                                          /* save slot */
+    while (i > 0)                                                            /* sift up */
+    {
+        uint8_t parent = (uint8_t)((i - 1) / 2);                             /* parent position */
+
+        if (a_ba121_filter_above(handle, is_high, slot, heap[parent]) == 0)  /* check order */
+        {
+            break;                                                           /* break */
+        }
+        a_ba121_filter_place(handle, is_high, i, heap[parent]);              /* move parent down */
+        i = parent;                                                          /* next */
+    }
+    while (1)                                                                /* sift down */
+    {
+        uint8_t child = (uint8_t)(2 * i + 1);                                /* left child */
+
+        if (child >= count)                                                  /* check child */
+        {
+            break;                                                           /* break */
+        }
+        if ((child + 1 < count) &&
+            (a_ba121_filter_above(handle, is_high, heap[child + 1], heap[child]) != 0))
+        {
+            child++;                                                         /* right child */
+        }
+        if (a_ba121_filter_above(handle, is_high, heap[child], slot) == 0)   /* check order */
+        {
+            break;                                                           /* break */
+        }
+        a_ba121_filter_place(handle, is_high, i, heap[child]);               /* move child up */
+        i = child;                                                           /* next */
+    }
+    a_ba121_filter_place(handle, is_high, i, slot);                          /* place slot */
+}
+
+/**
+ * @brief     push a slot into a heap
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] is_high upper heap flag
+ * @param[in] slot sample slot
+ * @note      none
+ */
+static void a_ba121_filter_push(ba121_filter_handle_t *handle, uint8_t is_high, uint8_t slot)
+{
+    uint8_t i;
+
+    if (is_high != 0)                                                        /* upper heap */
+    {
+        i = handle->high_count++;                                            /* append */
+    }
+    else                                                                     /* lower heap */
+    {
+        i = handle->low_count++;                                             /* append */
+    }
+    a_ba121_filter_place(handle, is_high, i, slot);                          /* place slot */
+    a_ba121_filter_sift(handle, is_high, i);                                 /* sift */
+}
+
+/**
+ * @brief     remove a heap position
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] is_high upper heap flag
+ * @param[in] i heap position
+ * @return    removed slot
+ * @note      none
+ */
+static uint8_t a_ba121_filter_remove_at(ba121_filter_handle_t *handle, uint8_t is_high, uint8_t i)
+{
+    uint8_t *heap;
+    uint8_t slot;
+    uint8_t last;
+
+    heap = (is_high != 0) ? handle->high : handle->low;                      /* select heap */
+    slot = heap[i];                                                          /* save slot */
+    if (is_high != 0)                                                        /* upper heap */
+    {
+        last = --handle->high_count;                                         /* shrink */
+    }
+    else                                                                     /* lower heap */
+    {
+        last = --handle->low_count;                                          /* shrink */
+    }
+    if (i != last)                                                           /* not the last one */
+    {
+        a_ba121_filter_place(handle, is_high, i, heap[last]);                /* fill the hole */
+        a_ba121_filter_sift(handle, is_high, i);                             /* sift */
+    }
+
+    return slot;                                                             /* return slot */
+}
+
+/**
+ * @brief     keep both halves balanced
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @note      the lower half holds the extra sample for odd counts
+ */
+static void a_ba121_filter_balance(ba121_filter_handle_t *handle)
+{
+    if (handle->low_count > handle->high_count + 1)                          /* lower half too big */
+    {
+        a_ba121_filter_push(handle, 1, a_ba121_filter_remove_at(handle, 0, 0));
+    }
+    else if (handle->high_count > handle->low_count)                         /* upper half too big */
+    {
+        a_ba121_filter_push(handle, 0, a_ba121_filter_remove_at(handle, 1, 0));
+    }
+    else
+    {
+        /* balanced */
+    }
+}
+
+/**
+ * @brief     insert a slot
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] slot sample slot
+ * @note      none
+ */
+static void a_ba121_filter_insert(ba121_filter_handle_t *handle, uint8_t slot)
+{
+    if ((handle->low_count == 0) ||
+        (handle->sample[slot] <= handle->sample[handle->low[0]]))            /* belongs to the lower half */
+    {
+        a_ba121_filter_push(handle, 0, slot);                                /* push lower */
+    }
+    else
+    {
+        a_ba121_filter_push(handle, 1, slot);                                /* push upper */
+    }
+    a_ba121_filter_balance(handle);                                          /* balance */
+}
+
+/**
+ * @brief     erase a slot
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] slot sample slot
+ * @note      none
+ */
+static void a_ba121_filter_erase(ba121_filter_handle_t *handle, uint8_t slot)
+{
+    uint8_t p;
+
+    p = handle->pos[slot];                                                   /* get position */
+    (void)a_ba121_filter_remove_at(handle, (uint8_t)(p & BA121_FILTER_HIGH_FLAG),
+                                   (uint8_t)(p & ~BA121_FILTER_HIGH_FLAG));  /* remove */
+    a_ba121_filter_balance(handle);                                          /* balance */
+}
+
+/**
+ * @brief         select the k-th smallest value
+ * @param[in,out] *buf pointer to a data buffer
+ * @param[in]     n data length
+ * @param[in]     k rank
+ * @return        k-th smallest value
+ * @note          the buffer is reordered, the three way partition groups the values equal to the pivot,
+ *                so a flat window, where every deviation is 0, finishes in one pass
+ */
+static uint16_t a_ba121_filter_select(uint16_t *buf, uint8_t n, uint8_t k)
+{
+    uint8_t left;
+    uint8_t right;
+
+    left = 0;                                                                /* init left */
+    right = (uint8_t)(n - 1);                                                /* init right */
+    while (left < right)                                                     /* narrow down */
+    {
+        uint16_t pivot;
+        uint16_t t;
+        uint8_t lt;
+        uint8_t gt;
+        uint8_t i;
+
+        pivot = buf[(left + right) / 2];                                     /* middle pivot */
+        lt = left;                                                           /* end of the smaller part */
+        gt = right;                                                          /* start of the bigger part */
+        i = left;                                                            /* init index */
+        while (i <= gt)                                                      /* partition */
+        {
+            if (buf[i] < pivot)                                              /* smaller */
+            {
+                t = buf[i];                                                  /* swap */
+                buf[i] = buf[lt];                                            /* swap */
+                buf[lt] = t;                                                 /* swap */
+                lt++;                                                        /* next */
+                i++;                                                         /* next */
+            }
+            else if (buf[i] > pivot)                                         /* bigger */
+            {
+                t = buf[i];                                                  /* swap */
+                buf[i] = buf[gt];                                            /* swap */
+                buf[gt] = t;                                                 /* swap */
+                gt--;                                                        /* the pivot is still in [i, gt] */
+            }
+            else                                                             /* equal */
+            {
+                i++;                                                         /* next */
+            }
+        }
+        if (k < lt)                                                          /* left part */
+        {
+            right = (uint8_t)(lt - 1);                                       /* move right */
+        }
+        else if (k > gt)                                                     /* right part */
+        {
+            left = (uint8_t)(gt + 1);                                        /* move left */
+        }
+        else                                                                 /* equal part */
+        {
+            return pivot;                                                    /* return value */
+        }
+    }
+
+    return buf[k];                                                           /* return value */
+}
+
+/**
+ * @brief     initialize the filter
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] window window length
+ * @param[in] sigma hampel threshold in sigma
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 window is invalid
+ *            - 5 sigma is invalid
+ * @note      1 <= window <= BA121_FILTER_MAX_WINDOW, sigma <= 0 disables the hampel identifier
+ */
+uint8_t ba121_filter_init(ba121_filter_handle_t *handle, uint8_t window, float sigma)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if ((window == 0) || (window > BA121_FILTER_MAX_WINDOW))                 /* check window */
+    {
+        return 4;                                                            /* return error */
+    }
+    if (sigma != sigma)                                                      /* check nan */
+    {
+        return 5;                                                            /* return error */
+    }
+
+    memset(handle, 0, sizeof(ba121_filter_handle_t));                        /* clear handle */
+    handle->window = window;                                                 /* set window */
+    handle->sigma = sigma;                                                   /* set sigma */
+    handle->inited = 1;                                                      /* flag finish initialization */
+
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief     reset the filter history
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ba121_filter_reset(ba121_filter_handle_t *handle)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+
+    handle->low_count = 0;                                                   /* clear lower half */
+    handle->high_count = 0;                                                  /* clear upper half */
+    handle->head = 0;                                                        /* clear head */
+    handle->count = 0;                                                       /* clear count */
+
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      push one sample through the filter
+ * @param[in]  *handle pointer to a ba121 filter handle structure
+ * @param[in]  raw raw sample
+ * @param[out] *median pointer to a running median buffer
+ * @param[out] *output pointer to a filtered output buffer
+ * @param[out] *outlier pointer to an outlier flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the running median costs O(log window) per sample, the hampel identifier adds O(window),
+ *             one pass for the deviations and a three way quickselect for the mad,
+ *             output is the median when the sample is an outlier, otherwise the sample itself,
+ *             the mad is at least BA121_FILTER_MIN_MAD
+ */
+uint8_t ba121_filter_update(ba121_filter_handle_t *handle, uint16_t raw,
+                            uint16_t *median, uint16_t *output, uint8_t *outlier)
+{
+    uint8_t slot;
+    uint8_t i;
+    uint16_t med;
+    uint16_t dev;
+
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+
+    if (handle->count < handle->window)                                      /* window is filling */
+    {
+        slot = handle->count;                                                /* next free slot */
+        handle->count++;                                                     /* count one more */
+    }
+    else                                                                     /* window is full */
+    {
+        slot = handle->head;                                                 /* oldest slot */
+        a_ba121_filter_erase(handle, slot);                                  /* drop the oldest sample */
+        handle->head = (uint8_t)((handle->head + 1) % handle->window);       /* move head */
+    }
+    handle->sample[slot] = raw;                                              /* save sample */
+    a_ba121_filter_insert(handle, slot);                                     /* insert sample */
+
+    if ((handle->count & 0x01) != 0)                                         /* odd count */
+    {
+        med = handle->sample[handle->low[0]];                                /* middle sample */
+    }
+    else                                                                     /* even count */
+    {
+        med = (uint16_t)(((uint32_t)handle->sample[handle->low[0]] +
+                          (uint32_t)handle->sample[handle->high[0]]) / 2);   /* mean of the middle samples */
+    }
+    *median = med;                                                           /* set median */
+    *output = raw;                                                           /* set output */
+    *outlier = 0;                                                            /* no outlier */
+
+    if ((handle->sigma > 0.0f) && (handle->count >= 3))                      /* hampel identifier */
+    {
+        uint16_t mad;
+
+        for (i = 0; i < handle->count; i++)                                  /* absolute deviations */
+        {
+            handle->scratch[i] = (handle->sample[i] > med) ? (uint16_t)(handle->sample[i] - med) :
+                                                             (uint16_t)(med - handle->sample[i]);
+        }
+        mad = a_ba121_filter_select(handle->scratch, handle->count,
+                                    (uint8_t)((handle->count - 1) / 2));     /* median absolute deviation */
+        if (mad < BA121_FILTER_MIN_MAD)                                      /* quantized quiet window */
+        {
+            mad = BA121_FILTER_MIN_MAD;                                      /* floor */
+        }
+        dev = (raw > med) ? (uint16_t)(raw - med) : (uint16_t)(med - raw);   /* sample deviation */
+        if ((float)dev > handle->sigma * 1.4826f * (float)mad)               /* check threshold */
+        {
+            *output = med;                                                   /* replace with the median */
+            *outlier = 1;                                                    /* flag outlier */
+        }
+    }
+
+    return 0;                                                                /* success return 0 */
+}
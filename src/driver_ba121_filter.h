@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_filter.h
+ * @brief     driver ba121 filter header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_FILTER_H
+#define DRIVER_BA121_FILTER_H
+
+#include "driver_ba121.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_filter_driver ba121 filter driver function
+ * @brief    ba121 filter driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief ba121 filter max window definition
+ */
+#ifndef BA121_FILTER_MAX_WINDOW
+    #define BA121_FILTER_MAX_WINDOW        31        /**< max 127 */
+#endif
+
+/**
+ * @brief ba121 filter default definition
+ */
+#define BA121_FILTER_DEFAULT_WINDOW        7            /**< 7 samples */
+#define BA121_FILTER_DEFAULT_SIGMA         3.0f         /**< 3 sigma */
+
+/**
+ * @brief ba121 filter min mad definition
+ * @note  the samples are integers, so a quiet window often has a mad of 0 and would flag every 1 lsb step
+ */
+#ifndef BA121_FILTER_MIN_MAD
+    #define BA121_FILTER_MIN_MAD           1            /**< 1 lsb */
+#endif
+
+/**
+ * @brief ba121 filter handle structure definition
+ */
+typedef struct ba121_filter_handle_s
+{
+    uint16_t sample[BA121_FILTER_MAX_WINDOW];        /**< sample ring */
+    uint16_t scratch[BA121_FILTER_MAX_WINDOW];       /**< deviation scratch buffer */
+    uint8_t low[BA121_FILTER_MAX_WINDOW];            /**< max heap of the lower half */
+    uint8_t high[BA121_FILTER_MAX_WINDOW];           /**< min heap of the upper half */
+    uint8_t pos[BA121_FILTER_MAX_WINDOW];            /**< heap position of each slot */
+    uint8_t low_count;                               /**< lower half count */
+    uint8_t high_count;                              /**< upper half count */
+    uint8_t window;                                  /**< window length */
+    uint8_t head;                                    /**< oldest slot */
+    uint8_t count;                                   /**< valid sample count */
+    uint8_t inited;                                  /**< inited flag */
+    float sigma;                                     /**< hampel threshold in sigma */
+} ba121_filter_handle_t;
+
+/**
+ * @brief     initialize the filter
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @param[in] window window length
+ * @param[in] sigma hampel threshold in sigma
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 window is invalid
+ *            - 5 sigma is invalid
+ * @note      1 <= window <= BA121_FILTER_MAX_WINDOW, sigma <= 0 disables the hampel identifier
+ */
+uint8_t ba121_filter_init(ba121_filter_handle_t *handle, uint8_t window, float sigma);
+
+/**
+ * @brief     reset the filter history
+ * @param[in] *handle pointer to a ba121 filter handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ba121_filter_reset(ba121_filter_handle_t *handle);
+
+/**
+ * @brief      push one sample through the filter
+ * @param[in]  *handle pointer to a ba121 filter handle structure
+ * @param[in]  raw raw sample
+ * @param[out] *median pointer to a running median buffer
+ * @param[out] *output pointer to a filtered output buffer
+ * @param[out] *outlier pointer to an outlier flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the running median costs O(log window) per sample, the hampel identifier adds O(window),
+ *             one pass for the deviations and a three way quickselect for the mad,
+ *             output is the median when the sample is an outlier, otherwise the sample itself,
+ *             the mad is at least BA121_FILTER_MIN_MAD
+ */
+uint8_t ba121_filter_update(ba121_filter_handle_t *handle, uint16_t raw,
+                            uint16_t *median, uint16_t *output, uint8_t *outlier);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_frame.h
+ * @brief     driver ba121 frame header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_FRAME_H
+#define DRIVER_BA121_FRAME_H
+
+#include "driver_ba121.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_frame_driver ba121 frame driver function
+ * @brief    ba121 frame driver modules, shared by the driver and the pool, not part of the public api
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief chip command definition
+ */
+#define BA121_COMMAND_READ        0xA0        /**< read command */
+#define BA121_COMMAND_BASELINE    0xA6        /**< baseline command */
+#define BA121_COMMAND_NTC_RES     0xA3        /**< ntc resistance command */
+#define BA121_COMMAND_NTC_B       0xA5        /**< ntc b command */
+
+/**
+ * @brief chip command delay definition
+ */
+#define BA121_READ_DELAY_MS       800         /**< read reply delay */
+#define BA121_ACK_DELAY_MS        500         /**< ack reply delay */
+
+/**
+ * @brief chip frame definition
+ */
+#define BA121_FRAME_LEN           6           /**< frame length */
+#define BA121_FRAME_DATA          0xAA        /**< data reply header */
+#define BA121_FRAME_ACK           0xAC        /**< ack reply header */
+
+/**
+ * @brief      make frame
+ * @param[in]  command input command
+ * @param[in]  data input data
+ * @param[out] *output pointer to an output buffer
+ * @note       none
+ */
+void ba121_frame_make(uint8_t command, uint32_t data, uint8_t output[6]);
+
+/**
+ * @brief      parse frame
+ * @param[in]  *input pointer to an input buffer
+ * @param[in]  header expected frame header
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 checksum error
+ *             - 2 frame header invalid
+ * @note       none
+ */
+uint8_t ba121_frame_parse(const uint8_t input[6], uint8_t header, uint32_t *data);
+
+/**
+ * @brief         find the first reply frame in a byte stream
+ * @param[in,out] *buf pointer to a stream buffer
+ * @param[in,out] *len pointer to a stream length buffer
+ * @return        status code
+ *                - 0 a frame starts at buf[0]
+ *                - 1 less than one frame left
+ * @note          bytes that don't start a data or ack frame with a good checksum are dropped one by one,
+ *                the frame itself stays in the buffer
+ */
+uint8_t ba121_frame_sync(uint8_t *buf, uint16_t *len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
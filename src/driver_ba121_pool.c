@@ -0,0 +1,811 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_pool.c
+ * @brief     driver ba121 pool source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_pool.h"
+#include "driver_ba121_frame.h"
+
+/**
+ * @brief pool receive definition
+ */
+#define BA121_POOL_RX_LEN        (2 * BA121_FRAME_LEN)        /**< room for a stale frame and the reply */
+#define BA121_POOL_RX_READS      16                           /**< reads before a split reply fails */
+
+/**
+ * @brief     check a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @return    1 if the channel is active, otherwise 0
+ * @note      none
+ */
+static uint8_t a_ba121_pool_is_active(ba121_pool_t *pool, uint16_t channel)
+{
+    if (channel >= BA121_POOL_MAX_CHANNELS)                                                 /* check range */
+    {
+        return 0;                                                                           /* invalid */
+    }
+
+    return (uint8_t)((pool->active[channel / 32] >> (channel % 32)) & 1U);                  /* get bit */
+}
+
+/**
+ * @brief     get the time
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @return    time in us, 0 if no timestamp function is linked
+ * @note      none
+ */
+static uint64_t a_ba121_pool_now_us(ba121_pool_t *pool)
+{
+    if (pool->timestamp_us == NULL)                                                         /* check timestamp_us */
+    {
+        return 0;                                                                           /* no clock */
+    }
+
+    return pool->timestamp_us();                                                            /* get time */
+}
+
+/**
+ * @brief     send one command to a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @param[in] *frame pointer to a command frame
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush or write failed
+ * @note      none
+ */
+static uint8_t a_ba121_pool_send(ba121_pool_t *pool, uint16_t channel, uint8_t frame[6])
+{
+    const ba121_pool_ops_t *ops;
+
+    ops = pool->ops[pool->ops_index[channel]];                                              /* get ops */
+    if ((ops->uart_flush(pool->port[channel]) != 0) ||
+        (ops->uart_write(pool->port[channel], frame, BA121_FRAME_LEN) != 0))                /* flush and write */
+    {
+        pool->debug_print("ba121: channel %d uart write failed.\n", channel);               /* uart write failed */
+
+        return 1;                                                                           /* return error */
+    }
+    pool->tx_us[channel] = a_ba121_pool_now_us(pool);                                       /* stamp transmit */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      receive one reply from a channel
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  channel channel index
+ * @param[in]  header expected frame header
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no valid reply
+ * @note       a reply split over several reads is collected, junk bytes and a stale frame of the
+ *             other type are skipped with the driver resync
+ */
+static uint8_t a_ba121_pool_receive(ba121_pool_t *pool, uint16_t channel, uint8_t header, uint32_t *data)
+{
+    const ba121_pool_ops_t *ops;
+    uint8_t buf[BA121_POOL_RX_LEN];
+    uint16_t len;
+    uint16_t n;
+    uint8_t i;
+
+    ops = pool->ops[pool->ops_index[channel]];                                              /* get ops */
+    len = 0;                                                                                /* init 0 */
+    for (i = 0; i < BA121_POOL_RX_READS; i++)                                               /* bounded reads */
+    {
+        n = ops->uart_read(pool->port[channel], &buf[len], (uint16_t)(sizeof(buf) - len));  /* read */
+        len = (uint16_t)(len + n);                                                          /* append */
+        while (ba121_frame_sync(buf, &len) == 0)                                            /* resync to a frame */
+        {
+            if (ba121_frame_parse(buf, header, data) == 0)                                  /* check type */
+            {
+                return 0;                                                                   /* success return 0 */
+            }
+            len = (uint16_t)(len - BA121_FRAME_LEN);                                        /* drop stale frame */
+            memmove(buf, &buf[BA121_FRAME_LEN], len);                                       /* move */
+        }
+        if (n == 0)                                                                         /* nothing more */
+        {
+            break;                                                                          /* break */
+        }
+    }
+    pool->debug_print("ba121: channel %d frame error.\n", channel);                         /* frame error */
+
+    return 1;                                                                               /* return error */
+}
+
+/**
+ * @brief     run one ack command on a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @param[in] command input command
+ * @param[in] param input data
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush, write, read or frame failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ *            - 5 response error
+ * @note      link and frame errors are retried, a response error is the answer of the sensor
+ */
+static uint8_t a_ba121_pool_command(ba121_pool_t *pool, uint16_t channel, uint8_t command, uint32_t param)
+{
+    const ba121_pool_ops_t *ops;
+    uint32_t data;
+    uint8_t output[6];
+    uint8_t attempt;
+
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (a_ba121_pool_is_active(pool, channel) == 0)                                         /* check channel */
+    {
+        return 4;                                                                           /* return error */
+    }
+
+    ops = pool->ops[pool->ops_index[channel]];                                              /* get ops */
+    ba121_frame_make(command, param, output);                                               /* make frame */
+    for (attempt = 0; attempt < pool->retry_attempts; attempt++)                            /* all attempts */
+    {
+        if (a_ba121_pool_send(pool, channel, output) != 0)                                  /* send */
+        {
+            continue;                                                                       /* retry */
+        }
+        if (ops->wait_reply != NULL)                                                        /* check wait_reply */
+        {
+            (void)ops->wait_reply(pool->port[channel], BA121_FRAME_LEN,
+                                  BA121_ACK_DELAY_MS);                                      /* wait for the reply */
+        }
+        else
+        {
+            pool->delay_ms(BA121_ACK_DELAY_MS);                                             /* delay */
+        }
+        if (a_ba121_pool_receive(pool, channel, BA121_FRAME_ACK, &data) != 0)               /* receive */
+        {
+            continue;                                                                       /* retry */
+        }
+        pool->rx_us[channel] = (ops->wait_reply != NULL) ?
+                               a_ba121_pool_now_us(pool) : 0;                               /* stamp arrival, unknown after a fixed delay */
+        pool->last_status[channel] = (uint8_t)((data >> 24) & 0xFF);                        /* save last status */
+        if (pool->last_status[channel] != 0)                                                /* check last status */
+        {
+            pool->debug_print("ba121: channel %d response error.\n", channel);              /* response error */
+
+            return 5;                                                                       /* return error */
+        }
+
+        return 0;                                                                           /* success return 0 */
+    }
+
+    return 1;                                                                               /* return error */
+}
+
+/**
+ * @brief     initialize the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] *delay_ms pointer to a delay_ms function
+ * @param[in] *debug_print pointer to a debug_print function
+ * @return    status code
+ *            - 0 success
+ *            - 2 pool is NULL
+ *            - 3 linked functions is NULL
+ * @note      none
+ */
+uint8_t ba121_pool_init(ba121_pool_t *pool, void (*delay_ms)(uint32_t ms),
+                        void (*debug_print)(const char *const fmt, ...))
+{
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if ((delay_ms == NULL) || (debug_print == NULL))                                        /* check linked functions */
+    {
+        return 3;                                                                           /* return error */
+    }
+
+    memset(pool, 0, sizeof(ba121_pool_t));                                                  /* clear pool */
+    pool->delay_ms = delay_ms;                                                              /* set delay_ms */
+    pool->debug_print = debug_print;                                                        /* set debug_print */
+    pool->retry_attempts = 1;                                                               /* one attempt */
+    pool->inited = 1;                                                                       /* flag finish initialization */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the clock of the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] *timestamp_us pointer to a monotonic timestamp_us function, NULL to unlink
+ * @return    status code
+ *            - 0 success
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ * @note      with a clock, the channels whose ops have a wait_reply function are collected as soon
+ *            as their reply arrives and get an arrival time, otherwise the read delay runs in full
+ */
+uint8_t ba121_pool_set_clock(ba121_pool_t *pool, uint64_t (*timestamp_us)(void))
+{
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+
+    pool->timestamp_us = timestamp_us;                                                      /* set timestamp_us */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     set the retry attempts of the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] attempts attempts per command and rounds per sweep, at least 1
+ * @return    status code
+ *            - 0 success
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 attempts is 0
+ * @note      a sweep round only sends to the channels that failed so far, a response error is never retried
+ */
+uint8_t ba121_pool_set_retry(ba121_pool_t *pool, uint8_t attempts)
+{
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (attempts == 0)                                                                      /* check attempts */
+    {
+        pool->debug_print("ba121: attempts is 0.\n");                                       /* attempts is 0 */
+
+        return 4;                                                                           /* return error */
+    }
+
+    pool->retry_attempts = attempts;                                                        /* set attempts */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     close every channel of the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ * @note      all channels are removed even if one uart deinit fails
+ */
+uint8_t ba121_pool_deinit(ba121_pool_t *pool)
+{
+    uint8_t res;
+    uint16_t channel;
+
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+
+    res = 0;                                                                                /* init 0 */
+    channel = BA121_POOL_ITERATE_START;                                                     /* from the first channel */
+    while (ba121_pool_next(pool, BA121_POOL_ITERATE_ACTIVE, &channel) == 0)                 /* all active channels */
+    {
+        if (ba121_pool_remove(pool, channel) != 0)                                          /* remove */
+        {
+            res = 1;                                                                        /* flag error */
+        }
+    }
+    pool->inited = 0;                                                                       /* flag close */
+
+    return res;                                                                             /* return result */
+}
+
+/**
+ * @brief      register an ops table
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  *ops pointer to a ba121 pool ops structure, must stay valid
+ * @param[out] *index pointer to an ops index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no free ops slot
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 ops or its functions is NULL
+ * @note       none
+ */
+uint8_t ba121_pool_register_ops(ba121_pool_t *pool, const ba121_pool_ops_t *ops, uint8_t *index)
+{
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if ((ops == NULL) || (ops->uart_init == NULL) || (ops->uart_deinit == NULL) ||
+        (ops->uart_read == NULL) || (ops->uart_flush == NULL) ||
+        (ops->uart_write == NULL))                                                          /* check ops */
+    {
+        pool->debug_print("ba121: ops is invalid.\n");                                      /* ops is invalid */
+
+        return 4;                                                                           /* return error */
+    }
+    if (pool->ops_count >= BA121_POOL_MAX_OPS)                                              /* check slot */
+    {
+        pool->debug_print("ba121: no free ops slot.\n");                                    /* no free ops slot */
+
+        return 1;                                                                           /* return error */
+    }
+
+    pool->ops[pool->ops_count] = ops;                                                       /* save ops */
+    *index = pool->ops_count;                                                               /* set index */
+    pool->ops_count++;                                                                      /* next slot */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      add a sensor
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  ops_index registered ops index
+ * @param[in]  port port passed to the ops functions
+ * @param[out] *channel pointer to a channel buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart init failed
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 ops index is invalid
+ *             - 5 pool is full
+ * @note       the lowest free channel is used
+ */
+uint8_t ba121_pool_add(ba121_pool_t *pool, uint8_t ops_index, uint16_t port, uint16_t *channel)
+{
+    uint16_t i;
+
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (ops_index >= pool->ops_count)                                                       /* check ops index */
+    {
+        return 4;                                                                           /* return error */
+    }
+
+    for (i = 0; i < BA121_POOL_MAX_CHANNELS; i++)                                           /* find a free channel */
+    {
+        if (a_ba121_pool_is_active(pool, i) == 0)                                           /* free */
+        {
+            break;                                                                          /* found */
+        }
+    }
+    if (i == BA121_POOL_MAX_CHANNELS)                                                       /* check free channel */
+    {
+        pool->debug_print("ba121: pool is full.\n");                                        /* pool is full */
+
+        return 5;                                                                           /* return error */
+    }
+    if (pool->ops[ops_index]->uart_init(port) != 0)                                         /* uart init */
+    {
+        pool->debug_print("ba121: port %d uart init failed.\n", port);                      /* uart init failed */
+
+        return 1;                                                                           /* return error */
+    }
+
+    pool->ops_index[i] = ops_index;                                                         /* set ops index */
+    pool->port[i] = port;                                                                   /* set port */
+    pool->last_status[i] = 0;                                                               /* init 0 */
+    pool->tx_us[i] = 0;                                                                     /* init 0 */
+    pool->rx_us[i] = 0;                                                                     /* init 0 */
+    pool->conductivity_raw[i] = 0;                                                          /* init 0 */
+    pool->temperature_raw[i] = 0;                                                           /* init 0 */
+    pool->valid[i / 32] &= ~(1UL << (i % 32));                                              /* no sample */
+    pool->active[i / 32] |= 1UL << (i % 32);                                                /* flag active */
+    *channel = i;                                                                           /* set channel */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     remove a sensor
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ * @note      the channel is freed even if the uart deinit fails
+ */
+uint8_t ba121_pool_remove(ba121_pool_t *pool, uint16_t channel)
+{
+    uint8_t res;
+
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (a_ba121_pool_is_active(pool, channel) == 0)                                         /* check channel */
+    {
+        return 4;                                                                           /* return error */
+    }
+
+    res = 0;                                                                                /* init 0 */
+    if (pool->ops[pool->ops_index[channel]]->uart_deinit(pool->port[channel]) != 0)         /* uart deinit */
+    {
+        pool->debug_print("ba121: channel %d uart deinit failed.\n", channel);              /* uart deinit failed */
+        res = 1;                                                                            /* flag error */
+    }
+    pool->active[channel / 32] &= ~(1UL << (channel % 32));                                 /* flag free */
+    pool->valid[channel / 32] &= ~(1UL << (channel % 32));                                  /* no sample */
+
+    return res;                                                                             /* return result */
+}
+
+/**
+ * @brief      read every channel in one pass
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[out] *valid_count pointer to a valid channel count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ * @note       the read command is written to every channel first, then the replies are collected,
+ *             so a round takes one read delay whatever the channel count, the failed channels get
+ *             another round while retry attempts are left, check the result of each channel with
+ *             the iteration helpers
+ */
+uint8_t ba121_pool_sweep(ba121_pool_t *pool, uint16_t *valid_count)
+{
+    uint16_t channel;
+    uint16_t count;
+    uint32_t data;
+    uint32_t sent[BA121_POOL_WORDS];
+    uint64_t elapsed_us;
+    uint8_t output[6];
+    uint8_t attempt;
+    uint8_t fixed;
+    const ba121_pool_ops_t *ops;
+
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+
+    ba121_frame_make(BA121_COMMAND_READ, 0x00000000, output);                               /* make frame once */
+    memset(pool->valid, 0, sizeof(pool->valid));                                            /* no sample yet */
+    count = 0;                                                                              /* init 0 */
+    for (attempt = 0; attempt < pool->retry_attempts; attempt++)                            /* all rounds */
+    {
+        memset(sent, 0, sizeof(sent));                                                      /* nothing sent */
+        fixed = (uint8_t)(pool->timestamp_us == NULL);                                      /* a wait needs the clock */
+        channel = BA121_POOL_ITERATE_START;                                                 /* from the first channel */
+        while (ba121_pool_next(pool, BA121_POOL_ITERATE_INVALID, &channel) == 0)            /* send phase */
+        {
+            if (a_ba121_pool_send(pool, channel, output) != 0)                              /* send */
+            {
+                continue;                                                                   /* next */
+            }
+            sent[channel / 32] |= 1UL << (channel % 32);                                    /* flag sent */
+            if (pool->ops[pool->ops_index[channel]]->wait_reply == NULL)                    /* check wait_reply */
+            {
+                fixed = 1;                                                                  /* fixed delay */
+            }
+        }
+        if (fixed != 0)                                                                     /* fixed delay */
+        {
+            pool->delay_ms(BA121_READ_DELAY_MS);                                            /* one delay for all */
+        }
+
+        channel = BA121_POOL_ITERATE_START;                                                 /* from the first channel */
+        while (ba121_pool_next(pool, BA121_POOL_ITERATE_INVALID, &channel) == 0)            /* collect phase */
+        {
+            if (((sent[channel / 32] >> (channel % 32)) & 1U) == 0)                         /* check sent */
+            {
+                continue;                                                                   /* next */
+            }
+            ops = pool->ops[pool->ops_index[channel]];                                      /* get ops */
+            if (fixed == 0)                                                                 /* wait for this reply */
+            {
+                elapsed_us = a_ba121_pool_now_us(pool) - pool->tx_us[channel];              /* time since the write */
+                (void)ops->wait_reply(pool->port[channel], BA121_FRAME_LEN,
+                                      (elapsed_us >= (uint64_t)BA121_READ_DELAY_MS * 1000) ? 0 :
+                                      (uint32_t)(BA121_READ_DELAY_MS - elapsed_us / 1000)); /* wait the rest of the delay */
+            }
+            if (a_ba121_pool_receive(pool, channel, BA121_FRAME_DATA, &data) != 0)          /* receive */
+            {
+                continue;                                                                   /* next */
+            }
+            pool->rx_us[channel] = (fixed == 0) ? a_ba121_pool_now_us(pool) : 0;            /* stamp arrival, unknown after a fixed delay */
+            pool->conductivity_raw[channel] = (uint16_t)((data >> 16) & 0xFFFFU);           /* set conductivity raw */
+            pool->temperature_raw[channel] = (uint16_t)((data >> 0) & 0xFFFFU);             /* set temperature raw */
+            pool->valid[channel / 32] |= 1UL << (channel % 32);                             /* flag valid */
+            count++;                                                                        /* count valid */
+        }
+        channel = BA121_POOL_ITERATE_START;                                                 /* from the first channel */
+        if (ba121_pool_next(pool, BA121_POOL_ITERATE_INVALID, &channel) != 0)               /* check failed channels */
+        {
+            break;                                                                          /* all sampled */
+        }
+    }
+    if (valid_count != NULL)                                                                /* check buffer */
+    {
+        *valid_count = count;                                                               /* set count */
+    }
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief         get the next channel
+ * @param[in]     *pool pointer to a ba121 pool structure
+ * @param[in]     type iterate type
+ * @param[in,out] *channel pointer to a channel buffer, BA121_POOL_ITERATE_START to start
+ * @return        status code
+ *                - 0 success
+ *                - 1 no more channels
+ *                - 2 pool is NULL
+ *                - 3 pool is not initialized
+ *                - 4 type is invalid
+ * @note          for (ch = BA121_POOL_ITERATE_START; ba121_pool_next(&pool, type, &ch) == 0; ) visits channels in order
+ */
+uint8_t ba121_pool_next(ba121_pool_t *pool, ba121_pool_iterate_t type, uint16_t *channel)
+{
+    uint32_t start;
+    uint32_t word;
+    uint32_t bits;
+
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (type > BA121_POOL_ITERATE_INVALID)                                                  /* check type */
+    {
+        return 4;                                                                           /* return error */
+    }
+
+    start = (*channel == BA121_POOL_ITERATE_START) ? 0 : (uint32_t)*channel + 1;            /* first candidate */
+    for (word = start / 32; word < BA121_POOL_WORDS; word++)                                /* scan words */
+    {
+        if (type == BA121_POOL_ITERATE_ACTIVE)                                              /* active channels */
+        {
+            bits = pool->active[word];                                                      /* get bits */
+        }
+        else if (type == BA121_POOL_ITERATE_VALID)                                          /* sampled channels */
+        {
+            bits = pool->active[word] & pool->valid[word];                                  /* get bits */
+        }
+        else                                                                                /* failed channels */
+        {
+            bits = pool->active[word] & ~pool->valid[word];                                 /* get bits */
+        }
+        if (word == start / 32)                                                             /* first word */
+        {
+            bits &= 0xFFFFFFFFUL << (start % 32);                                           /* skip visited */
+        }
+        if (bits != 0)                                                                      /* found */
+        {
+            uint32_t bit;
+
+            bit = 0;                                                                        /* init 0 */
+            while ((bits & 1U) == 0)                                                        /* lowest set bit */
+            {
+                bits >>= 1;                                                                 /* shift */
+                bit++;                                                                      /* next */
+            }
+            if (word * 32 + bit >= BA121_POOL_MAX_CHANNELS)                                 /* check range */
+            {
+                return 1;                                                                   /* no more */
+            }
+            *channel = (uint16_t)(word * 32 + bit);                                         /* set channel */
+
+            return 0;                                                                       /* success return 0 */
+        }
+    }
+
+    return 1;                                                                               /* no more */
+}
+
+/**
+ * @brief      get the last sample of a channel
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  channel channel index
+ * @param[out] *conductivity_raw pointer to a conductivity raw buffer
+ * @param[out] *conductivity_us_cm pointer to a conductivity buffer
+ * @param[out] *temperature_raw pointer to a temperature raw buffer
+ * @param[out] *temperature pointer to a temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample from the last sweep
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 channel is invalid
+ * @note       none
+ */
+uint8_t ba121_pool_get_sample(ba121_pool_t *pool, uint16_t channel,
+                              uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
+                              uint16_t *temperature_raw, float *temperature)
+{
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (a_ba121_pool_is_active(pool, channel) == 0)                                         /* check channel */
+    {
+        return 4;                                                                           /* return error */
+    }
+    if (((pool->valid[channel / 32] >> (channel % 32)) & 1U) == 0)                          /* check sample */
+    {
+        return 1;                                                                           /* return error */
+    }
+
+    *conductivity_raw = pool->conductivity_raw[channel];                                    /* set conductivity raw */
+    *conductivity_us_cm = *conductivity_raw;                                                /* set conductivity us cm */
+    *temperature_raw = pool->temperature_raw[channel];                                      /* set temperature raw */
+    *temperature = (float)(*temperature_raw) / 100.0f;                                      /* set temperature */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the time stamps of the last reply of a channel
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  channel channel index
+ * @param[out] *tx_us pointer to a transmit time buffer
+ * @param[out] *rx_us pointer to an arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 channel is invalid
+ * @note       both are 0 without a clock, rx_us is 0 when the reply was read after a fixed delay
+ */
+uint8_t ba121_pool_get_timestamp(ba121_pool_t *pool, uint16_t channel, uint64_t *tx_us, uint64_t *rx_us)
+{
+    if (pool == NULL)                                                                       /* check pool */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (pool->inited != 1)                                                                  /* check pool initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    if (a_ba121_pool_is_active(pool, channel) == 0)                                         /* check channel */
+    {
+        return 4;                                                                           /* return error */
+    }
+
+    *tx_us = pool->tx_us[channel];                                                          /* set transmit time */
+    *rx_us = pool->rx_us[channel];                                                          /* set arrival time */
+
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     run the baseline calibration on a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush, write, read or frame failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ *            - 5 response error
+ * @note      blocking, link and frame errors are retried, the response status is kept in last_status
+ */
+uint8_t ba121_pool_baseline_calibration(ba121_pool_t *pool, uint16_t channel)
+{
+    return a_ba121_pool_command(pool, channel, BA121_COMMAND_BASELINE, 0x00000000);         /* send */
+}
+
+/**
+ * @brief     set the ntc resistance of a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @param[in] ohm resistance ohm
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush, write, read or frame failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ *            - 5 response error
+ * @note      blocking, link and frame errors are retried, the response status is kept in last_status
+ */
+uint8_t ba121_pool_set_ntc_resistance(ba121_pool_t *pool, uint16_t channel, uint32_t ohm)
+{
+    return a_ba121_pool_command(pool, channel, BA121_COMMAND_NTC_RES, ohm);                 /* send */
+}
+
+/**
+ * @brief     set the ntc b of a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @param[in] value ntc value
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush, write, read or frame failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ *            - 5 response error
+ * @note      blocking, link and frame errors are retried, the response status is kept in last_status
+ */
+uint8_t ba121_pool_set_ntc_b(ba121_pool_t *pool, uint16_t channel, uint16_t value)
+{
+    return a_ba121_pool_command(pool, channel, BA121_COMMAND_NTC_B,
+                                (uint32_t)value << 16);                                     /* send */
+}
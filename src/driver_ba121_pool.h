@@ -0,0 +1,344 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_pool.h
+ * @brief     driver ba121 pool header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_POOL_H
+#define DRIVER_BA121_POOL_H
+
+#include "driver_ba121.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_pool_driver ba121 pool driver function
+ * @brief    ba121 pool driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief ba121 pool max channels definition
+ */
+#ifndef BA121_POOL_MAX_CHANNELS
+    #define BA121_POOL_MAX_CHANNELS        64        /**< 64 sensors */
+#endif
+
+/**
+ * @brief ba121 pool max ops definition
+ */
+#ifndef BA121_POOL_MAX_OPS
+    #define BA121_POOL_MAX_OPS             4         /**< 4 ops tables */
+#endif
+
+/**
+ * @brief ba121 pool iteration start definition
+ */
+#define BA121_POOL_ITERATE_START           0xFFFFU   /**< pass as channel to get the first channel */
+
+/**
+ * @brief ba121 pool bitmap words definition
+ */
+#define BA121_POOL_WORDS                   ((BA121_POOL_MAX_CHANNELS + 31) / 32)
+
+/**
+ * @brief ba121 pool iterate enumeration definition
+ */
+typedef enum
+{
+    BA121_POOL_ITERATE_ACTIVE  = 0x00,        /**< all added channels */
+    BA121_POOL_ITERATE_VALID   = 0x01,        /**< channels with a sample from the last sweep */
+    BA121_POOL_ITERATE_INVALID = 0x02,        /**< channels that failed the last sweep */
+} ba121_pool_iterate_t;
+
+/**
+ * @brief ba121 pool ops structure definition
+ * @note  port is the value given to ba121_pool_add, one table serves every sensor on the same kind of link
+ */
+typedef struct ba121_pool_ops_s
+{
+    uint8_t (*uart_init)(uint16_t port);                                  /**< point to an uart_init function address */
+    uint8_t (*uart_deinit)(uint16_t port);                                /**< point to an uart_deinit function address */
+    uint16_t (*uart_read)(uint16_t port, uint8_t *buf, uint16_t len);     /**< point to an uart_read function address */
+    uint8_t (*uart_flush)(uint16_t port);                                 /**< point to an uart_flush function address */
+    uint8_t (*uart_write)(uint16_t port, uint8_t *buf, uint16_t len);     /**< point to an uart_write function address */
+    uint8_t (*wait_reply)(uint16_t port, uint16_t len,
+                          uint32_t timeout_ms);                           /**< point to a wait_reply function address, may be NULL */
+} ba121_pool_ops_t;
+
+/**
+ * @brief ba121 pool structure definition
+ * @note  the per channel state is kept as parallel arrays so a sweep only touches what it needs
+ */
+typedef struct ba121_pool_s
+{
+    const ba121_pool_ops_t *ops[BA121_POOL_MAX_OPS];                  /**< shared ops tables */
+    void (*delay_ms)(uint32_t ms);                                    /**< point to a delay_ms function address */
+    void (*debug_print)(const char *const fmt, ...);                  /**< point to a debug_print function address */
+    uint64_t (*timestamp_us)(void);                                   /**< point to a timestamp_us function address, may be NULL */
+    uint32_t active[BA121_POOL_WORDS];                                /**< added channel bitmap */
+    uint32_t valid[BA121_POOL_WORDS];                                 /**< sampled channel bitmap */
+    uint8_t ops_index[BA121_POOL_MAX_CHANNELS];                       /**< ops table of each channel */
+    uint16_t port[BA121_POOL_MAX_CHANNELS];                           /**< port of each channel */
+    uint8_t last_status[BA121_POOL_MAX_CHANNELS];                     /**< last ack status of each channel */
+    uint16_t conductivity_raw[BA121_POOL_MAX_CHANNELS];               /**< last conductivity raw of each channel */
+    uint16_t temperature_raw[BA121_POOL_MAX_CHANNELS];                /**< last temperature raw of each channel */
+    uint64_t tx_us[BA121_POOL_MAX_CHANNELS];                          /**< last transmit time of each channel */
+    uint64_t rx_us[BA121_POOL_MAX_CHANNELS];                          /**< last arrival time of each channel, 0 after a fixed delay */
+    uint8_t retry_attempts;                                           /**< attempts per command and rounds per sweep */
+    uint8_t ops_count;                                                /**< registered ops tables */
+    uint8_t inited;                                                   /**< inited flag */
+} ba121_pool_t;
+
+/**
+ * @brief     initialize the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] *delay_ms pointer to a delay_ms function
+ * @param[in] *debug_print pointer to a debug_print function
+ * @return    status code
+ *            - 0 success
+ *            - 2 pool is NULL
+ *            - 3 linked functions is NULL
+ * @note      none
+ */
+uint8_t ba121_pool_init(ba121_pool_t *pool, void (*delay_ms)(uint32_t ms),
+                        void (*debug_print)(const char *const fmt, ...));
+
+/**
+ * @brief     set the clock of the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] *timestamp_us pointer to a monotonic timestamp_us function, NULL to unlink
+ * @return    status code
+ *            - 0 success
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ * @note      with a clock, the channels whose ops have a wait_reply function are collected as soon
+ *            as their reply arrives and get an arrival time, otherwise the read delay runs in full
+ */
+uint8_t ba121_pool_set_clock(ba121_pool_t *pool, uint64_t (*timestamp_us)(void));
+
+/**
+ * @brief     set the retry attempts of the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] attempts attempts per command and rounds per sweep, at least 1
+ * @return    status code
+ *            - 0 success
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 attempts is 0
+ * @note      a sweep round only sends to the channels that failed so far, a response error is never retried
+ */
+uint8_t ba121_pool_set_retry(ba121_pool_t *pool, uint8_t attempts);
+
+/**
+ * @brief     close every channel of the pool
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ * @note      all channels are removed even if one uart deinit fails
+ */
+uint8_t ba121_pool_deinit(ba121_pool_t *pool);
+
+/**
+ * @brief      register an ops table
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  *ops pointer to a ba121 pool ops structure, must stay valid
+ * @param[out] *index pointer to an ops index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no free ops slot
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 ops or its functions is NULL
+ * @note       none
+ */
+uint8_t ba121_pool_register_ops(ba121_pool_t *pool, const ba121_pool_ops_t *ops, uint8_t *index);
+
+/**
+ * @brief      add a sensor
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  ops_index registered ops index
+ * @param[in]  port port passed to the ops functions
+ * @param[out] *channel pointer to a channel buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uart init failed
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 ops index is invalid
+ *             - 5 pool is full
+ * @note       the lowest free channel is used
+ */
+uint8_t ba121_pool_add(ba121_pool_t *pool, uint8_t ops_index, uint16_t port, uint16_t *channel);
+
+/**
+ * @brief     remove a sensor
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart deinit failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ * @note      the channel is freed even if the uart deinit fails
+ */
+uint8_t ba121_pool_remove(ba121_pool_t *pool, uint16_t channel);
+
+/**
+ * @brief      read every channel in one pass
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[out] *valid_count pointer to a valid channel count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ * @note       the read command is written to every channel first, then the replies are collected,
+ *             so a round takes one read delay whatever the channel count, the failed channels get
+ *             another round while retry attempts are left, check the result of each channel with
+ *             the iteration helpers
+ */
+uint8_t ba121_pool_sweep(ba121_pool_t *pool, uint16_t *valid_count);
+
+/**
+ * @brief         get the next channel
+ * @param[in]     *pool pointer to a ba121 pool structure
+ * @param[in]     type iterate type
+ * @param[in,out] *channel pointer to a channel buffer, BA121_POOL_ITERATE_START to start
+ * @return        status code
+ *                - 0 success
+ *                - 1 no more channels
+ *                - 2 pool is NULL
+ *                - 3 pool is not initialized
+ *                - 4 type is invalid
+ * @note          for (ch = BA121_POOL_ITERATE_START; ba121_pool_next(&pool, type, &ch) == 0; ) visits channels in order
+ */
+uint8_t ba121_pool_next(ba121_pool_t *pool, ba121_pool_iterate_t type, uint16_t *channel);
+
+/**
+ * @brief      get the last sample of a channel
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  channel channel index
+ * @param[out] *conductivity_raw pointer to a conductivity raw buffer
+ * @param[out] *conductivity_us_cm pointer to a conductivity buffer
+ * @param[out] *temperature_raw pointer to a temperature raw buffer
+ * @param[out] *temperature pointer to a temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no sample from the last sweep
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 channel is invalid
+ * @note       none
+ */
+uint8_t ba121_pool_get_sample(ba121_pool_t *pool, uint16_t channel,
+                              uint16_t *conductivity_raw, uint16_t *conductivity_us_cm,
+                              uint16_t *temperature_raw, float *temperature);
+
+/**
+ * @brief      get the time stamps of the last reply of a channel
+ * @param[in]  *pool pointer to a ba121 pool structure
+ * @param[in]  channel channel index
+ * @param[out] *tx_us pointer to a transmit time buffer
+ * @param[out] *rx_us pointer to an arrival time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 pool is NULL
+ *             - 3 pool is not initialized
+ *             - 4 channel is invalid
+ * @note       both are 0 without a clock, rx_us is 0 when the reply was read after a fixed delay
+ */
+uint8_t ba121_pool_get_timestamp(ba121_pool_t *pool, uint16_t channel, uint64_t *tx_us, uint64_t *rx_us);
+
+/**
+ * @brief     run the baseline calibration on a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush, write, read or frame failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ *            - 5 response error
+ * @note      blocking, link and frame errors are retried, the response status is kept in last_status
+ */
+uint8_t ba121_pool_baseline_calibration(ba121_pool_t *pool, uint16_t channel);
+
+/**
+ * @brief     set the ntc resistance of a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @param[in] ohm resistance ohm
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush, write, read or frame failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ *            - 5 response error
+ * @note      blocking, link and frame errors are retried, the response status is kept in last_status
+ */
+uint8_t ba121_pool_set_ntc_resistance(ba121_pool_t *pool, uint16_t channel, uint32_t ohm);
+
+/**
+ * @brief     set the ntc b of a channel
+ * @param[in] *pool pointer to a ba121 pool structure
+ * @param[in] channel channel index
+ * @param[in] value ntc value
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart flush, write, read or frame failed
+ *            - 2 pool is NULL
+ *            - 3 pool is not initialized
+ *            - 4 channel is invalid
+ *            - 5 response error
+ * @note      blocking, link and frame errors are retried, the response status is kept in last_status
+ */
+uint8_t ba121_pool_set_ntc_b(ba121_pool_t *pool, uint16_t channel, uint16_t value);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_tracker.c
+ * @brief     driver ba121 tracker source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_tracker.h"
+
+/**
+ * @brief      project a state forward
+ * @param[in]  *state pointer to a ba121 tracker state structure
+ * @param[in]  dt_ms forward time in ms
+ * @return     projected value
+ * @note       none
+ */
+static ba121_tracker_value_t a_ba121_tracker_project(ba121_tracker_state_t *state, uint32_t dt_ms)
+{
+#if (BA121_TRACKER_FIXED_POINT != 0)
+    return state->value + (int32_t)(((int64_t)state->rate * (int64_t)dt_ms) / 1000);          /* x + v * dt */
+#else
+    return state->value + state->rate * ((float)dt_ms / 1000.0f);                            /* x + v * dt */
+#endif
+}
+
+/**
+ * @brief     correct a state with one measurement
+ * @param[in] *state pointer to a ba121 tracker state structure
+ * @param[in] raw measured raw data
+ * @param[in] dt_ms time since the previous measurement in ms
+ * @note      none
+ */
+static void a_ba121_tracker_correct(ba121_tracker_state_t *state, uint16_t raw, uint32_t dt_ms)
+{
+    ba121_tracker_value_t predicted;
+    ba121_tracker_value_t residual;
+
+    predicted = a_ba121_tracker_project(state, dt_ms);                                        /* predict */
+#if (BA121_TRACKER_FIXED_POINT != 0)
+    residual = ((int32_t)raw << 8) - predicted;                                               /* innovation */
+    state->value = predicted + (int32_t)(((int64_t)state->alpha * residual + 0x4000) >> 15);  /* correct value, rounded */
+    if (dt_ms != 0)                                                                           /* check time */
+    {
+        state->rate += (int32_t)((((int64_t)state->beta * residual) * 1000 /
+                                  (int64_t)dt_ms + 0x4000) >> 15);                            /* correct rate, rounded */
+    }
+#else
+    residual = (float)raw - predicted;                                                        /* innovation */
+    state->value = predicted + state->alpha * residual;                                       /* correct value */
+    if (dt_ms != 0)                                                                           /* check time */
+    {
+        state->rate += state->beta * residual * 1000.0f / (float)dt_ms;                       /* correct rate */
+    }
+#endif
+}
+
+/**
+ * @brief     initialize the tracker
+ * @param[in] *handle pointer to a ba121 tracker handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      both channels start with the default gains
+ */
+uint8_t ba121_tracker_init(ba121_tracker_handle_t *handle)
+{
+    uint8_t i;
+
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+
+    memset(handle, 0, sizeof(ba121_tracker_handle_t));                                        /* clear handle */
+    for (i = 0; i < 2; i++)                                                                   /* set all channels */
+    {
+        handle->channel[i].alpha = BA121_TRACKER_DEFAULT_ALPHA;                               /* set default alpha */
+        handle->channel[i].beta = BA121_TRACKER_DEFAULT_BETA;                                 /* set default beta */
+    }
+    handle->inited = 1;                                                                       /* flag finish initialization */
+
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     set the channel gains
+ * @param[in] *handle pointer to a ba121 tracker handle structure
+ * @param[in] channel tracker channel
+ * @param[in] alpha position gain
+ * @param[in] beta rate gain
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 channel is invalid
+ * @note      for a stable tracker 0 < alpha <= 1 and 0 < beta < 4 - 2 * alpha,
+ *            beta = alpha * alpha / (2 - alpha) gives the steady state kalman gains
+ */
+uint8_t ba121_tracker_set_gain(ba121_tracker_handle_t *handle, ba121_tracker_channel_t channel,
+                               ba121_tracker_gain_t alpha, ba121_tracker_gain_t beta)
+{
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if (channel > BA121_TRACKER_CHANNEL_TEMPERATURE)                                          /* check channel */
+    {
+        return 4;                                                                             /* return error */
+    }
+
+    handle->channel[channel].alpha = alpha;                                                   /* set alpha */
+    handle->channel[channel].beta = beta;                                                     /* set beta */
+
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     feed one sample into the tracker
+ * @param[in] *handle pointer to a ba121 tracker handle structure
+ * @param[in] conductivity_raw conductivity raw data from ba121_read
+ * @param[in] temperature_raw temperature raw data from ba121_read
+ * @param[in] dt_ms time since the previous sample in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the first sample seeds the estimate and dt_ms is ignored
+ */
+uint8_t ba121_tracker_update(ba121_tracker_handle_t *handle, uint16_t conductivity_raw,
+                             uint16_t temperature_raw, uint32_t dt_ms)
+{
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+
+    if (handle->seeded == 0)                                                                  /* first sample */
+    {
+#if (BA121_TRACKER_FIXED_POINT != 0)
+        handle->channel[BA121_TRACKER_CHANNEL_CONDUCTIVITY].value = (int32_t)conductivity_raw << 8;  /* seed conductivity */
+        handle->channel[BA121_TRACKER_CHANNEL_TEMPERATURE].value = (int32_t)temperature_raw << 8;    /* seed temperature */
+#else
+        handle->channel[BA121_TRACKER_CHANNEL_CONDUCTIVITY].value = (float)conductivity_raw;         /* seed conductivity */
+        handle->channel[BA121_TRACKER_CHANNEL_TEMPERATURE].value = (float)temperature_raw;           /* seed temperature */
+#endif
+        handle->channel[BA121_TRACKER_CHANNEL_CONDUCTIVITY].rate = 0;                         /* no rate yet */
+        handle->channel[BA121_TRACKER_CHANNEL_TEMPERATURE].rate = 0;                          /* no rate yet */
+        handle->seeded = 1;                                                                   /* flag seeded */
+
+        return 0;                                                                             /* success return 0 */
+    }
+
+    a_ba121_tracker_correct(&handle->channel[BA121_TRACKER_CHANNEL_CONDUCTIVITY],
+                            conductivity_raw, dt_ms);                                         /* correct conductivity */
+    a_ba121_tracker_correct(&handle->channel[BA121_TRACKER_CHANNEL_TEMPERATURE],
+                            temperature_raw, dt_ms);                                          /* correct temperature */
+
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      predict the state between samples
+ * @param[in]  *handle pointer to a ba121 tracker handle structure
+ * @param[in]  dt_ms time since the last sample in ms
+ * @param[out] *conductivity pointer to a conductivity estimate buffer
+ * @param[out] *conductivity_rate pointer to a conductivity rate buffer
+ * @param[out] *temperature pointer to a temperature estimate buffer
+ * @param[out] *temperature_rate pointer to a temperature rate buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 tracker is not seeded
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       estimates are in raw units and rates in raw units per second,
+ *             the tracker state is not changed
+ */
+uint8_t ba121_tracker_predict(ba121_tracker_handle_t *handle, uint32_t dt_ms,
+                              ba121_tracker_value_t *conductivity, ba121_tracker_value_t *conductivity_rate,
+                              ba121_tracker_value_t *temperature, ba121_tracker_value_t *temperature_rate)
+{
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if (handle->seeded == 0)                                                                  /* check seeded */
+    {
+        return 1;                                                                             /* return error */
+    }
+
+    *conductivity = a_ba121_tracker_project(&handle->channel[BA121_TRACKER_CHANNEL_CONDUCTIVITY], dt_ms);
+    *conductivity_rate = handle->channel[BA121_TRACKER_CHANNEL_CONDUCTIVITY].rate;            /* set conductivity rate */
+    *temperature = a_ba121_tracker_project(&handle->channel[BA121_TRACKER_CHANNEL_TEMPERATURE], dt_ms);
+    *temperature_rate = handle->channel[BA121_TRACKER_CHANNEL_TEMPERATURE].rate;              /* set temperature rate */
+
+    return 0;                                                                                 /* success return 0 */
+}
@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_tracker.h
+ * @brief     driver ba121 tracker header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_TRACKER_H
+#define DRIVER_BA121_TRACKER_H
+
+#include "driver_ba121.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_tracker_driver ba121 tracker driver function
+ * @brief    ba121 tracker driver modules
+ * @ingroup  ba121_driver
+ * @{
+ */
+
+/**
+ * @brief ba121 tracker fixed point configure
+ */
+#ifndef BA121_TRACKER_FIXED_POINT
+    #define BA121_TRACKER_FIXED_POINT        0        /**< use float */
+#endif
+
+#if (BA121_TRACKER_FIXED_POINT != 0)
+/**
+ * @brief ba121 tracker value type definition
+ */
+typedef int32_t ba121_tracker_value_t;        /**< raw units in q24.8 */
+
+/**
+ * @brief ba121 tracker gain type definition
+ */
+typedef uint16_t ba121_tracker_gain_t;        /**< gain in q0.15 */
+
+/**
+ * @brief     convert a gain constant
+ * @param[in] G gain between 0.0 and 1.0
+ * @note      none
+ */
+#define BA121_TRACKER_GAIN(G)                 ((ba121_tracker_gain_t)((G) * 32768.0f + 0.5f))
+
+/**
+ * @brief     convert a tracker value to float raw units
+ * @param[in] V tracker value
+ * @note      none
+ */
+#define BA121_TRACKER_TO_FLOAT(V)             ((float)(V) / 256.0f)
+#else
+/**
+ * @brief ba121 tracker value type definition
+ */
+typedef float ba121_tracker_value_t;          /**< raw units */
+
+/**
+ * @brief ba121 tracker gain type definition
+ */
+typedef float ba121_tracker_gain_t;           /**< gain */
+
+/**
+ * @brief     convert a gain constant
+ * @param[in] G gain between 0.0 and 1.0
+ * @note      none
+ */
+#define BA121_TRACKER_GAIN(G)                 ((ba121_tracker_gain_t)(G))
+
+/**
+ * @brief     convert a tracker value to float raw units
+ * @param[in] V tracker value
+ * @note      none
+ */
+#define BA121_TRACKER_TO_FLOAT(V)             ((float)(V))
+#endif
+
+/**
+ * @brief ba121 tracker default definition
+ */
+#define BA121_TRACKER_DEFAULT_ALPHA           BA121_TRACKER_GAIN(0.5f)         /**< position gain */
+#define BA121_TRACKER_DEFAULT_BETA            BA121_TRACKER_GAIN(0.05f)        /**< rate gain */
+
+/**
+ * @brief ba121 tracker channel enumeration definition
+ */
+typedef enum
+{
+    BA121_TRACKER_CHANNEL_CONDUCTIVITY = 0x00,        /**< conductivity channel */
+    BA121_TRACKER_CHANNEL_TEMPERATURE  = 0x01,        /**< temperature channel */
+} ba121_tracker_channel_t;
+
+/**
+ * @brief ba121 tracker state structure definition
+ */
+typedef struct ba121_tracker_state_s
+{
+    ba121_tracker_value_t value;        /**< estimate in raw units */
+    ba121_tracker_value_t rate;         /**< rate of change in raw units per second */
+    ba121_tracker_gain_t alpha;         /**< position gain */
+    ba121_tracker_gain_t beta;          /**< rate gain */
+} ba121_tracker_state_t;
+
+/**
+ * @brief ba121 tracker handle structure definition
+ */
+typedef struct ba121_tracker_handle_s
+{
+    ba121_tracker_state_t channel[2];        /**< conductivity and temperature state */
+    uint8_t seeded;                          /**< seeded flag */
+    uint8_t inited;                          /**< inited flag */
+} ba121_tracker_handle_t;
+
+/**
+ * @brief     initialize the tracker
+ * @param[in] *handle pointer to a ba121 tracker handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      both channels start with the default gains
+ */
+uint8_t ba121_tracker_init(ba121_tracker_handle_t *handle);
+
+/**
+ * @brief     set the channel gains
+ * @param[in] *handle pointer to a ba121 tracker handle structure
+ * @param[in] channel tracker channel
+ * @param[in] alpha position gain
+ * @param[in] beta rate gain
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 channel is invalid
+ * @note      for a stable tracker 0 < alpha <= 1 and 0 < beta < 4 - 2 * alpha,
+ *            beta = alpha * alpha / (2 - alpha) gives the steady state kalman gains
+ */
+uint8_t ba121_tracker_set_gain(ba121_tracker_handle_t *handle, ba121_tracker_channel_t channel,
+                               ba121_tracker_gain_t alpha, ba121_tracker_gain_t beta);
+
+/**
+ * @brief     feed one sample into the tracker
+ * @param[in] *handle pointer to a ba121 tracker handle structure
+ * @param[in] conductivity_raw conductivity raw data from ba121_read
+ * @param[in] temperature_raw temperature raw data from ba121_read
+ * @param[in] dt_ms time since the previous sample in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the first sample seeds the estimate and dt_ms is ignored
+ */
+uint8_t ba121_tracker_update(ba121_tracker_handle_t *handle, uint16_t conductivity_raw,
+                             uint16_t temperature_raw, uint32_t dt_ms);
+
+/**
+ * @brief      predict the state between samples
+ * @param[in]  *handle pointer to a ba121 tracker handle structure
+ * @param[in]  dt_ms time since the last sample in ms
+ * @param[out] *conductivity pointer to a conductivity estimate buffer
+ * @param[out] *conductivity_rate pointer to a conductivity rate buffer
+ * @param[out] *temperature pointer to a temperature estimate buffer
+ * @param[out] *temperature_rate pointer to a temperature rate buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 tracker is not seeded
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       estimates are in raw units and rates in raw units per second,
+ *             the tracker state is not changed
+ */
+uint8_t ba121_tracker_predict(ba121_tracker_handle_t *handle, uint32_t dt_ms,
+                              ba121_tracker_value_t *conductivity, ba121_tracker_value_t *conductivity_rate,
+                              ba121_tracker_value_t *temperature, ba121_tracker_value_t *temperature_rate);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,393 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_alarm_test.c
+ * @brief     driver ba121 alarm test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_alarm_test.h"
+#include <stdio.h>
+
+/**
+ * @brief alarm record structure definition
+ */
+typedef struct alarm_record_s
+{
+    ba121_alarm_handle_t *handle;        /**< handle of the last transition */
+    uint32_t count;                      /**< transitions */
+    uint8_t index;                       /**< rule of the last transition */
+    ba121_alarm_state_t state;           /**< state of the last transition */
+    float value;                         /**< value of the last transition */
+} alarm_record_t;
+
+/**
+ * @brief alarm step structure definition
+ */
+typedef struct alarm_step_s
+{
+    uint32_t timestamp_ms;        /**< sample time */
+    uint16_t conductivity;        /**< conductivity in uS/cm */
+    float temperature;            /**< temperature in C */
+    uint8_t state;                /**< expected state after the sample */
+    uint32_t count;               /**< expected transitions after the sample */
+} alarm_step_t;
+
+/**
+ * @brief     record a transition
+ * @param[in] *handle pointer to a ba121 alarm handle structure
+ * @param[in] index rule index
+ * @param[in] state new state
+ * @param[in] value value that caused the transition
+ * @param[in] *user pointer to an alarm record structure
+ * @note      none
+ */
+static void a_alarm_callback(ba121_alarm_handle_t *handle, uint8_t index,
+                             ba121_alarm_state_t state, float value, void *user)
+{
+    alarm_record_t *record = (alarm_record_t *)user;
+    
+    record->handle = handle;
+    record->count++;
+    record->index = index;
+    record->state = state;
+    record->value = value;
+}
+
+/**
+ * @brief     run one rule through a sample sequence
+ * @param[in] *name test name
+ * @param[in] *rule pointer to a ba121 alarm rule structure
+ * @param[in] *step pointer to a step table
+ * @param[in] len step table length
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      each step checks the rule state and the callback count
+ */
+static uint8_t a_alarm_run(const char *name, const ba121_alarm_rule_t *rule, const alarm_step_t *step, uint8_t len)
+{
+    ba121_alarm_handle_t alarm;
+    alarm_record_t record = {0};
+    ba121_alarm_state_t state;
+    uint8_t index;
+    uint8_t i;
+    
+    if ((ba121_alarm_init(&alarm, a_alarm_callback, &record) != 0) ||
+        (ba121_alarm_add_rule(&alarm, rule, &index) != 0))
+    {
+        printf("alarm: %s setup failed.\n", name);
+        
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        (void)ba121_alarm_process(&alarm, step[i].conductivity, step[i].temperature, step[i].timestamp_ms);
+        (void)ba121_alarm_get_state(&alarm, index, &state);
+        if ((state != step[i].state) || (record.count != step[i].count))
+        {
+            printf("alarm: %s step %u gave state %u after %u transitions, expected %u after %u.\n",
+                   name, (unsigned int)i, (unsigned int)state, (unsigned int)record.count,
+                   (unsigned int)step[i].state, (unsigned int)step[i].count);
+            
+            return 1;
+        }
+    }
+    if ((record.count != 0) && ((record.handle != &alarm) || (record.index != index) ||
+                                (record.state != state)))
+    {
+        printf("alarm: %s callback got the wrong handle, rule or state.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check the status codes
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   none
+ */
+static uint8_t a_alarm_status_test(void)
+{
+    ba121_alarm_handle_t alarm;
+    ba121_alarm_rule_t rule = {BA121_ALARM_SOURCE_CONDUCTIVITY, BA121_ALARM_CONDITION_ABOVE, 1000.0f, 0.0f, 0};
+    ba121_alarm_rule_t bad;
+    ba121_alarm_state_t state;
+    uint8_t index;
+    uint8_t i;
+    
+    alarm.inited = 0;
+    if ((ba121_alarm_init(NULL, NULL, NULL) != 2) ||
+        (ba121_alarm_process(&alarm, 0, 25.0f, 0) != 3) ||
+        (ba121_alarm_add_rule(&alarm, &rule, &index) != 3) ||
+        (ba121_alarm_init(&alarm, NULL, NULL) != 0) ||
+        (ba121_alarm_add_rule(&alarm, NULL, &index) != 4))
+    {
+        printf("alarm: init status codes failed.\n");
+        
+        return 1;
+    }
+    bad = rule;
+    bad.source = (ba121_alarm_source_t)3;
+    if (ba121_alarm_add_rule(&alarm, &bad, &index) != 4)
+    {
+        printf("alarm: invalid source accepted.\n");
+        
+        return 1;
+    }
+    bad = rule;
+    bad.condition = (ba121_alarm_condition_t)4;
+    if (ba121_alarm_add_rule(&alarm, &bad, &index) != 4)
+    {
+        printf("alarm: invalid condition accepted.\n");
+        
+        return 1;
+    }
+    bad = rule;
+    bad.hysteresis = -1.0f;
+    if (ba121_alarm_add_rule(&alarm, &bad, &index) != 4)
+    {
+        printf("alarm: negative hysteresis accepted.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < BA121_ALARM_MAX_RULES; i++)
+    {
+        if ((ba121_alarm_add_rule(&alarm, &rule, &index) != 0) || (index != i))
+        {
+            printf("alarm: add rule %u failed.\n", (unsigned int)i);
+            
+            return 1;
+        }
+    }
+    if ((ba121_alarm_add_rule(&alarm, &rule, &index) != 1) ||
+        (ba121_alarm_remove_rule(&alarm, BA121_ALARM_MAX_RULES) != 4) ||
+        (ba121_alarm_remove_rule(&alarm, 2) != 0) ||
+        (ba121_alarm_remove_rule(&alarm, 2) != 4) ||
+        (ba121_alarm_get_state(&alarm, 2, &state) != 4) ||
+        (ba121_alarm_add_rule(&alarm, &rule, &index) != 0) || (index != 2))
+    {
+        printf("alarm: rule table status codes failed.\n");
+        
+        return 1;
+    }
+    
+    /* no callback must not crash on a transition */
+    if ((ba121_alarm_process(&alarm, 2000, 25.0f, 0) != 0) ||
+        (ba121_alarm_get_state(&alarm, 0, &state) != 0) || (state != BA121_ALARM_STATE_ACTIVE))
+    {
+        printf("alarm: process without a callback failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check the compensated source
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   the same conductivity raises the raw rule at any temperature but the compensated rule
+ *         only near the reference
+ */
+static uint8_t a_alarm_compensation_test(void)
+{
+    ba121_alarm_handle_t alarm;
+    alarm_record_t record = {0};
+    ba121_alarm_rule_t rule = {BA121_ALARM_SOURCE_COMPENSATED_CONDUCTIVITY, BA121_ALARM_CONDITION_ABOVE, 1050.0f, 0.0f, 0};
+    ba121_alarm_state_t raw_state;
+    ba121_alarm_state_t state;
+    uint8_t raw_index;
+    uint8_t index;
+    
+    (void)ba121_alarm_init(&alarm, a_alarm_callback, &record);
+    (void)ba121_alarm_add_rule(&alarm, &rule, &index);
+    rule.source = BA121_ALARM_SOURCE_CONDUCTIVITY;
+    (void)ba121_alarm_add_rule(&alarm, &rule, &raw_index);
+    
+    /* 1100 uS/cm at 30C compensates to 1000 uS/cm */
+    (void)ba121_alarm_process(&alarm, 1100, 30.0f, 0);
+    (void)ba121_alarm_get_state(&alarm, index, &state);
+    (void)ba121_alarm_get_state(&alarm, raw_index, &raw_state);
+    if ((state != BA121_ALARM_STATE_CLEAR) || (raw_state != BA121_ALARM_STATE_ACTIVE) ||
+        (record.count != 1) || (record.index != raw_index))
+    {
+        printf("alarm: compensation at 30C gave %u/%u.\n", (unsigned int)state, (unsigned int)raw_state);
+        
+        return 1;
+    }
+    (void)ba121_alarm_process(&alarm, 1100, 25.0f, 1000);
+    (void)ba121_alarm_get_state(&alarm, index, &state);
+    if ((state != BA121_ALARM_STATE_ACTIVE) || (record.count != 2) ||
+        (record.index != index) || (record.value != 1100.0f))
+    {
+        printf("alarm: compensation at 25C gave %u.\n", (unsigned int)state);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check two engines sharing one callback
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   each transition must reach the record of its own engine
+ */
+static uint8_t a_alarm_user_test(void)
+{
+    ba121_alarm_handle_t alarm[2];
+    alarm_record_t record[2] = {{0}, {0}};
+    ba121_alarm_rule_t rule = {BA121_ALARM_SOURCE_CONDUCTIVITY, BA121_ALARM_CONDITION_ABOVE, 1000.0f, 0.0f, 0};
+    uint8_t index;
+    
+    (void)ba121_alarm_init(&alarm[0], a_alarm_callback, &record[0]);
+    (void)ba121_alarm_init(&alarm[1], a_alarm_callback, &record[1]);
+    (void)ba121_alarm_add_rule(&alarm[0], &rule, &index);
+    rule.threshold = 2000.0f;
+    (void)ba121_alarm_add_rule(&alarm[1], &rule, &index);
+    (void)ba121_alarm_process(&alarm[0], 1500, 25.0f, 0);
+    (void)ba121_alarm_process(&alarm[1], 1500, 25.0f, 0);
+    if ((record[0].count != 1) || (record[0].handle != &alarm[0]) || (record[0].value != 1500.0f) ||
+        (record[1].count != 0))
+    {
+        printf("alarm: first engine transition reached the wrong record.\n");
+        
+        return 1;
+    }
+    (void)ba121_alarm_process(&alarm[1], 2500, 25.0f, 1000);
+    if ((record[1].count != 1) || (record[1].handle != &alarm[1]) || (record[1].value != 2500.0f) ||
+        (record[0].count != 1))
+    {
+        printf("alarm: second engine transition reached the wrong record.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  alarm test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   checks the status codes, the hysteresis band, the hold time, the rate rules and that
+ *         two engines sharing one callback get their own handle and user pointer
+ */
+uint8_t ba121_alarm_test(void)
+{
+    /* raise above 1000, stay active inside the 50 uS/cm band, clear below 950 */
+    static const ba121_alarm_rule_t above = {BA121_ALARM_SOURCE_CONDUCTIVITY, BA121_ALARM_CONDITION_ABOVE, 1000.0f, 50.0f, 0};
+    static const alarm_step_t above_step[] =
+    {
+        {0, 990, 25.0f, 0, 0}, {1000, 1000, 25.0f, 0, 0}, {2000, 1001, 25.0f, 1, 1}, {3000, 960, 25.0f, 1, 1},
+        {4000, 950, 25.0f, 1, 1}, {5000, 949, 25.0f, 0, 2}, {6000, 999, 25.0f, 0, 2}, {7000, 1200, 25.0f, 1, 3},
+    };
+    
+    /* raise below 10C, clear above 11C */
+    static const ba121_alarm_rule_t below = {BA121_ALARM_SOURCE_TEMPERATURE, BA121_ALARM_CONDITION_BELOW, 10.0f, 1.0f, 0};
+    static const alarm_step_t below_step[] =
+    {
+        {0, 500, 10.5f, 0, 0}, {1000, 500, 9.9f, 1, 1}, {2000, 500, 10.8f, 1, 1}, {3000, 500, 11.0f, 1, 1},
+        {4000, 500, 11.2f, 0, 2}, {5000, 500, 10.2f, 0, 2},
+    };
+    
+    /* a 3s hold restarts when the condition breaks and runs across the timestamp wrap */
+    static const ba121_alarm_rule_t hold = {BA121_ALARM_SOURCE_CONDUCTIVITY, BA121_ALARM_CONDITION_ABOVE, 1000.0f, 100.0f, 3000};
+    static const alarm_step_t hold_step[] =
+    {
+        {0xFFFFF830U, 1100, 25.0f, 0, 0}, {0xFFFFFC18U, 950, 25.0f, 0, 0}, {0xFFFFFFFFU, 1100, 25.0f, 0, 0},
+        {1000, 1100, 25.0f, 0, 0}, {2998, 1100, 25.0f, 0, 0}, {2999, 1100, 25.0f, 1, 1},
+        {4000, 800, 25.0f, 1, 1}, {6000, 950, 25.0f, 1, 1}, {7000, 800, 25.0f, 1, 1},
+        {9999, 800, 25.0f, 1, 1}, {10000, 800, 25.0f, 0, 2},
+    };
+    
+    /* raise above 10 uS/cm/s, clear below 5 uS/cm/s, the first sample and a repeated time give no rate */
+    static const ba121_alarm_rule_t rate = {BA121_ALARM_SOURCE_CONDUCTIVITY, BA121_ALARM_CONDITION_RATE_ABOVE, 10.0f, 5.0f, 0};
+    static const alarm_step_t rate_step[] =
+    {
+        {0, 1000, 25.0f, 0, 0}, {1000, 1005, 25.0f, 0, 0}, {2000, 1020, 25.0f, 1, 1}, {2000, 5000, 25.0f, 1, 1},
+        {3000, 1027, 25.0f, 1, 1}, {4000, 1031, 25.0f, 0, 2}, {4500, 1040, 25.0f, 1, 3},
+    };
+    
+    /* raise when cooling faster than 0.5C/s, clear once it slows under 0.25C/s */
+    static const ba121_alarm_rule_t cooling = {BA121_ALARM_SOURCE_TEMPERATURE, BA121_ALARM_CONDITION_RATE_BELOW, -0.5f, 0.25f, 0};
+    static const alarm_step_t cooling_step[] =
+    {
+        {0, 500, 30.0f, 0, 0}, {2000, 500, 29.5f, 0, 0}, {4000, 500, 28.0f, 1, 1}, {6000, 500, 27.5f, 1, 1},
+        {8000, 500, 27.25f, 0, 2},
+    };
+    
+    if (a_alarm_status_test() != 0)
+    {
+        return 1;
+    }
+    printf("alarm: status codes passed.\n");
+    if ((a_alarm_run("hysteresis above", &above, above_step, sizeof(above_step) / sizeof(above_step[0])) != 0) ||
+        (a_alarm_run("hysteresis below", &below, below_step, sizeof(below_step) / sizeof(below_step[0])) != 0))
+    {
+        return 1;
+    }
+    printf("alarm: hysteresis passed.\n");
+    if (a_alarm_run("hold", &hold, hold_step, sizeof(hold_step) / sizeof(hold_step[0])) != 0)
+    {
+        return 1;
+    }
+    printf("alarm: hold passed.\n");
+    if ((a_alarm_run("rate above", &rate, rate_step, sizeof(rate_step) / sizeof(rate_step[0])) != 0) ||
+        (a_alarm_run("rate below", &cooling, cooling_step, sizeof(cooling_step) / sizeof(cooling_step[0])) != 0))
+    {
+        return 1;
+    }
+    printf("alarm: rate passed.\n");
+    if (a_alarm_compensation_test() != 0)
+    {
+        return 1;
+    }
+    printf("alarm: compensation passed.\n");
+    if (a_alarm_user_test() != 0)
+    {
+        return 1;
+    }
+    printf("alarm: user pointer passed.\n");
+    printf("alarm: finish test.\n");
+    
+    return 0;
+}
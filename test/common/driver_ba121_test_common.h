@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_test_common.h
+ * @brief     driver ba121 test common header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_TEST_COMMON_H
+#define DRIVER_BA121_TEST_COMMON_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_test_common ba121 test common
+ * @brief    ba121 random number and argument helpers shared by the test programs
+ * @{
+ */
+
+/**
+ * @brief     seed a random state
+ * @param[in] seed random seed
+ * @return    random state
+ * @note      0 is replaced by 1, because xorshift32 sticks at 0
+ */
+uint32_t ba121_test_seed(uint32_t seed);
+
+/**
+ * @brief         get the next random number
+ * @param[in,out] *state pointer to a random state
+ * @return        random number
+ * @note          xorshift32, the same seed gives the same sequence on every platform
+ */
+uint32_t ba121_test_random(uint32_t *state);
+
+/**
+ * @brief     get a numeric argument
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @param[in] index argument index
+ * @param[in] value default value
+ * @return    argument value or the default when it is missing
+ * @note      decimal, 0x hex or 0 octal like strtoul
+ */
+uint32_t ba121_test_arg(int argc, char **argv, int index, uint32_t value);
+
+/**
+ * @brief     run a test with the [times] [seed] arguments
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @param[in] *test pointer to a test function
+ * @param[in] times default times
+ * @param[in] seed default seed
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the return value of main
+ */
+int ba121_test_main(int argc, char **argv, uint8_t (*test)(uint32_t times, uint32_t seed),
+                    uint32_t times, uint32_t seed);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
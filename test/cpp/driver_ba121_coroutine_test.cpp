@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_coroutine_test.cpp
+ * @brief     driver ba121 coroutine test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_cpp_test.h"
+#include "driver_ba121_coroutine.hpp"
+#include "driver_ba121_interface_mock.h"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <sys/eventfd.h>
+
+/**
+ * @brief coroutine test context structure definition
+ */
+struct coroutine_context
+{
+    ba121::read_result read;        /**< read result */
+    uint8_t baseline;               /**< baseline status code */
+    uint8_t ntc_b;                  /**< ntc b status code */
+    bool caught;                    /**< child exception caught */
+    bool done;                      /**< task finished */
+};
+
+/**
+ * @brief     read one sample in a child task
+ * @param[in] &s sensor
+ * @return    task resuming with the read result
+ */
+static ba121::task<ba121::read_result> a_coroutine_child_read(ba121::sensor &s)
+{
+    co_return co_await s.read();
+}
+
+/**
+ * @brief  fail in a child task
+ * @return task throwing to the awaiting coroutine
+ */
+static ba121::task<int> a_coroutine_child_throw()
+{
+    throw std::runtime_error("child");
+    co_return 0;
+}
+
+/**
+ * @brief         run a read and two ack commands
+ * @param[in]     &s sensor
+ * @param[in,out] &ctx coroutine test context
+ * @return        task
+ */
+static ba121::task<void> a_coroutine_run(ba121::sensor &s, coroutine_context &ctx)
+{
+    ctx.read = co_await a_coroutine_child_read(s);
+    try
+    {
+        (void)co_await a_coroutine_child_throw();
+    }
+    catch (const std::runtime_error &)
+    {
+        ctx.caught = true;
+    }
+    ctx.baseline = co_await s.calibrate_baseline();
+    ctx.ntc_b = co_await s.set_ntc_b(3950);
+    ctx.done = true;
+}
+
+/**
+ * @brief  fail in a spawned task
+ * @return task throwing to the executor
+ */
+static ba121::task<void> a_coroutine_spawn_throw()
+{
+    throw std::runtime_error("spawned");
+    co_return;
+}
+
+/**
+ * @brief  coroutine layer test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the sensor fd is an eventfd that stays readable and the mock replies without latency,
+ *         so every reply is parsed on the next loop pass
+ */
+uint8_t ba121_coroutine_test(void)
+{
+    ba121::executor ex;
+    ba121_handle_t handle;
+    coroutine_context ctx{};
+    uint32_t ntc_resistance;
+    uint16_t ntc_b;
+    uint32_t baseline_count;
+    bool rethrown;
+    int fd;
+    
+    ba121_mock_reset();
+    ba121_mock_set_latency(0);
+    DRIVER_BA121_LINK_INIT(&handle, ba121_handle_t);
+    DRIVER_BA121_LINK_UART_INIT(&handle, ba121_interface_uart_init);
+    DRIVER_BA121_LINK_UART_DEINIT(&handle, ba121_interface_uart_deinit);
+    DRIVER_BA121_LINK_UART_READ(&handle, ba121_interface_uart_read);
+    DRIVER_BA121_LINK_UART_FLUSH(&handle, ba121_interface_uart_flush);
+    DRIVER_BA121_LINK_UART_WRITE(&handle, ba121_interface_uart_write);
+    DRIVER_BA121_LINK_DELAY_MS(&handle, ba121_interface_delay_ms);
+    DRIVER_BA121_LINK_DEBUG_PRINT(&handle, ba121_interface_debug_print);
+    fd = eventfd(1, EFD_CLOEXEC);
+    if ((fd < 0) || !ex.valid() || (ba121_init(&handle) != 0))
+    {
+        std::printf("coroutine: init failed.\n");
+        
+        return 1;
+    }
+    {
+        ba121::sensor s(ex, &handle, fd);
+        
+        /* the spawned exception stops the first run, the second run finishes the other task */
+        ba121_mock_set_sample(1500, 2600);
+        ex.spawn(a_coroutine_run(s, ctx));
+        ex.spawn(a_coroutine_spawn_throw());
+        rethrown = false;
+        try
+        {
+            (void)ex.run();
+        }
+        catch (const std::runtime_error &e)
+        {
+            rethrown = (std::string(e.what()) == "spawned");
+        }
+        if (!rethrown || ctx.done || (ex.run() != 0) || !ctx.done)
+        {
+            std::printf("coroutine: spawned exception is not rethrown.\n");
+            (void)ba121_deinit(&handle);
+            (void)close(fd);
+            
+            return 1;
+        }
+    }
+    (void)ba121_deinit(&handle);
+    (void)close(fd);
+    ba121_mock_get_settings(&ntc_resistance, &ntc_b, &baseline_count);
+    if ((ctx.read.res != 0) || (ctx.read.conductivity_raw != 1500) || (ctx.read.temperature_raw != 2600) ||
+        !ctx.caught || (ctx.baseline != 0) || (ctx.ntc_b != 0) || (ntc_b != 3950) || (baseline_count != 1))
+    {
+        std::printf("coroutine: results are wrong.\n");
+        
+        return 1;
+    }
+    std::printf("coroutine: finish test.\n");
+    
+    return 0;
+}
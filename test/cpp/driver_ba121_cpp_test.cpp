@@ -0,0 +1,186 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_cpp_test.cpp
+ * @brief     driver ba121 c++ test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_cpp_test.h"
+#include "driver_ba121_frame.h"
+#include "driver_ba121_interface_mock.h"
+#include <cstdio>
+
+/**
+ * @brief mock transport definition
+ */
+using mock_transport = ba121::static_transport<ba121_interface_uart_init, ba121_interface_uart_deinit,
+                                               ba121_interface_uart_read, ba121_interface_uart_flush,
+                                               ba121_interface_uart_write, ba121_interface_delay_ms,
+                                               ba121_interface_debug_print, ba121_interface_wait_reply,
+                                               ba121_interface_timestamp_us>;
+
+/**
+ * @brief     check the constexpr frames
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every frame must equal the one of the c driver
+ */
+static uint8_t a_cpp_frame_test()
+{
+    const uint32_t params[] = {0x00000000U, 0x00002710U, 0x0F6E0000U, 0xFFFFFFFFU, 0x12345678U};
+    const uint8_t commands[] = {BA121_COMMAND_READ, BA121_COMMAND_BASELINE,
+                                BA121_COMMAND_NTC_RES, BA121_COMMAND_NTC_B};
+    uint8_t c[6];
+    
+    for (uint8_t command : commands)
+    {
+        for (uint32_t param : params)
+        {
+            ba121::frame::type f = ba121::frame::make(command, param);
+            
+            ba121_frame_make(command, param, c);
+            for (int i = 0; i < 6; i++)
+            {
+                if (f[i] != c[i])
+                {
+                    std::printf("cpp: frame 0x%02X 0x%08X differs from the driver.\n",
+                                (unsigned int)command, (unsigned int)param);
+                    
+                    return 1;
+                }
+            }
+        }
+    }
+    if ((ba121::frame::read != ba121::frame::make(BA121_COMMAND_READ, 0)) ||
+        (ba121::frame::ntc_b<3950> != ba121::frame::make(BA121_COMMAND_NTC_B, 3950UL << 16)))
+    {
+        std::printf("cpp: constexpr frame differs.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  c++ wrapper test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs the device wrapper on the mock, checks the results, the driver retry and time stamps
+ *         through the wrapper, and the constexpr frames against the driver
+ */
+uint8_t ba121_cpp_test(void)
+{
+    const uint8_t bad[6] = {0xAA, 0x01, 0x02, 0x03, 0x04, 0x00};
+    uint64_t tx_us;
+    uint64_t rx_us;
+    uint8_t attempts;
+    uint32_t ntc_resistance;
+    uint16_t ntc_b;
+    uint32_t baseline_count;
+    
+    if (a_cpp_frame_test() != 0)
+    {
+        return 1;
+    }
+    
+    ba121_mock_reset();
+    ba121_mock_set_latency(30);
+    {
+        ba121::device<mock_transport> dev;
+        
+        if (!dev.status())
+        {
+            std::printf("cpp: init failed.\n");
+            
+            return 1;
+        }
+        
+        /* a read through the c driver, the wait ends at the reply */
+        ba121_mock_set_sample(1234, 2512);
+        ba121::result<ba121::sample> s = dev.read();
+        if (!s || (s->conductivity_raw != 1234) || (s->temperature_raw != 2512) ||
+            (ba121_get_timestamp(dev.native(), &tx_us, &rx_us) != 0) || (rx_us - tx_us != 30000))
+        {
+            std::printf("cpp: read failed.\n");
+            
+            return 1;
+        }
+        
+        /* frame errors surface as errc, the driver retry recovers them */
+        (void)ba121_mock_script_reply(bad, sizeof(bad));
+        s = dev.read();
+        if (s || (s.error() != ba121::errc::frame) || (s.code() != 4))
+        {
+            std::printf("cpp: frame error is not reported.\n");
+            
+            return 1;
+        }
+        (void)ba121_mock_script_reply(bad, sizeof(bad));
+        if ((ba121_set_retry(dev.native(), 3, 10, 100, BA121_RETRY_ALL) != 0) || !dev.read() ||
+            (ba121_get_last_attempts(dev.native(), &attempts) != 0) || (attempts != 2))
+        {
+            std::printf("cpp: retry through the wrapper failed.\n");
+            
+            return 1;
+        }
+        
+        /* ack commands */
+        if (!dev.set_ntc_resistance(10000) || !dev.set_ntc_b(3950) || !dev.calibrate_baseline())
+        {
+            std::printf("cpp: ack command failed.\n");
+            
+            return 1;
+        }
+        ba121_mock_get_settings(&ntc_resistance, &ntc_b, &baseline_count);
+        ba121_mock_set_ack_status(2);
+        ba121::result<void> r = dev.calibrate_baseline();
+        if ((ntc_resistance != 10000) || (ntc_b != 3950) || (baseline_count != 1) ||
+            r || (r.error() != ba121::errc::response))
+        {
+            std::printf("cpp: ack results are wrong.\n");
+            
+            return 1;
+        }
+    }
+    
+    /* the destructor closed the uart */
+    if (ba121_interface_uart_read(const_cast<uint8_t *>(bad), 0) != 0)
+    {
+        return 1;
+    }
+    std::printf("cpp: finish test.\n");
+    
+    return 0;
+}
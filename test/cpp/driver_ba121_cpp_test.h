@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_cpp_test.h
+ * @brief     driver ba121 c++ test header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_CPP_TEST_H
+#define DRIVER_BA121_CPP_TEST_H
+
+#include "driver_ba121.hpp"
+
+/**
+ * @defgroup ba121_cpp_test ba121 c++ test
+ * @brief    ba121 c++ and coroutine header test modules
+ * @{
+ */
+
+/**
+ * @brief  c++ wrapper test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs the device wrapper on the mock, checks the results, the driver retry and time stamps
+ *         through the wrapper, and the constexpr frames against the driver
+ */
+uint8_t ba121_cpp_test(void);
+
+/**
+ * @brief  coroutine layer test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   runs a sensor on the executor with the mock, checks the awaited results, a child exception
+ *         caught by its parent and a spawned exception rethrown by run
+ */
+uint8_t ba121_coroutine_test(void);
+
+/**
+ * @}
+ */
+
+#endif
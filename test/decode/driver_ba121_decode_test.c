@@ -0,0 +1,307 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_decode_test.c
+ * @brief     driver ba121 decode test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_decode_test.h"
+#include "driver_ba121_test_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief decode test definition
+ */
+#define DECODE_TEST_MAX_FRAMES        200           /**< max frames per random buffer */
+#define DECODE_TEST_GUARD             0x5A          /**< guard byte after each output array */
+#define DECODE_TEST_BENCH_FRAMES      100000        /**< frames of the throughput buffer */
+#define DECODE_TEST_BENCH_LOOPS       50            /**< throughput passes */
+
+static uint32_t gs_state;        /**< random state */
+
+/**
+ * @brief     get a path name
+ * @param[in] path decode path
+ * @return    path name
+ * @note      none
+ */
+static const char *a_decode_name(ba121_decode_path_t path)
+{
+    switch (path)
+    {
+        case BA121_DECODE_PATH_SCALAR :
+        {
+            return "scalar";
+        }
+        case BA121_DECODE_PATH_SSE2 :
+        {
+            return "sse2";
+        }
+        case BA121_DECODE_PATH_SSSE3 :
+        {
+            return "ssse3";
+        }
+        case BA121_DECODE_PATH_AVX2 :
+        {
+            return "avx2";
+        }
+        case BA121_DECODE_PATH_NEON :
+        {
+            return "neon";
+        }
+        default :
+        {
+            return "unknown";
+        }
+    }
+}
+
+/**
+ * @brief     fill a buffer with frames
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] frame_count number of frames
+ * @note      a quarter random bytes, a quarter with a bad checksum, the rest valid
+ */
+static void a_decode_fill(uint8_t *buf, uint32_t frame_count)
+{
+    uint32_t i;
+    uint8_t j;
+    
+    for (i = 0; i < frame_count; i++)
+    {
+        uint8_t *p = buf + i * BA121_DECODE_FRAME_LENGTH;
+        uint32_t r = ba121_test_random(&gs_state);
+        
+        for (j = 0; j < BA121_DECODE_FRAME_LENGTH; j++)
+        {
+            p[j] = (uint8_t)ba121_test_random(&gs_state);
+        }
+        if ((r & 3) != 0)
+        {
+            p[0] = 0xAA;
+            p[5] = (uint8_t)(p[0] + p[1] + p[2] + p[3] + p[4]);
+            if ((r & 3) == 1)
+            {
+                p[5] = (uint8_t)(p[5] + 1 + (r >> 8) % 255);
+            }
+        }
+    }
+}
+
+/**
+ * @brief     check one buffer against the reference
+ * @param[in] *buf pointer to a frame buffer
+ * @param[in] frame_count number of frames
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the output arrays carry a guard entry to catch writes past frame_count
+ */
+static uint8_t a_decode_check(const uint8_t *buf, uint32_t frame_count)
+{
+    static uint16_t conductivity[DECODE_TEST_MAX_FRAMES + 1];
+    static uint16_t temperature[DECODE_TEST_MAX_FRAMES + 1];
+    static uint8_t valid[DECODE_TEST_MAX_FRAMES + 1];
+    uint32_t valid_count;
+    uint32_t count;
+    uint32_t i;
+    
+    memset(conductivity, DECODE_TEST_GUARD, sizeof(conductivity));
+    memset(temperature, DECODE_TEST_GUARD, sizeof(temperature));
+    memset(valid, DECODE_TEST_GUARD, sizeof(valid));
+    if (ba121_decode_frames(buf, frame_count, conductivity, temperature, valid, &valid_count) != 0)
+    {
+        printf("decode: %u frames failed.\n", (unsigned int)frame_count);
+        
+        return 1;
+    }
+    count = 0;
+    for (i = 0; i < frame_count; i++)
+    {
+        const uint8_t *p = buf + i * BA121_DECODE_FRAME_LENGTH;
+        uint8_t ok = (uint8_t)((p[0] == 0xAA) && ((uint8_t)(p[0] + p[1] + p[2] + p[3] + p[4]) == p[5]));
+        
+        if ((conductivity[i] != (uint16_t)((p[1] << 8) | p[2])) ||
+            (temperature[i] != (uint16_t)((p[3] << 8) | p[4])) || (valid[i] != ok))
+        {
+            printf("decode: frame %u of %u gave %04X/%04X/%u, expected %04X/%04X/%u.\n",
+                   (unsigned int)i, (unsigned int)frame_count, (unsigned int)conductivity[i],
+                   (unsigned int)temperature[i], (unsigned int)valid[i], (unsigned int)((p[1] << 8) | p[2]),
+                   (unsigned int)((p[3] << 8) | p[4]), (unsigned int)ok);
+            
+            return 1;
+        }
+        count += ok;
+    }
+    if (valid_count != count)
+    {
+        printf("decode: %u frames gave %u valid, expected %u.\n", (unsigned int)frame_count,
+               (unsigned int)valid_count, (unsigned int)count);
+        
+        return 1;
+    }
+    if ((conductivity[frame_count] != (uint16_t)((DECODE_TEST_GUARD << 8) | DECODE_TEST_GUARD)) ||
+        (temperature[frame_count] != (uint16_t)((DECODE_TEST_GUARD << 8) | DECODE_TEST_GUARD)) ||
+        (valid[frame_count] != DECODE_TEST_GUARD))
+    {
+        printf("decode: %u frames wrote past the end.\n", (unsigned int)frame_count);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     measure the throughput of the active path
+ * @param[in] *buf pointer to a frame buffer with DECODE_TEST_BENCH_FRAMES frames
+ * @return    frames per second
+ * @note      informational only, the result does not fail the test
+ */
+static double a_decode_bench(const uint8_t *buf)
+{
+    static uint16_t conductivity[DECODE_TEST_BENCH_FRAMES];
+    static uint16_t temperature[DECODE_TEST_BENCH_FRAMES];
+    static uint8_t valid[DECODE_TEST_BENCH_FRAMES];
+    uint32_t valid_count;
+    clock_t start;
+    double s;
+    uint32_t i;
+    
+    start = clock();
+    for (i = 0; i < DECODE_TEST_BENCH_LOOPS; i++)
+    {
+        (void)ba121_decode_frames(buf, DECODE_TEST_BENCH_FRAMES, conductivity, temperature, valid, &valid_count);
+    }
+    s = (double)(clock() - start) / CLOCKS_PER_SEC;
+    
+    return (s > 0.0) ? (double)DECODE_TEST_BENCH_FRAMES * DECODE_TEST_BENCH_LOOPS / s : 0.0;
+}
+
+/**
+ * @brief     decode test
+ * @param[in] times random buffers per path
+ * @param[in] seed random seed of the buffers
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      every path the cpu runs must match a frame by frame reference on buffers of any length,
+ *            paths that are not built or not supported are reported and skipped
+ */
+uint8_t ba121_decode_test(uint32_t times, uint32_t seed)
+{
+    static const ba121_decode_path_t path_table[5] =
+    {
+        BA121_DECODE_PATH_SCALAR, BA121_DECODE_PATH_SSE2, BA121_DECODE_PATH_SSSE3,
+        BA121_DECODE_PATH_AVX2, BA121_DECODE_PATH_NEON,
+    };
+    ba121_decode_path_t path;
+    uint32_t valid_count;
+    uint16_t value;
+    uint8_t flag;
+    uint8_t *bench;
+    uint32_t frame_count;
+    uint32_t i;
+    uint8_t p;
+    
+    /* the first query picks the fastest path */
+    if ((ba121_decode_get_path(NULL) != 2) || (ba121_decode_get_path(&path) != 0) ||
+        (ba121_decode_frames(NULL, 1, &value, &value, &flag, &valid_count) != 2) ||
+        (ba121_decode_set_path((ba121_decode_path_t)0x7F) != 4))
+    {
+        printf("decode: status codes failed.\n");
+        
+        return 1;
+    }
+    printf("decode: default path %s.\n", a_decode_name(path));
+    bench = (uint8_t *)malloc(DECODE_TEST_BENCH_FRAMES * BA121_DECODE_FRAME_LENGTH);
+    if (bench == NULL)
+    {
+        printf("decode: malloc failed.\n");
+        
+        return 1;
+    }
+    gs_state = ba121_test_seed(seed);
+    a_decode_fill(bench, DECODE_TEST_BENCH_FRAMES);
+    for (p = 0; p < 5; p++)
+    {
+        if (ba121_decode_set_path(path_table[p]) != 0)
+        {
+            printf("decode: %s is not supported here, skipped.\n", a_decode_name(path_table[p]));
+            
+            continue;
+        }
+        if ((ba121_decode_get_path(&path) != 0) || (path != path_table[p]))
+        {
+            printf("decode: %s was not set.\n", a_decode_name(path_table[p]));
+            free(bench);
+            
+            return 1;
+        }
+        
+        /* same buffers for every path, each allocated to its exact size */
+        gs_state = ba121_test_seed(seed);
+        for (i = 0; i < times; i++)
+        {
+            uint8_t *buf;
+            
+            frame_count = ba121_test_random(&gs_state) % (DECODE_TEST_MAX_FRAMES + 1);
+            buf = (uint8_t *)malloc((frame_count != 0) ? frame_count * BA121_DECODE_FRAME_LENGTH : 1);
+            if (buf == NULL)
+            {
+                printf("decode: malloc failed.\n");
+                free(bench);
+                
+                return 1;
+            }
+            a_decode_fill(buf, frame_count);
+            if (a_decode_check(buf, frame_count) != 0)
+            {
+                printf("decode: %s path failed, buffer %u.\n", a_decode_name(path_table[p]), (unsigned int)i);
+                free(buf);
+                free(bench);
+                
+                return 1;
+            }
+            free(buf);
+        }
+        printf("decode: %s matches the reference on %u buffers, %.1f mframes/s.\n",
+               a_decode_name(path_table[p]), (unsigned int)times, a_decode_bench(bench) / 1e6);
+    }
+    free(bench);
+    printf("decode: finish test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,357 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_dma_test.c
+ * @brief     driver ba121 dma test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_dma_test.h"
+#include "driver_ba121_test_common.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief dma test size definition
+ */
+#define DMA_TEST_DMA_SIZE         64         /**< same as the stm32 uart2 dma buffer */
+#define DMA_TEST_RING_SIZE        256        /**< smaller than the stm32 ring, so it wraps often */
+
+static uint8_t gs_dma[DMA_TEST_DMA_SIZE];          /**< simulated dma buffer */
+static uint8_t gs_storage[DMA_TEST_RING_SIZE];     /**< ring storage */
+static ring_t gs_ring;                             /**< ring under test */
+static dma_rx_t gs_rx;                             /**< dma position under test */
+static uint32_t gs_wpos;                           /**< simulated dma write position */
+
+/**
+ * @brief     check a condition
+ * @param[in] ok condition
+ * @param[in] *what pointer to a description
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_dma_check(int ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("dma: %s failed.\n", what);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      build a frame
+ * @param[in]  i frame index
+ * @param[out] *frame pointer to a frame buffer
+ * @note       the index goes into the data bytes, so every frame differs
+ */
+static void a_dma_frame(uint32_t i, uint8_t frame[FRAME_LEN])
+{
+    uint16_t sum;
+    uint8_t j;
+    
+    frame[0] = ((i & 1) != 0) ? 0xAC : 0xAA;
+    frame[1] = (uint8_t)(i >> 24);
+    frame[2] = (uint8_t)(i >> 16);
+    frame[3] = (uint8_t)(i >> 8);
+    frame[4] = (uint8_t)(i >> 0);
+    sum = 0;
+    for (j = 0; j < FRAME_LEN - 1; j++)
+    {
+        sum += frame[j];
+    }
+    frame[FRAME_LEN - 1] = (uint8_t)sum;
+}
+
+/**
+ * @brief     simulated dma receives one byte
+ * @param[in] data received byte
+ * @note      fires the half and the full event like the stm32 dma
+ */
+static void a_dma_byte(uint8_t data)
+{
+    gs_dma[gs_wpos] = data;
+    gs_wpos++;
+    if (gs_wpos == DMA_TEST_DMA_SIZE / 2)
+    {
+        (void)dma_rx_update(&gs_rx, gs_wpos);
+    }
+    if (gs_wpos == DMA_TEST_DMA_SIZE)
+    {
+        (void)dma_rx_update(&gs_rx, gs_wpos);
+        gs_wpos = 0;
+    }
+}
+
+/**
+ * @brief simulated idle line
+ * @note  the hal skips the idle event when the remaining count equals the buffer size
+ */
+static void a_dma_idle(void)
+{
+    if (gs_wpos != 0)
+    {
+        (void)dma_rx_update(&gs_rx, gs_wpos);
+    }
+}
+
+/**
+ * @brief  single thread corner cases
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+static uint8_t a_dma_corner_test(void)
+{
+    ring_t ring;
+    dma_rx_t rx;
+    uint8_t storage[16];
+    uint8_t dma[8];
+    uint8_t out[32];
+    uint8_t frame[FRAME_LEN];
+    uint32_t dropped;
+    uint32_t i;
+    uint8_t res;
+    
+    res = 0;
+    for (i = 0; i < 8; i++)
+    {
+        dma[i] = (uint8_t)(0x10 + i);
+    }
+    
+    /* init */
+    res |= a_dma_check(ring_init(&ring, storage, 16) == 0, "ring init");
+    res |= a_dma_check(dma_rx_init(&rx, dma, 0, &ring) == 1, "zero size");
+    res |= a_dma_check(dma_rx_init(&rx, dma, 8, NULL) == 1, "null ring");
+    res |= a_dma_check(dma_rx_init(&rx, dma, 8, &ring) == 0, "init");
+    
+    /* a position past the buffer and a repeated position move nothing */
+    res |= a_dma_check(dma_rx_update(&rx, 9) == 0, "position past the buffer");
+    res |= a_dma_check(dma_rx_update(&rx, 0) == 0, "same position");
+    
+    /* idle at 3, full at 8, then idle at 2 */
+    res |= a_dma_check(dma_rx_update(&rx, 3) == 3, "idle");
+    res |= a_dma_check(dma_rx_update(&rx, 8) == 5, "full");
+    res |= a_dma_check((rx.pos == 0) && (dma_rx_update(&rx, 2) == 2), "after full");
+    res |= a_dma_check((ring_read(&ring, out, 32) == 10) && (memcmp(out, dma, 8) == 0) &&
+                       (memcmp(&out[8], dma, 2) == 0), "full lap order");
+    
+    /* a wrap without the full event takes the tail then the head */
+    res |= a_dma_check(dma_rx_update(&rx, 6) == 4, "idle at 6");
+    res |= a_dma_check(dma_rx_update(&rx, 1) == 3, "wrapped idle");
+    res |= a_dma_check((ring_read(&ring, out, 32) == 7) && (memcmp(out, &dma[2], 6) == 0) &&
+                       (out[6] == dma[0]), "wrap order");
+    
+    /* the restart after an error begins at 0 */
+    dma_rx_reset(&rx);
+    res |= a_dma_check(dma_rx_update(&rx, 2) == 2, "reset");
+    res |= a_dma_check((ring_read(&ring, out, 32) == 2) && (memcmp(out, dma, 2) == 0), "reset order");
+    
+    /* a full ring drops and counts */
+    dma_rx_reset(&rx);
+    for (i = 0; i < 3; i++)
+    {
+        (void)dma_rx_update(&rx, 8);
+    }
+    res |= a_dma_check((ring_count(&ring) == 16) && (ring.overflow == 8), "ring overflow");
+    ring_flush(&ring);
+    
+    /* a frame split over two bursts stays until it is whole */
+    a_dma_frame(7, frame);
+    (void)ring_write(&ring, frame, 4);
+    res |= a_dma_check(frame_read(&ring, out, 32, &dropped) == 0, "partial frame");
+    res |= a_dma_check((ring_count(&ring) == 4) && (dropped == 0), "partial frame kept");
+    (void)ring_write(&ring, &frame[4], 2);
+    res |= a_dma_check(frame_read(&ring, out, 5, &dropped) == 0, "short buffer");
+    res |= a_dma_check(frame_read(&ring, out, 32, NULL) == 6, "whole frame");
+    res |= a_dma_check(memcmp(out, frame, FRAME_LEN) == 0, "whole frame data");
+    
+    /* a bad checksum drops the header and resyncs on the next frame */
+    out[0] = 0xAA;
+    out[1] = 0x01;
+    out[2] = 0x02;
+    out[3] = 0x03;
+    out[4] = 0x04;
+    out[5] = 0x00;
+    (void)ring_write(&ring, out, 6);
+    (void)ring_write(&ring, frame, 6);
+    res |= a_dma_check(frame_read(&ring, out, 32, &dropped) == 6, "resync");
+    res |= a_dma_check((dropped == 6) && (memcmp(out, frame, FRAME_LEN) == 0), "resync data");
+    
+    /* two frames, a buffer for one and a half */
+    (void)ring_write(&ring, frame, 6);
+    (void)ring_write(&ring, frame, 6);
+    res |= a_dma_check(frame_read(&ring, out, 9, NULL) == 6, "one of two");
+    res |= a_dma_check(ring_count(&ring) == 6, "second kept");
+    ring_flush(&ring);
+    
+    return res;
+}
+
+/**
+ * @brief     ba121 dma test
+ * @param[in] times frames sent through the simulated dma
+ * @param[in] seed random seed of the bursts, the noise and the reads
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      checks the dma position and frame corner cases, then plays a circular dma with half, full and
+ *            idle events like the stm32 port and fails on any lost, duplicated, reordered or invented frame
+ */
+uint8_t ba121_dma_test(uint32_t times, uint32_t seed)
+{
+    uint8_t frame[FRAME_LEN];
+    uint8_t out[DMA_TEST_RING_SIZE];
+    uint32_t state;
+    uint32_t sent;
+    uint32_t expect;
+    uint32_t noise;
+    uint32_t dropped;
+    uint32_t total;
+    uint32_t bursts;
+    uint32_t r;
+    uint16_t len;
+    uint16_t n;
+    uint16_t i;
+    uint8_t j;
+    
+    printf("dma: corner cases.\n");
+    if (a_dma_corner_test() != 0)
+    {
+        return 1;
+    }
+    
+    state = ba121_test_seed(seed);
+    (void)ring_init(&gs_ring, gs_storage, DMA_TEST_RING_SIZE);
+    (void)dma_rx_init(&gs_rx, gs_dma, DMA_TEST_DMA_SIZE, &gs_ring);
+    gs_wpos = 0;
+    
+    printf("dma: %u frames, seed 0x%08X.\n", (unsigned int)times, (unsigned int)seed);
+    sent = 0;
+    expect = 0;
+    noise = 0;
+    total = 0;
+    bursts = 0;
+    while (expect < times)
+    {
+        /* a burst of up to 8 frames, sometimes with line noise that never looks like a header */
+        r = ba121_test_random(&state);
+        for (j = 0; (j < (r & 7) + 1) && (sent < times); j++)
+        {
+            if (((r >> 8) & 7) == 0)
+            {
+                uint8_t data = (uint8_t)(ba121_test_random(&state) >> 24);
+                
+                if ((data == 0xAA) || (data == 0xAC))
+                {
+                    data = 0x00;
+                }
+                a_dma_byte(data);
+                noise++;
+            }
+            a_dma_frame(sent, frame);
+            for (i = 0; i < FRAME_LEN; i++)
+            {
+                a_dma_byte(frame[i]);
+            }
+            sent++;
+        }
+        
+        /* the line goes quiet after most bursts, a back to back burst relies on the half and full events */
+        if (((r >> 12) & 3) != 0)
+        {
+            a_dma_idle();
+            bursts++;
+        }
+        if (sent == times)
+        {
+            a_dma_idle();
+        }
+        
+        /* the driver reads at random times with random buffer sizes */
+        if ((((r >> 16) & 1) != 0) || (ring_count(&gs_ring) > DMA_TEST_RING_SIZE / 2) || (sent == times))
+        {
+            len = (uint16_t)((r >> 20) % DMA_TEST_RING_SIZE);
+            if ((ring_count(&gs_ring) > DMA_TEST_RING_SIZE / 2) || (sent == times))
+            {
+                len = DMA_TEST_RING_SIZE;
+            }
+            n = frame_read(&gs_ring, out, len, &dropped);
+            total += dropped;
+            if ((n % FRAME_LEN) != 0)
+            {
+                printf("dma: read %u bytes, not whole frames.\n", (unsigned int)n);
+                
+                return 1;
+            }
+            for (i = 0; i < n; i += FRAME_LEN)
+            {
+                a_dma_frame(expect, frame);
+                if (memcmp(&out[i], frame, FRAME_LEN) != 0)
+                {
+                    printf("dma: frame %u is wrong.\n", (unsigned int)expect);
+                    
+                    return 1;
+                }
+                expect++;
+            }
+            if ((sent == times) && (n == 0) && (expect < times))
+            {
+                printf("dma: frame %u is lost.\n", (unsigned int)expect);
+                
+                return 1;
+            }
+        }
+    }
+    if (gs_ring.overflow != 0)
+    {
+        printf("dma: ring overflow %u.\n", (unsigned int)gs_ring.overflow);
+        
+        return 1;
+    }
+    if (total != noise)
+    {
+        printf("dma: dropped %u bytes, sent %u noise bytes.\n", (unsigned int)total, (unsigned int)noise);
+        
+        return 1;
+    }
+    printf("dma: %u frames in %u bursts with %u events, %u noise bytes dropped.\n", (unsigned int)expect,
+           (unsigned int)bursts, (unsigned int)gs_rx.events, (unsigned int)noise);
+    printf("dma: finish test.\n");
+    
+    return 0;
+}
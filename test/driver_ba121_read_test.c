@@ -61,6 +61,8 @@ uint8_t ba121_read_test(uint32_t times)
     DRIVER_BA121_LINK_UART_WRITE(&gs_handle, ba121_interface_uart_write);
     DRIVER_BA121_LINK_DELAY_MS(&gs_handle, ba121_interface_delay_ms);
     DRIVER_BA121_LINK_DEBUG_PRINT(&gs_handle, ba121_interface_debug_print);
+    DRIVER_BA121_LINK_TIMESTAMP_US(&gs_handle, ba121_interface_timestamp_us);
+    DRIVER_BA121_LINK_WAIT_REPLY(&gs_handle, ba121_interface_wait_reply);
     
     /* get ba121 information */
     res = ba121_info(&info);
@@ -48,6 +48,10 @@ static ba121_handle_t gs_handle;        /**< ba121 handle */
 uint8_t ba121_register_test(void)
 {
     uint8_t res;
+    uint8_t attempts;
+    uint8_t mask;
+    uint16_t backoff_ms;
+    uint16_t max_backoff_ms;
     ba121_status_t status;
     ba121_info_t info;
     
@@ -60,6 +64,8 @@ uint8_t ba121_register_test(void)
     DRIVER_BA121_LINK_UART_WRITE(&gs_handle, ba121_interface_uart_write);
     DRIVER_BA121_LINK_DELAY_MS(&gs_handle, ba121_interface_delay_ms);
     DRIVER_BA121_LINK_DEBUG_PRINT(&gs_handle, ba121_interface_debug_print);
+    DRIVER_BA121_LINK_TIMESTAMP_US(&gs_handle, ba121_interface_timestamp_us);
+    DRIVER_BA121_LINK_WAIT_REPLY(&gs_handle, ba121_interface_wait_reply);
     
     /* get ba121 information */
     res = ba121_info(&info);
@@ -148,6 +154,48 @@ uint8_t ba121_register_test(void)
     ba121_interface_debug_print("ba121: check baseline calibration %s.\n", res == 0 ? "ok" : "error");
 #endif
     
+    /* ba121_set_retry/ba121_get_retry test */
+    ba121_interface_debug_print("ba121: ba121_set_retry/ba121_get_retry test.\n");
+    
+    /* set retry */
+    ba121_interface_debug_print("ba121: set retry 3 attempts, 20ms - 80ms backoff.\n");
+    
+    /* set retry */
+    res = ba121_set_retry(&gs_handle, 3, 20, 80, BA121_RETRY_ALL);
+    if (res != 0)
+    {
+        ba121_interface_debug_print("ba121: set retry failed.\n");
+        (void)ba121_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* get retry */
+    res = ba121_get_retry(&gs_handle, &attempts, &backoff_ms, &max_backoff_ms, &mask);
+    if (res != 0)
+    {
+        ba121_interface_debug_print("ba121: get retry failed.\n");
+        (void)ba121_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ba121_interface_debug_print("ba121: check retry %s.\n", ((attempts == 3) && (backoff_ms == 20) &&
+                                (max_backoff_ms == 80) && (mask == BA121_RETRY_ALL)) ? "ok" : "error");
+    
+    /* ba121_get_last_attempts test */
+    ba121_interface_debug_print("ba121: ba121_get_last_attempts test.\n");
+    
+    /* get last attempts */
+    res = ba121_get_last_attempts(&gs_handle, &attempts);
+    if (res != 0)
+    {
+        ba121_interface_debug_print("ba121: get last attempts failed.\n");
+        (void)ba121_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ba121_interface_debug_print("ba121: last attempts is %d.\n", attempts);
+    
     /* ba121_get_last_status test */
     ba121_interface_debug_print("ba121: ba121_get_last_status test.\n");
     
@@ -0,0 +1,285 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_fault.c
+ * @brief     driver ba121 fault source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_fault.h"
+#include "driver_ba121_test_common.h"
+#include <string.h>
+
+static uint16_t (*gs_uart_read)(uint8_t *buf, uint16_t len) = NULL;        /**< wrapped uart read */
+static uint8_t (*gs_uart_write)(uint8_t *buf, uint16_t len) = NULL;        /**< wrapped uart write */
+static uint8_t (*gs_uart_flush)(void) = NULL;                              /**< wrapped uart flush */
+static uint64_t (*gs_timestamp_us)(void) = NULL;                           /**< monotonic clock */
+static ba121_fault_config_t gs_config;                                     /**< fault config */
+static ba121_fault_stats_t gs_stats;                                       /**< fault statistics */
+static uint32_t gs_seed = 1;                                               /**< random state */
+static uint8_t gs_buf[BA121_FAULT_BUFFER_SIZE];                            /**< hold buffer */
+static uint16_t gs_len;                                                    /**< held bytes */
+static uint8_t gs_holding;                                                 /**< delayed reply flag */
+static uint64_t gs_hold_until_us;                                          /**< delayed reply release time */
+
+/**
+ * @brief     roll a fault
+ * @param[in] ppm rate in parts per million
+ * @return    1 if the fault happens, otherwise 0
+ * @note      no random number is used for a disabled fault, so enabling one fault doesn't move the others
+ */
+static uint8_t a_fault_hit(uint32_t ppm)
+{
+    if (ppm == 0)
+    {
+        return 0;
+    }
+    
+    return (uint8_t)((ba121_test_random(&gs_seed) % 1000000U) < ppm);
+}
+
+/**
+ * @brief     hold one byte
+ * @param[in] byte received byte
+ * @note      none
+ */
+static void a_fault_store(uint8_t byte)
+{
+    if (gs_len < BA121_FAULT_BUFFER_SIZE)
+    {
+        gs_buf[gs_len++] = byte;
+    }
+    else
+    {
+        gs_stats.overflows++;
+    }
+}
+
+/**
+ * @brief pull the received bytes of the wrapped transport through the faults
+ * @note  none
+ */
+static void a_fault_pull(void)
+{
+    uint8_t n;
+    uint16_t i;
+    uint16_t len;
+    uint8_t tmp[BA121_FAULT_BUFFER_SIZE];
+    
+    for (n = 0; (n < 4) && (gs_len < BA121_FAULT_BUFFER_SIZE); n++)
+    {
+        len = gs_uart_read(tmp, (uint16_t)(BA121_FAULT_BUFFER_SIZE - gs_len));
+        for (i = 0; i < len; i++)
+        {
+            if (a_fault_hit(gs_config.drop_ppm) != 0)
+            {
+                gs_stats.dropped++;
+                
+                continue;
+            }
+            if (a_fault_hit(gs_config.garbage_ppm) != 0)
+            {
+                a_fault_store((uint8_t)ba121_test_random(&gs_seed));
+                gs_stats.garbage++;
+            }
+            if (a_fault_hit(gs_config.flip_ppm) != 0)
+            {
+                tmp[i] ^= (uint8_t)(1U << (ba121_test_random(&gs_seed) % 8));
+                gs_stats.flipped++;
+            }
+            a_fault_store(tmp[i]);
+        }
+        if (len == 0)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     link the wrapped transport
+ * @param[in] *uart_read pointer to the wrapped uart read function
+ * @param[in] *uart_write pointer to the wrapped uart write function
+ * @param[in] *uart_flush pointer to the wrapped uart flush function
+ * @param[in] *timestamp_us pointer to a monotonic us clock
+ * @return    status code
+ *            - 0 success
+ *            - 1 a function is NULL
+ * @note      link ba121_fault_uart_read, ba121_fault_uart_write and ba121_fault_uart_flush into the handle instead,
+ *            there is one fault layer per process because the interface callbacks carry no context,
+ *            it can't be used with BA121_STATIC_LINK
+ */
+uint8_t ba121_fault_link(uint16_t (*uart_read)(uint8_t *buf, uint16_t len),
+                         uint8_t (*uart_write)(uint8_t *buf, uint16_t len),
+                         uint8_t (*uart_flush)(void),
+                         uint64_t (*timestamp_us)(void))
+{
+    if ((uart_read == NULL) || (uart_write == NULL) || (uart_flush == NULL) || (timestamp_us == NULL))
+    {
+        return 1;
+    }
+    gs_uart_read = uart_read;
+    gs_uart_write = uart_write;
+    gs_uart_flush = uart_flush;
+    gs_timestamp_us = timestamp_us;
+    
+    return 0;
+}
+
+/**
+ * @brief     set the faults
+ * @param[in] *config pointer to a fault config structure
+ * @param[in] seed random seed, the same seed repeats the same faults
+ * @note      the held bytes and the statistics are cleared
+ */
+void ba121_fault_set_config(const ba121_fault_config_t *config, uint32_t seed)
+{
+    gs_config = *config;
+    gs_seed = ba121_test_seed(seed);
+    gs_len = 0;
+    gs_holding = 0;
+    gs_hold_until_us = 0;
+    memset(&gs_stats, 0, sizeof(ba121_fault_stats_t));
+}
+
+/**
+ * @brief      get the injected fault statistics
+ * @param[out] *stats pointer to a fault statistics structure
+ * @note       none
+ */
+void ba121_fault_get_stats(ba121_fault_stats_t *stats)
+{
+    *stats = gs_stats;
+}
+
+/**
+ * @brief      fault uart read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       received bytes are dropped, flipped or padded with garbage on the way in
+ */
+uint16_t ba121_fault_uart_read(uint8_t *buf, uint16_t len)
+{
+    uint16_t n;
+    
+    if (gs_uart_read == NULL)
+    {
+        return 0;
+    }
+    a_fault_pull();
+    if (gs_holding != 0)
+    {
+        if (gs_timestamp_us() < gs_hold_until_us)
+        {
+            return 0;
+        }
+        gs_holding = 0;
+    }
+    n = (len < gs_len) ? len : gs_len;
+    if ((n > 1) && (a_fault_hit(gs_config.short_read_ppm) != 0))
+    {
+        n = (uint16_t)(1 + ba121_test_random(&gs_seed) % (n - 1));
+        gs_stats.short_reads++;
+    }
+    memcpy(buf, gs_buf, n);
+    gs_len = (uint16_t)(gs_len - n);
+    memmove(gs_buf, &gs_buf[n], gs_len);
+    
+    return n;
+}
+
+/**
+ * @brief     fault uart write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart write failed
+ * @note      a write may fail or hold its reply back
+ */
+uint8_t ba121_fault_uart_write(uint8_t *buf, uint16_t len)
+{
+    uint64_t until;
+    
+    if (gs_uart_write == NULL)
+    {
+        return 1;
+    }
+    if (a_fault_hit(gs_config.write_fail_ppm) != 0)
+    {
+        gs_stats.write_fails++;
+        
+        return 1;
+    }
+    if (gs_uart_write(buf, len) != 0)
+    {
+        return 1;
+    }
+    if (a_fault_hit(gs_config.delay_ppm) != 0)
+    {
+        until = gs_timestamp_us() + (uint64_t)gs_config.delay_ms * 1000;
+        if ((gs_holding == 0) || (until > gs_hold_until_us))
+        {
+            gs_hold_until_us = until;
+        }
+        gs_holding = 1;
+        gs_stats.delayed++;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  fault uart flush
+ * @return status code
+ *         - 0 success
+ *         - 1 uart flush failed
+ * @note   held bytes of a delayed reply survive the flush, they have not arrived yet
+ */
+uint8_t ba121_fault_uart_flush(void)
+{
+    if (gs_uart_flush == NULL)
+    {
+        return 1;
+    }
+    if ((gs_holding != 0) && (gs_timestamp_us() < gs_hold_until_us))
+    {
+        a_fault_pull();
+    }
+    else
+    {
+        gs_holding = 0;
+        gs_len = 0;
+    }
+    
+    return gs_uart_flush();
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_fault.h
+ * @brief     driver ba121 fault header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_FAULT_H
+#define DRIVER_BA121_FAULT_H
+
+#include "driver_ba121.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_fault_driver ba121 fault driver function
+ * @brief    ba121 fault driver modules
+ * @ingroup  ba121_test_driver
+ * @{
+ */
+
+/**
+ * @brief fault hold buffer size definition
+ */
+#ifndef BA121_FAULT_BUFFER_SIZE
+    #define BA121_FAULT_BUFFER_SIZE 64        /**< 64 bytes */
+#endif
+
+/**
+ * @brief ba121 fault config structure definition
+ * @note  every rate is in parts per million, 0 disables the fault
+ */
+typedef struct ba121_fault_config_s
+{
+    uint32_t drop_ppm;              /**< received byte dropped */
+    uint32_t garbage_ppm;           /**< random byte inserted before a received byte */
+    uint32_t flip_ppm;              /**< one bit of a received byte flipped */
+    uint32_t delay_ppm;             /**< reply to a written command held back */
+    uint32_t delay_ms;              /**< hold time of a delayed reply */
+    uint32_t short_read_ppm;        /**< read returns only a part of the available bytes */
+    uint32_t write_fail_ppm;        /**< write fails without sending */
+} ba121_fault_config_t;
+
+/**
+ * @brief ba121 fault statistics structure definition
+ */
+typedef struct ba121_fault_stats_s
+{
+    uint32_t dropped;            /**< dropped bytes */
+    uint32_t garbage;            /**< inserted bytes */
+    uint32_t flipped;            /**< flipped bytes */
+    uint32_t delayed;            /**< delayed replies */
+    uint32_t short_reads;        /**< short reads */
+    uint32_t write_fails;        /**< failed writes */
+    uint32_t overflows;          /**< bytes lost because the hold buffer was full */
+} ba121_fault_stats_t;
+
+/**
+ * @brief     link the wrapped transport
+ * @param[in] *uart_read pointer to the wrapped uart read function
+ * @param[in] *uart_write pointer to the wrapped uart write function
+ * @param[in] *uart_flush pointer to the wrapped uart flush function
+ * @param[in] *timestamp_us pointer to a monotonic us clock
+ * @return    status code
+ *            - 0 success
+ *            - 1 a function is NULL
+ * @note      link ba121_fault_uart_read, ba121_fault_uart_write and ba121_fault_uart_flush into the handle instead,
+ *            there is one fault layer per process because the interface callbacks carry no context,
+ *            it can't be used with BA121_STATIC_LINK
+ */
+uint8_t ba121_fault_link(uint16_t (*uart_read)(uint8_t *buf, uint16_t len),
+                         uint8_t (*uart_write)(uint8_t *buf, uint16_t len),
+                         uint8_t (*uart_flush)(void),
+                         uint64_t (*timestamp_us)(void));
+
+/**
+ * @brief     set the faults
+ * @param[in] *config pointer to a fault config structure
+ * @param[in] seed random seed, the same seed repeats the same faults
+ * @note      the held bytes and the statistics are cleared
+ */
+void ba121_fault_set_config(const ba121_fault_config_t *config, uint32_t seed);
+
+/**
+ * @brief      get the injected fault statistics
+ * @param[out] *stats pointer to a fault statistics structure
+ * @note       none
+ */
+void ba121_fault_get_stats(ba121_fault_stats_t *stats);
+
+/**
+ * @brief      fault uart read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       received bytes are dropped, flipped or padded with garbage on the way in
+ */
+uint16_t ba121_fault_uart_read(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     fault uart write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart write failed
+ * @note      a write may fail or hold its reply back
+ */
+uint8_t ba121_fault_uart_write(uint8_t *buf, uint16_t len);
+
+/**
+ * @brief  fault uart flush
+ * @return status code
+ *         - 0 success
+ *         - 1 uart flush failed
+ * @note   held bytes of a delayed reply survive the flush, they have not arrived yet
+ */
+uint8_t ba121_fault_uart_flush(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_fault_bench.c
+ * @brief     driver ba121 fault bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_fault_bench.h"
+#include "driver_ba121_interface_mock.h"
+#include "driver_ba121_test_common.h"
+#include <time.h>
+
+static ba121_handle_t gs_handle;        /**< ba121 handle */
+static uint32_t gs_seed;                /**< random state */
+
+/**
+ * @brief     check one count against its limit
+ * @param[in] *name count name
+ * @param[in] count event count
+ * @param[in] times read transaction times
+ * @param[in] limit_ppm limit in ppm
+ * @return    status code
+ *            - 0 within the limit
+ *            - 1 limit exceeded
+ * @note      none
+ */
+static uint8_t a_bench_limit(const char *name, uint32_t count, uint32_t times, uint32_t limit_ppm)
+{
+    if ((uint64_t)count * 1000000ULL > (uint64_t)limit_ppm * (uint64_t)times)
+    {
+        ba121_interface_debug_print("ba121: %s %u is over the limit of %uppm.\n", name,
+                                    (unsigned int)count, (unsigned int)limit_ppm);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     fault soak bench
+ * @param[in] times read transaction times
+ * @param[in] seed random seed
+ * @param[in] attempts driver retry attempts, 0 or 1 disables the retry
+ * @param[in] *config pointer to a fault config structure
+ * @param[in] *limit pointer to a fault limit structure, NULL only reports
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed or a limit was exceeded
+ * @note      reads from the mock sensor through the fault layer on the virtual clock and reports
+ *            samples lost, wrong samples accepted, recovery latency and cpu time per sample,
+ *            an accepted sample equal to the previous read is stale, one equal to neither is corrupt
+ */
+uint8_t ba121_fault_bench(uint32_t times, uint32_t seed, uint8_t attempts,
+                          const ba121_fault_config_t *config, const ba121_fault_limit_t *limit)
+{
+    uint8_t res;
+    uint8_t last_attempts;
+    uint32_t i;
+    uint32_t ok;
+    uint32_t stale;
+    uint32_t corrupt;
+    uint32_t link_error;
+    uint32_t frame_error;
+    uint32_t retries;
+    uint32_t recoveries;
+    uint32_t recovery_max_ms;
+    uint32_t start_ms;
+    uint32_t failed_ms;
+    uint64_t recovery_total_ms;
+    uint8_t failing;
+    uint8_t over;
+    uint16_t prev_c;
+    uint16_t prev_t;
+    clock_t start;
+    double cpu_s;
+    ba121_fault_stats_t stats;
+    
+    /* link the fault layer between the driver and the mock */
+    ba121_mock_reset();
+    gs_seed = ba121_test_seed(seed);
+    ba121_fault_set_config(config, ba121_test_random(&gs_seed));
+    if (ba121_fault_link(ba121_interface_uart_read, ba121_interface_uart_write,
+                         ba121_interface_uart_flush, ba121_interface_timestamp_us) != 0)
+    {
+        return 1;
+    }
+    DRIVER_BA121_LINK_INIT(&gs_handle, ba121_handle_t);
+    DRIVER_BA121_LINK_UART_INIT(&gs_handle, ba121_interface_uart_init);
+    DRIVER_BA121_LINK_UART_DEINIT(&gs_handle, ba121_interface_uart_deinit);
+    DRIVER_BA121_LINK_UART_READ(&gs_handle, ba121_fault_uart_read);
+    DRIVER_BA121_LINK_UART_FLUSH(&gs_handle, ba121_fault_uart_flush);
+    DRIVER_BA121_LINK_UART_WRITE(&gs_handle, ba121_fault_uart_write);
+    DRIVER_BA121_LINK_DELAY_MS(&gs_handle, ba121_interface_delay_ms);
+    DRIVER_BA121_LINK_DEBUG_PRINT(&gs_handle, ba121_interface_debug_print);
+    DRIVER_BA121_LINK_TIMESTAMP_US(&gs_handle, ba121_interface_timestamp_us);
+    res = ba121_init(&gs_handle);
+    if (res != 0)
+    {
+        return 1;
+    }
+    if (attempts > 1)
+    {
+        res = ba121_set_retry(&gs_handle, attempts, 20, 200, BA121_RETRY_ALL);
+        if (res != 0)
+        {
+            (void)ba121_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    ok = 0;
+    stale = 0;
+    corrupt = 0;
+    prev_c = 0;
+    prev_t = 0;
+    link_error = 0;
+    frame_error = 0;
+    retries = 0;
+    recoveries = 0;
+    recovery_max_ms = 0;
+    recovery_total_ms = 0;
+    failing = 0;
+    failed_ms = 0;
+    start = clock();
+    for (i = 0; i < times; i++)
+    {
+        uint16_t c;
+        uint16_t t;
+        uint16_t conductivity_raw;
+        uint16_t conductivity_us_cm;
+        uint16_t temperature_raw;
+        float temperature;
+        
+        c = (uint16_t)ba121_test_random(&gs_seed);
+        t = (uint16_t)ba121_test_random(&gs_seed);
+        ba121_mock_set_sample(c, t);
+        start_ms = ba121_mock_get_time_ms();
+        res = ba121_read(&gs_handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+        (void)ba121_get_last_attempts(&gs_handle, &last_attempts);
+        retries += (last_attempts > 1) ? (uint32_t)(last_attempts - 1) : 0;
+        if (res == 0)
+        {
+            ok++;
+            if ((conductivity_raw != c) || (temperature_raw != t))
+            {
+                /* a late reply of the previous read is stale */
+                if ((i != 0) && (conductivity_raw == prev_c) && (temperature_raw == prev_t))
+                {
+                    stale++;
+                }
+                else
+                {
+                    corrupt++;
+                }
+            }
+            if (failing != 0)
+            {
+                uint32_t recovery_ms = ba121_mock_get_time_ms() - failed_ms;
+                
+                recoveries++;
+                recovery_total_ms += recovery_ms;
+                recovery_max_ms = (recovery_ms > recovery_max_ms) ? recovery_ms : recovery_max_ms;
+                failing = 0;
+            }
+        }
+        else
+        {
+            if (res == 1)
+            {
+                link_error++;
+            }
+            else
+            {
+                frame_error++;
+            }
+            if (failing == 0)
+            {
+                failing = 1;
+                failed_ms = start_ms;
+            }
+        }
+        prev_c = c;
+        prev_t = t;
+    }
+    cpu_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+    (void)ba121_deinit(&gs_handle);
+    ba121_fault_get_stats(&stats);
+    
+    /* output */
+    ba121_mock_set_verbose(1);
+    ba121_interface_debug_print("ba121: %u reads in %u virtual s, %u attempts per read.\n", (unsigned int)times,
+                                (unsigned int)(ba121_mock_get_time_ms() / 1000), (unsigned int)((attempts > 1) ? attempts : 1));
+    ba121_interface_debug_print("ba121: injected %u dropped, %u garbage, %u flipped, %u delayed, %u short reads, %u write fails.\n",
+                                (unsigned int)stats.dropped, (unsigned int)stats.garbage, (unsigned int)stats.flipped,
+                                (unsigned int)stats.delayed, (unsigned int)stats.short_reads, (unsigned int)stats.write_fails);
+    ba121_interface_debug_print("ba121: samples ok %u, lost %u (%.4f%%), wrong accepted %u stale and %u corrupt, retries %u.\n",
+                                (unsigned int)ok, (unsigned int)(times - ok),
+                                (times != 0) ? 100.0 * (double)(times - ok) / (double)times : 0.0,
+                                (unsigned int)stale, (unsigned int)corrupt, (unsigned int)retries);
+    ba121_interface_debug_print("ba121: errors link %u, frame %u.\n", (unsigned int)link_error, (unsigned int)frame_error);
+    ba121_interface_debug_print("ba121: recoveries %u, mean %.1fms, max %ums.\n", (unsigned int)recoveries,
+                                (recoveries != 0) ? (double)recovery_total_ms / (double)recoveries : 0.0,
+                                (unsigned int)recovery_max_ms);
+    ba121_interface_debug_print("ba121: cpu %.3fs, %.2fus per sample.\n", cpu_s,
+                                (times != 0) ? cpu_s * 1e6 / (double)times : 0.0);
+    
+    /* check every limit, so all failures are reported */
+    if (limit == NULL)
+    {
+        return 0;
+    }
+    over = a_bench_limit("lost", times - ok, times, limit->lost_ppm);
+    over |= a_bench_limit("stale", stale, times, limit->stale_ppm);
+    over |= a_bench_limit("corrupt", corrupt, times, limit->corrupt_ppm);
+    if (over != 0)
+    {
+        return 1;
+    }
+    ba121_interface_debug_print("ba121: within the limits of %uppm lost, %uppm stale and %uppm corrupt.\n",
+                                (unsigned int)limit->lost_ppm, (unsigned int)limit->stale_ppm,
+                                (unsigned int)limit->corrupt_ppm);
+    
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_fault_bench.h
+ * @brief     driver ba121 fault bench header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_FAULT_BENCH_H
+#define DRIVER_BA121_FAULT_BENCH_H
+
+#include "driver_ba121_fault.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ba121_fault_driver
+ * @{
+ */
+
+/**
+ * @brief fault bench limit structure definition
+ */
+typedef struct ba121_fault_limit_s
+{
+    uint32_t lost_ppm;           /**< max failed reads in ppm */
+    uint32_t stale_ppm;          /**< max accepted samples that belong to the previous read in ppm */
+    uint32_t corrupt_ppm;        /**< max accepted samples that match no read in ppm */
+} ba121_fault_limit_t;
+
+/**
+ * @brief     fault soak bench
+ * @param[in] times read transaction times
+ * @param[in] seed random seed
+ * @param[in] attempts driver retry attempts, 0 or 1 disables the retry
+ * @param[in] *config pointer to a fault config structure
+ * @param[in] *limit pointer to a fault limit structure, NULL only reports
+ * @return    status code
+ *            - 0 success
+ *            - 1 bench failed or a limit was exceeded
+ * @note      reads from the mock sensor through the fault layer on the virtual clock and reports
+ *            samples lost, wrong samples accepted, recovery latency and cpu time per sample
+ */
+uint8_t ba121_fault_bench(uint32_t times, uint32_t seed, uint8_t attempts,
+                          const ba121_fault_config_t *config, const ba121_fault_limit_t *limit);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_fault_bench.h"
+#include "driver_ba121_test_common.h"
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      usage: ba121_fault_bench [times] [seed] [attempts] [lost_ppm] [stale_ppm] [corrupt_ppm],
+ *            1000000 reads, a fixed seed, no retry and the limits of the retry setting by default
+ */
+int main(int argc, char **argv)
+{
+    uint32_t times;
+    uint32_t seed;
+    uint8_t attempts;
+    ba121_fault_config_t config;
+    ba121_fault_limit_t limit;
+    
+    times = ba121_test_arg(argc, argv, 1, 1000000);
+    seed = ba121_test_arg(argc, argv, 2, 0x6A09E667U);
+    attempts = (uint8_t)ba121_test_arg(argc, argv, 3, 1);
+    
+    /* a noisy cable */
+    config.drop_ppm = 200;
+    config.garbage_ppm = 200;
+    config.flip_ppm = 200;
+    config.delay_ppm = 2000;
+    config.delay_ms = 1500;
+    config.short_read_ppm = 5000;
+    config.write_fail_ppm = 1000;
+    
+    /* on this cable a single attempt loses about 1.2% of the reads and takes about 0.2% stale samples
+       from the delayed replies, a retry loses almost nothing, checksum escapes stay near 10ppm */
+    limit.lost_ppm = (attempts > 1) ? 500 : 15000;
+    limit.stale_ppm = (attempts > 1) ? 500 : 3000;
+    limit.corrupt_ppm = 100;
+    limit.lost_ppm = ba121_test_arg(argc, argv, 4, limit.lost_ppm);
+    limit.stale_ppm = ba121_test_arg(argc, argv, 5, limit.stale_ppm);
+    limit.corrupt_ppm = ba121_test_arg(argc, argv, 6, limit.corrupt_ppm);
+    
+    return (ba121_fault_bench(times, seed, attempts, &config, &limit) == 0) ? 0 : 1;
+}
@@ -0,0 +1,267 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_filter_test.c
+ * @brief     driver ba121 filter test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_filter_test.h"
+#include "driver_ba121_test_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief filter test definition
+ */
+#define FILTER_TEST_BLOCK           1000        /**< samples per window and threshold */
+#define FILTER_TEST_NOISE           100000      /**< samples of the noise check */
+#define FILTER_TEST_SPIKE           50          /**< spike height in lsb */
+
+static uint32_t gs_state;                                  /**< random state */
+static uint16_t gs_ref[BA121_FILTER_MAX_WINDOW];           /**< reference window */
+static uint8_t gs_ref_count;                               /**< reference sample count */
+
+/**
+ * @brief     compare two samples
+ * @param[in] *a pointer to a sample
+ * @param[in] *b pointer to a sample
+ * @return    order
+ * @note      none
+ */
+static int a_filter_compare(const void *a, const void *b)
+{
+    return (int)(*(const uint16_t *)a) - (int)(*(const uint16_t *)b);
+}
+
+/**
+ * @brief      brute force filter step
+ * @param[in]  window window length
+ * @param[in]  sigma hampel threshold
+ * @param[in]  raw raw sample
+ * @param[out] *median pointer to a median buffer
+ * @param[out] *output pointer to an output buffer
+ * @param[out] *outlier pointer to an outlier flag buffer
+ * @note       sorts a copy of the window, the mad is the lower median of the deviations
+ */
+static void a_filter_reference(uint8_t window, float sigma, uint16_t raw,
+                               uint16_t *median, uint16_t *output, uint8_t *outlier)
+{
+    uint16_t sorted[BA121_FILTER_MAX_WINDOW];
+    uint16_t dev[BA121_FILTER_MAX_WINDOW];
+    uint16_t med;
+    uint16_t mad;
+    uint16_t d;
+    uint8_t i;
+    
+    if (gs_ref_count == window)
+    {
+        for (i = 1; i < window; i++)
+        {
+            gs_ref[i - 1] = gs_ref[i];
+        }
+        gs_ref_count--;
+    }
+    gs_ref[gs_ref_count++] = raw;
+    for (i = 0; i < gs_ref_count; i++)
+    {
+        sorted[i] = gs_ref[i];
+    }
+    qsort(sorted, gs_ref_count, sizeof(uint16_t), a_filter_compare);
+    if ((gs_ref_count & 0x01) != 0)
+    {
+        med = sorted[gs_ref_count / 2];
+    }
+    else
+    {
+        med = (uint16_t)(((uint32_t)sorted[gs_ref_count / 2 - 1] + (uint32_t)sorted[gs_ref_count / 2]) / 2);
+    }
+    *median = med;
+    *output = raw;
+    *outlier = 0;
+    if ((sigma > 0.0f) && (gs_ref_count >= 3))
+    {
+        for (i = 0; i < gs_ref_count; i++)
+        {
+            dev[i] = (gs_ref[i] > med) ? (uint16_t)(gs_ref[i] - med) : (uint16_t)(med - gs_ref[i]);
+        }
+        qsort(dev, gs_ref_count, sizeof(uint16_t), a_filter_compare);
+        mad = dev[(gs_ref_count - 1) / 2];
+        if (mad < BA121_FILTER_MIN_MAD)
+        {
+            mad = BA121_FILTER_MIN_MAD;
+        }
+        d = (raw > med) ? (uint16_t)(raw - med) : (uint16_t)(med - raw);
+        if ((float)d > sigma * 1.4826f * (float)mad)
+        {
+            *output = med;
+            *outlier = 1;
+        }
+    }
+}
+
+/**
+ * @brief  next test sample
+ * @return sample
+ * @note   a drifting level with small noise, plateaus, spikes and full scale values
+ */
+static uint16_t a_filter_sample(void)
+{
+    static uint16_t level = 1000;
+    uint32_t r;
+    
+    r = ba121_test_random(&gs_state);
+    switch (r & 0x1F)
+    {
+        case 0 :
+        {
+            return (uint16_t)(level + 200 + (ba121_test_random(&gs_state) % 2000));
+        }
+        case 1 :
+        {
+            return (uint16_t)((ba121_test_random(&gs_state) & 1) != 0 ? 0xFFFF : 0);
+        }
+        case 2 :
+        {
+            level = (uint16_t)(ba121_test_random(&gs_state) % 60000);
+            
+            return level;
+        }
+        case 3 :
+        case 4 :
+        case 5 :
+        {
+            return level;
+        }
+        default :
+        {
+            return (uint16_t)(level + (ba121_test_random(&gs_state) % 5) - 2);
+        }
+    }
+}
+
+/**
+ * @brief     filter test
+ * @param[in] times random samples
+ * @param[in] seed random seed of the windows, the thresholds and the samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      compares the running median, the outlier flag and the output with a brute force
+ *            sort of the window, then checks the outlier rate on quantized noise with sparse spikes
+ */
+uint8_t ba121_filter_test(uint32_t times, uint32_t seed)
+{
+    static const float sigma_table[4] = {0.0f, 2.0f, 3.0f, 4.5f};
+    ba121_filter_handle_t filter;
+    uint32_t i;
+    uint32_t flagged;
+    uint32_t spikes;
+    uint32_t caught;
+    uint8_t window;
+    float sigma;
+    uint16_t raw;
+    uint16_t median;
+    uint16_t output;
+    uint8_t outlier;
+    uint16_t ref_median;
+    uint16_t ref_output;
+    uint8_t ref_outlier;
+    
+    gs_state = ba121_test_seed(seed);
+    
+    printf("filter: %u samples against a brute force median, seed 0x%08X.\n", (unsigned int)times, (unsigned int)seed);
+    window = 1;
+    sigma = 0.0f;
+    for (i = 0; i < times; i++)
+    {
+        if ((i % FILTER_TEST_BLOCK) == 0)
+        {
+            window = (uint8_t)(1 + ba121_test_random(&gs_state) % BA121_FILTER_MAX_WINDOW);
+            sigma = sigma_table[ba121_test_random(&gs_state) & 3];
+            if (ba121_filter_init(&filter, window, sigma) != 0)
+            {
+                printf("filter: init window %u failed.\n", (unsigned int)window);
+                
+                return 1;
+            }
+            gs_ref_count = 0;
+        }
+        raw = a_filter_sample();
+        (void)ba121_filter_update(&filter, raw, &median, &output, &outlier);
+        a_filter_reference(window, sigma, raw, &ref_median, &ref_output, &ref_outlier);
+        if ((median != ref_median) || (output != ref_output) || (outlier != ref_outlier))
+        {
+            printf("filter: window %u sigma %.1f sample %u gave %u/%u/%u, expected %u/%u/%u.\n",
+                   (unsigned int)window, sigma, (unsigned int)i, (unsigned int)median, (unsigned int)output,
+                   (unsigned int)outlier, (unsigned int)ref_median, (unsigned int)ref_output, (unsigned int)ref_outlier);
+            
+            return 1;
+        }
+    }
+    
+    /* 1 lsb noise must not be flagged, the 1% spikes must */
+    (void)ba121_filter_init(&filter, BA121_FILTER_DEFAULT_WINDOW, BA121_FILTER_DEFAULT_SIGMA);
+    flagged = 0;
+    spikes = 0;
+    caught = 0;
+    for (i = 0; i < FILTER_TEST_NOISE; i++)
+    {
+        if ((ba121_test_random(&gs_state) % 100) == 0)
+        {
+            raw = 1000 + FILTER_TEST_SPIKE;
+            spikes++;
+        }
+        else
+        {
+            raw = (uint16_t)(1000 + (ba121_test_random(&gs_state) % 3) - 1);
+        }
+        (void)ba121_filter_update(&filter, raw, &median, &output, &outlier);
+        flagged += outlier;
+        if ((outlier != 0) && (raw == 1000 + FILTER_TEST_SPIKE))
+        {
+            caught++;
+        }
+    }
+    printf("filter: quantized noise flagged %.2f%% with %.2f%% spikes, %u of %u spikes caught.\n",
+           100.0 * flagged / FILTER_TEST_NOISE, 100.0 * spikes / FILTER_TEST_NOISE,
+           (unsigned int)caught, (unsigned int)spikes);
+    if ((flagged != caught) || (caught * 100 < spikes * 99))
+    {
+        printf("filter: noise outliers %u, missed spikes %u.\n", (unsigned int)(flagged - caught),
+               (unsigned int)(spikes - caught));
+        
+        return 1;
+    }
+    printf("filter: finish test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,321 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_fuzz.c
+ * @brief     driver ba121 fuzz source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_fuzz.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief fuzz stream max length definition
+ */
+#define FUZZ_STREAM_MAX_LEN (BA121_MOCK_REPLY_DEPTH * BA121_MOCK_FRAME_MAX_LEN)        /**< mock receive capacity */
+
+static ba121_handle_t gs_handle;        /**< ba121 handle */
+
+/**
+ * @brief async read result structure definition
+ */
+typedef struct fuzz_async_s
+{
+    uint8_t done;                     /**< done flag */
+    uint8_t res;                      /**< result */
+    uint16_t conductivity_raw;        /**< conductivity raw data */
+    uint16_t temperature_raw;         /**< temperature raw data */
+} fuzz_async_t;
+
+/**
+ * @brief     stop on a mismatch
+ * @param[in] ok bool value
+ * @param[in] *what pointer to a mismatch description
+ * @note      abort() so libFuzzer and AFL record the input
+ */
+static void a_fuzz_check(int ok, const char *what)
+{
+    if (ok == 0)
+    {
+        fprintf(stderr, "ba121: fuzz mismatch, %s.\n", what);
+        abort();
+    }
+}
+
+/**
+ * @brief      reference frame decoder
+ * @param[in]  *frame pointer to 6 bytes
+ * @param[out] *type pointer to a frame type buffer
+ * @param[out] *data pointer to a data buffer
+ * @return     1 if the frame is a valid 0xAA or 0xAC frame, otherwise 0
+ * @note       written from the datasheet frame layout and kept apart from the driver code on purpose:
+ *             the header, 4 big endian data bytes and the low byte of the sum of the first 5 bytes
+ */
+static uint8_t a_fuzz_reference_decode(const uint8_t *frame, uint8_t *type, uint32_t *data)
+{
+    uint32_t i;
+    uint32_t sum;
+    uint32_t value;
+    
+    sum = 0;
+    value = 0;
+    for (i = 0; i < 5; i++)
+    {
+        sum += frame[i];
+    }
+    for (i = 1; i < 5; i++)
+    {
+        value = value * 256U + frame[i];
+    }
+    *type = frame[0];
+    *data = value;
+    
+    return (uint8_t)(((sum % 256U) == frame[5]) && ((frame[0] == 0xAA) || (frame[0] == 0xAC)));
+}
+
+/**
+ * @brief     async read callback
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] res result
+ * @param[in] conductivity_raw conductivity raw data
+ * @param[in] conductivity_us_cm conductivity uS/cm data
+ * @param[in] temperature_raw temperature raw data
+ * @param[in] temperature converted temperature data
+ * @param[in] *user pointer to a fuzz_async_t result
+ * @note      none
+ */
+static void a_fuzz_read_callback(ba121_handle_t *handle, uint8_t res,
+                                 uint16_t conductivity_raw, uint16_t conductivity_us_cm,
+                                 uint16_t temperature_raw, float temperature, void *user)
+{
+    fuzz_async_t *result = (fuzz_async_t *)user;
+    
+    (void)handle;
+    (void)conductivity_us_cm;
+    (void)temperature;
+    result->done++;
+    result->res = res;
+    result->conductivity_raw = conductivity_raw;
+    result->temperature_raw = temperature_raw;
+}
+
+/**
+ * @brief     run a blocking command against one scripted reply
+ * @param[in] op fuzz operation
+ * @param[in] param command param
+ * @param[in] *reply pointer to the reply bytes
+ * @param[in] len reply length
+ * @note      none
+ */
+static void a_fuzz_blocking(uint8_t op, uint32_t param, const uint8_t *reply, uint16_t len)
+{
+    uint8_t res;
+    uint8_t expect;
+    uint8_t type;
+    uint8_t valid;
+    uint8_t command;
+    uint8_t expect_command;
+    uint16_t conductivity_raw;
+    uint16_t conductivity_us_cm;
+    uint16_t temperature_raw;
+    uint32_t data;
+    uint32_t sent;
+    uint32_t expect_param;
+    float temperature;
+    ba121_status_t status;
+    
+    if (len > BA121_MOCK_FRAME_MAX_LEN)
+    {
+        len = BA121_MOCK_FRAME_MAX_LEN;
+    }
+    (void)ba121_mock_script_reply(reply, len);
+    valid = (len >= 6) ? a_fuzz_reference_decode(reply, &type, &data) : 0;
+    if (op == BA121_FUZZ_OP_READ)
+    {
+        res = ba121_read(&gs_handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+        expect = (len < 6) ? 1 : (((valid != 0) && (type == 0xAA)) ? 0 : 4);
+        a_fuzz_check(res == expect, "read result");
+        if (res == 0)
+        {
+            a_fuzz_check(conductivity_raw == (data >> 16), "conductivity");
+            a_fuzz_check(temperature_raw == (data & 0xFFFFU), "temperature");
+            a_fuzz_check(temperature == (float)temperature_raw / 100.0f, "converted temperature");
+        }
+        expect_command = 0xA0;
+        expect_param = 0;
+    }
+    else
+    {
+        if (op == BA121_FUZZ_OP_BASELINE)
+        {
+            res = ba121_baseline_calibration(&gs_handle);
+            expect_command = 0xA6;
+            expect_param = 0;
+        }
+        else if (op == BA121_FUZZ_OP_NTC_RESISTANCE)
+        {
+            res = ba121_set_ntc_resistance(&gs_handle, param);
+            expect_command = 0xA3;
+            expect_param = param;
+        }
+        else
+        {
+            res = ba121_set_ntc_b(&gs_handle, (uint16_t)param);
+            expect_command = 0xA5;
+            expect_param = (param & 0xFFFFU) * 65536U;
+        }
+        expect = (len < 6) ? 1 : (((valid != 0) && (type == 0xAC)) ? ((reply[1] == 0) ? 0 : 5) : 4);
+        a_fuzz_check(res == expect, "ack result");
+        if ((res == 0) || (res == 5))
+        {
+            (void)ba121_get_last_status(&gs_handle, &status);
+            a_fuzz_check((uint8_t)status == reply[1], "ack status");
+        }
+    }
+    sent = ba121_mock_get_last_command(&command, &data);
+    a_fuzz_check((sent == 1) && (command == expect_command) && (data == expect_param), "command frame");
+}
+
+/**
+ * @brief     run an async read against a raw byte stream
+ * @param[in] *stream pointer to the stream bytes
+ * @param[in] len stream length
+ * @note      the driver has to find the first valid data frame wherever it sits in the stream
+ */
+static void a_fuzz_stream(const uint8_t *stream, uint16_t len)
+{
+    uint8_t type;
+    uint8_t found;
+    uint16_t i;
+    uint32_t data;
+    uint32_t value;
+    uint32_t timeout_ms;
+    fuzz_async_t result;
+    
+    if (len > FUZZ_STREAM_MAX_LEN)
+    {
+        len = FUZZ_STREAM_MAX_LEN;
+    }
+    
+    /* reference: skip a byte on garbage, a whole frame on a valid one, stop at the first data frame */
+    found = 0;
+    value = 0;
+    i = 0;
+    while ((found == 0) && (i + 6 <= len))
+    {
+        if (a_fuzz_reference_decode(&stream[i], &type, &data) == 0)
+        {
+            i++;
+            
+            continue;
+        }
+        if (type == 0xAA)
+        {
+            found = 1;
+            value = data;
+        }
+        i = (uint16_t)(i + 6);
+    }
+    
+    /* driver, the simulated reply is scripted away so only the stream arrives */
+    result.done = 0;
+    (void)ba121_mock_script_reply(NULL, 0);
+    a_fuzz_check(ba121_async_read(&gs_handle, a_fuzz_read_callback, &result) == 0, "async read submit");
+    (void)ba121_async_timeout(&gs_handle, ba121_mock_get_time_ms());
+    (void)ba121_mock_inject(stream, len);
+    for (i = 0; (i < 64) && (result.done == 0) && (ba121_mock_get_readable() != 0); i++)
+    {
+        (void)ba121_async_readable(&gs_handle, ba121_mock_get_time_ms());
+    }
+    for (i = 0; (i < 64) && (result.done == 0); i++)
+    {
+        (void)ba121_async_get_timeout(&gs_handle, ba121_mock_get_time_ms(), &timeout_ms);
+        ba121_mock_advance_ms(timeout_ms);
+        (void)ba121_async_timeout(&gs_handle, ba121_mock_get_time_ms());
+    }
+    a_fuzz_check(result.done == 1, "async read completion");
+    a_fuzz_check(result.res == ((found != 0) ? 0 : 1), "async read result");
+    if (found != 0)
+    {
+        a_fuzz_check(result.conductivity_raw == (value >> 16), "async conductivity");
+        a_fuzz_check(result.temperature_raw == (value & 0xFFFFU), "async temperature");
+    }
+}
+
+/**
+ * @brief     run one fuzz input
+ * @param[in] *data pointer to the input
+ * @param[in] size input size
+ * @return    0 always, a mismatch with the reference decoder aborts
+ * @note      byte 0 selects the operation, bytes 1 - 4 are the big endian command param,
+ *            the rest is what the sensor sends back
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    uint8_t op;
+    uint32_t param;
+    uint16_t len;
+    
+    if (size < 5)
+    {
+        return 0;
+    }
+    op = (uint8_t)(data[0] % BA121_FUZZ_OP_NUM);
+    param = ((uint32_t)data[1] << 24) | ((uint32_t)data[2] << 16) |
+            ((uint32_t)data[3] << 8) | ((uint32_t)data[4] << 0);
+    len = (size - 5 > 0xFFFF) ? 0xFFFF : (uint16_t)(size - 5);
+    
+    /* link interface function */
+    ba121_mock_reset();
+    DRIVER_BA121_LINK_INIT(&gs_handle, ba121_handle_t);
+    DRIVER_BA121_LINK_UART_INIT(&gs_handle, ba121_interface_uart_init);
+    DRIVER_BA121_LINK_UART_DEINIT(&gs_handle, ba121_interface_uart_deinit);
+    DRIVER_BA121_LINK_UART_READ(&gs_handle, ba121_interface_uart_read);
+    DRIVER_BA121_LINK_UART_FLUSH(&gs_handle, ba121_interface_uart_flush);
+    DRIVER_BA121_LINK_UART_WRITE(&gs_handle, ba121_interface_uart_write);
+    DRIVER_BA121_LINK_DELAY_MS(&gs_handle, ba121_interface_delay_ms);
+    DRIVER_BA121_LINK_DEBUG_PRINT(&gs_handle, ba121_interface_debug_print);
+    DRIVER_BA121_LINK_TIMESTAMP_US(&gs_handle, ba121_interface_timestamp_us);
+    a_fuzz_check(ba121_init(&gs_handle) == 0, "init");
+    
+    if (op == BA121_FUZZ_OP_STREAM)
+    {
+        a_fuzz_stream(&data[5], len);
+    }
+    else
+    {
+        a_fuzz_blocking(op, param, &data[5], len);
+    }
+    (void)ba121_deinit(&gs_handle);
+    
+    return 0;
+}
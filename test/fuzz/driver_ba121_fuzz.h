@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_fuzz.h
+ * @brief     driver ba121 fuzz header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_FUZZ_H
+#define DRIVER_BA121_FUZZ_H
+
+#include "driver_ba121_interface_mock.h"
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_fuzz_driver ba121 fuzz driver function
+ * @brief    ba121 fuzz driver modules
+ * @ingroup  ba121_test_driver
+ * @{
+ */
+
+/**
+ * @brief fuzz operation definition
+ */
+#define BA121_FUZZ_OP_READ              0        /**< blocking read */
+#define BA121_FUZZ_OP_BASELINE          1        /**< baseline calibration */
+#define BA121_FUZZ_OP_NTC_RESISTANCE    2        /**< set ntc resistance */
+#define BA121_FUZZ_OP_NTC_B             3        /**< set ntc b */
+#define BA121_FUZZ_OP_STREAM            4        /**< async read of a byte stream */
+#define BA121_FUZZ_OP_NUM               5        /**< operation count */
+
+/**
+ * @brief     run one fuzz input
+ * @param[in] *data pointer to the input
+ * @param[in] size input size
+ * @return    0 always, a mismatch with the reference decoder aborts
+ * @note      byte 0 selects the operation, bytes 1 - 4 are the big endian command param,
+ *            the rest is what the sensor sends back
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,212 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_fuzz.h"
+#include "driver_ba121_test_common.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief fuzz input max length definition
+ */
+#define FUZZ_INPUT_MAX_LEN 256        /**< 256 bytes */
+
+/**
+ * @brief seed input structure definition
+ */
+typedef struct fuzz_seed_s
+{
+    uint8_t len;                  /**< input length */
+    uint8_t buf[32];              /**< input bytes */
+} fuzz_seed_t;
+
+/**
+ * @brief built-in seeds, the same inputs as the corpus directory
+ */
+static const fuzz_seed_t gsc_seed[] =
+{
+    {11, {0x00, 0x00, 0x00, 0x00, 0x00, 0xAA, 0x04, 0xD2, 0x09, 0xC4, 0x4D}},
+    {11, {0x01, 0x00, 0x00, 0x00, 0x00, 0xAC, 0x00, 0x00, 0x00, 0x00, 0xAC}},
+    {11, {0x02, 0x00, 0x00, 0x27, 0x10, 0xAC, 0x00, 0x00, 0x00, 0x00, 0xAC}},
+    {11, {0x03, 0x00, 0x00, 0x0D, 0x6B, 0xAC, 0x02, 0x00, 0x00, 0x00, 0xAE}},
+    {11, {0x03, 0x00, 0x00, 0x0D, 0x6B, 0xAC, 0x00, 0x01, 0x00, 0x00, 0xAD}},
+    {24, {0x04, 0x00, 0x00, 0x00, 0x00, 0x55, 0xAA, 0x01, 0xAC, 0x00, 0x00, 0x00, 0x00,
+          0xAC, 0xAA, 0x04, 0xD2, 0x09, 0xC4, 0x4D, 0xAA, 0x00, 0x00, 0x00}},
+};
+
+static uint32_t gs_seed;        /**< random state */
+
+/**
+ * @brief         mutate one input
+ * @param[in,out] *buf pointer to an input buffer
+ * @param[in]     len input length
+ * @return        new input length
+ * @note          bit flips, random bytes, inserted valid-looking headers, truncation and growth
+ */
+static size_t a_fuzz_mutate(uint8_t *buf, size_t len)
+{
+    uint32_t i;
+    uint32_t n;
+    uint32_t pos;
+    
+    n = 1 + ba121_test_random(&gs_seed) % 4;
+    for (i = 0; i < n; i++)
+    {
+        pos = ba121_test_random(&gs_seed) % (uint32_t)len;
+        switch (ba121_test_random(&gs_seed) % 6)
+        {
+            case 0 :
+            {
+                buf[pos] ^= (uint8_t)(1U << (ba121_test_random(&gs_seed) % 8));
+                
+                break;
+            }
+            case 1 :
+            {
+                buf[pos] = (uint8_t)ba121_test_random(&gs_seed);
+                
+                break;
+            }
+            case 2 :
+            {
+                buf[pos] = ((ba121_test_random(&gs_seed) & 1) != 0) ? 0xAA : 0xAC;
+                
+                break;
+            }
+            case 3 :
+            {
+                len = (len > 12) ? len - 1 - ba121_test_random(&gs_seed) % 6 : len;
+                
+                break;
+            }
+            case 4 :
+            {
+                if ((len >= 6) && (len + 6 <= FUZZ_INPUT_MAX_LEN))
+                {
+                    memcpy(&buf[len], &buf[len - 6], 6);
+                    len += 6;
+                }
+                
+                break;
+            }
+            default :
+            {
+                if (len < FUZZ_INPUT_MAX_LEN)
+                {
+                    buf[len++] = (uint8_t)ba121_test_random(&gs_seed);
+                }
+                
+                break;
+            }
+        }
+    }
+    
+    return len;
+}
+
+/**
+ * @brief     replay one input file
+ * @param[in] *name pointer to a file name
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      none
+ */
+static uint8_t a_fuzz_replay(const char *name)
+{
+    FILE *fp;
+    size_t len;
+    uint8_t buf[4096];
+    
+    fp = fopen(name, "rb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "ba121: open %s failed.\n", name);
+        
+        return 1;
+    }
+    len = fread(buf, 1, sizeof(buf), fp);
+    (void)fclose(fp);
+    (void)LLVMFuzzerTestOneInput(buf, len);
+    
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      usage: ba121_fuzz [file ...] replays inputs, for crash reproduction and afl-fuzz @@,
+ *            ba121_fuzz -r [times] [seed] runs the built-in mutator, the default without arguments
+ */
+int main(int argc, char **argv)
+{
+    int i;
+    size_t len;
+    uint32_t n;
+    uint32_t times;
+    uint8_t buf[FUZZ_INPUT_MAX_LEN];
+    
+    if ((argc > 1) && (strcmp(argv[1], "-r") != 0))
+    {
+        for (i = 1; i < argc; i++)
+        {
+            if (a_fuzz_replay(argv[i]) != 0)
+            {
+                return 1;
+            }
+        }
+        printf("ba121: %d inputs replayed.\n", argc - 1);
+        
+        return 0;
+    }
+    times = ba121_test_arg(argc, argv, 2, 200000);
+    gs_seed = ba121_test_seed(ba121_test_arg(argc, argv, 3, 0x9E3779B9U));
+    for (n = 0; n < times; n++)
+    {
+        const fuzz_seed_t *seed = &gsc_seed[ba121_test_random(&gs_seed) % (sizeof(gsc_seed) / sizeof(gsc_seed[0]))];
+        
+        memcpy(buf, seed->buf, seed->len);
+        len = ((n % 8) == 0) ? seed->len : a_fuzz_mutate(buf, seed->len);
+        (void)LLVMFuzzerTestOneInput(buf, len);
+    }
+    printf("ba121: %u fuzz inputs passed.\n", (unsigned int)times);
+    
+    return 0;
+}
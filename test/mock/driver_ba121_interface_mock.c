@@ -0,0 +1,725 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_interface_mock.c
+ * @brief     driver ba121 interface mock source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_interface_mock.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief mock reply structure definition
+ */
+typedef struct mock_reply_s
+{
+    uint8_t buf[BA121_MOCK_FRAME_MAX_LEN];        /**< reply bytes */
+    uint16_t len;                                 /**< reply length */
+    uint16_t pos;                                 /**< read position */
+    uint64_t due_us;                              /**< arrival time */
+} mock_reply_t;
+
+static uint64_t gs_now_us;                                             /**< virtual clock */
+static uint8_t gs_verbose;                                             /**< debug output flag */
+static uint8_t gs_opened;                                              /**< uart open flag */
+static uint16_t gs_conductivity_raw;                                   /**< simulated conductivity */
+static uint16_t gs_temperature_raw;                                    /**< simulated temperature */
+static uint8_t gs_ack_status;                                          /**< simulated ack status */
+static uint32_t gs_latency_ms;                                         /**< simulated reply latency */
+static uint32_t gs_ntc_resistance;                                     /**< simulated ntc resistance */
+static uint16_t gs_ntc_b;                                              /**< simulated ntc b */
+static uint32_t gs_baseline_count;                                     /**< baseline calibration count */
+static uint8_t gs_cmd_buf[6];                                          /**< command assembly buffer */
+static uint8_t gs_cmd_len;                                             /**< command assembly length */
+static uint8_t gs_last_command;                                        /**< last command */
+static uint32_t gs_last_param;                                         /**< last param */
+static uint32_t gs_command_count;                                      /**< command count */
+static uint8_t gs_write_fail;                                          /**< failing writes */
+static uint8_t gs_flush_fail;                                          /**< failing flushes */
+static mock_reply_t gs_reply[BA121_MOCK_REPLY_DEPTH];                  /**< pending replies */
+static uint8_t gs_reply_head;                                          /**< pending reply head */
+static uint8_t gs_reply_count;                                         /**< pending reply count */
+static uint8_t gs_script_buf[BA121_MOCK_SCRIPT_DEPTH][BA121_MOCK_FRAME_MAX_LEN];        /**< scripted replies */
+static uint16_t gs_script_len[BA121_MOCK_SCRIPT_DEPTH];                /**< scripted reply lengths */
+static uint8_t gs_script_head;                                         /**< script head */
+static uint8_t gs_script_count;                                        /**< script count */
+static pthread_mutex_t gs_os_mutex = PTHREAD_MUTEX_INITIALIZER;         /**< driver mutex */
+static pthread_mutex_t gs_sem_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< semaphore mutex */
+static pthread_cond_t gs_sem_cond;                                     /**< semaphore condition */
+static pthread_once_t gs_sem_once = PTHREAD_ONCE_INIT;                 /**< semaphore init flag */
+static uint32_t gs_sem_count;                                          /**< semaphore count */
+
+/**
+ * @brief     queue a reply
+ * @param[in] *buf pointer to a reply buffer
+ * @param[in] len reply length
+ * @note      the oldest reply is dropped when all slots are used, like an overrun uart fifo
+ */
+static void a_mock_push_reply(const uint8_t *buf, uint16_t len)
+{
+    mock_reply_t *reply;
+    
+    if (len == 0)                                                                     /* lost reply */
+    {
+        return;                                                                       /* return */
+    }
+    if (gs_reply_count == BA121_MOCK_REPLY_DEPTH)                                     /* check full */
+    {
+        gs_reply_head = (uint8_t)((gs_reply_head + 1) % BA121_MOCK_REPLY_DEPTH);      /* drop oldest */
+        gs_reply_count--;                                                             /* one less */
+    }
+    reply = &gs_reply[(gs_reply_head + gs_reply_count) % BA121_MOCK_REPLY_DEPTH];     /* tail slot */
+    memcpy(reply->buf, buf, len);                                                     /* copy reply */
+    reply->len = len;                                                                 /* set length */
+    reply->pos = 0;                                                                   /* init 0 */
+    reply->due_us = gs_now_us + (uint64_t)gs_latency_ms * 1000;                       /* arrival time */
+    gs_reply_count++;                                                                 /* one more */
+}
+
+/**
+ * @brief     make a reply frame
+ * @param[in] type reply type
+ * @param[in] data reply data
+ * @note      none
+ */
+static void a_mock_reply(uint8_t type, uint32_t data)
+{
+    uint8_t i;
+    uint8_t frame[6];
+    
+    frame[0] = type;                                                                  /* set type */
+    frame[1] = (data >> 24) & 0xFF;                                                   /* set data */
+    frame[2] = (data >> 16) & 0xFF;                                                   /* set data */
+    frame[3] = (data >> 8) & 0xFF;                                                    /* set data */
+    frame[4] = (data >> 0) & 0xFF;                                                    /* set data */
+    frame[5] = 0;                                                                     /* init 0 */
+    for (i = 0; i < 5; i++)                                                           /* add all */
+    {
+        frame[5] = (uint8_t)(frame[5] + frame[i]);                                    /* sum */
+    }
+    a_mock_push_reply(frame, 6);                                                      /* queue reply */
+}
+
+/**
+ * @brief let the simulated sensor handle one complete command
+ * @note  a frame with a bad checksum or an unknown command gets no reply
+ */
+static void a_mock_execute(void)
+{
+    uint8_t i;
+    uint8_t sum;
+    uint32_t param;
+    
+    sum = 0;                                                                          /* init 0 */
+    for (i = 0; i < 5; i++)                                                           /* add all */
+    {
+        sum = (uint8_t)(sum + gs_cmd_buf[i]);                                         /* sum */
+    }
+    param = ((uint32_t)gs_cmd_buf[1] << 24) | ((uint32_t)gs_cmd_buf[2] << 16) |
+            ((uint32_t)gs_cmd_buf[3] << 8) | ((uint32_t)gs_cmd_buf[4] << 0);          /* get param */
+    gs_last_command = gs_cmd_buf[0];                                                  /* save command */
+    gs_last_param = param;                                                            /* save param */
+    gs_command_count++;                                                               /* count command */
+    if (gs_script_count != 0)                                                         /* scripted reply */
+    {
+        a_mock_push_reply(gs_script_buf[gs_script_head], gs_script_len[gs_script_head]);        /* queue it */
+        gs_script_head = (uint8_t)((gs_script_head + 1) % BA121_MOCK_SCRIPT_DEPTH);   /* next */
+        gs_script_count--;                                                            /* one less */
+        
+        return;                                                                       /* return */
+    }
+    if (sum != gs_cmd_buf[5])                                                         /* check sum */
+    {
+        return;                                                                       /* ignore */
+    }
+    switch (gs_cmd_buf[0])
+    {
+        case 0xA0 :                                                                   /* read */
+        {
+            a_mock_reply(0xAA, ((uint32_t)gs_conductivity_raw << 16) | gs_temperature_raw);
+            
+            break;
+        }
+        case 0xA3 :                                                                   /* ntc resistance */
+        {
+            if (gs_ack_status == 0)                                                   /* check status */
+            {
+                gs_ntc_resistance = param;                                            /* save setting */
+            }
+            a_mock_reply(0xAC, (uint32_t)gs_ack_status << 24);                        /* ack */
+            
+            break;
+        }
+        case 0xA5 :                                                                   /* ntc b */
+        {
+            if (gs_ack_status == 0)                                                   /* check status */
+            {
+                gs_ntc_b = (uint16_t)(param >> 16);                                   /* save setting */
+            }
+            a_mock_reply(0xAC, (uint32_t)gs_ack_status << 24);                        /* ack */
+            
+            break;
+        }
+        case 0xA6 :                                                                   /* baseline */
+        {
+            if (gs_ack_status == 0)                                                   /* check status */
+            {
+                gs_baseline_count++;                                                  /* count calibration */
+            }
+            a_mock_reply(0xAC, (uint32_t)gs_ack_status << 24);                        /* ack */
+            
+            break;
+        }
+        default :
+        {
+            break;                                                                    /* ignore */
+        }
+    }
+}
+
+/**
+ * @brief mock reset
+ * @note  the virtual clock restarts at 0, the script is emptied and the sensor gets default values
+ */
+void ba121_mock_reset(void)
+{
+    gs_now_us = 0;
+    gs_verbose = 0;
+    gs_opened = 0;
+    gs_conductivity_raw = 1000;
+    gs_temperature_raw = 2500;
+    gs_ack_status = 0;
+    gs_latency_ms = 10;
+    gs_ntc_resistance = 0;
+    gs_ntc_b = 0;
+    gs_baseline_count = 0;
+    gs_cmd_len = 0;
+    gs_last_command = 0;
+    gs_last_param = 0;
+    gs_command_count = 0;
+    gs_write_fail = 0;
+    gs_flush_fail = 0;
+    gs_reply_head = 0;
+    gs_reply_count = 0;
+    gs_script_head = 0;
+    gs_script_count = 0;
+}
+
+/**
+ * @brief     set the debug output
+ * @param[in] enable bool value
+ * @note      the output is disabled after a reset
+ */
+void ba121_mock_set_verbose(uint8_t enable)
+{
+    gs_verbose = enable;
+}
+
+/**
+ * @brief     set the sample the simulated sensor returns
+ * @param[in] conductivity_raw conductivity raw data
+ * @param[in] temperature_raw temperature raw data
+ * @note      none
+ */
+void ba121_mock_set_sample(uint16_t conductivity_raw, uint16_t temperature_raw)
+{
+    gs_conductivity_raw = conductivity_raw;
+    gs_temperature_raw = temperature_raw;
+}
+
+/**
+ * @brief     set the status the simulated sensor acks with
+ * @param[in] status ack status, 0 means ok
+ * @note      none
+ */
+void ba121_mock_set_ack_status(uint8_t status)
+{
+    gs_ack_status = status;
+}
+
+/**
+ * @brief     set the reply latency of the simulated sensor
+ * @param[in] ms latency in ms
+ * @note      the reply becomes readable when the virtual clock passes the write time plus the latency
+ */
+void ba121_mock_set_latency(uint32_t ms)
+{
+    gs_latency_ms = ms;
+}
+
+/**
+ * @brief     script the reply to the next written command
+ * @param[in] *buf pointer to a reply buffer
+ * @param[in] len reply length
+ * @return    status code
+ *            - 0 success
+ *            - 1 script is full or len is too long
+ * @note      scripted replies are used in order and replace the simulated reply,
+ *            len 0 scripts a lost reply
+ */
+uint8_t ba121_mock_script_reply(const uint8_t *buf, uint16_t len)
+{
+    uint8_t index;
+    
+    if ((gs_script_count == BA121_MOCK_SCRIPT_DEPTH) || (len > BA121_MOCK_FRAME_MAX_LEN))
+    {
+        return 1;
+    }
+    index = (uint8_t)((gs_script_head + gs_script_count) % BA121_MOCK_SCRIPT_DEPTH);
+    if (len != 0)
+    {
+        memcpy(gs_script_buf[index], buf, len);
+    }
+    gs_script_len[index] = len;
+    gs_script_count++;
+    
+    return 0;
+}
+
+/**
+ * @brief     inject raw bytes into the uart receive stream
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 stream is full
+ * @note      the bytes arrive at the current virtual time, in order after the pending replies
+ */
+uint8_t ba121_mock_inject(const uint8_t *buf, uint16_t len)
+{
+    uint16_t chunk;
+    uint32_t latency_ms;
+    
+    if ((uint32_t)(BA121_MOCK_REPLY_DEPTH - gs_reply_count) * BA121_MOCK_FRAME_MAX_LEN < len)
+    {
+        return 1;
+    }
+    latency_ms = gs_latency_ms;
+    gs_latency_ms = 0;
+    while (len != 0)
+    {
+        chunk = (len > BA121_MOCK_FRAME_MAX_LEN) ? BA121_MOCK_FRAME_MAX_LEN : len;
+        a_mock_push_reply(buf, chunk);
+        buf += chunk;
+        len = (uint16_t)(len - chunk);
+    }
+    gs_latency_ms = latency_ms;
+    
+    return 0;
+}
+
+/**
+ * @brief     script a link failure
+ * @param[in] write_fail number of next writes that fail
+ * @param[in] flush_fail number of next flushes that fail
+ * @note      none
+ */
+void ba121_mock_script_link_error(uint8_t write_fail, uint8_t flush_fail)
+{
+    gs_write_fail = write_fail;
+    gs_flush_fail = flush_fail;
+}
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] ms time in ms
+ * @note      none
+ */
+void ba121_mock_advance_ms(uint32_t ms)
+{
+    gs_now_us += (uint64_t)ms * 1000;
+}
+
+/**
+ * @brief  get the virtual clock
+ * @return time in ms
+ * @note   none
+ */
+uint32_t ba121_mock_get_time_ms(void)
+{
+    return (uint32_t)(gs_now_us / 1000);
+}
+
+/**
+ * @brief  get the readable byte count
+ * @return byte count that is due at the current virtual time
+ * @note   use it as the poll result of an async loop
+ */
+uint16_t ba121_mock_get_readable(void)
+{
+    uint8_t i;
+    uint16_t count;
+    mock_reply_t *reply;
+    
+    count = 0;
+    for (i = 0; i < gs_reply_count; i++)
+    {
+        reply = &gs_reply[(gs_reply_head + i) % BA121_MOCK_REPLY_DEPTH];
+        if (reply->due_us > gs_now_us)
+        {
+            break;
+        }
+        count = (uint16_t)(count + reply->len - reply->pos);
+    }
+    
+    return count;
+}
+
+/**
+ * @brief      get the last command seen by the simulated sensor
+ * @param[out] *command pointer to a command buffer
+ * @param[out] *param pointer to a param buffer
+ * @return     number of written commands since the reset
+ * @note       none
+ */
+uint32_t ba121_mock_get_last_command(uint8_t *command, uint32_t *param)
+{
+    *command = gs_last_command;
+    *param = gs_last_param;
+    
+    return gs_command_count;
+}
+
+/**
+ * @brief      get the simulated sensor settings
+ * @param[out] *ntc_resistance pointer to a ntc resistance buffer
+ * @param[out] *ntc_b pointer to a ntc b buffer
+ * @param[out] *baseline_count pointer to a baseline calibration count buffer
+ * @note       none
+ */
+void ba121_mock_get_settings(uint32_t *ntc_resistance, uint16_t *ntc_b, uint32_t *baseline_count)
+{
+    *ntc_resistance = gs_ntc_resistance;
+    *ntc_b = gs_ntc_b;
+    *baseline_count = gs_baseline_count;
+}
+
+/**
+ * @brief  interface uart init
+ * @return status code
+ *         - 0 success
+ *         - 1 uart init failed
+ * @note   none
+ */
+uint8_t ba121_interface_uart_init(void)
+{
+    gs_opened = 1;
+    gs_cmd_len = 0;
+    gs_reply_count = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  interface uart deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 uart deinit failed
+ * @note   none
+ */
+uint8_t ba121_interface_uart_deinit(void)
+{
+    gs_opened = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      interface uart read
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       only the bytes that arrived by the virtual clock are returned, it never waits
+ */
+uint16_t ba121_interface_uart_read(uint8_t *buf, uint16_t len)
+{
+    uint16_t n;
+    uint16_t chunk;
+    mock_reply_t *reply;
+    
+    n = 0;
+    while ((gs_opened != 0) && (gs_reply_count != 0) && (n < len))
+    {
+        reply = &gs_reply[gs_reply_head];
+        if (reply->due_us > gs_now_us)
+        {
+            break;
+        }
+        chunk = (uint16_t)(reply->len - reply->pos);
+        if (chunk > (uint16_t)(len - n))
+        {
+            chunk = (uint16_t)(len - n);
+        }
+        memcpy(&buf[n], &reply->buf[reply->pos], chunk);
+        reply->pos = (uint16_t)(reply->pos + chunk);
+        n = (uint16_t)(n + chunk);
+        if (reply->pos == reply->len)
+        {
+            gs_reply_head = (uint8_t)((gs_reply_head + 1) % BA121_MOCK_REPLY_DEPTH);
+            gs_reply_count--;
+        }
+    }
+    
+    return n;
+}
+
+/**
+ * @brief  interface uart flush
+ * @return status code
+ *         - 0 success
+ *         - 1 uart flush failed
+ * @note   only the bytes that already arrived are dropped, a late reply still comes in after the flush
+ */
+uint8_t ba121_interface_uart_flush(void)
+{
+    if ((gs_opened == 0) || (gs_flush_fail != 0))
+    {
+        if (gs_flush_fail != 0)
+        {
+            gs_flush_fail--;
+        }
+        
+        return 1;
+    }
+    while ((gs_reply_count != 0) && (gs_reply[gs_reply_head].due_us <= gs_now_us))
+    {
+        gs_reply_head = (uint8_t)((gs_reply_head + 1) % BA121_MOCK_REPLY_DEPTH);
+        gs_reply_count--;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface uart write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart write failed
+ * @note      every complete 6 bytes command is handled by the simulated sensor
+ */
+uint8_t ba121_interface_uart_write(uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    if ((gs_opened == 0) || (gs_write_fail != 0))
+    {
+        if (gs_write_fail != 0)
+        {
+            gs_write_fail--;
+        }
+        
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        gs_cmd_buf[gs_cmd_len++] = buf[i];
+        if (gs_cmd_len == 6)
+        {
+            a_mock_execute();
+            gs_cmd_len = 0;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      the virtual clock moves forward at once
+ */
+void ba121_interface_delay_ms(uint32_t ms)
+{
+    gs_now_us += (uint64_t)ms * 1000;
+}
+
+/**
+ * @brief     interface wait reply
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the virtual clock jumps to the arrival of the reply byte number len, or to the timeout
+ */
+uint8_t ba121_interface_wait_reply(uint16_t len, uint32_t timeout_ms)
+{
+    uint8_t i;
+    uint32_t count;
+    uint64_t end_us;
+    mock_reply_t *reply;
+    
+    end_us = gs_now_us + (uint64_t)timeout_ms * 1000;
+    count = 0;
+    for (i = 0; (gs_opened != 0) && (i < gs_reply_count); i++)
+    {
+        reply = &gs_reply[(gs_reply_head + i) % BA121_MOCK_REPLY_DEPTH];
+        if (reply->due_us > end_us)
+        {
+            break;
+        }
+        count += (uint32_t)(reply->len - reply->pos);
+        if (count >= len)
+        {
+            if (reply->due_us > gs_now_us)
+            {
+                gs_now_us = reply->due_us;
+            }
+            
+            return 0;
+        }
+    }
+    gs_now_us = end_us;
+    
+    return 1;
+}
+
+/**
+ * @brief set up the semaphore condition
+ * @note  the condition waits on the monotonic clock
+ */
+static void a_os_sem_init(void)
+{
+    pthread_condattr_t attr;
+    
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&gs_sem_cond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief interface os lock
+ * @note  blocks until the driver mutex is held
+ */
+void ba121_interface_os_lock(void)
+{
+    (void)pthread_mutex_lock(&gs_os_mutex);
+}
+
+/**
+ * @brief interface os unlock
+ * @note  none
+ */
+void ba121_interface_os_unlock(void)
+{
+    (void)pthread_mutex_unlock(&gs_os_mutex);
+}
+
+/**
+ * @brief     interface os semaphore wait
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      a pthread counting semaphore on the real clock, not the virtual one
+ */
+uint8_t ba121_interface_os_sem_wait(uint32_t timeout_ms)
+{
+    struct timespec ts;
+    
+    (void)pthread_once(&gs_sem_once, a_os_sem_init);
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += (time_t)(timeout_ms / 1000);
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    (void)pthread_mutex_lock(&gs_sem_mutex);
+    while (gs_sem_count == 0)
+    {
+        if (pthread_cond_timedwait(&gs_sem_cond, &gs_sem_mutex, &ts) == ETIMEDOUT)
+        {
+            break;
+        }
+    }
+    if (gs_sem_count == 0)
+    {
+        (void)pthread_mutex_unlock(&gs_sem_mutex);
+        
+        return 1;
+    }
+    gs_sem_count--;
+    (void)pthread_mutex_unlock(&gs_sem_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief interface os semaphore give
+ * @note  none
+ */
+void ba121_interface_os_sem_give(void)
+{
+    (void)pthread_once(&gs_sem_once, a_os_sem_init);
+    (void)pthread_mutex_lock(&gs_sem_mutex);
+    gs_sem_count++;
+    (void)pthread_cond_signal(&gs_sem_cond);
+    (void)pthread_mutex_unlock(&gs_sem_mutex);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return monotonic time in us
+ * @note   the virtual clock
+ */
+uint64_t ba121_interface_timestamp_us(void)
+{
+    return gs_now_us;
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      the output is dropped unless the mock is verbose
+ */
+void ba121_interface_debug_print(const char *const fmt, ...)
+{
+    va_list args;
+    
+    if (gs_verbose == 0)
+    {
+        return;
+    }
+    va_start(args, fmt);
+    (void)vprintf(fmt, args);
+    va_end(args);
+}
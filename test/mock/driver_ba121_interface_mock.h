@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_interface_mock.h
+ * @brief     driver ba121 interface mock header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_BA121_INTERFACE_MOCK_H
+#define DRIVER_BA121_INTERFACE_MOCK_H
+
+#include "driver_ba121_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ba121_mock_driver ba121 mock driver function
+ * @brief    ba121 mock driver modules
+ * @ingroup  ba121_test_driver
+ * @{
+ */
+
+/**
+ * @brief mock script depth definition
+ */
+#ifndef BA121_MOCK_SCRIPT_DEPTH
+    #define BA121_MOCK_SCRIPT_DEPTH 8        /**< 8 scripted replies */
+#endif
+
+/**
+ * @brief mock frame max length definition
+ */
+#ifndef BA121_MOCK_FRAME_MAX_LEN
+    #define BA121_MOCK_FRAME_MAX_LEN 16        /**< 16 bytes */
+#endif
+
+/**
+ * @brief mock reply slot definition
+ */
+#ifndef BA121_MOCK_REPLY_DEPTH
+    #define BA121_MOCK_REPLY_DEPTH 8        /**< 8 pending replies */
+#endif
+
+/**
+ * @brief mock reset
+ * @note  the virtual clock restarts at 0, the script is emptied and the sensor gets default values
+ */
+void ba121_mock_reset(void);
+
+/**
+ * @brief     set the debug output
+ * @param[in] enable bool value
+ * @note      the output is disabled after a reset
+ */
+void ba121_mock_set_verbose(uint8_t enable);
+
+/**
+ * @brief     set the sample the simulated sensor returns
+ * @param[in] conductivity_raw conductivity raw data
+ * @param[in] temperature_raw temperature raw data
+ * @note      none
+ */
+void ba121_mock_set_sample(uint16_t conductivity_raw, uint16_t temperature_raw);
+
+/**
+ * @brief     set the status the simulated sensor acks with
+ * @param[in] status ack status, 0 means ok
+ * @note      none
+ */
+void ba121_mock_set_ack_status(uint8_t status);
+
+/**
+ * @brief     set the reply latency of the simulated sensor
+ * @param[in] ms latency in ms
+ * @note      the reply becomes readable when the virtual clock passes the write time plus the latency
+ */
+void ba121_mock_set_latency(uint32_t ms);
+
+/**
+ * @brief     script the reply to the next written command
+ * @param[in] *buf pointer to a reply buffer
+ * @param[in] len reply length
+ * @return    status code
+ *            - 0 success
+ *            - 1 script is full or len is too long
+ * @note      scripted replies are used in order and replace the simulated reply,
+ *            len 0 scripts a lost reply
+ */
+uint8_t ba121_mock_script_reply(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     inject raw bytes into the uart receive stream
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 stream is full
+ * @note      the bytes arrive at the current virtual time, in order after the pending replies
+ */
+uint8_t ba121_mock_inject(const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     script a link failure
+ * @param[in] write_fail number of next writes that fail
+ * @param[in] flush_fail number of next flushes that fail
+ * @note      none
+ */
+void ba121_mock_script_link_error(uint8_t write_fail, uint8_t flush_fail);
+
+/**
+ * @brief     advance the virtual clock
+ * @param[in] ms time in ms
+ * @note      none
+ */
+void ba121_mock_advance_ms(uint32_t ms);
+
+/**
+ * @brief  get the virtual clock
+ * @return time in ms
+ * @note   none
+ */
+uint32_t ba121_mock_get_time_ms(void);
+
+/**
+ * @brief  get the readable byte count
+ * @return byte count that is due at the current virtual time
+ * @note   use it as the poll result of an async loop
+ */
+uint16_t ba121_mock_get_readable(void);
+
+/**
+ * @brief      get the last command seen by the simulated sensor
+ * @param[out] *command pointer to a command buffer
+ * @param[out] *param pointer to a param buffer
+ * @return     number of written commands since the reset
+ * @note       none
+ */
+uint32_t ba121_mock_get_last_command(uint8_t *command, uint32_t *param);
+
+/**
+ * @brief      get the simulated sensor settings
+ * @param[out] *ntc_resistance pointer to a ntc resistance buffer
+ * @param[out] *ntc_b pointer to a ntc b buffer
+ * @param[out] *baseline_count pointer to a baseline calibration count buffer
+ * @note       none
+ */
+void ba121_mock_get_settings(uint32_t *ntc_resistance, uint16_t *ntc_b, uint32_t *baseline_count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,485 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_mock_test.c
+ * @brief     driver ba121 mock test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_mock_test.h"
+#include "driver_ba121_register_test.h"
+#include "driver_ba121_read_test.h"
+#include "driver_ba121_test_common.h"
+
+/**
+ * @brief read reply delay definition
+ * @note  must match the driver read delay
+ */
+#define MOCK_READ_DELAY_MS 800        /**< 800ms */
+
+/**
+ * @brief mock wait hook definition
+ * @note  a static build links the wait hook for every read or for none
+ */
+#if (BA121_STATIC_LINK == 1)
+    #define MOCK_WAIT_ALWAYS    BA121_STATIC_WAIT_REPLY                                    /**< wait on every read */
+    #define MOCK_WAIT_TEST      ((BA121_STATIC_WAIT_REPLY == 1) && (BA121_STATIC_TIMESTAMP == 1))   /**< run the wait test */
+#else
+    #define MOCK_WAIT_ALWAYS    0                                                          /**< linked by the wait test */
+    #define MOCK_WAIT_TEST      1                                                          /**< run the wait test */
+#endif
+
+static ba121_handle_t gs_handle;        /**< ba121 handle */
+static uint32_t gs_seed;                /**< random state */
+
+/**
+ * @brief async read context structure definition
+ */
+typedef struct mock_async_s
+{
+    uint8_t done;                     /**< done flag */
+    uint8_t res;                      /**< result */
+    uint16_t conductivity_raw;        /**< conductivity raw data */
+    uint16_t temperature_raw;         /**< temperature raw data */
+} mock_async_t;
+
+#if (BA121_QUEUE_ENABLE == 1)
+
+/**
+ * @brief     async read callback
+ * @param[in] *handle pointer to a ba121 handle structure
+ * @param[in] res result
+ * @param[in] conductivity_raw conductivity raw data
+ * @param[in] conductivity_us_cm conductivity uS/cm data
+ * @param[in] temperature_raw temperature raw data
+ * @param[in] temperature converted temperature data
+ * @param[in] *user pointer to a mock_async_t context
+ * @note      none
+ */
+static void a_mock_async_read_callback(ba121_handle_t *handle, uint8_t res,
+                                       uint16_t conductivity_raw, uint16_t conductivity_us_cm,
+                                       uint16_t temperature_raw, float temperature, void *user)
+{
+    mock_async_t *ctx = (mock_async_t *)user;
+    
+    (void)handle;
+    (void)conductivity_us_cm;
+    (void)temperature;
+    ctx->done = 1;
+    ctx->res = res;
+    ctx->conductivity_raw = conductivity_raw;
+    ctx->temperature_raw = temperature_raw;
+}
+
+#endif
+
+/**
+ * @brief     run one async read like an event loop would
+ * @param[in] *ctx pointer to a mock_async_t context
+ * @return    status code
+ *            - 0 success
+ *            - 1 the read never completed
+ * @note      the virtual clock moves in 5ms steps, the uart is polled between the steps,
+ *            without the queue the read runs blocking
+ */
+static uint8_t a_mock_async_read(mock_async_t *ctx)
+{
+#if (BA121_QUEUE_ENABLE == 1)
+    uint32_t i;
+    uint32_t timeout_ms;
+    
+    ctx->done = 0;
+    if (ba121_async_read(&gs_handle, a_mock_async_read_callback, ctx) != 0)
+    {
+        return 1;
+    }
+    for (i = 0; (i < 10000) && (ctx->done == 0); i++)
+    {
+        if (ba121_mock_get_readable() != 0)
+        {
+            (void)ba121_async_readable(&gs_handle, ba121_mock_get_time_ms());
+            
+            continue;
+        }
+        (void)ba121_async_get_timeout(&gs_handle, ba121_mock_get_time_ms(), &timeout_ms);
+        if (timeout_ms == 0)
+        {
+            (void)ba121_async_timeout(&gs_handle, ba121_mock_get_time_ms());
+            
+            continue;
+        }
+        ba121_mock_advance_ms((timeout_ms < 5) ? timeout_ms : 5);
+    }
+    
+    return (ctx->done != 0) ? 0 : 1;
+#else
+    uint16_t conductivity_us_cm;
+    float temperature;
+    
+    ctx->res = ba121_read(&gs_handle, &ctx->conductivity_raw, &conductivity_us_cm,
+                          &ctx->temperature_raw, &temperature);
+    ctx->done = 1;
+    
+    return 0;
+#endif
+}
+
+/**
+ * @brief     run one random transaction
+ * @param[in] op transaction type
+ * @return    status code
+ *            - 0 success
+ *            - 1 unexpected result
+ * @note      none
+ */
+static uint8_t a_mock_transaction(uint8_t op)
+{
+    uint8_t res;
+    uint8_t command;
+    uint8_t frame[6];
+    uint16_t conductivity_raw;
+    uint16_t conductivity_us_cm;
+    uint16_t temperature_raw;
+    uint16_t c;
+    uint16_t t;
+    uint16_t ntc_b;
+    float temperature;
+    uint64_t tx_us;
+    uint64_t rx_us;
+    uint32_t param;
+    uint32_t ohm;
+    uint32_t count;
+    uint32_t ntc_resistance;
+    uint32_t baseline_count;
+    mock_async_t ctx;
+    
+    c = (uint16_t)ba121_test_random(&gs_seed);
+    t = (uint16_t)ba121_test_random(&gs_seed);
+    ba121_mock_set_sample(c, t);
+    switch (op)
+    {
+        case 0 :
+        {
+            /* blocking read with timestamps, the fixed delay gives no arrival time */
+            res = ba121_read_with_timestamp(&gs_handle, &conductivity_raw, &conductivity_us_cm,
+                                            &temperature_raw, &temperature, &tx_us, &rx_us);
+            if ((res != 0) || (conductivity_raw != c) || (temperature_raw != t) || ((MOCK_WAIT_ALWAYS == 0) && (rx_us != 0)))
+            {
+                return 1;
+            }
+            
+            break;
+        }
+        case 1 :
+        {
+            /* async read */
+            if ((a_mock_async_read(&ctx) != 0) || (ctx.res != 0) ||
+                (ctx.conductivity_raw != c) || (ctx.temperature_raw != t))
+            {
+                return 1;
+            }
+            
+            break;
+        }
+        case 2 :
+        {
+            /* ntc resistance */
+            ohm = ba121_test_random(&gs_seed) % 1000000;
+            res = ba121_set_ntc_resistance(&gs_handle, ohm);
+            ba121_mock_get_settings(&ntc_resistance, &ntc_b, &baseline_count);
+            if ((res != 0) || (ntc_resistance != ohm))
+            {
+                return 1;
+            }
+            
+            break;
+        }
+        case 3 :
+        {
+            /* ntc b */
+            ntc_b = (uint16_t)ba121_test_random(&gs_seed);
+            res = ba121_set_ntc_b(&gs_handle, ntc_b);
+            count = ba121_mock_get_last_command(&command, &param);
+            ba121_mock_get_settings(&ntc_resistance, &t, &baseline_count);
+            if ((res != 0) || (t != ntc_b) || (command != 0xA5) || (count == 0))
+            {
+                return 1;
+            }
+            
+            break;
+        }
+        case 4 :
+        {
+            /* baseline calibration */
+            ba121_mock_get_settings(&ntc_resistance, &ntc_b, &count);
+            res = ba121_baseline_calibration(&gs_handle);
+            ba121_mock_get_settings(&ntc_resistance, &ntc_b, &baseline_count);
+            if ((res != 0) || (baseline_count != count + 1))
+            {
+                return 1;
+            }
+            
+            break;
+        }
+        case 5 :
+        {
+            /* response error */
+            ba121_mock_set_ack_status((uint8_t)(1 + ba121_test_random(&gs_seed) % 255));
+            res = ba121_set_ntc_b(&gs_handle, 3435);
+            ba121_mock_set_ack_status(0);
+            if (res != 5)
+            {
+                return 1;
+            }
+            
+            break;
+        }
+        case 6 :
+        {
+            /* corrupted reply */
+            frame[0] = 0xAA;
+            frame[1] = (uint8_t)(c >> 8);
+            frame[2] = (uint8_t)(c >> 0);
+            frame[3] = (uint8_t)(t >> 8);
+            frame[4] = (uint8_t)(t >> 0);
+            frame[5] = (uint8_t)(frame[0] + frame[1] + frame[2] + frame[3] + frame[4] + 1);
+            (void)ba121_mock_script_reply(frame, 6);
+            res = ba121_read(&gs_handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+            if (res != 4)
+            {
+                return 1;
+            }
+            
+            break;
+        }
+        default :
+        {
+            /* lost reply or link error */
+            if ((ba121_test_random(&gs_seed) & 1) != 0)
+            {
+                (void)ba121_mock_script_reply(NULL, 0);
+            }
+            else
+            {
+                ba121_mock_script_link_error(1, 0);
+            }
+            res = ba121_read(&gs_handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+            if (res != 1)
+            {
+                return 1;
+            }
+            
+            break;
+        }
+    }
+    
+    return 0;
+}
+
+#if MOCK_WAIT_TEST
+
+/**
+ * @brief  wait reply test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   with the wait_reply hook a read ends when the reply arrives,
+ *         a lost or late reply still takes the whole reply time
+ */
+static uint8_t a_mock_wait_test(void)
+{
+    uint8_t res;
+    uint16_t conductivity_raw;
+    uint16_t conductivity_us_cm;
+    uint16_t temperature_raw;
+    float temperature;
+    uint64_t tx_us;
+    uint64_t rx_us;
+    uint32_t start;
+    
+    /* link the wait */
+    DRIVER_BA121_LINK_WAIT_REPLY(&gs_handle, ba121_interface_wait_reply);
+    ba121_mock_reset();
+    ba121_mock_set_latency(10);
+    ba121_mock_set_sample(1234, 2345);
+    if (ba121_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    
+    /* the read ends with the reply */
+    start = ba121_mock_get_time_ms();
+    res = ba121_read_with_timestamp(&gs_handle, &conductivity_raw, &conductivity_us_cm,
+                                    &temperature_raw, &temperature, &tx_us, &rx_us);
+    if ((res != 0) || (conductivity_raw != 1234) || (temperature_raw != 2345) ||
+        (rx_us - tx_us != 10 * 1000) || (ba121_mock_get_time_ms() - start != 10))
+    {
+        (void)ba121_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a lost reply waits the whole reply time */
+    (void)ba121_mock_script_reply(NULL, 0);
+    start = ba121_mock_get_time_ms();
+    res = ba121_read(&gs_handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+    if ((res != 1) || (ba121_mock_get_time_ms() - start != MOCK_READ_DELAY_MS))
+    {
+        (void)ba121_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* so does a reply later than the reply time */
+    ba121_mock_set_latency(MOCK_READ_DELAY_MS + 1);
+    start = ba121_mock_get_time_ms();
+    res = ba121_read(&gs_handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+    if ((res != 1) || (ba121_mock_get_time_ms() - start != MOCK_READ_DELAY_MS))
+    {
+        (void)ba121_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)ba121_deinit(&gs_handle);
+    DRIVER_BA121_LINK_WAIT_REPLY(&gs_handle, NULL);
+    
+    return 0;
+}
+
+#endif
+
+/**
+ * @brief     mock test
+ * @param[in] times randomized transaction times
+ * @param[in] seed random seed
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      runs the register and read tests and then random reads, settings and injected faults
+ *            against the simulated sensor, every delay only moves the virtual clock
+ */
+uint8_t ba121_mock_test(uint32_t times, uint32_t seed)
+{
+    uint8_t res;
+    uint8_t op;
+    uint32_t i;
+    uint32_t counts[8];
+    uint32_t times_ms;
+    
+    /* run the hardware tests against the simulated sensor */
+    ba121_mock_reset();
+    if (ba121_register_test() != 0)
+    {
+        ba121_mock_set_verbose(1);
+        ba121_interface_debug_print("ba121: register test failed.\n");
+        
+        return 1;
+    }
+    ba121_mock_reset();
+    if (ba121_read_test(3) != 0)
+    {
+        ba121_mock_set_verbose(1);
+        ba121_interface_debug_print("ba121: read test failed.\n");
+        
+        return 1;
+    }
+    
+    /* link interface function */
+    DRIVER_BA121_LINK_INIT(&gs_handle, ba121_handle_t);
+    DRIVER_BA121_LINK_UART_INIT(&gs_handle, ba121_interface_uart_init);
+    DRIVER_BA121_LINK_UART_DEINIT(&gs_handle, ba121_interface_uart_deinit);
+    DRIVER_BA121_LINK_UART_READ(&gs_handle, ba121_interface_uart_read);
+    DRIVER_BA121_LINK_UART_FLUSH(&gs_handle, ba121_interface_uart_flush);
+    DRIVER_BA121_LINK_UART_WRITE(&gs_handle, ba121_interface_uart_write);
+    DRIVER_BA121_LINK_DELAY_MS(&gs_handle, ba121_interface_delay_ms);
+    DRIVER_BA121_LINK_DEBUG_PRINT(&gs_handle, ba121_interface_debug_print);
+    DRIVER_BA121_LINK_TIMESTAMP_US(&gs_handle, ba121_interface_timestamp_us);
+    
+    /* ba121 init */
+    ba121_mock_reset();
+    gs_seed = ba121_test_seed(seed);
+    res = ba121_init(&gs_handle);
+    if (res != 0)
+    {
+        ba121_mock_set_verbose(1);
+        ba121_interface_debug_print("ba121: init failed.\n");
+        
+        return 1;
+    }
+    
+    for (i = 0; i < 8; i++)
+    {
+        counts[i] = 0;
+    }
+    for (i = 0; i < times; i++)
+    {
+        op = (uint8_t)(ba121_test_random(&gs_seed) % 8);
+        counts[op]++;
+        if (a_mock_transaction(op) != 0)
+        {
+            (void)ba121_deinit(&gs_handle);
+            ba121_mock_set_verbose(1);
+            ba121_interface_debug_print("ba121: transaction %d type %d failed, seed is %u.\n",
+                                        (int)i, (int)op, (unsigned int)seed);
+            
+            return 1;
+        }
+    }
+    (void)ba121_deinit(&gs_handle);
+    times_ms = ba121_mock_get_time_ms();
+    
+    /* the wait hook */
+#if MOCK_WAIT_TEST
+    if (a_mock_wait_test() != 0)
+    {
+        ba121_mock_set_verbose(1);
+        ba121_interface_debug_print("ba121: wait reply test failed.\n");
+        
+        return 1;
+    }
+#endif
+    
+    /* output */
+    ba121_mock_set_verbose(1);
+    ba121_interface_debug_print("ba121: %d random transactions passed in %d virtual seconds.\n",
+                                (int)times, (int)(times_ms / 1000));
+    ba121_interface_debug_print("ba121: read %d, async read %d, ntc resistance %d, ntc b %d.\n",
+                                (int)counts[0], (int)counts[1], (int)counts[2], (int)counts[3]);
+    ba121_interface_debug_print("ba121: baseline %d, response error %d, frame error %d, link error %d.\n",
+                                (int)counts[4], (int)counts[5], (int)counts[6], (int)counts[7]);
+#if MOCK_WAIT_TEST
+    ba121_interface_debug_print("ba121: wait reply read in 10ms, lost reply in %dms.\n", MOCK_READ_DELAY_MS);
+#else
+    ba121_interface_debug_print("ba121: wait reply test needs the wait and time hooks.\n");
+#endif
+    
+    return 0;
+}
@@ -0,0 +1,440 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_os_test.c
+ * @brief     driver ba121 os test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_os_test.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief static link check
+ * @note  the overlap check lives in the linked uart wrappers, a static link build calls the
+ *        interface directly and would pass without checking anything
+ */
+#if (BA121_STATIC_LINK != 0)
+    #error "the os test needs the linked uart functions, build it without BA121_STATIC_LINK"
+#endif
+
+/**
+ * @brief os test definition
+ */
+#define OS_TEST_LATENCY_US        20000         /**< real reply time */
+#define OS_TEST_STALL_US          300000        /**< reply time of the stalled read */
+#define OS_TEST_MAX_TASKS         16            /**< max reading threads */
+
+/**
+ * @brief os test task structure definition
+ */
+typedef struct os_test_task_s
+{
+    pthread_t thread;        /**< thread */
+    uint32_t reads;          /**< reads to run */
+    uint32_t failed;         /**< failed checks */
+} os_test_task_t;
+
+static ba121_handle_t gs_handle;                                    /**< ba121 handle */
+static pthread_mutex_t gs_check = PTHREAD_MUTEX_INITIALIZER;        /**< test counter mutex */
+static uint8_t gs_active;                                           /**< transaction in progress */
+static uint32_t gs_overlap;                                         /**< overlapped transactions */
+static uint32_t gs_started;                                         /**< written read commands */
+static uint32_t gs_latency_us;                                      /**< real reply time */
+static uint8_t gs_force_timeout;                                    /**< bus wait times out at once */
+static os_test_task_t gs_task[OS_TEST_MAX_TASKS + 1];               /**< readers and the setter */
+
+/**
+ * @brief  monotonic time
+ * @return time in ms
+ * @note   none
+ */
+static uint32_t a_os_now_ms(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+/**
+ * @brief  uart flush with the overlap check
+ * @return status code
+ *         - 0 success
+ *         - 1 uart flush failed
+ * @note   every transaction starts with a flush
+ */
+static uint8_t a_os_uart_flush(void)
+{
+    (void)pthread_mutex_lock(&gs_check);
+    if (gs_active != 0)
+    {
+        gs_overlap++;
+    }
+    gs_active = 1;
+    (void)pthread_mutex_unlock(&gs_check);
+    
+    return ba121_interface_uart_flush();
+}
+
+/**
+ * @brief     uart write that numbers the reads
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 uart write failed
+ * @note      the simulated sensor answers read number n with n as both values
+ */
+static uint8_t a_os_uart_write(uint8_t *buf, uint16_t len)
+{
+    if ((len != 0) && (buf[0] == 0xA0))
+    {
+        (void)pthread_mutex_lock(&gs_check);
+        gs_started++;
+        ba121_mock_set_sample((uint16_t)gs_started, (uint16_t)gs_started);
+        (void)pthread_mutex_unlock(&gs_check);
+    }
+    
+    return ba121_interface_uart_write(buf, len);
+}
+
+/**
+ * @brief     wait reply in real time
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the other threads run while the reply is on its way
+ */
+static uint8_t a_os_wait_reply(uint16_t len, uint32_t timeout_ms)
+{
+    (void)usleep(gs_latency_us);
+    
+    return ba121_interface_wait_reply(len, timeout_ms);
+}
+
+/**
+ * @brief      uart read that ends the transaction
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       none
+ */
+static uint16_t a_os_uart_read(uint8_t *buf, uint16_t len)
+{
+    uint16_t l;
+    
+    l = ba121_interface_uart_read(buf, len);
+    (void)pthread_mutex_lock(&gs_check);
+    gs_active = 0;
+    (void)pthread_mutex_unlock(&gs_check);
+    
+    return l;
+}
+
+/**
+ * @brief     semaphore wait with a forced timeout
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      none
+ */
+static uint8_t a_os_sem_wait(uint32_t timeout_ms)
+{
+    if (gs_force_timeout != 0)
+    {
+        return 1;
+    }
+    
+    return ba121_interface_os_sem_wait(timeout_ms);
+}
+
+/**
+ * @brief     reading thread
+ * @param[in] *arg pointer to a task structure
+ * @return    NULL
+ * @note      every result must come from a read that finished after the call started
+ */
+static void *a_os_reader(void *arg)
+{
+    os_test_task_t *task;
+    uint8_t res;
+    uint32_t i;
+    uint32_t before;
+    uint32_t after;
+    uint16_t conductivity_raw;
+    uint16_t conductivity_us_cm;
+    uint16_t temperature_raw;
+    float temperature;
+    
+    task = (os_test_task_t *)arg;
+    for (i = 0; i < task->reads; i++)
+    {
+        /* the newest published read before the call */
+        ba121_interface_os_lock();
+        before = gs_handle.bus_read_done;
+        ba121_interface_os_unlock();
+        
+        res = ba121_read(&gs_handle, &conductivity_raw, &conductivity_us_cm, &temperature_raw, &temperature);
+        (void)pthread_mutex_lock(&gs_check);
+        after = gs_started;
+        (void)pthread_mutex_unlock(&gs_check);
+        if ((res != 0) || (conductivity_raw != temperature_raw) ||
+            (conductivity_raw <= (uint16_t)before) || (conductivity_raw > (uint16_t)after))
+        {
+            printf("os: read returned %u with read %u, published %u and started %u.\n", (unsigned int)res,
+                   (unsigned int)conductivity_raw, (unsigned int)before, (unsigned int)after);
+            task->failed++;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     setting thread
+ * @param[in] *arg pointer to a task structure
+ * @return    NULL
+ * @note      the settings take turns with the reads on the same bus
+ */
+static void *a_os_setter(void *arg)
+{
+    os_test_task_t *task;
+    uint32_t i;
+    
+    task = (os_test_task_t *)arg;
+    for (i = 1; i <= task->reads; i++)
+    {
+        if (ba121_set_ntc_resistance(&gs_handle, 10000 + i) != 0)
+        {
+            printf("os: set ntc resistance failed.\n");
+            task->failed++;
+        }
+        if (ba121_set_ntc_b(&gs_handle, (uint16_t)(3000 + i)) != 0)
+        {
+            printf("os: set ntc b failed.\n");
+            task->failed++;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief  run a bus wait into its timeout
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   a setting that times out behind a stalled read must fail without touching the uart
+ */
+static uint8_t a_os_timeout_test(void)
+{
+    uint8_t command;
+    uint32_t param;
+    uint32_t count;
+    uint32_t start;
+    uint32_t elapsed;
+    uint32_t ntc_resistance;
+    uint16_t ntc_b;
+    uint32_t baseline_count;
+    uint8_t res;
+    uint8_t active;
+    
+    count = ba121_mock_get_last_command(&command, &param);
+    gs_latency_us = OS_TEST_STALL_US;
+    gs_task[0].reads = 1;
+    gs_task[0].failed = 0;
+    if (pthread_create(&gs_task[0].thread, NULL, a_os_reader, &gs_task[0]) != 0)
+    {
+        printf("os: create thread failed.\n");
+        
+        return 1;
+    }
+    
+    /* wait until the read is in flight */
+    start = a_os_now_ms();
+    do
+    {
+        (void)usleep(1000);
+        (void)pthread_mutex_lock(&gs_check);
+        active = gs_active;
+        (void)pthread_mutex_unlock(&gs_check);
+    } while ((active == 0) && ((a_os_now_ms() - start) < 1000));
+    
+    gs_force_timeout = 1;
+    start = a_os_now_ms();
+    res = ba121_set_ntc_b(&gs_handle, 1234);
+    elapsed = a_os_now_ms() - start;
+    gs_force_timeout = 0;
+    (void)pthread_join(gs_task[0].thread, NULL);
+    gs_latency_us = OS_TEST_LATENCY_US;
+    if ((active == 0) || (res != 1) || (elapsed >= OS_TEST_STALL_US / 1000) || (gs_task[0].failed != 0))
+    {
+        printf("os: timed out setting returned %u after %ums.\n", (unsigned int)res, (unsigned int)elapsed);
+        
+        return 1;
+    }
+    if (ba121_mock_get_last_command(&command, &param) != count + 1)
+    {
+        printf("os: timed out setting reached the uart.\n");
+        
+        return 1;
+    }
+    
+    /* the bus is free again */
+    if (ba121_set_ntc_b(&gs_handle, 1234) != 0)
+    {
+        printf("os: set ntc b failed.\n");
+        
+        return 1;
+    }
+    ba121_mock_get_settings(&ntc_resistance, &ntc_b, &baseline_count);
+    if (ntc_b != 1234)
+    {
+        printf("os: ntc b is %u.\n", (unsigned int)ntc_b);
+        
+        return 1;
+    }
+    printf("os: bus wait timed out after %ums behind a %ums read.\n",
+           (unsigned int)elapsed, (unsigned int)(OS_TEST_STALL_US / 1000));
+    
+    return 0;
+}
+
+/**
+ * @brief     os test
+ * @param[in] tasks reading threads
+ * @param[in] reads reads per thread
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      several pthreads share one handle with the pthread os functions of the mock,
+ *            every reply takes real time, the test fails if two transactions overlap,
+ *            if a read returns a result older than its call or if no read was shared
+ */
+uint8_t ba121_os_test(uint32_t tasks, uint32_t reads)
+{
+    uint32_t i;
+    uint32_t failed;
+    uint32_t start;
+    uint32_t calls;
+    uint32_t ntc_resistance;
+    uint16_t ntc_b;
+    uint32_t baseline_count;
+    
+    if ((tasks == 0) || (tasks > OS_TEST_MAX_TASKS) || (reads == 0) || (tasks * reads > 30000))
+    {
+        printf("os: tasks must be 1 - %d and reads 1 - %u.\n", OS_TEST_MAX_TASKS, (unsigned int)(30000 / tasks));
+        
+        return 1;
+    }
+    
+    /* link interface function */
+    ba121_mock_reset();
+    DRIVER_BA121_LINK_INIT(&gs_handle, ba121_handle_t);
+    DRIVER_BA121_LINK_UART_INIT(&gs_handle, ba121_interface_uart_init);
+    DRIVER_BA121_LINK_UART_DEINIT(&gs_handle, ba121_interface_uart_deinit);
+    DRIVER_BA121_LINK_UART_READ(&gs_handle, a_os_uart_read);
+    DRIVER_BA121_LINK_UART_FLUSH(&gs_handle, a_os_uart_flush);
+    DRIVER_BA121_LINK_UART_WRITE(&gs_handle, a_os_uart_write);
+    DRIVER_BA121_LINK_DELAY_MS(&gs_handle, ba121_interface_delay_ms);
+    DRIVER_BA121_LINK_DEBUG_PRINT(&gs_handle, ba121_interface_debug_print);
+    DRIVER_BA121_LINK_WAIT_REPLY(&gs_handle, a_os_wait_reply);
+    DRIVER_BA121_LINK_OS_LOCK(&gs_handle, ba121_interface_os_lock);
+    DRIVER_BA121_LINK_OS_UNLOCK(&gs_handle, ba121_interface_os_unlock);
+    DRIVER_BA121_LINK_OS_SEM_WAIT(&gs_handle, a_os_sem_wait);
+    DRIVER_BA121_LINK_OS_SEM_GIVE(&gs_handle, ba121_interface_os_sem_give);
+    if (ba121_init(&gs_handle) != 0)
+    {
+        printf("os: init failed.\n");
+        
+        return 1;
+    }
+    gs_latency_us = OS_TEST_LATENCY_US;
+    
+    printf("os: %u tasks with %u reads and one setting task.\n", (unsigned int)tasks, (unsigned int)reads);
+    start = a_os_now_ms();
+    for (i = 0; i <= tasks; i++)
+    {
+        gs_task[i].reads = reads;
+        gs_task[i].failed = 0;
+        if (pthread_create(&gs_task[i].thread, NULL, (i < tasks) ? a_os_reader : a_os_setter, &gs_task[i]) != 0)
+        {
+            printf("os: create thread failed.\n");
+            
+            return 1;
+        }
+    }
+    failed = 0;
+    for (i = 0; i <= tasks; i++)
+    {
+        (void)pthread_join(gs_task[i].thread, NULL);
+        failed += gs_task[i].failed;
+    }
+    calls = tasks * reads;
+    printf("os: %u reads in %u transactions, %ums.\n", (unsigned int)calls,
+           (unsigned int)gs_started, (unsigned int)(a_os_now_ms() - start));
+    if ((failed != 0) || (gs_overlap != 0))
+    {
+        printf("os: %u failed checks and %u overlapped transactions.\n", (unsigned int)failed, (unsigned int)gs_overlap);
+        
+        return 1;
+    }
+    if ((tasks > 1) && (gs_started >= calls))
+    {
+        printf("os: no read was shared.\n");
+        
+        return 1;
+    }
+    ba121_mock_get_settings(&ntc_resistance, &ntc_b, &baseline_count);
+    if ((ntc_resistance != 10000 + reads) || (ntc_b != 3000 + reads))
+    {
+        printf("os: settings are %u and %u.\n", (unsigned int)ntc_resistance, (unsigned int)ntc_b);
+        
+        return 1;
+    }
+    
+    if (a_os_timeout_test() != 0)
+    {
+        return 1;
+    }
+    (void)ba121_deinit(&gs_handle);
+    printf("os: finish test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,521 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_pool_test.c
+ * @brief     driver ba121 pool test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_pool_test.h"
+#include "driver_ba121_interface_mock.h"
+#include <stdio.h>
+
+/**
+ * @brief pool test definition
+ */
+#define POOL_TEST_PORTS           6          /**< simulated sensors */
+#define POOL_TEST_READ_DELAY_MS   800        /**< must match the driver read delay */
+#define POOL_TEST_ACK_DELAY_MS    500        /**< must match the driver ack delay */
+
+/**
+ * @brief pool test port structure definition
+ */
+typedef struct pool_port_s
+{
+    uint8_t buf[32];          /**< received bytes */
+    uint16_t len;             /**< received length */
+    uint32_t due_ms;          /**< arrival time of the received bytes */
+    uint32_t latency_ms;      /**< reply latency */
+    uint16_t chunk;           /**< max bytes per read, 0 for no limit */
+    uint8_t junk;             /**< junk bytes before the next reply */
+    uint8_t stale;            /**< stale frames before the next reply */
+    uint8_t lost;             /**< next replies that are lost */
+    uint8_t opened;           /**< opened flag */
+} pool_port_t;
+
+static pool_port_t gs_port[POOL_TEST_PORTS];        /**< simulated ports */
+static ba121_pool_t gs_pool;                        /**< pool under test */
+
+/**
+ * @brief     port init
+ * @param[in] port port index
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+static uint8_t a_pool_uart_init(uint16_t port)
+{
+    if ((port >= POOL_TEST_PORTS) || (gs_port[port].opened != 0))
+    {
+        return 1;
+    }
+    gs_port[port].opened = 1;
+    gs_port[port].len = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     port deinit
+ * @param[in] port port index
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      none
+ */
+static uint8_t a_pool_uart_deinit(uint16_t port)
+{
+    if (gs_port[port].opened == 0)
+    {
+        return 1;
+    }
+    gs_port[port].opened = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      port read
+ * @param[in]  port port index
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     length of the read data
+ * @note       only the bytes that arrived are returned, at most chunk bytes per call
+ */
+static uint16_t a_pool_uart_read(uint16_t port, uint8_t *buf, uint16_t len)
+{
+    pool_port_t *p = &gs_port[port];
+    
+    if (ba121_mock_get_time_ms() < p->due_ms)
+    {
+        return 0;
+    }
+    if (len > p->len)
+    {
+        len = p->len;
+    }
+    if ((p->chunk != 0) && (len > p->chunk))
+    {
+        len = p->chunk;
+    }
+    memcpy(buf, p->buf, len);
+    p->len = (uint16_t)(p->len - len);
+    memmove(p->buf, &p->buf[len], p->len);
+    
+    return len;
+}
+
+/**
+ * @brief     port flush
+ * @param[in] port port index
+ * @return    status code
+ *            - 0 success
+ * @note      only the bytes that already arrived are dropped
+ */
+static uint8_t a_pool_uart_flush(uint16_t port)
+{
+    if (ba121_mock_get_time_ms() >= gs_port[port].due_ms)
+    {
+        gs_port[port].len = 0;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     port write
+ * @param[in] port port index
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the mock runs the command with the sample of this port, the reply is moved to the port
+ *            behind the scripted junk and stale frames and arrives after the port latency
+ */
+static uint8_t a_pool_uart_write(uint16_t port, uint8_t *buf, uint16_t len)
+{
+    const uint8_t junk[3] = {0xAA, 0x00, 0x55};
+    const uint8_t stale[6] = {0xAC, 0x00, 0x00, 0x00, 0x00, 0xAC};
+    pool_port_t *p = &gs_port[port];
+    uint8_t i;
+    uint16_t n;
+    
+    ba121_mock_set_sample((uint16_t)(1000 + port), (uint16_t)(2000 + 10 * port));
+    for (i = 0; i < p->stale; i++)
+    {
+        (void)ba121_mock_inject(stale, sizeof(stale));
+    }
+    p->stale = 0;
+    (void)ba121_mock_inject(junk, p->junk);
+    p->junk = 0;
+    if (p->lost != 0)
+    {
+        (void)ba121_mock_script_reply(junk, 0);
+        p->lost--;
+    }
+    if (ba121_interface_uart_write(buf, len) != 0)
+    {
+        return 1;
+    }
+    n = ba121_interface_uart_read(&p->buf[p->len], (uint16_t)(sizeof(p->buf) - p->len));
+    p->len = (uint16_t)(p->len + n);
+    p->due_ms = ba121_mock_get_time_ms() + p->latency_ms;
+    
+    return 0;
+}
+
+/**
+ * @brief     port wait reply
+ * @param[in] port port index
+ * @param[in] len reply length
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 timeout
+ * @note      the virtual clock jumps to the arrival or to the timeout
+ */
+static uint8_t a_pool_wait_reply(uint16_t port, uint16_t len, uint32_t timeout_ms)
+{
+    pool_port_t *p = &gs_port[port];
+    uint32_t now;
+    
+    now = ba121_mock_get_time_ms();
+    if ((p->len >= len) && (p->due_ms <= now + timeout_ms))
+    {
+        if (p->due_ms > now)
+        {
+            ba121_mock_advance_ms(p->due_ms - now);
+        }
+        
+        return 0;
+    }
+    ba121_mock_advance_ms(timeout_ms);
+    
+    return 1;
+}
+
+/**
+ * @brief pool ops with a fixed delay
+ */
+static const ba121_pool_ops_t gs_delay_ops =
+{
+    a_pool_uart_init,
+    a_pool_uart_deinit,
+    a_pool_uart_read,
+    a_pool_uart_flush,
+    a_pool_uart_write,
+    NULL,
+};
+
+/**
+ * @brief pool ops with a wait reply
+ */
+static const ba121_pool_ops_t gs_wait_ops =
+{
+    a_pool_uart_init,
+    a_pool_uart_deinit,
+    a_pool_uart_read,
+    a_pool_uart_flush,
+    a_pool_uart_write,
+    a_pool_wait_reply,
+};
+
+/**
+ * @brief     set up the mock and a pool of all ports
+ * @param[in] *ops pointer to a pool ops structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 setup failed
+ * @note      none
+ */
+static uint8_t a_pool_setup(const ba121_pool_ops_t *ops)
+{
+    uint16_t i;
+    uint16_t channel;
+    uint8_t ops_index;
+    
+    ba121_mock_reset();
+    ba121_mock_set_latency(0);
+    (void)ba121_interface_uart_init();
+    memset(gs_port, 0, sizeof(gs_port));
+    for (i = 0; i < POOL_TEST_PORTS; i++)
+    {
+        gs_port[i].latency_ms = 10 * (uint32_t)(i + 1);
+    }
+    if ((ba121_pool_init(&gs_pool, ba121_interface_delay_ms, ba121_interface_debug_print) != 0) ||
+        (ba121_pool_register_ops(&gs_pool, ops, &ops_index) != 0))
+    {
+        printf("pool: init failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < POOL_TEST_PORTS; i++)
+    {
+        if ((ba121_pool_add(&gs_pool, ops_index, i, &channel) != 0) || (channel != i))
+        {
+            printf("pool: add port %u failed.\n", (unsigned int)i);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run a sweep and check it
+ * @param[in] *name pointer to a step name
+ * @param[in] expect_valid expected valid channels
+ * @param[in] expect_ms expected virtual time of the sweep
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every valid channel must hold the sample of its port
+ */
+static uint8_t a_pool_sweep(const char *name, uint16_t expect_valid, uint32_t expect_ms)
+{
+    uint16_t valid;
+    uint16_t channel;
+    uint16_t conductivity_raw;
+    uint16_t conductivity_us_cm;
+    uint16_t temperature_raw;
+    float temperature;
+    uint32_t start;
+    
+    start = ba121_mock_get_time_ms();
+    if ((ba121_pool_sweep(&gs_pool, &valid) != 0) || (valid != expect_valid))
+    {
+        printf("pool: %s sweep gave %u valid, expected %u.\n", name, (unsigned int)valid, (unsigned int)expect_valid);
+        
+        return 1;
+    }
+    if (ba121_mock_get_time_ms() - start != expect_ms)
+    {
+        printf("pool: %s sweep took %ums, expected %ums.\n", name,
+               (unsigned int)(ba121_mock_get_time_ms() - start), (unsigned int)expect_ms);
+        
+        return 1;
+    }
+    for (channel = BA121_POOL_ITERATE_START; ba121_pool_next(&gs_pool, BA121_POOL_ITERATE_VALID, &channel) == 0; )
+    {
+        if ((ba121_pool_get_sample(&gs_pool, channel, &conductivity_raw, &conductivity_us_cm,
+                                   &temperature_raw, &temperature) != 0) ||
+            (conductivity_raw != 1000 + gs_pool.port[channel]) ||
+            (temperature_raw != 2000 + 10 * gs_pool.port[channel]))
+        {
+            printf("pool: %s channel %u has a wrong sample.\n", name, (unsigned int)channel);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     collect the channels of an iteration
+ * @param[in] type iterate type
+ * @return    channel bitmap
+ * @note      none
+ */
+static uint32_t a_pool_iterate(ba121_pool_iterate_t type)
+{
+    uint16_t channel;
+    uint16_t last;
+    uint32_t bits;
+    
+    bits = 0;
+    last = 0;
+    for (channel = BA121_POOL_ITERATE_START; ba121_pool_next(&gs_pool, type, &channel) == 0; )
+    {
+        if ((bits != 0) && (channel <= last))
+        {
+            return 0xFFFFFFFFUL;
+        }
+        bits |= 1UL << channel;
+        last = channel;
+    }
+    
+    return bits;
+}
+
+/**
+ * @brief  pool test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   every port is a simulated sensor of the mock, the test covers sweep, iterate, add and remove,
+ *         resync after junk, stale and split replies, retry of lost replies, wait_reply timing and
+ *         the ack commands
+ */
+uint8_t ba121_pool_test(void)
+{
+    uint16_t channel;
+    uint16_t i;
+    uint64_t tx_us;
+    uint64_t rx_us;
+    uint32_t ntc_resistance;
+    uint16_t ntc_b;
+    uint32_t baseline_count;
+    uint32_t start;
+    
+    printf("pool: %u simulated sensors.\n", (unsigned int)POOL_TEST_PORTS);
+    
+    /* one read delay for all channels */
+    if ((a_pool_setup(&gs_delay_ops) != 0) ||
+        (a_pool_sweep("fixed delay", POOL_TEST_PORTS, POOL_TEST_READ_DELAY_MS) != 0))
+    {
+        return 1;
+    }
+    if ((ba121_pool_get_timestamp(&gs_pool, 0, &tx_us, &rx_us) != 0) || (tx_us != 0) || (rx_us != 0))
+    {
+        printf("pool: time stamps without a clock.\n");
+        
+        return 1;
+    }
+    
+    /* iterate, remove and add again */
+    if ((ba121_pool_remove(&gs_pool, 2) != 0) || (gs_port[2].opened != 0) ||
+        (a_pool_iterate(BA121_POOL_ITERATE_ACTIVE) != 0x3BUL) ||
+        (a_pool_iterate(BA121_POOL_ITERATE_VALID) != 0x3BUL) ||
+        (a_pool_iterate(BA121_POOL_ITERATE_INVALID) != 0) ||
+        (ba121_pool_remove(&gs_pool, 2) != 4))
+    {
+        printf("pool: remove failed.\n");
+        
+        return 1;
+    }
+    if ((a_pool_sweep("removed", POOL_TEST_PORTS - 1, POOL_TEST_READ_DELAY_MS) != 0) ||
+        (ba121_pool_add(&gs_pool, 0, 2, &channel) != 0) || (channel != 2) ||
+        (a_pool_iterate(BA121_POOL_ITERATE_ACTIVE) != 0x3FUL) ||
+        (a_pool_iterate(BA121_POOL_ITERATE_INVALID) != 0x04UL))
+    {
+        printf("pool: add again failed.\n");
+        
+        return 1;
+    }
+    
+    /* junk, a stale ack and split reads are resynchronised */
+    gs_port[1].junk = 3;
+    gs_port[3].stale = 1;
+    gs_port[4].chunk = 4;
+    gs_port[5].junk = 2;
+    gs_port[5].chunk = 1;
+    if (a_pool_sweep("resync", POOL_TEST_PORTS, POOL_TEST_READ_DELAY_MS) != 0)
+    {
+        return 1;
+    }
+    
+    /* a lost reply fails one channel, a retry round recovers it */
+    gs_port[4].lost = 1;
+    if ((a_pool_sweep("lost", POOL_TEST_PORTS - 1, POOL_TEST_READ_DELAY_MS) != 0) ||
+        (a_pool_iterate(BA121_POOL_ITERATE_INVALID) != 0x10UL))
+    {
+        return 1;
+    }
+    gs_port[4].lost = 1;
+    gs_port[0].lost = 2;
+    if ((ba121_pool_set_retry(&gs_pool, 2) != 0) ||
+        (a_pool_sweep("retry", POOL_TEST_PORTS - 1, 2 * POOL_TEST_READ_DELAY_MS) != 0) ||
+        (a_pool_iterate(BA121_POOL_ITERATE_INVALID) != 0x01UL))
+    {
+        return 1;
+    }
+    
+    /* ack commands, the lost ack costs one more delay */
+    gs_port[2].lost = 1;
+    start = ba121_mock_get_time_ms();
+    if ((ba121_pool_set_ntc_resistance(&gs_pool, 2, 10000) != 0) ||
+        (ba121_pool_set_ntc_b(&gs_pool, 1, 3950) != 0) ||
+        (ba121_pool_baseline_calibration(&gs_pool, 0) != 0) ||
+        (ba121_mock_get_time_ms() - start != 4 * POOL_TEST_ACK_DELAY_MS))
+    {
+        printf("pool: ack command failed.\n");
+        
+        return 1;
+    }
+    ba121_mock_get_settings(&ntc_resistance, &ntc_b, &baseline_count);
+    if ((ntc_resistance != 10000) || (ntc_b != 3950) || (baseline_count != 1))
+    {
+        printf("pool: settings %u/%u/%u are wrong.\n", (unsigned int)ntc_resistance,
+               (unsigned int)ntc_b, (unsigned int)baseline_count);
+        
+        return 1;
+    }
+    ba121_mock_set_ack_status(1);
+    if ((ba121_pool_baseline_calibration(&gs_pool, 0) != 5) || (gs_pool.last_status[0] != 1))
+    {
+        printf("pool: response error is not reported.\n");
+        
+        return 1;
+    }
+    ba121_mock_set_ack_status(0);
+    if ((ba121_pool_deinit(&gs_pool) != 0) || (gs_port[0].opened != 0) || (gs_port[5].opened != 0))
+    {
+        printf("pool: deinit failed.\n");
+        
+        return 1;
+    }
+    
+    /* with a clock and wait_reply a sweep lasts as long as the slowest reply */
+    if ((a_pool_setup(&gs_wait_ops) != 0) ||
+        (ba121_pool_set_clock(&gs_pool, ba121_interface_timestamp_us) != 0) ||
+        (a_pool_sweep("wait reply", POOL_TEST_PORTS, 10 * POOL_TEST_PORTS) != 0))
+    {
+        return 1;
+    }
+    for (i = 0; i < POOL_TEST_PORTS; i++)
+    {
+        if ((ba121_pool_get_timestamp(&gs_pool, i, &tx_us, &rx_us) != 0) ||
+            (rx_us - tx_us != (uint64_t)gs_port[i].latency_ms * 1000))
+        {
+            printf("pool: channel %u reply time is wrong.\n", (unsigned int)i);
+            
+            return 1;
+        }
+    }
+    gs_port[3].lost = 1;
+    if ((a_pool_sweep("wait lost", POOL_TEST_PORTS - 1, POOL_TEST_READ_DELAY_MS) != 0) ||
+        (ba121_pool_set_ntc_b(&gs_pool, 3, 3435) != 0) ||
+        (ba121_mock_get_time_ms() != 10 * POOL_TEST_PORTS + POOL_TEST_READ_DELAY_MS + 40))
+    {
+        printf("pool: wait timing is wrong.\n");
+        
+        return 1;
+    }
+    (void)ba121_pool_deinit(&gs_pool);
+    
+    printf("pool: finish test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,59 @@
+#!/bin/sh
+#
+# Copyright (c) 2015 - present LibDriver All rights reserved
+#
+# The MIT License (MIT)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+# golden test of ba121_reprocess
+# usage: golden.sh <ba121_reprocess> <directory of this script>
+# every thread count and chunk size must give the same bytes as the single thread golden file
+
+TOOL=$1
+DIR=$2
+
+run()
+{
+    EXPECT=$1
+    shift
+    if ! "$TOOL" -i "$DIR/golden.log" "$@" 2> /dev/null | cmp -s - "$DIR/$EXPECT"; then
+        echo "reprocess: $* differs from $EXPECT."
+        exit 1
+    fi
+}
+
+# no filter, the hampel threshold 0 passes every sample through
+run raw.csv -j 1
+run raw.csv -j 4 --chunk=4096
+run raw.csv -j 3 --chunk=4096 --median=7 --sigma=0
+
+# median/hampel filter, the default and a tighter threshold
+run hampel.csv -j 1 --median=7
+run hampel.csv -j 2 --chunk=4096 --median=7
+run hampel.csv -j 8 --chunk=4096 --median=7 --sigma=3
+run sigma2.csv -j 1 --median=7 --sigma=2
+run sigma2.csv -j 4 --chunk=4096 --median=7 --sigma=2
+
+# rollup buckets split across chunks
+run rollup.csv -j 1 --median=7 --rollup=60000
+run rollup.csv -j 4 --chunk=4096 --median=7 --rollup=60000
+
+echo "reprocess: golden test passed."
@@ -0,0 +1,271 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_ring_test.c
+ * @brief     driver ba121 ring test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_ring_test.h"
+#include "driver_ba121_test_common.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief ring test size definition
+ */
+#define RING_TEST_SIZE        64        /**< small, so the stream wraps and fills often */
+
+static ring_t gs_ring;                               /**< ring under test */
+static uint8_t gs_buf[RING_TEST_SIZE];               /**< ring storage */
+static volatile uint32_t gs_times;                   /**< streamed bytes */
+static volatile uint32_t gs_full;                    /**< failed puts of the producer */
+
+/**
+ * @brief     sequence byte
+ * @param[in] i byte index
+ * @return    expected byte
+ * @note      not a plain counter, so a stale byte of the last lap doesn't match
+ */
+static uint8_t a_ring_byte(uint32_t i)
+{
+    return (uint8_t)(i ^ (i >> 8) ^ (i >> 16));
+}
+
+/**
+ * @brief     check a condition
+ * @param[in] ok condition
+ * @param[in] *what pointer to a description
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_ring_check(int ok, const char *what)
+{
+    if (!ok)
+    {
+        printf("ring: %s failed.\n", what);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  single thread corner cases
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+static uint8_t a_ring_corner_test(void)
+{
+    ring_t ring;
+    uint8_t storage[8];
+    uint8_t data[16];
+    uint8_t out[16];
+    uint8_t res;
+    uint32_t i;
+    
+    res = 0;
+    for (i = 0; i < 16; i++)
+    {
+        data[i] = (uint8_t)(0xA0 + i);
+    }
+    
+    /* init */
+    res |= a_ring_check(ring_init(&ring, storage, 6) == 1, "non power of 2 size");
+    res |= a_ring_check(ring_init(&ring, storage, 8) == 0, "init");
+    res |= a_ring_check(ring_read(&ring, out, 16) == 0, "read empty");
+    
+    /* fill, then one more */
+    for (i = 0; i < 8; i++)
+    {
+        res |= a_ring_check(ring_put(&ring, data[i]) == 0, "put");
+    }
+    res |= a_ring_check(ring_put(&ring, 0x55) == 1, "put full");
+    res |= a_ring_check((ring_count(&ring) == 8) && (ring.overflow == 1), "full count");
+    
+    /* a short read leaves the rest */
+    res |= a_ring_check(ring_read(&ring, out, 3) == 3, "short read");
+    res |= a_ring_check(memcmp(out, data, 3) == 0, "short read data");
+    res |= a_ring_check(ring_count(&ring) == 5, "rest count");
+    
+    /* wrap the storage */
+    res |= a_ring_check(ring_write(&ring, &data[8], 5) == 3, "write partial");
+    res |= a_ring_check(ring.overflow == 3, "write overflow");
+    res |= a_ring_check(ring_peek(&ring, 2, out, 16) == 6, "peek offset");
+    res |= a_ring_check(memcmp(out, &data[5], 6) == 0, "peek data");
+    res |= a_ring_check(ring_peek(&ring, 8, out, 16) == 0, "peek past end");
+    res |= a_ring_check(ring_skip(&ring, 4) == 4, "skip");
+    res |= a_ring_check(ring_read(&ring, out, 16) == 4, "read wrapped");
+    res |= a_ring_check(memcmp(out, &data[7], 4) == 0, "read wrapped data");
+    res |= a_ring_check(ring_skip(&ring, 1) == 0, "skip empty");
+    
+    /* flush */
+    (void)ring_write(&ring, data, 5);
+    ring_flush(&ring);
+    res |= a_ring_check(ring_count(&ring) == 0, "flush");
+    
+    /* the free running indices wrap at 2^32 */
+    ring.head = 0xFFFFFFFCU;
+    ring.tail = 0xFFFFFFFCU;
+    res |= a_ring_check(ring_write(&ring, data, 8) == 8, "write across 2^32");
+    res |= a_ring_check(ring_put(&ring, 0x55) == 1, "full across 2^32");
+    res |= a_ring_check(ring_read(&ring, out, 16) == 8, "read across 2^32");
+    res |= a_ring_check(memcmp(out, data, 8) == 0, "data across 2^32");
+    
+    return res;
+}
+
+/**
+ * @brief     producer thread
+ * @param[in] *arg not used
+ * @return    NULL
+ * @note      plays the uart interrupt, one byte per put
+ */
+static void *a_ring_producer(void *arg)
+{
+    uint32_t i;
+    uint32_t full;
+    
+    (void)arg;
+    full = 0;
+    for (i = 0; i < gs_times; )
+    {
+        if (ring_put(&gs_ring, a_ring_byte(i)) == 0)
+        {
+            i++;
+        }
+        else
+        {
+            /* let the consumer run on a single core */
+            full++;
+            (void)sched_yield();
+        }
+    }
+    gs_full = full;
+    
+    return NULL;
+}
+
+/**
+ * @brief     ring test
+ * @param[in] times bytes streamed from the producer thread to the consumer
+ * @param[in] seed random seed of the consumer read sizes
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      checks the ring corner cases, then streams a counting sequence through the ring on two threads,
+ *            like the stm32 uart interrupt and the driver, and fails on any lost, duplicated or reordered byte
+ */
+uint8_t ba121_ring_test(uint32_t times, uint32_t seed)
+{
+    pthread_t thread;
+    struct timespec start;
+    struct timespec stop;
+    uint8_t out[RING_TEST_SIZE];
+    uint32_t state;
+    uint32_t received;
+    uint32_t len;
+    uint32_t i;
+    double s;
+    
+    printf("ring: start ring test.\n");
+    if (a_ring_corner_test() != 0)
+    {
+        return 1;
+    }
+    printf("ring: corner cases passed.\n");
+    
+    /* stream */
+    (void)ring_init(&gs_ring, gs_buf, RING_TEST_SIZE);
+    gs_times = times;
+    gs_full = 0;
+    state = ba121_test_seed(seed);
+    received = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (pthread_create(&thread, NULL, a_ring_producer, NULL) != 0)
+    {
+        printf("ring: create thread failed.\n");
+        
+        return 1;
+    }
+    while (received < times)
+    {
+        /* mix whole reads with the peek and skip of a frame parser */
+        len = 1 + ba121_test_random(&state) % RING_TEST_SIZE;
+        if ((ba121_test_random(&state) & 1) != 0)
+        {
+            len = ring_read(&gs_ring, out, len);
+        }
+        else
+        {
+            len = ring_peek(&gs_ring, 0, out, len);
+            len = ring_skip(&gs_ring, len);
+        }
+        for (i = 0; i < len; i++)
+        {
+            if (out[i] != a_ring_byte(received + i))
+            {
+                printf("ring: byte %u is 0x%02X, expected 0x%02X.\n", (unsigned int)(received + i),
+                       out[i], a_ring_byte(received + i));
+                (void)pthread_join(thread, NULL);
+                
+                return 1;
+            }
+        }
+        received += len;
+        if (len == 0)
+        {
+            (void)sched_yield();
+        }
+    }
+    (void)pthread_join(thread, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    s = (double)(stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1e9;
+    
+    /* every failed put was counted, nothing else */
+    if (a_ring_check((ring_count(&gs_ring) == 0) && (gs_ring.overflow == gs_full), "overflow count") != 0)
+    {
+        return 1;
+    }
+    printf("ring: %u bytes streamed in order, %u full waits, %.1f MB/s.\n", (unsigned int)times,
+           (unsigned int)gs_full, (s > 0.0) ? (double)times / s / 1e6 : 0.0);
+    printf("ring: finish ring test.\n");
+    
+    return 0;
+}
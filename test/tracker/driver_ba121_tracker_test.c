@@ -0,0 +1,308 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_tracker_test.c
+ * @brief     driver ba121 tracker test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_tracker_test.h"
+#include "driver_ba121_test_common.h"
+#include <math.h>
+#include <stdio.h>
+
+/**
+ * @brief tracker test definition
+ */
+#define TRACKER_TEST_BLOCK          1000        /**< samples per gain and level block */
+#define TRACKER_TEST_RAMP           400         /**< samples per ramp */
+#define TRACKER_TEST_SETTLE         100         /**< samples before the ramp check */
+#define TRACKER_TEST_RAMP_VALUE     0.1         /**< ramp value bound in lsb */
+#define TRACKER_TEST_RAMP_RATE      0.01        /**< ramp rate bound, relative */
+#if (BA121_TRACKER_FIXED_POINT != 0)
+/* at the smallest gains the rate step rounds to 0 of 1/256 lsb/s and the estimate lags by a few lsb */
+#define TRACKER_TEST_VALUE          8.0         /**< value bound against the reference in lsb */
+#define TRACKER_TEST_RATE           0.5         /**< rate bound against the reference in lsb/s */
+#else
+#define TRACKER_TEST_VALUE          0.25        /**< value bound against the reference in lsb */
+#define TRACKER_TEST_RATE           0.5         /**< rate bound against the reference in lsb/s */
+#endif
+
+/**
+ * @brief tracker reference structure definition
+ */
+typedef struct tracker_reference_s
+{
+    double value;        /**< estimate */
+    double rate;         /**< rate */
+} tracker_reference_t;
+
+static uint32_t gs_state;        /**< random state */
+
+/**
+ * @brief     convert a gain to double
+ * @param[in] g tracker gain
+ * @return    gain
+ * @note      the q0.15 gain of the fixed point build is converted exactly
+ */
+static double a_tracker_gain(ba121_tracker_gain_t g)
+{
+#if (BA121_TRACKER_FIXED_POINT != 0)
+    return (double)g / 32768.0;
+#else
+    return (double)g;
+#endif
+}
+
+/**
+ * @brief         double precision tracker step
+ * @param[in,out] *ref pointer to a tracker reference structure
+ * @param[in]     alpha position gain
+ * @param[in]     beta rate gain
+ * @param[in]     raw measured raw data
+ * @param[in]     dt_ms time since the previous sample in ms
+ * @note          same equations as the driver
+ */
+static void a_tracker_reference(tracker_reference_t *ref, double alpha, double beta, uint16_t raw, uint32_t dt_ms)
+{
+    double predicted;
+    double residual;
+    
+    predicted = ref->value + ref->rate * (double)dt_ms / 1000.0;
+    residual = (double)raw - predicted;
+    ref->value = predicted + alpha * residual;
+    ref->rate += beta * residual * 1000.0 / (double)dt_ms;
+}
+
+/**
+ * @brief     check the status codes
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_tracker_status_test(void)
+{
+    ba121_tracker_handle_t tracker;
+    ba121_tracker_value_t c;
+    ba121_tracker_value_t cr;
+    ba121_tracker_value_t t;
+    ba121_tracker_value_t tr;
+    
+    tracker.inited = 0;
+    if ((ba121_tracker_init(NULL) != 2) ||
+        (ba121_tracker_update(&tracker, 0, 0, 1000) != 3) ||
+        (ba121_tracker_init(&tracker) != 0) ||
+        (ba121_tracker_set_gain(&tracker, (ba121_tracker_channel_t)2,
+                                BA121_TRACKER_DEFAULT_ALPHA, BA121_TRACKER_DEFAULT_BETA) != 4) ||
+        (ba121_tracker_predict(&tracker, 0, &c, &cr, &t, &tr) != 1) ||
+        (ba121_tracker_update(&tracker, 1000, 2000, 0) != 0) ||
+        (ba121_tracker_predict(&tracker, 500, &c, &cr, &t, &tr) != 0) ||
+        (BA121_TRACKER_TO_FLOAT(c) != 1000.0f) || (BA121_TRACKER_TO_FLOAT(t) != 2000.0f) ||
+        (cr != 0) || (tr != 0))
+    {
+        printf("tracker: status codes are wrong.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the convergence on a ramp
+ * @param[in] alpha position gain
+ * @param[in] beta rate gain
+ * @param[in] dt_ms sample interval in ms
+ * @param[in] c_rate conductivity ramp in lsb/s
+ * @param[in] t_rate temperature ramp in lsb/s
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      an alpha beta tracker follows a ramp without a steady state error,
+ *            the ramps step whole lsb per sample so the raw samples are exact
+ */
+static uint8_t a_tracker_ramp_test(ba121_tracker_gain_t alpha, ba121_tracker_gain_t beta,
+                                   uint32_t dt_ms, double c_rate, double t_rate)
+{
+    ba121_tracker_handle_t tracker;
+    ba121_tracker_value_t c;
+    ba121_tracker_value_t cr;
+    ba121_tracker_value_t t;
+    ba121_tracker_value_t tr;
+    double c_true;
+    double t_true;
+    double c_err;
+    double t_err;
+    double cr_err;
+    double tr_err;
+    uint32_t i;
+    
+    (void)ba121_tracker_init(&tracker);
+    (void)ba121_tracker_set_gain(&tracker, BA121_TRACKER_CHANNEL_CONDUCTIVITY, alpha, beta);
+    (void)ba121_tracker_set_gain(&tracker, BA121_TRACKER_CHANNEL_TEMPERATURE, alpha, beta);
+    c_err = 0.0;
+    t_err = 0.0;
+    cr_err = 0.0;
+    tr_err = 0.0;
+    for (i = 0; i < TRACKER_TEST_RAMP; i++)
+    {
+        c_true = 10000.0 + c_rate * (double)(i * dt_ms) / 1000.0;
+        t_true = 40000.0 + t_rate * (double)(i * dt_ms) / 1000.0;
+        (void)ba121_tracker_update(&tracker, (uint16_t)c_true, (uint16_t)t_true, dt_ms);
+        (void)ba121_tracker_predict(&tracker, 0, &c, &cr, &t, &tr);
+        if (i >= TRACKER_TEST_SETTLE)
+        {
+            c_err = fmax(c_err, fabs(BA121_TRACKER_TO_FLOAT(c) - c_true));
+            t_err = fmax(t_err, fabs(BA121_TRACKER_TO_FLOAT(t) - t_true));
+            cr_err = fmax(cr_err, fabs(BA121_TRACKER_TO_FLOAT(cr) - c_rate) / fabs(c_rate));
+            tr_err = fmax(tr_err, fabs(BA121_TRACKER_TO_FLOAT(tr) - t_rate) / fabs(t_rate));
+        }
+    }
+    printf("tracker: ramp %.1f/%.1f lsb/s every %ums, value error %.3f/%.3f lsb, rate error %.2f%%/%.2f%%.\n",
+           c_rate, t_rate, (unsigned int)dt_ms, c_err, t_err, 100.0 * cr_err, 100.0 * tr_err);
+    if ((c_err > TRACKER_TEST_RAMP_VALUE) || (t_err > TRACKER_TEST_RAMP_VALUE) ||
+        (cr_err > TRACKER_TEST_RAMP_RATE) || (tr_err > TRACKER_TEST_RAMP_RATE))
+    {
+        printf("tracker: ramp did not converge.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     tracker test
+ * @param[in] times random samples
+ * @param[in] seed random seed of the gains, the intervals and the samples
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      checks the status codes, the convergence on ramps and the agreement with a double precision
+ *            reference, the float and the q24.8 build must stay within the same bounds
+ */
+uint8_t ba121_tracker_test(uint32_t times, uint32_t seed)
+{
+    ba121_tracker_handle_t tracker;
+    tracker_reference_t ref[2];
+    ba121_tracker_value_t v[4];
+    double alpha;
+    double beta;
+    double level;
+    double drift;
+    double value_err;
+    double rate_err;
+    uint32_t i;
+    uint32_t dt_ms;
+    uint16_t raw[2];
+    uint8_t ch;
+    
+    ref[0].value = 0.0;
+    ref[0].rate = 0.0;
+    ref[1] = ref[0];
+    gs_state = ba121_test_seed(seed);
+    
+    printf("tracker: %s build.\n", (BA121_TRACKER_FIXED_POINT != 0) ? "q24.8" : "float");
+    if (a_tracker_status_test() != 0)
+    {
+        return 1;
+    }
+    if ((a_tracker_ramp_test(BA121_TRACKER_DEFAULT_ALPHA, BA121_TRACKER_DEFAULT_BETA, 1000, 40.0, -6.0) != 0) ||
+        (a_tracker_ramp_test(BA121_TRACKER_GAIN(0.2f), BA121_TRACKER_GAIN(0.0222f), 100, 250.0, 70.0) != 0) ||
+        (a_tracker_ramp_test(BA121_TRACKER_GAIN(0.8f), BA121_TRACKER_GAIN(0.5f), 2000, -3.5, 1.5) != 0))
+    {
+        return 1;
+    }
+    
+    /* random drift and noise with random gains and intervals against the reference */
+    printf("tracker: %u samples against a double precision reference, seed 0x%08X.\n",
+           (unsigned int)times, (unsigned int)seed);
+    value_err = 0.0;
+    rate_err = 0.0;
+    level = 0.0;
+    drift = 0.0;
+    alpha = 0.0;
+    beta = 0.0;
+    for (i = 0; i < times; i++)
+    {
+        if ((i % TRACKER_TEST_BLOCK) == 0)
+        {
+            /* stable gains between 0.05 and 1, beta up to the kalman value */
+            alpha = 0.05 + (double)(ba121_test_random(&gs_state) % 951) / 1000.0;
+            beta = alpha * alpha / (2.0 - alpha) * (double)(1 + ba121_test_random(&gs_state) % 100) / 100.0;
+            (void)ba121_tracker_init(&tracker);
+            (void)ba121_tracker_set_gain(&tracker, BA121_TRACKER_CHANNEL_CONDUCTIVITY,
+                                         BA121_TRACKER_GAIN((float)alpha), BA121_TRACKER_GAIN((float)beta));
+            (void)ba121_tracker_set_gain(&tracker, BA121_TRACKER_CHANNEL_TEMPERATURE,
+                                         BA121_TRACKER_GAIN((float)alpha), BA121_TRACKER_GAIN((float)beta));
+            alpha = a_tracker_gain(tracker.channel[0].alpha);
+            beta = a_tracker_gain(tracker.channel[0].beta);
+            level = 5000.0 + (double)(ba121_test_random(&gs_state) % 50000);
+            drift = (double)((int32_t)(ba121_test_random(&gs_state) % 201) - 100);
+        }
+        dt_ms = 50 + ba121_test_random(&gs_state) % 1951;
+        level += drift * (double)dt_ms / 1000.0;
+        if ((level < 1000.0) || (level > 64000.0))
+        {
+            drift = -drift;
+        }
+        raw[0] = (uint16_t)(level + (double)(ba121_test_random(&gs_state) % 21) - 10.0);
+        raw[1] = (uint16_t)(65535.0 - level + (double)(ba121_test_random(&gs_state) % 5) - 2.0);
+        (void)ba121_tracker_update(&tracker, raw[0], raw[1], dt_ms);
+        (void)ba121_tracker_predict(&tracker, 0, &v[0], &v[1], &v[2], &v[3]);
+        for (ch = 0; ch < 2; ch++)
+        {
+            if ((i % TRACKER_TEST_BLOCK) == 0)
+            {
+                ref[ch].value = (double)raw[ch];
+                ref[ch].rate = 0.0;
+            }
+            else
+            {
+                a_tracker_reference(&ref[ch], alpha, beta, raw[ch], dt_ms);
+            }
+            value_err = fmax(value_err, fabs(BA121_TRACKER_TO_FLOAT(v[ch * 2]) - ref[ch].value));
+            rate_err = fmax(rate_err, fabs(BA121_TRACKER_TO_FLOAT(v[ch * 2 + 1]) - ref[ch].rate));
+        }
+        if ((value_err > TRACKER_TEST_VALUE) || (rate_err > TRACKER_TEST_RATE))
+        {
+            printf("tracker: sample %u alpha %.4f beta %.4f dt %ums differs by %.3f lsb and %.3f lsb/s.\n",
+                   (unsigned int)i, alpha, beta, (unsigned int)dt_ms, value_err, rate_err);
+            
+            return 1;
+        }
+    }
+    printf("tracker: max error %.4f lsb and %.4f lsb/s.\n", value_err, rate_err);
+    printf("tracker: finish test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ba121_wait_test.c
+ * @brief     driver ba121 wait test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ba121_wait_test.h"
+#include "driver_ba121_test_common.h"
+#include <stdio.h>
+
+/**
+ * @brief wait test reply definition
+ */
+#define WAIT_TEST_REPLY_LEN        6           /**< one ba121 frame */
+#define WAIT_TEST_MAX_MS           1000        /**< longer than the 800ms read */
+
+static uint32_t gs_now;              /**< simulated tick */
+static uint32_t gs_reply_at;         /**< tick of the first reply byte */
+static uint8_t gs_reply;             /**< reply flag */
+static uint32_t gs_sleeps;           /**< sleep calls */
+static uint32_t gs_checks;           /**< ready calls */
+static uint32_t gs_state;            /**< random state */
+
+/**
+ * @brief  simulated tick
+ * @return tick in ms
+ * @note   none
+ */
+static uint32_t a_wait_tick(void)
+{
+    return gs_now;
+}
+
+/**
+ * @brief     simulated uart
+ * @param[in] need reply length
+ * @return    1 if need bytes arrived
+ * @note      one byte arrives per tick from gs_reply_at on, about 9600 baud
+ */
+static uint8_t a_wait_ready(uint32_t need)
+{
+    uint32_t count;
+    
+    gs_checks++;
+    if ((gs_reply == 0) || ((int32_t)(gs_now - gs_reply_at) < 0))
+    {
+        return 0;
+    }
+    count = gs_now - gs_reply_at + 1;
+    
+    return (uint8_t)(count >= need);
+}
+
+/**
+ * @brief simulated wfi
+ * @note  the systick wakes up once per tick, other interrupts wake up without a tick
+ */
+static void a_wait_sleep(void)
+{
+    gs_sleeps++;
+    if ((ba121_test_random(&gs_state) & 3) != 0)
+    {
+        gs_now++;
+    }
+}
+
+/**
+ * @brief simulated wait hooks
+ */
+static const wait_t gs_wait =
+{
+    a_wait_tick,
+    a_wait_ready,
+    a_wait_sleep,
+};
+
+/**
+ * @brief     run one wait
+ * @param[in] start start tick
+ * @param[in] reply reply flag
+ * @param[in] offset first reply byte after the start in ms
+ * @param[in] timeout_ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_wait_run(uint32_t start, uint8_t reply, uint32_t offset, uint32_t timeout_ms)
+{
+    uint8_t res;
+    uint8_t expect;
+    uint32_t done;
+    uint32_t elapsed;
+    
+    gs_now = start;
+    gs_reply = reply;
+    gs_reply_at = start + offset;
+    gs_sleeps = 0;
+    gs_checks = 0;
+    res = wait_until(&gs_wait, WAIT_TEST_REPLY_LEN, timeout_ms);
+    elapsed = gs_now - start;
+    
+    /* the reply is whole with its last byte, a reply on the timeout tick still counts */
+    done = offset + WAIT_TEST_REPLY_LEN - 1;
+    expect = ((reply != 0) && (done <= timeout_ms)) ? 0 : 1;
+    if (res != expect)
+    {
+        printf("wait: start %u offset %u timeout %u returned %u.\n", (unsigned int)start,
+               (unsigned int)offset, (unsigned int)timeout_ms, (unsigned int)res);
+        
+        return 1;
+    }
+    if (elapsed != ((expect == 0) ? done : timeout_ms))
+    {
+        printf("wait: start %u offset %u timeout %u ended after %ums.\n", (unsigned int)start,
+               (unsigned int)offset, (unsigned int)timeout_ms, (unsigned int)elapsed);
+        
+        return 1;
+    }
+    
+    /* no polling, one check per wake up */
+    if (gs_checks != gs_sleeps + 1)
+    {
+        printf("wait: %u checks for %u sleeps.\n", (unsigned int)gs_checks, (unsigned int)gs_sleeps);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     wait test
+ * @param[in] times simulated replies
+ * @param[in] seed random seed of the start ticks, the arrivals and the timeouts
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      drives the stm32 reply wait with a simulated tick and a simulated uart,
+ *            and fails unless it ends on the tick the reply is complete or on the timeout tick
+ */
+uint8_t ba121_wait_test(uint32_t times, uint32_t seed)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t start;
+    uint64_t asleep;
+    uint64_t total;
+    
+    gs_state = ba121_test_seed(seed);
+    
+    printf("wait: corner cases.\n");
+    res = 0;
+    res |= a_wait_run(0, 1, 10, 800);                            /* early reply */
+    res |= a_wait_run(0, 0, 0, 800);                             /* lost reply */
+    res |= a_wait_run(0, 1, 0, 0);                               /* no time */
+    res |= a_wait_run(100, 1, 0, 5);                             /* whole on the timeout tick */
+    res |= a_wait_run(100, 1, 0, 4);                             /* one byte short */
+    res |= a_wait_run(0xFFFFFF00U, 1, 500, 800);                 /* tick wraps before the reply */
+    res |= a_wait_run(0xFFFFFFF0U, 0, 0, 800);                   /* tick wraps before the timeout */
+    res |= a_wait_run(0, 1, 900, 800);                           /* late reply */
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    printf("wait: %u replies, seed 0x%08X.\n", (unsigned int)times, (unsigned int)seed);
+    asleep = 0;
+    total = 0;
+    for (i = 0; i < times; i++)
+    {
+        start = ((ba121_test_random(&gs_state) & 7) == 0) ? (0xFFFFFFFFU - (ba121_test_random(&gs_state) % WAIT_TEST_MAX_MS)) : ba121_test_random(&gs_state);
+        if (a_wait_run(start, (uint8_t)((ba121_test_random(&gs_state) & 3) != 0), ba121_test_random(&gs_state) % WAIT_TEST_MAX_MS,
+                       ba121_test_random(&gs_state) % WAIT_TEST_MAX_MS) != 0)
+        {
+            return 1;
+        }
+        asleep += gs_sleeps;
+        total += gs_now - start;
+    }
+    printf("wait: %llu ticks waited with %llu sleeps.\n", (unsigned long long)total, (unsigned long long)asleep);
+    printf("wait: finish test.\n");
+    
+    return 0;
+}